@@ -46,6 +46,7 @@
 #endif
 
 #include <openssl/bn.h>
+#include <openssl/ec.h>
 #include <openssl/rsa.h>
 #include <openssl/ssl.h>
 
@@ -61,12 +62,14 @@ enum
 {
   PROP_0,
   PROP_PEM,
+  PROP_KEY_TYPE,
   NUM_PROPERTIES
 };
 
 static GParamSpec *properties[NUM_PROPERTIES];
 
 #define DEFAULT_PEM NULL
+#define DEFAULT_KEY_TYPE GST_DTLS_KEY_TYPE_RSA
 
 struct _GstDtlsCertificatePrivate
 {
@@ -74,6 +77,7 @@ struct _GstDtlsCertificatePrivate
   EVP_PKEY *private_key;
 
   gchar *pem;
+  GstDtlsKeyType key_type;
 };
 
 G_DEFINE_TYPE_WITH_CODE (GstDtlsCertificate, gst_dtls_certificate,
@@ -81,6 +85,7 @@ G_DEFINE_TYPE_WITH_CODE (GstDtlsCertificate, gst_dtls_certificate,
     GST_DEBUG_CATEGORY_INIT (gst_dtls_certificate_debug,
         "dtlscertificate", 0, "DTLS Certificate"));
 
+static void gst_dtls_certificate_constructed (GObject * gobject);
 static void gst_dtls_certificate_finalize (GObject * gobject);
 static void gst_dtls_certificate_set_property (GObject *, guint prop_id,
     const GValue *, GParamSpec *);
@@ -101,14 +106,22 @@ gst_dtls_certificate_class_init (GstDtlsCertificateClass * klass)
   properties[PROP_PEM] =
       g_param_spec_string ("pem",
       "Pem string",
-      "A string containing a X509 certificate and RSA private key in PEM format",
+      "A string containing a X509 certificate and private key in PEM format",
       DEFAULT_PEM,
       G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_KEY_TYPE] =
+      g_param_spec_enum ("key-type",
+      "Key type",
+      "The type of private key to use when generating a certificate",
+      GST_DTLS_TYPE_KEY_TYPE, DEFAULT_KEY_TYPE,
+      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 
   _gst_dtls_init_openssl ();
 
+  gobject_class->constructed = gst_dtls_certificate_constructed;
   gobject_class->finalize = gst_dtls_certificate_finalize;
 }
 
@@ -122,6 +135,28 @@ gst_dtls_certificate_init (GstDtlsCertificate * self)
   priv->x509 = NULL;
   priv->private_key = NULL;
   priv->pem = NULL;
+  priv->key_type = DEFAULT_KEY_TYPE;
+}
+
+static void
+gst_dtls_certificate_constructed (GObject * gobject)
+{
+  GstDtlsCertificate *self = GST_DTLS_CERTIFICATE (gobject);
+  gchar *pem;
+
+  G_OBJECT_CLASS (gst_dtls_certificate_parent_class)->constructed (gobject);
+
+  /* both construct properties are needed to decide how to initialize, so
+   * this can not be done from set_property() */
+  pem = self->priv->pem;
+  self->priv->pem = NULL;
+
+  if (pem) {
+    init_from_pem_string (self, pem);
+    g_free (pem);
+  } else {
+    init_generated (self);
+  }
 }
 
 static void
@@ -147,16 +182,14 @@ gst_dtls_certificate_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
   GstDtlsCertificate *self = GST_DTLS_CERTIFICATE (object);
-  const gchar *pem;
 
   switch (prop_id) {
     case PROP_PEM:
-      pem = g_value_get_string (value);
-      if (pem) {
-        init_from_pem_string (self, pem);
-      } else {
-        init_generated (self);
-      }
+      g_free (self->priv->pem);
+      self->priv->pem = g_value_dup_string (value);
+      break;
+    case PROP_KEY_TYPE:
+      self->priv->key_type = g_value_get_enum (value);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
@@ -174,11 +207,30 @@ gst_dtls_certificate_get_property (GObject * object, guint prop_id,
       g_return_if_fail (self->priv->pem);
       g_value_set_string (value, self->priv->pem);
       break;
+    case PROP_KEY_TYPE:
+      g_value_set_enum (value, self->priv->key_type);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
 }
 
+GType
+gst_dtls_key_type_get_type (void)
+{
+  static GType type = 0;
+  static const GEnumValue values[] = {
+    {GST_DTLS_KEY_TYPE_RSA, "RSA 2048", "rsa"},
+    {GST_DTLS_KEY_TYPE_ECDSA, "ECDSA P-256", "ecdsa"},
+    {0, NULL, NULL},
+  };
+
+  if (!type) {
+    type = g_enum_register_static ("GstDtlsKeyType", values);
+  }
+  return type;
+}
+
 static const gchar base64_alphabet[64] = {
   'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
   'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
@@ -187,35 +239,11 @@ static const gchar base64_alphabet[64] = {
   '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
 };
 
-static void
-init_generated (GstDtlsCertificate * self)
+static EVP_PKEY *
+generate_rsa_key (void)
 {
-  GstDtlsCertificatePrivate *priv = self->priv;
+  EVP_PKEY *private_key;
   RSA *rsa;
-  BIGNUM *serial_number;
-  ASN1_INTEGER *asn1_serial_number;
-  X509_NAME *name = NULL;
-  gchar common_name[9] = { 0, };
-  gint i;
-
-  g_return_if_fail (!priv->x509);
-  g_return_if_fail (!priv->private_key);
-
-  priv->private_key = EVP_PKEY_new ();
-
-  if (!priv->private_key) {
-    GST_WARNING_OBJECT (self, "failed to create private key");
-    return;
-  }
-
-  priv->x509 = X509_new ();
-
-  if (!priv->x509) {
-    GST_WARNING_OBJECT (self, "failed to create certificate");
-    EVP_PKEY_free (priv->private_key);
-    priv->private_key = NULL;
-    return;
-  }
 
   /* XXX: RSA_generate_key is actually deprecated in 0.9.8 */
 #if OPENSSL_VERSION_NUMBER < 0x10100001L
@@ -235,25 +263,84 @@ init_generated (GstDtlsCertificate * self)
 #endif
 
   if (!rsa) {
-    GST_WARNING_OBJECT (self, "failed to generate RSA");
-    EVP_PKEY_free (priv->private_key);
-    priv->private_key = NULL;
-    X509_free (priv->x509);
-    priv->x509 = NULL;
-    return;
+    GST_WARNING ("failed to generate RSA");
+    return NULL;
   }
 
-  if (!EVP_PKEY_assign_RSA (priv->private_key, rsa)) {
-    GST_WARNING_OBJECT (self, "failed to assign RSA");
+  private_key = EVP_PKEY_new ();
+  if (!private_key || !EVP_PKEY_assign_RSA (private_key, rsa)) {
+    GST_WARNING ("failed to assign RSA");
     RSA_free (rsa);
-    rsa = NULL;
+    EVP_PKEY_free (private_key);
+    return NULL;
+  }
+
+  return private_key;
+}
+
+static EVP_PKEY *
+generate_ecdsa_key (void)
+{
+  EVP_PKEY *private_key;
+  EC_KEY *ec_key;
+
+  ec_key = EC_KEY_new_by_curve_name (NID_X9_62_prime256v1);
+  if (!ec_key) {
+    GST_WARNING ("failed to create P-256 key");
+    return NULL;
+  }
+
+  /* Peers only need to know the curve, not its parameters */
+  EC_KEY_set_asn1_flag (ec_key, OPENSSL_EC_NAMED_CURVE);
+
+  if (!EC_KEY_generate_key (ec_key)) {
+    GST_WARNING ("failed to generate ECDSA key");
+    EC_KEY_free (ec_key);
+    return NULL;
+  }
+
+  private_key = EVP_PKEY_new ();
+  if (!private_key || !EVP_PKEY_assign_EC_KEY (private_key, ec_key)) {
+    GST_WARNING ("failed to assign ECDSA key");
+    EC_KEY_free (ec_key);
+    EVP_PKEY_free (private_key);
+    return NULL;
+  }
+
+  return private_key;
+}
+
+static void
+init_generated (GstDtlsCertificate * self)
+{
+  GstDtlsCertificatePrivate *priv = self->priv;
+  BIGNUM *serial_number;
+  ASN1_INTEGER *asn1_serial_number;
+  X509_NAME *name = NULL;
+  gchar common_name[9] = { 0, };
+  gint i;
+
+  g_return_if_fail (!priv->x509);
+  g_return_if_fail (!priv->private_key);
+
+  if (priv->key_type == GST_DTLS_KEY_TYPE_ECDSA)
+    priv->private_key = generate_ecdsa_key ();
+  else
+    priv->private_key = generate_rsa_key ();
+
+  if (!priv->private_key) {
+    GST_WARNING_OBJECT (self, "failed to create private key");
+    return;
+  }
+
+  priv->x509 = X509_new ();
+
+  if (!priv->x509) {
+    GST_WARNING_OBJECT (self, "failed to create certificate");
     EVP_PKEY_free (priv->private_key);
     priv->private_key = NULL;
-    X509_free (priv->x509);
-    priv->x509 = NULL;
     return;
   }
-  rsa = NULL;
 
   X509_set_version (priv->x509, 2);
 
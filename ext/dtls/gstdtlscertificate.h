@@ -44,11 +44,30 @@ typedef struct _GstDtlsCertificate        GstDtlsCertificate;
 typedef struct _GstDtlsCertificateClass   GstDtlsCertificateClass;
 typedef struct _GstDtlsCertificatePrivate GstDtlsCertificatePrivate;
 
+/*
+ * GstDtlsKeyType:
+ * @GST_DTLS_KEY_TYPE_RSA: 2048 bit RSA key
+ * @GST_DTLS_KEY_TYPE_ECDSA: ECDSA key on the NIST P-256 curve
+ *
+ * The type of private key used for generated certificates.
+ */
+typedef enum
+{
+  GST_DTLS_KEY_TYPE_RSA,
+  GST_DTLS_KEY_TYPE_ECDSA,
+} GstDtlsKeyType;
+
+#define GST_DTLS_KEY_TYPE_LAST GST_DTLS_KEY_TYPE_ECDSA
+
+GType gst_dtls_key_type_get_type (void);
+#define GST_DTLS_TYPE_KEY_TYPE (gst_dtls_key_type_get_type ())
+
 /*
  * GstDtlsCertificate:
  *
  * Handles a X509 certificate and a private key.
- * If a certificate is created without the "pem" property, a self-signed certificate is generated.
+ * If a certificate is created without the "pem" property, a self-signed certificate is generated,
+ * with a private key of the type given by the "key-type" property.
  */
 struct _GstDtlsCertificate {
     GObject parent_instance;
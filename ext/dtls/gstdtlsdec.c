@@ -67,6 +67,8 @@ enum
   PROP_SRTP_CIPHER,
   PROP_SRTP_AUTH,
   PROP_CONNECTION_STATE,
+  PROP_KEY_TYPE,
+  PROP_CERTIFICATE_ROTATION,
   NUM_PROPERTIES
 };
 
@@ -79,6 +81,8 @@ static GParamSpec *properties[NUM_PROPERTIES];
 #define DEFAULT_DECODER_KEY NULL
 #define DEFAULT_SRTP_CIPHER 0
 #define DEFAULT_SRTP_AUTH 0
+#define DEFAULT_KEY_TYPE GST_DTLS_KEY_TYPE_RSA
+#define DEFAULT_CERTIFICATE_ROTATION 0
 
 
 static void gst_dtls_dec_finalize (GObject *);
@@ -103,6 +107,10 @@ static GstFlowReturn sink_chain_list (GstPad *, GstObject * parent,
     GstBufferList *);
 
 static GstDtlsAgent *get_agent_by_pem (const gchar * pem);
+static GstDtlsAgent *get_generated_agent (GstDtlsKeyType key_type,
+    guint rotation);
+static void prefetch_generated_agent (GstDtlsKeyType key_type);
+static void update_agent (GstDtlsDec *);
 static void agent_weak_ref_notify (gchar * pem, GstDtlsAgent *);
 static void create_connection (GstDtlsDec *, gchar * id);
 static void connection_weak_ref_notify (gchar * id, GstDtlsConnection *);
@@ -178,6 +186,39 @@ gst_dtls_dec_class_init (GstDtlsDecClass * klass)
       GST_DTLS_TYPE_CONNECTION_STATE,
       GST_DTLS_CONNECTION_STATE_NEW, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GstDtlsDec:key-type:
+   *
+   * The type of private key used when no #GstDtlsDec:pem is set and a
+   * certificate has to be generated.  Generated certificates are shared
+   * between all elements in the process using the same key type.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_KEY_TYPE] =
+      g_param_spec_enum ("key-type",
+      "Key type",
+      "The type of private key to use for generated certificates",
+      GST_DTLS_TYPE_KEY_TYPE, DEFAULT_KEY_TYPE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstDtlsDec:certificate-rotation:
+   *
+   * Maximum age in seconds of the shared generated certificate before new
+   * connections get a freshly generated one, or 0 to keep using the same
+   * certificate for the lifetime of the process.  Replacement certificates
+   * are generated in the background ahead of time.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_CERTIFICATE_ROTATION] =
+      g_param_spec_uint ("certificate-rotation",
+      "Certificate rotation",
+      "Maximum age in seconds of the generated certificate (0 = never rotate)",
+      0, G_MAXUINT, DEFAULT_CERTIFICATE_ROTATION,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 
   gst_element_class_add_static_pad_template (element_class, &src_template);
@@ -192,7 +233,13 @@ gst_dtls_dec_class_init (GstDtlsDecClass * klass)
 static void
 gst_dtls_dec_init (GstDtlsDec * self)
 {
-  self->agent = get_agent_by_pem (NULL);
+  /* The agent is only picked once it is needed so that the key type and
+   * rotation can still be configured */
+  self->agent = NULL;
+  self->pem = NULL;
+  self->key_type = DEFAULT_KEY_TYPE;
+  self->certificate_rotation = DEFAULT_CERTIFICATE_ROTATION;
+
   self->connection_id = NULL;
   self->connection = NULL;
   self->peer_pem = NULL;
@@ -230,6 +277,9 @@ gst_dtls_dec_finalize (GObject * object)
   g_free (self->peer_pem);
   self->peer_pem = NULL;
 
+  g_free (self->pem);
+  self->pem = NULL;
+
   g_mutex_clear (&self->src_mutex);
 
   GST_LOG_OBJECT (self, "finalized");
@@ -265,18 +315,34 @@ gst_dtls_dec_set_property (GObject * object, guint prop_id,
     case PROP_CONNECTION_ID:
       g_free (self->connection_id);
       self->connection_id = g_value_dup_string (value);
+      if (!self->agent)
+        update_agent (self);
       g_return_if_fail (self->agent);
       create_connection (self, self->connection_id);
       break;
     case PROP_PEM:
-      if (self->agent) {
-        g_object_unref (self->agent);
-      }
-      self->agent = get_agent_by_pem (g_value_get_string (value));
-      if (self->connection_id) {
+      g_free (self->pem);
+      self->pem = g_value_dup_string (value);
+      update_agent (self);
+      if (self->connection_id)
         create_connection (self, self->connection_id);
+      break;
+    case PROP_KEY_TYPE:
+      self->key_type = g_value_get_enum (value);
+      if (self->pem)
+        break;
+      if (self->agent) {
+        update_agent (self);
+        if (self->connection_id)
+          create_connection (self, self->connection_id);
+      } else {
+        /* generate the certificate in the background until it is needed */
+        prefetch_generated_agent (self->key_type);
       }
       break;
+    case PROP_CERTIFICATE_ROTATION:
+      self->certificate_rotation = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
@@ -293,9 +359,17 @@ gst_dtls_dec_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_string (value, self->connection_id);
       break;
     case PROP_PEM:
+      if (!self->agent)
+        update_agent (self);
       g_value_take_string (value,
           gst_dtls_agent_get_certificate_pem (self->agent));
       break;
+    case PROP_KEY_TYPE:
+      g_value_set_enum (value, self->key_type);
+      break;
+    case PROP_CERTIFICATE_ROTATION:
+      g_value_set_uint (value, self->certificate_rotation);
+      break;
     case PROP_PEER_PEM:
       g_value_set_string (value, self->peer_pem);
       break;
@@ -655,65 +729,196 @@ sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 static GHashTable *agent_table = NULL;
 G_LOCK_DEFINE_STATIC (agent_table);
 
-static GstDtlsAgent *generated_cert_agent = NULL;
+/* Agents with a generated certificate, one pool entry per key type.  Key
+ * generation is expensive, so a replacement is generated in a background
+ * thread while the current agent is still in use, and callers asking for an
+ * agent that is being generated wait for it instead of generating their own */
+typedef struct
+{
+  GstDtlsAgent *agent;
+  gint64 agent_time;
+  GstDtlsAgent *next;
+  gboolean generating;
+} GeneratedAgent;
+
+static GeneratedAgent generated_agents[GST_DTLS_KEY_TYPE_LAST + 1];
+static GMutex generated_agents_lock;
+static GCond generated_agents_cond;
 
 static GstDtlsAgent *
-get_agent_by_pem (const gchar * pem)
+generate_agent (GstDtlsKeyType key_type)
 {
   GstDtlsAgent *agent;
+  GObject *certificate;
+  gint64 start = g_get_monotonic_time ();
 
-  if (!pem) {
-    if (g_once_init_enter (&generated_cert_agent)) {
-      GstDtlsAgent *new_agent;
-      GObject *certificate;
+  certificate = g_object_new (GST_TYPE_DTLS_CERTIFICATE, "key-type", key_type,
+      NULL);
+  agent = g_object_new (GST_TYPE_DTLS_AGENT, "certificate", certificate, NULL);
+  g_object_unref (certificate);
 
-      certificate = g_object_new (GST_TYPE_DTLS_CERTIFICATE, NULL);
-      new_agent = g_object_new (GST_TYPE_DTLS_AGENT, "certificate",
-          certificate, NULL);
-      g_object_unref (certificate);
+  GST_DEBUG_OBJECT (agent, "generated certificate with key type %d in %"
+      G_GINT64_FORMAT " us", key_type, g_get_monotonic_time () - start);
 
-      GST_DEBUG_OBJECT (generated_cert_agent,
-          "no agent with generated cert found, creating new");
-      g_once_init_leave (&generated_cert_agent, new_agent);
-    } else {
-      GST_DEBUG_OBJECT (generated_cert_agent,
-          "using agent with generated cert");
+  return agent;
+}
+
+static gpointer
+generate_agent_thread (gpointer user_data)
+{
+  GstDtlsKeyType key_type = GPOINTER_TO_UINT (user_data);
+  GstDtlsAgent *agent;
+
+  agent = generate_agent (key_type);
+
+  g_mutex_lock (&generated_agents_lock);
+  generated_agents[key_type].next = agent;
+  generated_agents[key_type].generating = FALSE;
+  g_cond_broadcast (&generated_agents_cond);
+  g_mutex_unlock (&generated_agents_lock);
+
+  return NULL;
+}
+
+/* must be called with generated_agents_lock */
+static void
+start_generating_agent (GstDtlsKeyType key_type)
+{
+  GeneratedAgent *slot = &generated_agents[key_type];
+  GThread *thread;
+  GError *error = NULL;
+
+  if (slot->generating || slot->next)
+    return;
+
+  thread = g_thread_try_new ("dtls-certgen", generate_agent_thread,
+      GUINT_TO_POINTER (key_type), &error);
+  if (!thread) {
+    /* get_generated_agent() falls back to generating synchronously */
+    GST_WARNING ("failed to start certificate generation thread: %s",
+        error->message);
+    g_clear_error (&error);
+    return;
+  }
+
+  slot->generating = TRUE;
+  g_thread_unref (thread);
+}
+
+static void
+prefetch_generated_agent (GstDtlsKeyType key_type)
+{
+  g_mutex_lock (&generated_agents_lock);
+  if (!generated_agents[key_type].agent)
+    start_generating_agent (key_type);
+  g_mutex_unlock (&generated_agents_lock);
+}
+
+static GstDtlsAgent *
+get_generated_agent (GstDtlsKeyType key_type, guint rotation)
+{
+  GeneratedAgent *slot = &generated_agents[key_type];
+  GstDtlsAgent *agent;
+  gint64 now;
+
+  g_mutex_lock (&generated_agents_lock);
+
+  now = g_get_monotonic_time ();
+
+  while (TRUE) {
+    if (slot->agent && (rotation == 0
+            || now - slot->agent_time < (gint64) rotation * G_USEC_PER_SEC)) {
+      GST_DEBUG_OBJECT (slot->agent, "using agent with generated cert");
+      agent = g_object_ref (slot->agent);
+      break;
     }
 
-    agent = generated_cert_agent;
-    g_object_ref (agent);
-  } else {
-    G_LOCK (agent_table);
+    if (slot->next) {
+      /* connections still using the previous agent keep their reference */
+      GST_DEBUG_OBJECT (slot->next, "switching to new agent with generated "
+          "cert");
+      if (slot->agent)
+        g_object_unref (slot->agent);
+      slot->agent = slot->next;
+      slot->agent_time = now;
+      slot->next = NULL;
+      continue;
+    }
 
-    if (!agent_table) {
-      agent_table =
-          g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    if (slot->generating) {
+      g_cond_wait (&generated_agents_cond, &generated_agents_lock);
+      continue;
     }
 
-    agent = GST_DTLS_AGENT (g_hash_table_lookup (agent_table, pem));
+    GST_DEBUG ("no agent with generated cert found, creating new");
+    slot->generating = TRUE;
+    g_mutex_unlock (&generated_agents_lock);
+    agent = generate_agent (key_type);
+    g_mutex_lock (&generated_agents_lock);
+    slot->next = agent;
+    slot->generating = FALSE;
+    g_cond_broadcast (&generated_agents_cond);
+  }
 
-    if (!agent) {
-      GObject *certificate;
+  /* have the replacement ready by the time this one is due for rotation */
+  if (rotation > 0)
+    start_generating_agent (key_type);
 
-      certificate = g_object_new (GST_TYPE_DTLS_CERTIFICATE, "pem", pem, NULL);
-      agent = g_object_new (GST_TYPE_DTLS_AGENT, "certificate", certificate,
-          NULL);
-      g_object_unref (certificate);
+  g_mutex_unlock (&generated_agents_lock);
 
-      g_object_weak_ref (G_OBJECT (agent), (GWeakNotify) agent_weak_ref_notify,
-          (gpointer) g_strdup (pem));
+  return agent;
+}
 
-      g_hash_table_insert (agent_table, g_strdup (pem), agent);
+static void
+update_agent (GstDtlsDec * self)
+{
+  if (self->agent) {
+    g_object_unref (self->agent);
+  }
 
-      GST_DEBUG_OBJECT (agent, "no agent found, created new");
-    } else {
-      g_object_ref (agent);
-      GST_DEBUG_OBJECT (agent, "agent found");
-    }
+  if (self->pem)
+    self->agent = get_agent_by_pem (self->pem);
+  else
+    self->agent = get_generated_agent (self->key_type,
+        self->certificate_rotation);
+}
 
-    G_UNLOCK (agent_table);
+static GstDtlsAgent *
+get_agent_by_pem (const gchar * pem)
+{
+  GstDtlsAgent *agent;
+
+  g_return_val_if_fail (pem, NULL);
+
+  G_LOCK (agent_table);
+
+  if (!agent_table) {
+    agent_table =
+        g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
   }
 
+  agent = GST_DTLS_AGENT (g_hash_table_lookup (agent_table, pem));
+
+  if (!agent) {
+    GObject *certificate;
+
+    certificate = g_object_new (GST_TYPE_DTLS_CERTIFICATE, "pem", pem, NULL);
+    agent = g_object_new (GST_TYPE_DTLS_AGENT, "certificate", certificate,
+        NULL);
+    g_object_unref (certificate);
+
+    g_object_weak_ref (G_OBJECT (agent), (GWeakNotify) agent_weak_ref_notify,
+        (gpointer) g_strdup (pem));
+
+    g_hash_table_insert (agent_table, g_strdup (pem), agent);
+
+    GST_DEBUG_OBJECT (agent, "no agent found, created new");
+  } else {
+    g_object_ref (agent);
+    GST_DEBUG_OBJECT (agent, "agent found");
+  }
+
+  G_UNLOCK (agent_table);
 
   return agent;
 }
@@ -27,6 +27,7 @@
 #define gstdtlsdec_h
 
 #include "gstdtlsagent.h"
+#include "gstdtlscertificate.h"
 #include "gstdtlsconnection.h"
 
 #include <gst/gst.h>
@@ -55,6 +56,9 @@ struct _GstDtlsDec {
     GMutex src_mutex;
 
     GstDtlsAgent *agent;
+    gchar *pem;
+    GstDtlsKeyType key_type;
+    guint certificate_rotation;
     GstDtlsConnection *connection;
     GMutex connection_mutex;
     gchar *connection_id;
@@ -80,6 +80,11 @@ static GParamSpec *properties[NUM_PROPERTIES];
 
 #define INITIAL_QUEUE_SIZE 64
 
+/* Size of the pooled output buffers. DTLS records carrying SCTP or
+ * handshake messages fit into a single MTU, larger records fall back to
+ * separately allocated buffers */
+#define POOL_BUFFER_SIZE 1500
+
 static void gst_dtls_enc_finalize (GObject *);
 static void gst_dtls_enc_set_property (GObject *, guint prop_id,
     const GValue *, GParamSpec *);
@@ -96,6 +101,7 @@ static gboolean src_activate_mode (GstPad *, GstObject *, GstPadMode,
 static void src_task_loop (GstPad *);
 
 static GstFlowReturn sink_chain (GstPad *, GstObject *, GstBuffer *);
+static GstFlowReturn sink_chain_list (GstPad *, GstObject *, GstBufferList *);
 static gboolean sink_event (GstPad * pad, GstObject * parent, GstEvent * event);
 
 static void on_key_received (GstDtlsConnection *, gpointer key, guint cipher,
@@ -224,6 +230,12 @@ gst_dtls_enc_finalize (GObject * object)
   g_queue_clear (&self->queue);
   g_mutex_unlock (&self->queue_lock);
 
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+
   g_mutex_clear (&self->queue_lock);
   g_cond_clear (&self->queue_cond_add);
 
@@ -390,6 +402,7 @@ gst_dtls_enc_request_new_pad (GstElement * element,
   }
 
   gst_pad_set_chain_function (sink, GST_DEBUG_FUNCPTR (sink_chain));
+  gst_pad_set_chain_list_function (sink, GST_DEBUG_FUNCPTR (sink_chain_list));
   gst_pad_set_event_function (sink, GST_DEBUG_FUNCPTR (sink_event));
 
   ret = gst_pad_set_active (sink, TRUE);
@@ -411,6 +424,24 @@ src_activate_mode (GstPad * pad, GstObject * parent, GstPadMode mode,
   if (active) {
     GST_DEBUG_OBJECT (self, "src pad activating in push mode");
 
+    g_mutex_lock (&self->queue_lock);
+    if (!self->pool) {
+      GstStructure *config;
+
+      self->pool = gst_buffer_pool_new ();
+      config = gst_buffer_pool_get_config (self->pool);
+      gst_buffer_pool_config_set_params (config, NULL, POOL_BUFFER_SIZE, 0, 0);
+      if (!gst_buffer_pool_set_config (self->pool, config)) {
+        GST_WARNING_OBJECT (self, "failed to configure buffer pool");
+        gst_clear_object (&self->pool);
+      }
+    }
+    if (self->pool && !gst_buffer_pool_set_active (self->pool, TRUE)) {
+      GST_WARNING_OBJECT (self, "failed to activate buffer pool");
+      gst_clear_object (&self->pool);
+    }
+    g_mutex_unlock (&self->queue_lock);
+
     self->flushing = FALSE;
     self->src_ret = GST_FLOW_OK;
     self->send_initial_events = TRUE;
@@ -434,6 +465,11 @@ src_activate_mode (GstPad * pad, GstObject * parent, GstPadMode mode,
     if (!success) {
       GST_WARNING_OBJECT (self, "failed to deactivate pad task");
     }
+
+    g_mutex_lock (&self->queue_lock);
+    if (self->pool)
+      gst_buffer_pool_set_active (self->pool, FALSE);
+    g_mutex_unlock (&self->queue_lock);
   }
 
   return success;
@@ -445,6 +481,7 @@ src_task_loop (GstPad * pad)
   GstDtlsEnc *self = GST_DTLS_ENC (GST_PAD_PARENT (pad));
   GstFlowReturn ret;
   GstBuffer *buffer;
+  GstBufferList *list = NULL;
   gboolean check_connection_timeout = FALSE;
 
   GST_TRACE_OBJECT (self, "src loop: acquiring lock");
@@ -473,6 +510,17 @@ src_task_loop (GstPad * pad)
   GST_TRACE_OBJECT (self, "src loop: queue has element");
 
   buffer = g_queue_pop_head (&self->queue);
+
+  /* Push everything that was queued up in the meantime as a single list, up
+   * to the EOS marker which is handled by the next iteration */
+  if (buffer && g_queue_peek_head (&self->queue)) {
+    list = gst_buffer_list_new_sized (g_queue_get_length (&self->queue) + 1);
+    gst_buffer_list_add (list, buffer);
+    buffer = NULL;
+
+    while (g_queue_peek_head (&self->queue))
+      gst_buffer_list_add (list, g_queue_pop_head (&self->queue));
+  }
   g_mutex_unlock (&self->queue_lock);
 
   if (self->send_initial_events) {
@@ -494,8 +542,14 @@ src_task_loop (GstPad * pad)
 
   GST_TRACE_OBJECT (self, "src loop: releasing lock");
 
-  if (buffer) {
-    ret = gst_pad_push (self->src, buffer);
+  if (buffer || list) {
+    if (list) {
+      GST_LOG_OBJECT (self, "pushing buffer list of length %u",
+          gst_buffer_list_length (list));
+      ret = gst_pad_push_list (self->src, list);
+    } else {
+      ret = gst_pad_push (self->src, buffer);
+    }
     if (check_connection_timeout)
       gst_dtls_connection_check_timeout (self->connection);
 
@@ -516,35 +570,36 @@ src_task_loop (GstPad * pad)
 }
 
 static GstFlowReturn
-sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+check_src_ret (GstDtlsEnc * self)
+{
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->queue_lock);
+  ret = self->src_ret;
+  if (G_UNLIKELY (ret == GST_FLOW_NOT_LINKED || ret < GST_FLOW_EOS))
+    GST_ERROR_OBJECT (self, "Pushing previous data returned an error: %s",
+        gst_flow_get_name (ret));
+  g_mutex_unlock (&self->queue_lock);
+
+  return ret;
+}
+
+static GstFlowReturn
+send_buffer (GstDtlsEnc * self, GstBuffer * buffer)
 {
-  GstDtlsEnc *self = GST_DTLS_ENC (parent);
   GstMapInfo map_info;
   GError *err = NULL;
   gsize to_write, written = 0;
   GstFlowReturn ret = GST_FLOW_OK;
 
-  g_mutex_lock (&self->queue_lock);
-  if (self->src_ret != GST_FLOW_OK) {
-    if (G_UNLIKELY (self->src_ret == GST_FLOW_NOT_LINKED
-            || self->src_ret < GST_FLOW_EOS))
-      GST_ERROR_OBJECT (self, "Pushing previous data returned an error: %s",
-          gst_flow_get_name (self->src_ret));
-
-    gst_buffer_unref (buffer);
-    g_mutex_unlock (&self->queue_lock);
-    return self->src_ret;
-  }
-  g_mutex_unlock (&self->queue_lock);
-
   gst_buffer_map (buffer, &map_info, GST_MAP_READ);
 
   to_write = map_info.size;
 
   while (to_write > 0 && ret == GST_FLOW_OK) {
     ret =
-        gst_dtls_connection_send (self->connection, map_info.data,
-        map_info.size, &written, &err);
+        gst_dtls_connection_send (self->connection,
+        map_info.data + map_info.size - to_write, to_write, &written, &err);
 
     switch (ret) {
       case GST_FLOW_OK:
@@ -571,11 +626,47 @@ sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   }
 
   gst_buffer_unmap (buffer, &map_info);
+
+  return ret;
+}
+
+static GstFlowReturn
+sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstDtlsEnc *self = GST_DTLS_ENC (parent);
+  GstFlowReturn ret;
+
+  ret = check_src_ret (self);
+  if (ret == GST_FLOW_OK)
+    ret = send_buffer (self, buffer);
+
   gst_buffer_unref (buffer);
 
   return ret;
 }
 
+static GstFlowReturn
+sink_chain_list (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  GstDtlsEnc *self = GST_DTLS_ENC (parent);
+  GstFlowReturn ret;
+  guint i, n;
+
+  /* All records produced for this list are queued up by the send callback
+   * and pushed downstream together by the src pad task */
+  ret = check_src_ret (self);
+
+  n = gst_buffer_list_length (list);
+  for (i = 0; i < n && ret == GST_FLOW_OK; i++)
+    ret = send_buffer (self, gst_buffer_list_get (list, i));
+
+  GST_LOG_OBJECT (self, "sent %u of %u buffers from list", i, n);
+
+  gst_buffer_list_unref (list);
+
+  return ret;
+}
+
 
 static gboolean
 sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
@@ -662,13 +753,23 @@ on_send_data (GstDtlsConnection * connection, gconstpointer data, gsize length,
   GST_DEBUG_OBJECT (self, "sending data from %s with length %" G_GSIZE_FORMAT,
       self->connection_id, length);
 
-  buffer =
-      data ? gst_buffer_new_wrapped (g_memdup (data, length), length) : NULL;
-
   GST_TRACE_OBJECT (self, "send data: acquiring lock");
   g_mutex_lock (&self->queue_lock);
   GST_TRACE_OBJECT (self, "send data: acquired lock");
 
+  buffer = NULL;
+  if (data && length <= POOL_BUFFER_SIZE && self->pool) {
+    if (gst_buffer_pool_acquire_buffer (self->pool, &buffer,
+            NULL) == GST_FLOW_OK) {
+      gst_buffer_fill (buffer, 0, data, length);
+      gst_buffer_set_size (buffer, length);
+    } else {
+      buffer = NULL;
+    }
+  }
+  if (data && !buffer)
+    buffer = gst_buffer_new_wrapped (g_memdup (data, length), length);
+
   g_queue_push_tail (&self->queue, buffer);
 
   GST_TRACE_OBJECT (self, "send data: signaling add");
@@ -53,6 +53,8 @@ struct _GstDtlsEnc {
     GCond queue_cond_add;
     gboolean flushing;
 
+    GstBufferPool *pool;
+
     GstDtlsConnection *connection;
     gchar *connection_id;
 
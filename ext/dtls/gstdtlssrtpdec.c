@@ -28,6 +28,7 @@
 #endif
 
 #include "gstdtlssrtpdec.h"
+#include "gstdtlscertificate.h"
 #include "gstdtlsconnection.h"
 
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -69,6 +70,8 @@ enum
   PROP_PEM,
   PROP_PEER_PEM,
   PROP_CONNECTION_STATE,
+  PROP_KEY_TYPE,
+  PROP_CERTIFICATE_ROTATION,
   NUM_PROPERTIES
 };
 
@@ -139,6 +142,33 @@ gst_dtls_srtp_dec_class_init (GstDtlsSrtpDecClass * klass)
       GST_DTLS_TYPE_CONNECTION_STATE,
       GST_DTLS_CONNECTION_STATE_NEW, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GstDtlsSrtpDec:key-type:
+   *
+   * See #GstDtlsDec:key-type.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_KEY_TYPE] =
+      g_param_spec_enum ("key-type",
+      "Key type",
+      "The type of private key to use for generated certificates",
+      GST_DTLS_TYPE_KEY_TYPE, GST_DTLS_KEY_TYPE_RSA,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstDtlsSrtpDec:certificate-rotation:
+   *
+   * See #GstDtlsDec:certificate-rotation.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_CERTIFICATE_ROTATION] =
+      g_param_spec_uint ("certificate-rotation",
+      "Certificate rotation",
+      "Maximum age in seconds of the generated certificate (0 = never rotate)",
+      0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 
   gst_element_class_add_static_pad_template (element_class, &sink_template);
@@ -260,6 +290,16 @@ gst_dtls_srtp_dec_set_property (GObject * object,
         GST_WARNING_OBJECT (self, "tried to set pem after disabling DTLS");
       }
       break;
+    case PROP_KEY_TYPE:
+    case PROP_CERTIFICATE_ROTATION:
+      if (self->bin.dtls_element) {
+        g_object_set_property (G_OBJECT (self->bin.dtls_element),
+            pspec->name, value);
+      } else {
+        GST_WARNING_OBJECT (self, "tried to set %s after disabling DTLS",
+            pspec->name);
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
@@ -287,6 +327,16 @@ gst_dtls_srtp_dec_get_property (GObject * object,
         GST_WARNING_OBJECT (self, "tried to get peer-pem after disabling DTLS");
       }
       break;
+    case PROP_KEY_TYPE:
+    case PROP_CERTIFICATE_ROTATION:
+      if (self->bin.dtls_element) {
+        g_object_get_property (G_OBJECT (self->bin.dtls_element),
+            pspec->name, value);
+      } else {
+        GST_WARNING_OBJECT (self, "tried to get %s after disabling DTLS",
+            pspec->name);
+      }
+      break;
     case PROP_CONNECTION_STATE:
       g_object_get_property (G_OBJECT (self->bin.dtls_element),
           "connection-state", value);
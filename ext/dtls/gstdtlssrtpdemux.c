@@ -61,6 +61,8 @@ G_DEFINE_TYPE_WITH_CODE (GstDtlsSrtpDemux, gst_dtls_srtp_demux,
         "dtlssrtpdemux", 0, "DTLS SRTP Demultiplexer"));
 
 static GstFlowReturn sink_chain (GstPad *, GstObject * self, GstBuffer *);
+static GstFlowReturn sink_chain_list (GstPad *, GstObject * self,
+    GstBufferList *);
 
 static void
 gst_dtls_srtp_demux_class_init (GstDtlsSrtpDemuxClass * klass)
@@ -95,43 +97,121 @@ gst_dtls_srtp_demux_init (GstDtlsSrtpDemux * self)
   g_return_if_fail (self->dtls_src);
 
   gst_pad_set_chain_function (sink, GST_DEBUG_FUNCPTR (sink_chain));
+  gst_pad_set_chain_list_function (sink, GST_DEBUG_FUNCPTR (sink_chain_list));
 
   gst_element_add_pad (GST_ELEMENT (self), sink);
   gst_element_add_pad (GST_ELEMENT (self), self->rtp_src);
   gst_element_add_pad (GST_ELEMENT (self), self->dtls_src);
 }
 
-static GstFlowReturn
-sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+/* Returns the pad the buffer should be pushed on, or NULL if it should be
+ * dropped */
+static GstPad *
+select_src_pad (GstDtlsSrtpDemux * self, GstBuffer * buffer)
 {
-  GstDtlsSrtpDemux *self = GST_DTLS_SRTP_DEMUX (parent);
   guint8 first_byte;
 
   if (gst_buffer_get_size (buffer) == 0) {
     GST_LOG_OBJECT (self, "received buffer with size 0");
-    gst_buffer_unref (buffer);
-    return GST_FLOW_OK;
+    return NULL;
   }
 
   if (gst_buffer_extract (buffer, 0, &first_byte, 1) != 1) {
     GST_WARNING_OBJECT (self, "could not extract first byte from buffer");
+    return NULL;
+  }
+
+  if (PACKET_IS_DTLS (first_byte))
+    return self->dtls_src;
+
+  if (PACKET_IS_RTP (first_byte))
+    return self->rtp_src;
+
+  GST_WARNING_OBJECT (self, "received invalid buffer: %x", first_byte);
+  return NULL;
+}
+
+static GstFlowReturn
+sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstDtlsSrtpDemux *self = GST_DTLS_SRTP_DEMUX (parent);
+  GstPad *srcpad;
+
+  srcpad = select_src_pad (self, buffer);
+  if (!srcpad) {
     gst_buffer_unref (buffer);
     return GST_FLOW_OK;
   }
 
-  if (PACKET_IS_DTLS (first_byte)) {
-    GST_LOG_OBJECT (self, "pushing dtls packet");
+  GST_LOG_OBJECT (self, "pushing %s packet",
+      srcpad == self->dtls_src ? "dtls" : "rtp");
 
-    return gst_pad_push (self->dtls_src, buffer);
-  }
+  return gst_pad_push (srcpad, buffer);
+}
 
-  if (PACKET_IS_RTP (first_byte)) {
-    GST_LOG_OBJECT (self, "pushing rtp packet");
+static GstFlowReturn
+push_list (GstDtlsSrtpDemux * self, GstPad * srcpad, GstBufferList * list)
+{
+  GST_LOG_OBJECT (self, "pushing list of %u %s packets",
+      gst_buffer_list_length (list),
+      srcpad == self->dtls_src ? "dtls" : "rtp");
+
+  return gst_pad_push_list (srcpad, list);
+}
+
+typedef struct
+{
+  GstDtlsSrtpDemux *self;
+  GstBufferList *run;
+  GstPad *run_pad;
+  GstFlowReturn ret;
+} SplitListData;
+
+static gboolean
+split_list_func (GstBuffer ** buffer, guint idx, gpointer user_data)
+{
+  SplitListData *data = user_data;
+  GstPad *srcpad = select_src_pad (data->self, *buffer);
+
+  if (!srcpad)
+    return TRUE;
 
-    return gst_pad_push (self->rtp_src, buffer);
+  if (data->run && srcpad != data->run_pad) {
+    data->ret = push_list (data->self, data->run_pad, data->run);
+    data->run = NULL;
+    if (data->ret != GST_FLOW_OK)
+      return FALSE;
   }
 
-  GST_WARNING_OBJECT (self, "received invalid buffer: %x", first_byte);
-  gst_buffer_unref (buffer);
-  return GST_FLOW_OK;
+  if (!data->run) {
+    data->run = gst_buffer_list_new ();
+    data->run_pad = srcpad;
+  }
+
+  /* steal the buffer from the input list, it is removed from there */
+  gst_buffer_list_add (data->run, *buffer);
+  *buffer = NULL;
+
+  return TRUE;
+}
+
+/* Splits the list into runs of consecutive packets of the same kind so that
+ * packet order is kept while still pushing downstream in lists. The buffers
+ * are moved out of the input list so that they stay writable downstream */
+static GstFlowReturn
+sink_chain_list (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  SplitListData data = { GST_DTLS_SRTP_DEMUX (parent), NULL, NULL,
+    GST_FLOW_OK
+  };
+
+  list = gst_buffer_list_make_writable (list);
+  gst_buffer_list_foreach (list, split_list_func, &data);
+
+  if (data.run)
+    data.ret = push_list (data.self, data.run_pad, data.run);
+
+  gst_buffer_list_unref (list);
+
+  return data.ret;
 }
@@ -0,0 +1,923 @@
+
+/* autogenerated from gstiqaorc.orc */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <glib.h>
+
+#ifndef _ORC_INTEGER_TYPEDEFS_
+#define _ORC_INTEGER_TYPEDEFS_
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#include <stdint.h>
+typedef int8_t orc_int8;
+typedef int16_t orc_int16;
+typedef int32_t orc_int32;
+typedef int64_t orc_int64;
+typedef uint8_t orc_uint8;
+typedef uint16_t orc_uint16;
+typedef uint32_t orc_uint32;
+typedef uint64_t orc_uint64;
+#define ORC_UINT64_C(x) UINT64_C(x)
+#elif defined(_MSC_VER)
+typedef signed __int8 orc_int8;
+typedef signed __int16 orc_int16;
+typedef signed __int32 orc_int32;
+typedef signed __int64 orc_int64;
+typedef unsigned __int8 orc_uint8;
+typedef unsigned __int16 orc_uint16;
+typedef unsigned __int32 orc_uint32;
+typedef unsigned __int64 orc_uint64;
+#define ORC_UINT64_C(x) (x##Ui64)
+#define inline __inline
+#else
+#include <limits.h>
+typedef signed char orc_int8;
+typedef short orc_int16;
+typedef int orc_int32;
+typedef unsigned char orc_uint8;
+typedef unsigned short orc_uint16;
+typedef unsigned int orc_uint32;
+#if INT_MAX == LONG_MAX
+typedef long long orc_int64;
+typedef unsigned long long orc_uint64;
+#define ORC_UINT64_C(x) (x##ULL)
+#else
+typedef long orc_int64;
+typedef unsigned long orc_uint64;
+#define ORC_UINT64_C(x) (x##UL)
+#endif
+#endif
+typedef union
+{
+  orc_int16 i;
+  orc_int8 x2[2];
+} orc_union16;
+typedef union
+{
+  orc_int32 i;
+  float f;
+  orc_int16 x2[2];
+  orc_int8 x4[4];
+} orc_union32;
+typedef union
+{
+  orc_int64 i;
+  double f;
+  orc_int32 x2[2];
+  float x2f[2];
+  orc_int16 x4[4];
+} orc_union64;
+#endif
+#ifndef ORC_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define ORC_RESTRICT restrict
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#define ORC_RESTRICT __restrict__
+#else
+#define ORC_RESTRICT
+#endif
+#endif
+
+#ifndef ORC_INTERNAL
+#if defined(__SUNPRO_C) && (__SUNPRO_C >= 0x590)
+#define ORC_INTERNAL __attribute__((visibility("hidden")))
+#elif defined(__SUNPRO_C) && (__SUNPRO_C >= 0x550)
+#define ORC_INTERNAL __hidden
+#elif defined (__GNUC__)
+#define ORC_INTERNAL __attribute__((visibility("hidden")))
+#else
+#define ORC_INTERNAL
+#endif
+#endif
+
+
+#ifndef DISABLE_ORC
+#include <orc/orc.h>
+#endif
+void iqa_orc_sse_u8 (guint32 * ORC_RESTRICT a1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    int n);
+void iqa_orc_ssim_columns_u8 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint32 * ORC_RESTRICT d3,
+    guint32 * ORC_RESTRICT d4, const orc_uint8 * ORC_RESTRICT s1,
+    const orc_uint8 * ORC_RESTRICT s2, const orc_uint8 * ORC_RESTRICT s3,
+    const orc_uint8 * ORC_RESTRICT s4, const orc_uint8 * ORC_RESTRICT s5,
+    const orc_uint8 * ORC_RESTRICT s6, const orc_uint8 * ORC_RESTRICT s7,
+    const orc_uint8 * ORC_RESTRICT s8, int n);
+
+
+/* begin Orc C target preamble */
+#define ORC_CLAMP(x,a,b) ((x)<(a) ? (a) : ((x)>(b) ? (b) : (x)))
+#define ORC_ABS(a) ((a)<0 ? -(a) : (a))
+#define ORC_MIN(a,b) ((a)<(b) ? (a) : (b))
+#define ORC_MAX(a,b) ((a)>(b) ? (a) : (b))
+#define ORC_SB_MAX 127
+#define ORC_SB_MIN (-1-ORC_SB_MAX)
+#define ORC_UB_MAX (orc_uint8) 255
+#define ORC_UB_MIN 0
+#define ORC_SW_MAX 32767
+#define ORC_SW_MIN (-1-ORC_SW_MAX)
+#define ORC_UW_MAX (orc_uint16)65535
+#define ORC_UW_MIN 0
+#define ORC_SL_MAX 2147483647
+#define ORC_SL_MIN (-1-ORC_SL_MAX)
+#define ORC_UL_MAX 4294967295U
+#define ORC_UL_MIN 0
+#define ORC_CLAMP_SB(x) ORC_CLAMP(x,ORC_SB_MIN,ORC_SB_MAX)
+#define ORC_CLAMP_UB(x) ORC_CLAMP(x,ORC_UB_MIN,ORC_UB_MAX)
+#define ORC_CLAMP_SW(x) ORC_CLAMP(x,ORC_SW_MIN,ORC_SW_MAX)
+#define ORC_CLAMP_UW(x) ORC_CLAMP(x,ORC_UW_MIN,ORC_UW_MAX)
+#define ORC_CLAMP_SL(x) ORC_CLAMP(x,ORC_SL_MIN,ORC_SL_MAX)
+#define ORC_CLAMP_UL(x) ORC_CLAMP(x,ORC_UL_MIN,ORC_UL_MAX)
+#define ORC_SWAP_W(x) ((((x)&0xffU)<<8) | (((x)&0xff00U)>>8))
+#define ORC_SWAP_L(x) ((((x)&0xffU)<<24) | (((x)&0xff00U)<<8) | (((x)&0xff0000U)>>8) | (((x)&0xff000000U)>>24))
+#define ORC_SWAP_Q(x) ((((x)&ORC_UINT64_C(0xff))<<56) | (((x)&ORC_UINT64_C(0xff00))<<40) | (((x)&ORC_UINT64_C(0xff0000))<<24) | (((x)&ORC_UINT64_C(0xff000000))<<8) | (((x)&ORC_UINT64_C(0xff00000000))>>8) | (((x)&ORC_UINT64_C(0xff0000000000))>>24) | (((x)&ORC_UINT64_C(0xff000000000000))>>40) | (((x)&ORC_UINT64_C(0xff00000000000000))>>56))
+#define ORC_PTR_OFFSET(ptr,offset) ((void *)(((unsigned char *)(ptr)) + (offset)))
+#define ORC_DENORMAL(x) ((x) & ((((x)&0x7f800000) == 0) ? 0xff800000 : 0xffffffff))
+#define ORC_ISNAN(x) ((((x)&0x7f800000) == 0x7f800000) && (((x)&0x007fffff) != 0))
+#define ORC_DENORMAL_DOUBLE(x) ((x) & ((((x)&ORC_UINT64_C(0x7ff0000000000000)) == 0) ? ORC_UINT64_C(0xfff0000000000000) : ORC_UINT64_C(0xffffffffffffffff)))
+#define ORC_ISNAN_DOUBLE(x) ((((x)&ORC_UINT64_C(0x7ff0000000000000)) == ORC_UINT64_C(0x7ff0000000000000)) && (((x)&ORC_UINT64_C(0x000fffffffffffff)) != 0))
+#ifndef ORC_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define ORC_RESTRICT restrict
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#define ORC_RESTRICT __restrict__
+#else
+#define ORC_RESTRICT
+#endif
+#endif
+/* end Orc C target preamble */
+
+
+
+/* iqa_orc_sse_u8 */
+#ifdef DISABLE_ORC
+void
+iqa_orc_sse_u8 (guint32 * ORC_RESTRICT a1, const orc_uint8 * ORC_RESTRICT s1,
+    const orc_uint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_union32 var12 = { 0 };
+  orc_int8 var35;
+  orc_int8 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 1: convubw */
+    var37.i = (orc_uint8) var35;
+    /* 2: loadb */
+    var36 = ptr5[i];
+    /* 3: convubw */
+    var38.i = (orc_uint8) var36;
+    /* 4: subw */
+    var39.i = var37.i - var38.i;
+    /* 5: mulswl */
+    var40.i = var39.i * var39.i;
+    /* 6: accl */
+    var12.i = ((orc_uint32) var12.i) + ((orc_uint32) var40.i);
+  }
+  *a1 = var12.i;
+
+}
+
+#else
+static void
+_backup_iqa_orc_sse_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_union32 var12 = { 0 };
+  orc_int8 var35;
+  orc_int8 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 1: convubw */
+    var37.i = (orc_uint8) var35;
+    /* 2: loadb */
+    var36 = ptr5[i];
+    /* 3: convubw */
+    var38.i = (orc_uint8) var36;
+    /* 4: subw */
+    var39.i = var37.i - var38.i;
+    /* 5: mulswl */
+    var40.i = var39.i * var39.i;
+    /* 6: accl */
+    var12.i = ((orc_uint32) var12.i) + ((orc_uint32) var40.i);
+  }
+  ex->accumulators[0] = var12.i;
+
+}
+
+void
+iqa_orc_sse_u8 (guint32 * ORC_RESTRICT a1, const orc_uint8 * ORC_RESTRICT s1,
+    const orc_uint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 14, 105, 113, 97, 95, 111, 114, 99, 95, 115, 115, 101, 95, 117,
+        56, 12, 1, 1, 12, 1, 1, 13, 4, 20, 2, 20, 2, 20, 4, 150,
+        32, 4, 150, 33, 5, 98, 32, 32, 33, 176, 34, 32, 32, 181, 12, 34,
+        2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_iqa_orc_sse_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "iqa_orc_sse_u8");
+      orc_program_set_backup_function (p, _backup_iqa_orc_sse_u8);
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_accumulator (p, 4, "a1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "accl", 0, ORC_VAR_A1, ORC_VAR_T3, ORC_VAR_D1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+  *a1 = orc_executor_get_accumulator (ex, ORC_VAR_A1);
+}
+#endif
+
+
+/* iqa_orc_ssim_columns_u8 */
+#ifdef DISABLE_ORC
+void
+iqa_orc_ssim_columns_u8 (guint16 * ORC_RESTRICT d1, guint16 * ORC_RESTRICT d2,
+    guint32 * ORC_RESTRICT d3, guint32 * ORC_RESTRICT d4,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    const orc_uint8 * ORC_RESTRICT s5, const orc_uint8 * ORC_RESTRICT s6,
+    const orc_uint8 * ORC_RESTRICT s7, const orc_uint8 * ORC_RESTRICT s8,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  orc_union16 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_int8 *ORC_RESTRICT ptr11;
+  orc_int8 var37;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_int8 var42;
+  orc_int8 var43;
+  orc_int8 var44;
+  orc_int8 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+  orc_union16 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union16 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union16 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union16 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union16 var81;
+  orc_union32 var82;
+  orc_union16 var83;
+  orc_union32 var84;
+  orc_union16 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union16 var88;
+  orc_union32 var89;
+  orc_union32 var90;
+  orc_union16 var91;
+  orc_union32 var92;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr1 = (orc_union16 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+  ptr8 = (orc_int8 *) s5;
+  ptr9 = (orc_int8 *) s6;
+  ptr10 = (orc_int8 *) s7;
+  ptr11 = (orc_int8 *) s8;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var37 = ptr4[i];
+    /* 1: convubw */
+    var49.i = (orc_uint8) var37;
+    /* 2: loadb */
+    var38 = ptr5[i];
+    /* 3: convubw */
+    var50.i = (orc_uint8) var38;
+    /* 4: addw */
+    var51.i = var49.i + var50.i;
+    /* 5: loadb */
+    var39 = ptr6[i];
+    /* 6: convubw */
+    var52.i = (orc_uint8) var39;
+    /* 7: addw */
+    var53.i = var51.i + var52.i;
+    /* 8: loadb */
+    var40 = ptr7[i];
+    /* 9: convubw */
+    var54.i = (orc_uint8) var40;
+    /* 10: addw */
+    var41.i = var53.i + var54.i;
+    /* 11: storew */
+    ptr0[i] = var41;
+    /* 12: loadb */
+    var42 = ptr8[i];
+    /* 13: convubw */
+    var55.i = (orc_uint8) var42;
+    /* 14: loadb */
+    var43 = ptr9[i];
+    /* 15: convubw */
+    var56.i = (orc_uint8) var43;
+    /* 16: addw */
+    var57.i = var55.i + var56.i;
+    /* 17: loadb */
+    var44 = ptr10[i];
+    /* 18: convubw */
+    var58.i = (orc_uint8) var44;
+    /* 19: addw */
+    var59.i = var57.i + var58.i;
+    /* 20: loadb */
+    var45 = ptr11[i];
+    /* 21: convubw */
+    var60.i = (orc_uint8) var45;
+    /* 22: addw */
+    var46.i = var59.i + var60.i;
+    /* 23: storew */
+    ptr1[i] = var46;
+    /* 24: mulubw */
+    var61.i = (orc_uint8) var37 * (orc_uint8) var37;
+    /* 25: convuwl */
+    var62.i = (orc_uint16) var61.i;
+    /* 26: mulubw */
+    var63.i = (orc_uint8) var42 * (orc_uint8) var42;
+    /* 27: convuwl */
+    var64.i = (orc_uint16) var63.i;
+    /* 28: addl */
+    var65.i = ((orc_uint32) var62.i) + ((orc_uint32) var64.i);
+    /* 29: mulubw */
+    var66.i = (orc_uint8) var38 * (orc_uint8) var38;
+    /* 30: convuwl */
+    var67.i = (orc_uint16) var66.i;
+    /* 31: addl */
+    var68.i = ((orc_uint32) var65.i) + ((orc_uint32) var67.i);
+    /* 32: mulubw */
+    var69.i = (orc_uint8) var43 * (orc_uint8) var43;
+    /* 33: convuwl */
+    var70.i = (orc_uint16) var69.i;
+    /* 34: addl */
+    var71.i = ((orc_uint32) var68.i) + ((orc_uint32) var70.i);
+    /* 35: mulubw */
+    var72.i = (orc_uint8) var39 * (orc_uint8) var39;
+    /* 36: convuwl */
+    var73.i = (orc_uint16) var72.i;
+    /* 37: addl */
+    var74.i = ((orc_uint32) var71.i) + ((orc_uint32) var73.i);
+    /* 38: mulubw */
+    var75.i = (orc_uint8) var44 * (orc_uint8) var44;
+    /* 39: convuwl */
+    var76.i = (orc_uint16) var75.i;
+    /* 40: addl */
+    var77.i = ((orc_uint32) var74.i) + ((orc_uint32) var76.i);
+    /* 41: mulubw */
+    var78.i = (orc_uint8) var40 * (orc_uint8) var40;
+    /* 42: convuwl */
+    var79.i = (orc_uint16) var78.i;
+    /* 43: addl */
+    var80.i = ((orc_uint32) var77.i) + ((orc_uint32) var79.i);
+    /* 44: mulubw */
+    var81.i = (orc_uint8) var45 * (orc_uint8) var45;
+    /* 45: convuwl */
+    var82.i = (orc_uint16) var81.i;
+    /* 46: addl */
+    var47.i = ((orc_uint32) var80.i) + ((orc_uint32) var82.i);
+    /* 47: storel */
+    ptr2[i] = var47;
+    /* 48: mulubw */
+    var83.i = (orc_uint8) var37 * (orc_uint8) var42;
+    /* 49: convuwl */
+    var84.i = (orc_uint16) var83.i;
+    /* 50: mulubw */
+    var85.i = (orc_uint8) var38 * (orc_uint8) var43;
+    /* 51: convuwl */
+    var86.i = (orc_uint16) var85.i;
+    /* 52: addl */
+    var87.i = ((orc_uint32) var84.i) + ((orc_uint32) var86.i);
+    /* 53: mulubw */
+    var88.i = (orc_uint8) var39 * (orc_uint8) var44;
+    /* 54: convuwl */
+    var89.i = (orc_uint16) var88.i;
+    /* 55: addl */
+    var90.i = ((orc_uint32) var87.i) + ((orc_uint32) var89.i);
+    /* 56: mulubw */
+    var91.i = (orc_uint8) var40 * (orc_uint8) var45;
+    /* 57: convuwl */
+    var92.i = (orc_uint16) var91.i;
+    /* 58: addl */
+    var48.i = ((orc_uint32) var90.i) + ((orc_uint32) var92.i);
+    /* 59: storel */
+    ptr3[i] = var48;
+  }
+
+}
+
+#else
+static void
+_backup_iqa_orc_ssim_columns_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  orc_union16 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_int8 *ORC_RESTRICT ptr11;
+  orc_int8 var37;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_int8 var42;
+  orc_int8 var43;
+  orc_int8 var44;
+  orc_int8 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+  orc_union16 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union16 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union16 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union16 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union16 var81;
+  orc_union32 var82;
+  orc_union16 var83;
+  orc_union32 var84;
+  orc_union16 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union16 var88;
+  orc_union32 var89;
+  orc_union32 var90;
+  orc_union16 var91;
+  orc_union32 var92;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr1 = (orc_union16 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+  ptr8 = (orc_int8 *) ex->arrays[8];
+  ptr9 = (orc_int8 *) ex->arrays[9];
+  ptr10 = (orc_int8 *) ex->arrays[10];
+  ptr11 = (orc_int8 *) ex->arrays[11];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var37 = ptr4[i];
+    /* 1: convubw */
+    var49.i = (orc_uint8) var37;
+    /* 2: loadb */
+    var38 = ptr5[i];
+    /* 3: convubw */
+    var50.i = (orc_uint8) var38;
+    /* 4: addw */
+    var51.i = var49.i + var50.i;
+    /* 5: loadb */
+    var39 = ptr6[i];
+    /* 6: convubw */
+    var52.i = (orc_uint8) var39;
+    /* 7: addw */
+    var53.i = var51.i + var52.i;
+    /* 8: loadb */
+    var40 = ptr7[i];
+    /* 9: convubw */
+    var54.i = (orc_uint8) var40;
+    /* 10: addw */
+    var41.i = var53.i + var54.i;
+    /* 11: storew */
+    ptr0[i] = var41;
+    /* 12: loadb */
+    var42 = ptr8[i];
+    /* 13: convubw */
+    var55.i = (orc_uint8) var42;
+    /* 14: loadb */
+    var43 = ptr9[i];
+    /* 15: convubw */
+    var56.i = (orc_uint8) var43;
+    /* 16: addw */
+    var57.i = var55.i + var56.i;
+    /* 17: loadb */
+    var44 = ptr10[i];
+    /* 18: convubw */
+    var58.i = (orc_uint8) var44;
+    /* 19: addw */
+    var59.i = var57.i + var58.i;
+    /* 20: loadb */
+    var45 = ptr11[i];
+    /* 21: convubw */
+    var60.i = (orc_uint8) var45;
+    /* 22: addw */
+    var46.i = var59.i + var60.i;
+    /* 23: storew */
+    ptr1[i] = var46;
+    /* 24: mulubw */
+    var61.i = (orc_uint8) var37 * (orc_uint8) var37;
+    /* 25: convuwl */
+    var62.i = (orc_uint16) var61.i;
+    /* 26: mulubw */
+    var63.i = (orc_uint8) var42 * (orc_uint8) var42;
+    /* 27: convuwl */
+    var64.i = (orc_uint16) var63.i;
+    /* 28: addl */
+    var65.i = ((orc_uint32) var62.i) + ((orc_uint32) var64.i);
+    /* 29: mulubw */
+    var66.i = (orc_uint8) var38 * (orc_uint8) var38;
+    /* 30: convuwl */
+    var67.i = (orc_uint16) var66.i;
+    /* 31: addl */
+    var68.i = ((orc_uint32) var65.i) + ((orc_uint32) var67.i);
+    /* 32: mulubw */
+    var69.i = (orc_uint8) var43 * (orc_uint8) var43;
+    /* 33: convuwl */
+    var70.i = (orc_uint16) var69.i;
+    /* 34: addl */
+    var71.i = ((orc_uint32) var68.i) + ((orc_uint32) var70.i);
+    /* 35: mulubw */
+    var72.i = (orc_uint8) var39 * (orc_uint8) var39;
+    /* 36: convuwl */
+    var73.i = (orc_uint16) var72.i;
+    /* 37: addl */
+    var74.i = ((orc_uint32) var71.i) + ((orc_uint32) var73.i);
+    /* 38: mulubw */
+    var75.i = (orc_uint8) var44 * (orc_uint8) var44;
+    /* 39: convuwl */
+    var76.i = (orc_uint16) var75.i;
+    /* 40: addl */
+    var77.i = ((orc_uint32) var74.i) + ((orc_uint32) var76.i);
+    /* 41: mulubw */
+    var78.i = (orc_uint8) var40 * (orc_uint8) var40;
+    /* 42: convuwl */
+    var79.i = (orc_uint16) var78.i;
+    /* 43: addl */
+    var80.i = ((orc_uint32) var77.i) + ((orc_uint32) var79.i);
+    /* 44: mulubw */
+    var81.i = (orc_uint8) var45 * (orc_uint8) var45;
+    /* 45: convuwl */
+    var82.i = (orc_uint16) var81.i;
+    /* 46: addl */
+    var47.i = ((orc_uint32) var80.i) + ((orc_uint32) var82.i);
+    /* 47: storel */
+    ptr2[i] = var47;
+    /* 48: mulubw */
+    var83.i = (orc_uint8) var37 * (orc_uint8) var42;
+    /* 49: convuwl */
+    var84.i = (orc_uint16) var83.i;
+    /* 50: mulubw */
+    var85.i = (orc_uint8) var38 * (orc_uint8) var43;
+    /* 51: convuwl */
+    var86.i = (orc_uint16) var85.i;
+    /* 52: addl */
+    var87.i = ((orc_uint32) var84.i) + ((orc_uint32) var86.i);
+    /* 53: mulubw */
+    var88.i = (orc_uint8) var39 * (orc_uint8) var44;
+    /* 54: convuwl */
+    var89.i = (orc_uint16) var88.i;
+    /* 55: addl */
+    var90.i = ((orc_uint32) var87.i) + ((orc_uint32) var89.i);
+    /* 56: mulubw */
+    var91.i = (orc_uint8) var40 * (orc_uint8) var45;
+    /* 57: convuwl */
+    var92.i = (orc_uint16) var91.i;
+    /* 58: addl */
+    var48.i = ((orc_uint32) var90.i) + ((orc_uint32) var92.i);
+    /* 59: storel */
+    ptr3[i] = var48;
+  }
+
+}
+
+void
+iqa_orc_ssim_columns_u8 (guint16 * ORC_RESTRICT d1, guint16 * ORC_RESTRICT d2,
+    guint32 * ORC_RESTRICT d3, guint32 * ORC_RESTRICT d4,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    const orc_uint8 * ORC_RESTRICT s5, const orc_uint8 * ORC_RESTRICT s6,
+    const orc_uint8 * ORC_RESTRICT s7, const orc_uint8 * ORC_RESTRICT s8,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 23, 105, 113, 97, 95, 111, 114, 99, 95, 115, 115, 105, 109, 95,
+        99, 111, 108, 117, 109, 110, 115, 95, 117, 56, 11, 2, 2, 11, 2, 2,
+        11, 4, 4, 11, 4, 4, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12,
+        1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 20, 2,
+        20, 2, 20, 4, 20, 4, 20, 4, 150, 32, 4, 150, 33, 5, 70, 32,
+        32, 33, 150, 33, 6, 70, 32, 32, 33, 150, 33, 7, 70, 0, 32, 33,
+        150, 32, 8, 150, 33, 9, 70, 32, 32, 33, 150, 33, 10, 70, 32, 32,
+        33, 150, 33, 11, 70, 1, 32, 33, 175, 32, 4, 4, 154, 34, 32, 175,
+        32, 8, 8, 154, 35, 32, 103, 34, 34, 35, 175, 32, 5, 5, 154, 35,
+        32, 103, 34, 34, 35, 175, 32, 9, 9, 154, 35, 32, 103, 34, 34, 35,
+        175, 32, 6, 6, 154, 35, 32, 103, 34, 34, 35, 175, 32, 10, 10, 154,
+        35, 32, 103, 34, 34, 35, 175, 32, 7, 7, 154, 35, 32, 103, 34, 34,
+        35, 175, 32, 11, 11, 154, 35, 32, 103, 2, 34, 35, 175, 32, 4, 8,
+        154, 36, 32, 175, 32, 5, 9, 154, 35, 32, 103, 36, 36, 35, 175, 32,
+        6, 10, 154, 35, 32, 103, 36, 36, 35, 175, 32, 7, 11, 154, 35, 32,
+        103, 3, 36, 35, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_iqa_orc_ssim_columns_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "iqa_orc_ssim_columns_u8");
+      orc_program_set_backup_function (p, _backup_iqa_orc_ssim_columns_u8);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_destination (p, 2, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_source (p, 1, "s5");
+      orc_program_add_source (p, 1, "s6");
+      orc_program_add_source (p, 1, "s7");
+      orc_program_add_source (p, 1, "s8");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S7, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S8, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S5, ORC_VAR_S5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S6, ORC_VAR_S6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S7, ORC_VAR_S7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S8, ORC_VAR_S8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_S5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_S6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S3, ORC_VAR_S7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulubw", 0, ORC_VAR_T1, ORC_VAR_S4, ORC_VAR_S8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D4, ORC_VAR_T5, ORC_VAR_T4,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->arrays[ORC_VAR_S6] = (void *) s6;
+  ex->arrays[ORC_VAR_S7] = (void *) s7;
+  ex->arrays[ORC_VAR_S8] = (void *) s8;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
@@ -33,9 +33,20 @@
  * For each reference frame, IQA will post a message containing
  * a structure named IQA.
  *
- * The only metric supported for now is "dssim", which will be available
- * if https://github.com/pornel/dssim was installed on the system
- * at the time that plugin was compiled.
+ * The "psnr", "ssim" and "ms-ssim" metrics are computed natively on the
+ * planes of 8 to 16 bit planar YUV and GRAY formats, without converting
+ * the frames when all the streams share the same format. Each metric
+ * structure contains the value aggregated over all the components for
+ * every compared pad, and the value of every component in fields named
+ * after the pad and the component, e.g. "sink_1-y". Identical pictures
+ * have an infinite PSNR. The computation of each plane is split across
+ * #GstIqa:n-threads threads. The frames are converted to a planar format
+ * if needed, except when do-dssim is also enabled: the native metrics are
+ * then not computed on the RGBA frames.
+ *
+ * The "dssim" metric will be available if https://github.com/pornel/dssim
+ * was installed on the system at the time that plugin was compiled, it
+ * requires the output to be RGBA.
  *
  * For each metric activated, this structure will contain another
  * structure, named after the metric.
@@ -49,6 +60,12 @@
  * sink_2\=\(double\)0.0082939683976297474\;",
  * time=(guint64)0;
  *
+ * With do-psnr set to true, the emitted structure looks like this:
+ *
+ * IQA, psnr=(structure)"psnr\,\ sink_1\=\(double\)38.52\,\
+ * sink_1-y\=\(double\)37.80\,\ sink_1-u\=\(double\)42.11\,\
+ * sink_1-v\=\(double\)41.95\;", time=(guint64)0;
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 -m uridecodebin uri=file:///test/file/1 ! iqa name=iqa do-dssim=true \
@@ -62,6 +79,10 @@
 #endif
 
 #include "iqa.h"
+#include "iqametrics.h"
+
+#include <math.h>
+#include <string.h>
 
 #ifdef HAVE_DSSIM
 #include "dssim.h"
@@ -70,12 +91,31 @@
 GST_DEBUG_CATEGORY_STATIC (gst_iqa_debug);
 #define GST_CAT_DEFAULT gst_iqa_debug
 
-#define SINK_FORMATS " { AYUV, BGRA, ARGB, RGBA, ABGR, Y444, Y42B, YUY2, UYVY, "\
-                "   YVYU, I420, YV12, NV12, NV21, Y41B, RGB, BGR, xRGB, xBGR, "\
-                "   RGBx, BGRx } "
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+#define PLANAR_FORMATS "I420, YV12, Y42B, Y444, Y41B, GRAY8, I420_10LE, " \
+                "   I422_10LE, Y444_10LE, I420_12LE, I422_12LE, Y444_12LE, " \
+                "   GRAY16_LE"
+#else
+#define PLANAR_FORMATS "I420, YV12, Y42B, Y444, Y41B, GRAY8, I420_10BE, " \
+                "   I422_10BE, Y444_10BE, I420_12BE, I422_12BE, Y444_12BE, " \
+                "   GRAY16_BE"
+#endif
+
+#define SINK_FORMATS " { AYUV, BGRA, ARGB, RGBA, ABGR, YUY2, UYVY, "\
+                "   YVYU, NV12, NV21, RGB, BGR, xRGB, xBGR, "\
+                "   RGBx, BGRx, " PLANAR_FORMATS " } "
 
-#define SRC_FORMAT " { RGBA } "
+#define SRC_FORMAT " { RGBA, " PLANAR_FORMATS " } "
 #define DEFAULT_DSSIM_ERROR_THRESHOLD -1.0
+#define DEFAULT_DO_PSNR FALSE
+#define DEFAULT_DO_NATIVE_SSIM FALSE
+#define DEFAULT_DO_MS_SSIM FALSE
+#define DEFAULT_N_THREADS 1
+
+#define MS_SSIM_SCALES 5
+static const gdouble ms_ssim_weights[MS_SSIM_SCALES] = {
+  0.0448, 0.2856, 0.3001, 0.2363, 0.1333
+};
 
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
@@ -88,6 +128,10 @@ enum
   PROP_0,
   PROP_DO_SSIM,
   PROP_SSIM_ERROR_THRESHOLD,
+  PROP_DO_PSNR,
+  PROP_DO_NATIVE_SSIM,
+  PROP_DO_MS_SSIM,
+  PROP_N_THREADS,
   PROP_LAST,
 };
 
@@ -134,20 +178,10 @@ do_dssim (GstIqa * self, GstVideoFrame * ref, GstVideoFrame * cmp,
   GstStructure *dssim_structure;
   gboolean ret = TRUE;
 
-  if (ref->info.width != cmp->info.width ||
-      ref->info.height != cmp->info.height) {
-    GST_OBJECT_UNLOCK (self);
-
-    GST_ELEMENT_ERROR (self, STREAM, FAILED,
-        ("Video streams do not have the same sizes (add videoscale"
-            " and force the sizes to be equal on all sink pads.)"),
-        ("Reference width %d - compared width: %d. "
-            "Reference height %d - compared height: %d",
-            ref->info.width, cmp->info.width, ref->info.height,
-            cmp->info.height));
-
-    GST_OBJECT_LOCK (self);
-    return FALSE;
+  if (GST_VIDEO_FRAME_FORMAT (ref) != GST_VIDEO_FORMAT_RGBA) {
+    GST_WARNING_OBJECT (self, "dssim needs RGBA frames, got %s",
+        gst_video_format_to_string (GST_VIDEO_FRAME_FORMAT (ref)));
+    return TRUE;
   }
 
   gst_structure_get (msg_structure, "dssim", GST_TYPE_STRUCTURE,
@@ -241,10 +275,323 @@ cleanup_return:
 }
 #endif
 
+typedef struct _IqaSlice IqaSlice;
+
+struct _IqaSlice
+{
+  const IqaPlane *plane;
+  gint start;
+  gint end;
+
+  /* downsampling output */
+  gfloat *ref_out;
+  gfloat *cmp_out;
+  gint out_stride;
+
+  /* results */
+  guint64 sse;
+  IqaSsimSums ssim;
+};
+
+static void
+sse_slice (IqaSlice * slice)
+{
+  slice->sse = iqa_plane_sse (slice->plane, slice->start, slice->end);
+}
+
+static void
+ssim_slice (IqaSlice * slice)
+{
+  iqa_plane_ssim (slice->plane, slice->start, slice->end, &slice->ssim);
+}
+
+static void
+downsample_slice (IqaSlice * slice)
+{
+  iqa_plane_downsample (slice->plane, slice->ref_out, slice->cmp_out,
+      slice->out_stride, slice->start, slice->end);
+}
+
+/* Runs @func on @rows rows split into at most @max_slices slices. Must be
+ * called from the aggregation thread. The slices are returned in @slices,
+ * which must have room for @max_slices entries. */
+static guint
+run_slices (GstIqa * self, void (*func) (IqaSlice * slice),
+    const IqaPlane * plane, gint rows, gfloat * ref_out, gfloat * cmp_out,
+    gint out_stride, IqaSlice * slices, guint max_slices)
+{
+  guint i, n_slices = MIN (max_slices, (guint) MAX (rows, 1));
+
+  for (i = 0; i < n_slices; i++) {
+    slices[i].plane = plane;
+    slices[i].start = rows * i / n_slices;
+    slices[i].end = rows * (i + 1) / n_slices;
+    slices[i].ref_out = ref_out;
+    slices[i].cmp_out = cmp_out;
+    slices[i].out_stride = out_stride;
+    slices[i].sse = 0;
+    memset (&slices[i].ssim, 0, sizeof (IqaSsimSums));
+  }
+
+  gst_slice_runner_run (self->runner, (GstSliceFunc) func, slices,
+      sizeof (IqaSlice), n_slices);
+
+  return n_slices;
+}
+
+/* Must be called with the object lock held */
+static guint
+get_max_slices (GstIqa * self)
+{
+  self->runner = gst_slice_runner_update (self->runner, self->n_threads);
+
+  return gst_slice_runner_get_n_threads (self->runner);
+}
+
+static gdouble
+plane_psnr (GstIqa * self, const IqaPlane * plane, guint64 * sse_out,
+    IqaSlice * slices, guint max_slices)
+{
+  guint64 sse = 0;
+  guint i, n_slices;
+
+  n_slices = run_slices (self, sse_slice, plane, plane->height, NULL, NULL, 0,
+      slices, max_slices);
+  for (i = 0; i < n_slices; i++)
+    sse += slices[i].sse;
+
+  *sse_out = sse;
+
+  return sse == 0 ? INFINITY : 10.0 * log10 (plane->max_value *
+      plane->max_value * plane->width * plane->height / (gdouble) sse);
+}
+
+static void
+plane_ssim_sums (GstIqa * self, const IqaPlane * plane, IqaSsimSums * sums,
+    IqaSlice * slices, guint max_slices)
+{
+  guint i, n_slices;
+  gint rows = iqa_plane_ssim_rows (plane);
+
+  memset (sums, 0, sizeof (IqaSsimSums));
+  if (rows <= 0)
+    return;
+
+  n_slices = run_slices (self, ssim_slice, plane, rows, NULL, NULL, 0,
+      slices, max_slices);
+  for (i = 0; i < n_slices; i++) {
+    sums->l += slices[i].ssim.l;
+    sums->cs += slices[i].ssim.cs;
+    sums->ssim += slices[i].ssim.ssim;
+    sums->n_windows += slices[i].ssim.n_windows;
+  }
+}
+
+/* Multi-scale SSIM: the contrast-structure term of every scale but the
+ * last, where the full SSIM is used, weighted as in Wang et al. Planes too
+ * small for all the five scales use the first ones with renormalized
+ * weights. The SSIM of the first scale is returned in @ssim_out. */
+static gdouble
+plane_ms_ssim (GstIqa * self, const IqaPlane * plane, gdouble * ssim_out,
+    IqaSlice * slices, guint max_slices)
+{
+  IqaPlane scale_plane = *plane;
+  gfloat *ref_buf = NULL, *cmp_buf = NULL;
+  gdouble values[MS_SSIM_SCALES];
+  gdouble weight_sum = 0.0, ms_ssim = 1.0;
+  gint n_scales = 0, width, height;
+  gint i;
+
+  *ssim_out = 1.0;
+
+  for (i = 0; i < MS_SSIM_SCALES; i++) {
+    IqaSsimSums sums;
+    gfloat *ref_scaled, *cmp_scaled;
+
+    if (scale_plane.width < IQA_SSIM_MIN_SIZE ||
+        scale_plane.height < IQA_SSIM_MIN_SIZE)
+      break;
+
+    plane_ssim_sums (self, &scale_plane, &sums, slices, max_slices);
+    if (i == 0)
+      *ssim_out = sums.ssim / sums.n_windows;
+
+    width = scale_plane.width / 2;
+    height = scale_plane.height / 2;
+
+    if (i == MS_SSIM_SCALES - 1 || width < IQA_SSIM_MIN_SIZE ||
+        height < IQA_SSIM_MIN_SIZE) {
+      values[i] = sums.ssim / sums.n_windows;
+      n_scales = i + 1;
+      break;
+    }
+
+    values[i] = sums.cs / sums.n_windows;
+
+    /* the next scale is written while the current one is read */
+    ref_scaled = g_new (gfloat, width * height);
+    cmp_scaled = g_new (gfloat, width * height);
+
+    run_slices (self, downsample_slice, &scale_plane, height, ref_scaled,
+        cmp_scaled, width * sizeof (gfloat), slices, max_slices);
+
+    g_free (ref_buf);
+    g_free (cmp_buf);
+    ref_buf = ref_scaled;
+    cmp_buf = cmp_scaled;
+
+    scale_plane.type = IQA_SAMPLE_F32;
+    scale_plane.ref = (const guint8 *) ref_buf;
+    scale_plane.cmp = (const guint8 *) cmp_buf;
+    scale_plane.ref_stride = scale_plane.cmp_stride = width * sizeof (gfloat);
+    scale_plane.width = width;
+    scale_plane.height = height;
+  }
+
+  g_free (ref_buf);
+  g_free (cmp_buf);
+
+  if (n_scales == 0)
+    return 1.0;
+
+  for (i = 0; i < n_scales; i++)
+    weight_sum += ms_ssim_weights[i];
+
+  for (i = 0; i < n_scales; i++)
+    ms_ssim *= pow (MAX (values[i], 0.0), ms_ssim_weights[i] / weight_sum);
+
+  return ms_ssim;
+}
+
+static void
+set_metric (GstStructure * msg_structure, const gchar * metric,
+    const gchar * padname, const gchar * component, gdouble value)
+{
+  GstStructure *metric_structure;
+
+  gst_structure_get (msg_structure, metric, GST_TYPE_STRUCTURE,
+      &metric_structure, NULL);
+
+  if (component) {
+    gchar *name = g_strdup_printf ("%s-%s", padname, component);
+    gst_structure_set (metric_structure, name, G_TYPE_DOUBLE, value, NULL);
+    g_free (name);
+  } else {
+    gst_structure_set (metric_structure, padname, G_TYPE_DOUBLE, value, NULL);
+  }
+
+  gst_structure_set (msg_structure, metric, GST_TYPE_STRUCTURE,
+      metric_structure, NULL);
+  gst_structure_free (metric_structure);
+}
+
+static gboolean
+do_native_metrics (GstIqa * self, GstVideoFrame * ref, GstVideoFrame * cmp,
+    GstStructure * msg_structure, gchar * padname)
+{
+  static const gchar *yuv_names[] = { "y", "u", "v" };
+  const GstVideoFormatInfo *finfo = ref->info.finfo;
+  guint max_slices = get_max_slices (self);
+  IqaSlice *slices = g_newa (IqaSlice, max_slices);
+  guint64 sse_total = 0, samples_total = 0, peak_total = 0;
+  gdouble ssim_total = 0.0, ms_ssim_total = 0.0;
+  guint c;
+
+  /* Only happens when dssim forces RGBA frames */
+  if (!GST_VIDEO_FORMAT_INFO_IS_YUV (finfo) &&
+      !GST_VIDEO_FORMAT_INFO_IS_GRAY (finfo)) {
+    GST_WARNING_OBJECT (self, "native metrics need planar YUV or GRAY "
+        "frames, got %s", GST_VIDEO_FORMAT_INFO_NAME (finfo));
+    return TRUE;
+  }
+
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (ref); c++) {
+    IqaPlane plane;
+    guint64 samples;
+    gdouble ssim = 0.0;
+
+    plane.type = GST_VIDEO_FRAME_COMP_PSTRIDE (ref, c) == 1 ?
+        IQA_SAMPLE_U8 : IQA_SAMPLE_U16;
+    plane.ref = GST_VIDEO_FRAME_COMP_DATA (ref, c);
+    plane.ref_stride = GST_VIDEO_FRAME_COMP_STRIDE (ref, c);
+    plane.cmp = GST_VIDEO_FRAME_COMP_DATA (cmp, c);
+    plane.cmp_stride = GST_VIDEO_FRAME_COMP_STRIDE (cmp, c);
+    plane.width = GST_VIDEO_FRAME_COMP_WIDTH (ref, c);
+    plane.height = GST_VIDEO_FRAME_COMP_HEIGHT (ref, c);
+    plane.max_value = (1 << GST_VIDEO_FRAME_COMP_DEPTH (ref, c)) - 1;
+
+    samples = (guint64) plane.width * plane.height;
+    samples_total += samples;
+
+    if (self->do_psnr) {
+      guint64 sse;
+      gdouble psnr = plane_psnr (self, &plane, &sse, slices, max_slices);
+
+      set_metric (msg_structure, "psnr", padname, yuv_names[c], psnr);
+      /* the aggregate uses the peak of each plane weighted by its size */
+      sse_total += sse;
+      peak_total += (guint64) (plane.max_value * plane.max_value) * samples;
+    }
+
+    if (self->do_ms_ssim) {
+      gdouble ms_ssim = plane_ms_ssim (self, &plane, &ssim, slices,
+          max_slices);
+
+      set_metric (msg_structure, "ms-ssim", padname, yuv_names[c], ms_ssim);
+      ms_ssim_total += ms_ssim * samples;
+    } else if (self->do_native_ssim) {
+      IqaSsimSums sums;
+
+      plane_ssim_sums (self, &plane, &sums, slices, max_slices);
+      ssim = sums.n_windows ? sums.ssim / sums.n_windows : 1.0;
+    }
+
+    if (self->do_native_ssim) {
+      set_metric (msg_structure, "ssim", padname, yuv_names[c], ssim);
+      ssim_total += ssim * samples;
+    }
+  }
+
+  if (self->do_psnr) {
+    set_metric (msg_structure, "psnr", padname, NULL, sse_total == 0 ?
+        INFINITY : 10.0 * log10 (peak_total / (gdouble) sse_total));
+  }
+  if (self->do_native_ssim) {
+    set_metric (msg_structure, "ssim", padname, NULL,
+        ssim_total / samples_total);
+  }
+  if (self->do_ms_ssim) {
+    set_metric (msg_structure, "ms-ssim", padname, NULL,
+        ms_ssim_total / samples_total);
+  }
+
+  return TRUE;
+}
+
 static gboolean
 compare_frames (GstIqa * self, GstVideoFrame * ref, GstVideoFrame * cmp,
     GstBuffer * outbuf, GstStructure * msg_structure, gchar * padname)
 {
+  if (ref->info.width != cmp->info.width ||
+      ref->info.height != cmp->info.height) {
+    GST_OBJECT_UNLOCK (self);
+
+    GST_ELEMENT_ERROR (self, STREAM, FAILED,
+        ("Video streams do not have the same sizes (add videoscale"
+            " and force the sizes to be equal on all sink pads.)"),
+        ("Reference width %d - compared width: %d. "
+            "Reference height %d - compared height: %d",
+            ref->info.width, cmp->info.width, ref->info.height,
+            cmp->info.height));
+
+    GST_OBJECT_LOCK (self);
+    return FALSE;
+  }
+
+  if (self->do_psnr || self->do_native_ssim || self->do_ms_ssim) {
+    if (!do_native_metrics (self, ref, cmp, msg_structure, padname))
+      return FALSE;
+  }
 #ifdef HAVE_DSSIM
   if (self->do_dssim) {
     if (!do_dssim (self, ref, cmp, outbuf, msg_structure, padname))
@@ -255,6 +602,16 @@ compare_frames (GstIqa * self, GstVideoFrame * ref, GstVideoFrame * cmp,
   return TRUE;
 }
 
+static void
+add_metric_structure (GstStructure * msg_structure, const gchar * metric)
+{
+  GValue value = G_VALUE_INIT;
+
+  g_value_init (&value, GST_TYPE_STRUCTURE);
+  g_value_take_boxed (&value, gst_structure_new_empty (metric));
+  gst_structure_take_value (msg_structure, metric, &value);
+}
+
 static GstFlowReturn
 gst_iqa_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
 {
@@ -270,6 +627,12 @@ gst_iqa_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
         gst_structure_new_empty ("dssim"), NULL);
     self->max_dssim = 0.0;
   }
+  if (self->do_psnr)
+    add_metric_structure (msg_structure, "psnr");
+  if (self->do_native_ssim)
+    add_metric_structure (msg_structure, "ssim");
+  if (self->do_ms_ssim)
+    add_metric_structure (msg_structure, "ms-ssim");
 
   GST_OBJECT_LOCK (vagg);
   for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
@@ -295,6 +658,16 @@ gst_iqa_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
     }
   }
 
+  /* Without the dssim heat map the reference frame is output */
+  if (ref_frame && !self->do_dssim) {
+    GstVideoFrame out_frame;
+
+    if (gst_video_frame_map (&out_frame, &vagg->info, outbuf, GST_MAP_WRITE)) {
+      gst_video_frame_copy (&out_frame, ref_frame);
+      gst_video_frame_unmap (&out_frame);
+    }
+  }
+
   GST_OBJECT_UNLOCK (vagg);
 
   /* We only post the message here, because we can't post it while the object
@@ -328,6 +701,26 @@ _set_property (GObject * object, guint prop_id, const GValue * value,
       self->ssim_threshold = g_value_get_double (value);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_DO_PSNR:
+      GST_OBJECT_LOCK (self);
+      self->do_psnr = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_DO_NATIVE_SSIM:
+      GST_OBJECT_LOCK (self);
+      self->do_native_ssim = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_DO_MS_SSIM:
+      GST_OBJECT_LOCK (self);
+      self->do_ms_ssim = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      self->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -351,12 +744,86 @@ _get_property (GObject * object,
       g_value_set_double (value, self->ssim_threshold);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_DO_PSNR:
+      GST_OBJECT_LOCK (self);
+      g_value_set_boolean (value, self->do_psnr);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_DO_NATIVE_SSIM:
+      GST_OBJECT_LOCK (self);
+      g_value_set_boolean (value, self->do_native_ssim);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_DO_MS_SSIM:
+      GST_OBJECT_LOCK (self);
+      g_value_set_boolean (value, self->do_ms_ssim);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint (value, self->n_threads);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static GstCaps *
+gst_iqa_update_caps (GstVideoAggregator * vagg, GstCaps * caps)
+{
+  GstIqa *self = GST_IQA (vagg);
+  GstCaps *ret;
+  gboolean do_dssim, do_native;
+
+  ret = GST_VIDEO_AGGREGATOR_CLASS (parent_class)->update_caps (vagg, caps);
+
+  GST_OBJECT_LOCK (self);
+  do_dssim = self->do_dssim;
+  do_native = self->do_psnr || self->do_native_ssim || self->do_ms_ssim;
+  GST_OBJECT_UNLOCK (self);
+
+  /* The dssim heat map is only implemented for RGBA, otherwise prefer
+   * keeping the format of the sink pads to avoid converting frames */
+  if (do_dssim && ret) {
+    GstCaps *rgba = gst_caps_new_simple ("video/x-raw", "format",
+        G_TYPE_STRING, "RGBA", NULL);
+    GstCaps *tmp = gst_caps_intersect (ret, rgba);
+
+    gst_caps_unref (rgba);
+    gst_caps_unref (ret);
+    ret = tmp;
+  } else if (do_native && ret) {
+    /* The native metrics only handle planar YUV and GRAY, make the sink
+     * pads convert other formats */
+    GstCaps *planar = gst_caps_from_string ("video/x-raw, format=(string) { "
+        PLANAR_FORMATS " }");
+    GstCaps *tmp = gst_caps_intersect (ret, planar);
+
+    if (gst_caps_is_empty (tmp)) {
+      gst_caps_unref (tmp);
+      tmp = gst_caps_intersect (caps, planar);
+    }
+
+    gst_caps_unref (planar);
+    gst_caps_unref (ret);
+    ret = tmp;
+  }
+
+  return ret;
+}
+
+static void
+gst_iqa_finalize (GObject * object)
+{
+  GstIqa *self = GST_IQA (object);
+
+  gst_slice_runner_free (self->runner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 /* GObject boilerplate */
 static void
 gst_iqa_class_init (GstIqaClass * klass)
@@ -367,6 +834,7 @@ gst_iqa_class_init (GstIqaClass * klass)
       (GstVideoAggregatorClass *) klass;
 
   videoaggregator_class->aggregate_frames = gst_iqa_aggregate_frames;
+  videoaggregator_class->update_caps = gst_iqa_update_caps;
 
   gst_element_class_add_static_pad_template_with_gtype (gstelement_class,
       &src_factory, GST_TYPE_AGGREGATOR_PAD);
@@ -375,6 +843,58 @@ gst_iqa_class_init (GstIqaClass * klass)
 
   gobject_class->set_property = _set_property;
   gobject_class->get_property = _get_property;
+  gobject_class->finalize = gst_iqa_finalize;
+
+  /**
+   * GstIqa:do-psnr:
+   *
+   * Compute the PSNR of every component and of the whole picture.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_DO_PSNR,
+      g_param_spec_boolean ("do-psnr", "do-psnr",
+          "Compute the peak signal to noise ratio", DEFAULT_DO_PSNR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstIqa:do-ssim:
+   *
+   * Compute the structural similarity of every component and of the whole
+   * picture on 8x8 windows.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_DO_NATIVE_SSIM,
+      g_param_spec_boolean ("do-ssim", "do-ssim",
+          "Compute the structural similarity", DEFAULT_DO_NATIVE_SSIM,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstIqa:do-ms-ssim:
+   *
+   * Compute the multi-scale structural similarity over five scales of every
+   * component and of the whole picture.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_DO_MS_SSIM,
+      g_param_spec_boolean ("do-ms-ssim", "do-ms-ssim",
+          "Compute the multi-scale structural similarity", DEFAULT_DO_MS_SSIM,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstIqa:n-threads:
+   *
+   * Number of threads computing the metrics of each plane, 0 uses as many
+   * threads as there are processors.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads to use (0 = number of processors)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
 #ifdef HAVE_DSSIM
   g_object_class_install_property (gobject_class, PROP_DO_SSIM,
@@ -397,6 +917,10 @@ gst_iqa_class_init (GstIqaClass * klass)
 static void
 gst_iqa_init (GstIqa * self)
 {
+  self->do_psnr = DEFAULT_DO_PSNR;
+  self->do_native_ssim = DEFAULT_DO_NATIVE_SSIM;
+  self->do_ms_ssim = DEFAULT_DO_MS_SSIM;
+  self->n_threads = DEFAULT_N_THREADS;
 }
 
 static gboolean
@@ -23,6 +23,7 @@
 #include <gst/gst.h>
 #include <gst/video/video.h>
 #include <gst/video/gstvideoaggregator.h>
+#include <gst/slicerunner/gstslicerunner.h>
 
 G_BEGIN_DECLS
 
@@ -51,6 +52,13 @@ struct _GstIqa
   gboolean do_dssim;
   gdouble ssim_threshold;
   gdouble max_dssim;
+
+  gboolean do_psnr;
+  gboolean do_native_ssim;
+  gboolean do_ms_ssim;
+  guint n_threads;
+
+  GstSliceRunner *runner;
 };
 
 struct _GstIqaClass
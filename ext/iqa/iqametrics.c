@@ -0,0 +1,328 @@
+/* Image Quality Assessment plugin
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Metric kernels working directly on the samples of a single plane.
+ *
+ * 8 bit samples, by far the most common case, go through ORC: the squared
+ * differences of PSNR and the per column sums of SSIM are computed by the
+ * programs in gstiqaorc.orc.  The deeper sample types use plain C loops,
+ * one variant is generated per sample type.
+ *
+ * SSIM follows the usual fast approximation: the picture is cut into
+ * 4x4 blocks, the sums of the samples, of their squares and of their
+ * products are computed once per block, and every 8x8 window made of
+ * 2x2 neighbouring blocks is scored from those sums.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "iqametrics.h"
+#include "gstiqaorc.h"
+
+typedef struct
+{
+  gdouble s1;
+  gdouble s2;
+  gdouble ss;
+  gdouble s12;
+} IqaBlockSums;
+
+/* Per column sums over the 4 rows of a row of blocks, only used for 8 bit
+ * samples */
+typedef struct
+{
+  guint16 *s1;
+  guint16 *s2;
+  guint32 *ss;
+  guint32 *s12;
+} IqaColumnSums;
+
+/* a row of 8 bit samples sums up to at most 65025 * width, which fits into
+ * the 32 bits of the ORC accumulator for any sensible width */
+static inline guint64
+sse_row_u8 (const guint8 * ref, const guint8 * cmp, gint width)
+{
+  guint32 sse;
+
+  iqa_orc_sse_u8 (&sse, ref, cmp, width);
+
+  return sse;
+}
+
+static inline guint64
+sse_row_u16 (const guint8 * ref, const guint8 * cmp, gint width)
+{
+  const guint16 *a = (const guint16 *) ref;
+  const guint16 *b = (const guint16 *) cmp;
+  guint64 sse = 0;
+  gint i;
+
+  for (i = 0; i < width; i++) {
+    gint64 d = (gint64) a[i] - (gint64) b[i];
+    sse += (guint64) (d * d);
+  }
+
+  return sse;
+}
+
+/* The ORC program sums each column over the 4 rows, the 4 columns of each
+ * block are then added up here */
+static void
+block_row_u8 (const guint8 * ref, gint ref_stride, const guint8 * cmp,
+    gint cmp_stride, gint n_blocks, IqaColumnSums * cols, IqaBlockSums * sums)
+{
+  gint x, i;
+
+  iqa_orc_ssim_columns_u8 (cols->s1, cols->s2, cols->ss, cols->s12, ref,
+      ref + ref_stride, ref + 2 * ref_stride, ref + 3 * ref_stride, cmp,
+      cmp + cmp_stride, cmp + 2 * cmp_stride, cmp + 3 * cmp_stride,
+      n_blocks * 4);
+
+  for (x = 0; x < n_blocks; x++) {
+    guint32 s1 = 0, s2 = 0, ss = 0, s12 = 0;
+
+    for (i = x * 4; i < x * 4 + 4; i++) {
+      s1 += cols->s1[i];
+      s2 += cols->s2[i];
+      ss += cols->ss[i];
+      s12 += cols->s12[i];
+    }
+
+    sums[x].s1 = s1;
+    sums[x].s2 = s2;
+    sums[x].ss = ss;
+    sums[x].s12 = s12;
+  }
+}
+
+#define DEFINE_BLOCK_ROW(name, type, acc)                                    \
+static void                                                                  \
+block_row_##name (const guint8 * ref, gint ref_stride, const guint8 * cmp,   \
+    gint cmp_stride, gint n_blocks, IqaBlockSums * sums)                     \
+{                                                                            \
+  gint x, y, i;                                                              \
+                                                                             \
+  for (x = 0; x < n_blocks; x++) {                                           \
+    acc s1 = 0, s2 = 0, ss = 0, s12 = 0;                                     \
+                                                                             \
+    for (y = 0; y < 4; y++) {                                                \
+      const type *a = (const type *) (ref + y * ref_stride) + x * 4;         \
+      const type *b = (const type *) (cmp + y * cmp_stride) + x * 4;         \
+                                                                             \
+      for (i = 0; i < 4; i++) {                                              \
+        s1 += a[i];                                                          \
+        s2 += b[i];                                                          \
+        ss += (acc) a[i] * a[i] + (acc) b[i] * b[i];                         \
+        s12 += (acc) a[i] * b[i];                                            \
+      }                                                                      \
+    }                                                                        \
+                                                                             \
+    sums[x].s1 = s1;                                                         \
+    sums[x].s2 = s2;                                                         \
+    sums[x].ss = ss;                                                         \
+    sums[x].s12 = s12;                                                       \
+  }                                                                          \
+}
+
+DEFINE_BLOCK_ROW (u16, guint16, guint64)
+DEFINE_BLOCK_ROW (f32, gfloat, gdouble)
+
+#define DEFINE_DOWNSAMPLE_ROW(name, type)                                    \
+static void                                                                  \
+downsample_row_##name (const guint8 * src, gint stride, gfloat * dest,       \
+    gint width)                                                              \
+{                                                                            \
+  const type *s0 = (const type *) src;                                       \
+  const type *s1 = (const type *) (src + stride);                            \
+  gint i;                                                                    \
+                                                                             \
+  for (i = 0; i < width; i++) {                                              \
+    dest[i] = ((gfloat) s0[2 * i] + (gfloat) s0[2 * i + 1] +                 \
+        (gfloat) s1[2 * i] + (gfloat) s1[2 * i + 1]) * 0.25f;                \
+  }                                                                          \
+}
+
+DEFINE_DOWNSAMPLE_ROW (u8, guint8)
+DEFINE_DOWNSAMPLE_ROW (u16, guint16)
+DEFINE_DOWNSAMPLE_ROW (f32, gfloat)
+
+/* Sum of the squared differences of the rows y_start to y_end */
+guint64
+iqa_plane_sse (const IqaPlane * plane, gint y_start, gint y_end)
+{
+  guint64 sse = 0;
+  gint y;
+
+  g_return_val_if_fail (plane->type != IQA_SAMPLE_F32, 0);
+
+  for (y = y_start; y < y_end; y++) {
+    const guint8 *ref = plane->ref + (gsize) y * plane->ref_stride;
+    const guint8 *cmp = plane->cmp + (gsize) y * plane->cmp_stride;
+
+    if (plane->type == IQA_SAMPLE_U8)
+      sse += sse_row_u8 (ref, cmp, plane->width);
+    else
+      sse += sse_row_u16 (ref, cmp, plane->width);
+  }
+
+  return sse;
+}
+
+gint
+iqa_plane_ssim_rows (const IqaPlane * plane)
+{
+  if (plane->width < IQA_SSIM_MIN_SIZE || plane->height < IQA_SSIM_MIN_SIZE)
+    return 0;
+
+  return plane->height / 4 - 1;
+}
+
+static void
+block_row (const IqaPlane * plane, gint row, IqaColumnSums * cols,
+    IqaBlockSums * sums)
+{
+  const guint8 *ref = plane->ref + (gsize) row * 4 * plane->ref_stride;
+  const guint8 *cmp = plane->cmp + (gsize) row * 4 * plane->cmp_stride;
+  gint n_blocks = plane->width / 4;
+
+  switch (plane->type) {
+    case IQA_SAMPLE_U8:
+      block_row_u8 (ref, plane->ref_stride, cmp, plane->cmp_stride, n_blocks,
+          cols, sums);
+      break;
+    case IQA_SAMPLE_U16:
+      block_row_u16 (ref, plane->ref_stride, cmp, plane->cmp_stride, n_blocks,
+          sums);
+      break;
+    case IQA_SAMPLE_F32:
+      block_row_f32 (ref, plane->ref_stride, cmp, plane->cmp_stride, n_blocks,
+          sums);
+      break;
+  }
+}
+
+/* Accumulates the luminance, contrast-structure and SSIM terms of the
+ * window rows row_start to row_end */
+void
+iqa_plane_ssim (const IqaPlane * plane, gint row_start, gint row_end,
+    IqaSsimSums * sums)
+{
+  IqaBlockSums *top, *bottom, *tmp;
+  IqaColumnSums cols = { NULL, };
+  gint n_blocks = plane->width / 4;
+  gdouble c1 = (0.01 * plane->max_value) * (0.01 * plane->max_value);
+  gdouble c2 = (0.03 * plane->max_value) * (0.03 * plane->max_value);
+  gdouble l_sum = 0.0, cs_sum = 0.0, ssim_sum = 0.0;
+  gint row, x;
+
+  sums->l = sums->cs = sums->ssim = 0.0;
+  sums->n_windows = 0;
+
+  if (row_start >= row_end || n_blocks < 2)
+    return;
+
+  top = g_new (IqaBlockSums, n_blocks);
+  bottom = g_new (IqaBlockSums, n_blocks);
+
+  if (plane->type == IQA_SAMPLE_U8) {
+    gint n_columns = n_blocks * 4;
+
+    cols.s1 = g_new (guint16, 2 * n_columns);
+    cols.s2 = cols.s1 + n_columns;
+    cols.ss = g_new (guint32, 2 * n_columns);
+    cols.s12 = cols.ss + n_columns;
+  }
+
+  block_row (plane, row_start, &cols, top);
+
+  for (row = row_start; row < row_end; row++) {
+    block_row (plane, row + 1, &cols, bottom);
+
+    for (x = 0; x < n_blocks - 1; x++) {
+      gdouble s1, s2, ss, s12;
+      gdouble mu1, mu2, var, covar, l, cs;
+
+      s1 = top[x].s1 + top[x + 1].s1 + bottom[x].s1 + bottom[x + 1].s1;
+      s2 = top[x].s2 + top[x + 1].s2 + bottom[x].s2 + bottom[x + 1].s2;
+      ss = top[x].ss + top[x + 1].ss + bottom[x].ss + bottom[x + 1].ss;
+      s12 = top[x].s12 + top[x + 1].s12 + bottom[x].s12 + bottom[x + 1].s12;
+
+      mu1 = s1 / 64.0;
+      mu2 = s2 / 64.0;
+      var = ss / 64.0 - mu1 * mu1 - mu2 * mu2;
+      covar = s12 / 64.0 - mu1 * mu2;
+
+      l = (2.0 * mu1 * mu2 + c1) / (mu1 * mu1 + mu2 * mu2 + c1);
+      cs = (2.0 * covar + c2) / (var + c2);
+
+      l_sum += l;
+      cs_sum += cs;
+      ssim_sum += l * cs;
+    }
+
+    tmp = top;
+    top = bottom;
+    bottom = tmp;
+  }
+
+  sums->l = l_sum;
+  sums->cs = cs_sum;
+  sums->ssim = ssim_sum;
+  sums->n_windows = (guint64) (row_end - row_start) * (n_blocks - 1);
+
+  g_free (top);
+  g_free (bottom);
+  g_free (cols.s1);
+  g_free (cols.ss);
+}
+
+/* Writes the 2x2 box filtered rows y_start to y_end of both pictures of
+ * @plane, the output has half the width and height of @plane */
+void
+iqa_plane_downsample (const IqaPlane * plane, gfloat * ref_out,
+    gfloat * cmp_out, gint out_stride, gint y_start, gint y_end)
+{
+  gint width = plane->width / 2;
+  gint y;
+
+  for (y = y_start; y < y_end; y++) {
+    const guint8 *ref = plane->ref + (gsize) y * 2 * plane->ref_stride;
+    const guint8 *cmp = plane->cmp + (gsize) y * 2 * plane->cmp_stride;
+    gfloat *rdest = (gfloat *) ((guint8 *) ref_out + (gsize) y * out_stride);
+    gfloat *cdest = (gfloat *) ((guint8 *) cmp_out + (gsize) y * out_stride);
+
+    switch (plane->type) {
+      case IQA_SAMPLE_U8:
+        downsample_row_u8 (ref, plane->ref_stride, rdest, width);
+        downsample_row_u8 (cmp, plane->cmp_stride, cdest, width);
+        break;
+      case IQA_SAMPLE_U16:
+        downsample_row_u16 (ref, plane->ref_stride, rdest, width);
+        downsample_row_u16 (cmp, plane->cmp_stride, cdest, width);
+        break;
+      case IQA_SAMPLE_F32:
+        downsample_row_f32 (ref, plane->ref_stride, rdest, width);
+        downsample_row_f32 (cmp, plane->cmp_stride, cdest, width);
+        break;
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/* Image Quality Assessment plugin
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_IQA_METRICS_H__
+#define __GST_IQA_METRICS_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum
+{
+  IQA_SAMPLE_U8,
+  IQA_SAMPLE_U16,
+  IQA_SAMPLE_F32,
+} IqaSampleType;
+
+/* A single component of the reference and of the compared picture, the
+ * samples of both have the same type and geometry */
+typedef struct
+{
+  IqaSampleType type;
+  const guint8 *ref;
+  gint ref_stride;
+  const guint8 *cmp;
+  gint cmp_stride;
+  gint width;
+  gint height;
+  gdouble max_value;
+} IqaPlane;
+
+typedef struct
+{
+  gdouble l;
+  gdouble cs;
+  gdouble ssim;
+  guint64 n_windows;
+} IqaSsimSums;
+
+/* The SSIM windows are 8x8 pixels and overlap by 4 pixels in both
+ * directions, window row n covers the pixel rows 4n to 4n + 7 */
+#define IQA_SSIM_MIN_SIZE 8
+
+guint64     iqa_plane_sse               (const IqaPlane * plane,
+                                         gint y_start,
+                                         gint y_end);
+
+gint        iqa_plane_ssim_rows         (const IqaPlane * plane);
+
+void        iqa_plane_ssim              (const IqaPlane * plane,
+                                         gint row_start,
+                                         gint row_end,
+                                         IqaSsimSums * sums);
+
+void        iqa_plane_downsample        (const IqaPlane * plane,
+                                         gfloat * ref_out,
+                                         gfloat * cmp_out,
+                                         gint out_stride,
+                                         gint y_start,
+                                         gint y_end);
+
+G_END_DECLS
+
+#endif /* __GST_IQA_METRICS_H__ */
@@ -61,6 +61,11 @@ enum
   PROP_GST_SCTP_ASSOCIATION_ID,
   PROP_REMOTE_SCTP_PORT,
   PROP_USE_SOCK_STREAM,
+  PROP_SEND_BUFFER_SIZE,
+  PROP_RECEIVE_BUFFER_SIZE,
+  PROP_CWND,
+  PROP_RTT,
+  PROP_QUEUED_BYTES,
 
   NUM_PROPERTIES
 };
@@ -72,6 +77,11 @@ static GParamSpec *properties[NUM_PROPERTIES];
 #define DEFAULT_GST_SCTP_ORDERED TRUE
 #define DEFAULT_SCTP_PPID 1
 #define DEFAULT_USE_SOCK_STREAM FALSE
+#define DEFAULT_SEND_BUFFER_SIZE (1024 * 1024)
+#define DEFAULT_RECEIVE_BUFFER_SIZE (1024 * 1024)
+
+/* Maximum number of outbound SCTP packets pushed downstream in one list */
+#define MAX_PACKETS_PER_LIST 64
 
 #define BUFFER_FULL_SLEEP_TIME 100000
 
@@ -145,6 +155,8 @@ static void gst_sctp_enc_release_pad (GstElement * element, GstPad * pad);
 static void gst_sctp_enc_srcpad_loop (GstPad * pad);
 static GstFlowReturn gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buffer);
+static GstFlowReturn gst_sctp_enc_sink_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static gboolean gst_sctp_enc_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event);
 static gboolean gst_sctp_enc_src_event (GstPad * pad, GstObject * parent,
@@ -211,6 +223,71 @@ gst_sctp_enc_class_init (GstSctpEncClass * klass)
       "When TRUE the partial reliability parameters of the channel are ignored.",
       DEFAULT_USE_SOCK_STREAM, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GstSctpEnc:send-buffer-size:
+   *
+   * Size of the SCTP socket send buffer in bytes. Together with the round
+   * trip time this bounds the achievable throughput, so it needs to be
+   * raised for links with a high bandwidth-delay product.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_SEND_BUFFER_SIZE] =
+      g_param_spec_uint ("send-buffer-size", "Send buffer size",
+      "Size of the SCTP socket send buffer in bytes", 0, G_MAXINT,
+      DEFAULT_SEND_BUFFER_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstSctpEnc:receive-buffer-size:
+   *
+   * Size of the SCTP socket receive buffer in bytes.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_RECEIVE_BUFFER_SIZE] =
+      g_param_spec_uint ("receive-buffer-size", "Receive buffer size",
+      "Size of the SCTP socket receive buffer in bytes", 0, G_MAXINT,
+      DEFAULT_RECEIVE_BUFFER_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstSctpEnc:cwnd:
+   *
+   * Current congestion window of the association's primary path in bytes.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_CWND] =
+      g_param_spec_uint ("cwnd", "Congestion window",
+      "Congestion window of the primary path in bytes", 0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstSctpEnc:rtt:
+   *
+   * Smoothed round trip time of the association's primary path in
+   * milliseconds.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_RTT] =
+      g_param_spec_uint ("rtt", "Round trip time",
+      "Smoothed round trip time of the primary path in milliseconds", 0,
+      G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * GstSctpEnc:queued-bytes:
+   *
+   * Number of bytes currently held in the association's send buffer, either
+   * not yet sent or not yet acknowledged by the peer.
+   *
+   * Since: 1.18
+   */
+  properties[PROP_QUEUED_BYTES] =
+      g_param_spec_uint ("queued-bytes", "Queued bytes",
+      "Number of bytes queued in the send buffer waiting to be sent or "
+      "acknowledged", 0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 
   signals[SIGNAL_SCTP_ASSOCIATION_ESTABLISHED] =
@@ -257,6 +334,8 @@ gst_sctp_enc_init (GstSctpEnc * self)
 {
   self->sctp_association_id = DEFAULT_GST_SCTP_ASSOCIATION_ID;
   self->remote_sctp_port = DEFAULT_REMOTE_SCTP_PORT;
+  self->send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
+  self->receive_buffer_size = DEFAULT_RECEIVE_BUFFER_SIZE;
 
   self->sctp_association = NULL;
   self->outbound_sctp_packet_queue =
@@ -299,6 +378,12 @@ gst_sctp_enc_set_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       self->use_sock_stream = g_value_get_boolean (value);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      self->send_buffer_size = g_value_get_uint (value);
+      break;
+    case PROP_RECEIVE_BUFFER_SIZE:
+      self->receive_buffer_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -321,6 +406,30 @@ gst_sctp_enc_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_USE_SOCK_STREAM:
       g_value_set_boolean (value, self->use_sock_stream);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      g_value_set_uint (value, self->send_buffer_size);
+      break;
+    case PROP_RECEIVE_BUFFER_SIZE:
+      g_value_set_uint (value, self->receive_buffer_size);
+      break;
+    case PROP_CWND:
+    case PROP_RTT:
+    case PROP_QUEUED_BYTES:{
+      GstSctpAssociation *association = NULL;
+
+      GST_OBJECT_LOCK (self);
+      if (self->sctp_association)
+        association = g_object_ref (self->sctp_association);
+      GST_OBJECT_UNLOCK (self);
+
+      if (association) {
+        g_object_get_property (G_OBJECT (association), pspec->name, value);
+        g_object_unref (association);
+      } else {
+        g_value_set_uint (value, 0);
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -424,6 +533,8 @@ gst_sctp_enc_request_new_pad (GstElement * element, GstPadTemplate * template,
       template->direction, "template", template, NULL);
   gst_pad_set_chain_function (new_pad,
       GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_chain));
+  gst_pad_set_chain_list_function (new_pad,
+      GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_chain_list));
   gst_pad_set_event_function (new_pad,
       GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_event));
 
@@ -516,11 +627,39 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
   if (gst_data_queue_pop (self->outbound_sctp_packet_queue, &item)) {
     GstBuffer *buffer = GST_BUFFER (item->object);
 
-    GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
-
-    flow_ret = gst_pad_push (self->src_pad, buffer);
     item->object = NULL;
 
+    /* usrsctp usually produces a burst of packets for a single send or a
+     * single SACK. Whatever else is already queued is pushed together with
+     * this packet in one buffer list. We are the only consumer, so popping
+     * from a non-empty queue never blocks here. */
+    if (!gst_data_queue_is_empty (self->outbound_sctp_packet_queue)) {
+      GstBufferList *list = gst_buffer_list_new ();
+
+      gst_buffer_list_add (list, buffer);
+
+      while (gst_buffer_list_length (list) < MAX_PACKETS_PER_LIST
+          && !gst_data_queue_is_empty (self->outbound_sctp_packet_queue)) {
+        GstDataQueueItem *next_item;
+
+        if (!gst_data_queue_pop (self->outbound_sctp_packet_queue, &next_item))
+          break;
+
+        gst_buffer_list_add (list, GST_BUFFER (next_item->object));
+        next_item->object = NULL;
+        next_item->destroy (next_item);
+      }
+
+      GST_DEBUG_OBJECT (self, "Forwarding list of %u packets",
+          gst_buffer_list_length (list));
+
+      flow_ret = gst_pad_push_list (self->src_pad, list);
+    } else {
+      GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
+
+      flow_ret = gst_pad_push (self->src_pad, buffer);
+    }
+
     GST_OBJECT_LOCK (self);
     self->src_ret = flow_ret;
     GST_OBJECT_UNLOCK (self);
@@ -553,10 +692,27 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
 }
 
 static GstFlowReturn
-gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+check_src_ret (GstSctpEnc * self, GstPad * pad)
 {
-  GstSctpEnc *self = GST_SCTP_ENC (parent);
-  GstSctpEncPad *sctpenc_pad = GST_SCTP_ENC_PAD (pad);
+  GstFlowReturn flow_ret;
+
+  GST_OBJECT_LOCK (self);
+  flow_ret = self->src_ret;
+  GST_OBJECT_UNLOCK (self);
+
+  if (flow_ret != GST_FLOW_OK)
+    GST_ERROR_OBJECT (pad, "Pushing on source pad failed before: %s",
+        gst_flow_get_name (flow_ret));
+
+  return flow_ret;
+}
+
+/* Takes ownership of @buffer */
+static GstFlowReturn
+send_buffer (GstSctpEnc * self, GstSctpEncPad * sctpenc_pad,
+    GstBuffer * buffer)
+{
+  GstPad *pad = GST_PAD (sctpenc_pad);
   GstMapInfo map;
   guint32 ppid;
   gboolean ordered;
@@ -569,17 +725,6 @@ gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   const guint8 *data;
   guint32 length;
 
-  GST_OBJECT_LOCK (self);
-  if (self->src_ret != GST_FLOW_OK) {
-    GST_ERROR_OBJECT (pad, "Pushing on source pad failed before: %s",
-        gst_flow_get_name (self->src_ret));
-    flow_ret = self->src_ret;
-    GST_OBJECT_UNLOCK (self);
-    gst_buffer_unref (buffer);
-    return flow_ret;
-  }
-  GST_OBJECT_UNLOCK (self);
-
   ppid = sctpenc_pad->ppid;
   ordered = sctpenc_pad->ordered;
   pr = sctpenc_pad->reliability;
@@ -678,6 +823,54 @@ error:
   return flow_ret;
 }
 
+static GstFlowReturn
+gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstSctpEnc *self = GST_SCTP_ENC (parent);
+  GstFlowReturn flow_ret;
+
+  flow_ret = check_src_ret (self, pad);
+  if (flow_ret != GST_FLOW_OK) {
+    gst_buffer_unref (buffer);
+    return flow_ret;
+  }
+
+  return send_buffer (self, GST_SCTP_ENC_PAD (pad), buffer);
+}
+
+static GstFlowReturn
+gst_sctp_enc_sink_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstSctpEnc *self = GST_SCTP_ENC (parent);
+  GstFlowReturn flow_ret;
+  guint i, len;
+
+  flow_ret = check_src_ret (self, pad);
+  if (flow_ret != GST_FLOW_OK) {
+    gst_buffer_list_unref (list);
+    return flow_ret;
+  }
+
+  GST_LOG_OBJECT (pad, "Sending list of %u buffers",
+      gst_buffer_list_length (list));
+
+  /* Each buffer is one SCTP message. They are all handed to the association
+   * back to back, the resulting packets are collected by the source pad task
+   * and pushed downstream in lists. */
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len && flow_ret == GST_FLOW_OK; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+
+    flow_ret =
+        send_buffer (self, GST_SCTP_ENC_PAD (pad), gst_buffer_ref (buffer));
+  }
+
+  gst_buffer_list_unref (list);
+
+  return flow_ret;
+}
+
 static gboolean
 gst_sctp_enc_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -803,20 +996,25 @@ gst_sctp_enc_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 static gboolean
 configure_association (GstSctpEnc * self)
 {
+  GstSctpAssociation *association;
   gint state;
 
-  self->sctp_association = gst_sctp_association_get (self->sctp_association_id);
+  association = gst_sctp_association_get (self->sctp_association_id);
 
-  g_object_get (self->sctp_association, "state", &state, NULL);
+  g_object_get (association, "state", &state, NULL);
 
   if (state != GST_SCTP_ASSOCIATION_STATE_NEW) {
     GST_WARNING_OBJECT (self,
         "Could not configure SCTP association. Association already in use!");
-    g_object_unref (self->sctp_association);
-    self->sctp_association = NULL;
+    g_object_unref (association);
     goto error;
   }
 
+  /* the association properties are read from other threads */
+  GST_OBJECT_LOCK (self);
+  self->sctp_association = association;
+  GST_OBJECT_UNLOCK (self);
+
   self->signal_handler_state_changed =
       g_signal_connect_object (self->sctp_association, "notify::state",
       G_CALLBACK (on_sctp_association_state_changed), self, 0);
@@ -827,6 +1025,12 @@ configure_association (GstSctpEnc * self)
   g_object_bind_property (self, "use-sock-stream", self->sctp_association,
       "use-sock-stream", G_BINDING_SYNC_CREATE);
 
+  g_object_bind_property (self, "send-buffer-size", self->sctp_association,
+      "send-buffer-size", G_BINDING_SYNC_CREATE);
+
+  g_object_bind_property (self, "receive-buffer-size", self->sctp_association,
+      "receive-buffer-size", G_BINDING_SYNC_CREATE);
+
   gst_sctp_association_set_on_packet_out (self->sctp_association,
       on_sctp_packet_out, gst_object_ref (self), gst_object_unref);
 
@@ -940,6 +1144,7 @@ remove_sinkpad (const GValue * item, gpointer user_data)
 static void
 sctpenc_cleanup (GstSctpEnc * self)
 {
+  GstSctpAssociation *association;
   GstIterator *it;
 
   gst_sctp_association_set_on_packet_out (self->sctp_association, NULL, NULL,
@@ -949,8 +1154,11 @@ sctpenc_cleanup (GstSctpEnc * self)
       self->signal_handler_state_changed);
   stop_srcpad_task (self->src_pad, self);
   gst_sctp_association_force_close (self->sctp_association);
-  g_object_unref (self->sctp_association);
+  GST_OBJECT_LOCK (self);
+  association = self->sctp_association;
   self->sctp_association = NULL;
+  GST_OBJECT_UNLOCK (self);
+  g_object_unref (association);
 
   it = gst_element_iterate_sink_pads (GST_ELEMENT (self));
   while (gst_iterator_foreach (it, remove_sinkpad, self) == GST_ITERATOR_RESYNC)
@@ -85,6 +85,11 @@ enum
   PROP_REMOTE_PORT,
   PROP_STATE,
   PROP_USE_SOCK_STREAM,
+  PROP_SEND_BUFFER_SIZE,
+  PROP_RECEIVE_BUFFER_SIZE,
+  PROP_CWND,
+  PROP_RTT,
+  PROP_QUEUED_BYTES,
 
   NUM_PROPERTIES
 };
@@ -96,6 +101,12 @@ static GParamSpec *properties[NUM_PROPERTIES];
 #define DEFAULT_NUMBER_OF_SCTP_STREAMS 1024
 #define DEFAULT_LOCAL_SCTP_PORT 0
 #define DEFAULT_REMOTE_SCTP_PORT 0
+#define DEFAULT_SEND_BUFFER_SIZE (1024 * 1024)
+#define DEFAULT_RECEIVE_BUFFER_SIZE (1024 * 1024)
+
+/* Messages larger than this are handed to usrsctp in several parts and only
+ * the last one carries SCTP_EOR. Firefox uses the same value. */
+#define MAX_SEND_CHUNK_SIZE 0x4000
 
 static GHashTable *associations = NULL;
 G_LOCK_DEFINE_STATIC (associations_lock);
@@ -110,6 +121,11 @@ static void gst_sctp_association_get_property (GObject * object, guint prop_id,
 
 static struct socket *create_sctp_socket (GstSctpAssociation *
     gst_sctp_association);
+static gboolean set_socket_buffer_size (GstSctpAssociation * self,
+    struct socket *sock, int option, guint size);
+static gboolean get_status (GstSctpAssociation * self,
+    struct sctp_status *status);
+static guint get_queued_bytes (GstSctpAssociation * self);
 static struct sockaddr_conn get_sctp_socket_address (GstSctpAssociation *
     gst_sctp_association, guint16 port);
 static gboolean client_role_connect (GstSctpAssociation * self);
@@ -171,6 +187,32 @@ gst_sctp_association_class_init (GstSctpAssociationClass * klass)
       "When TRUE the partial reliability parameters of the channel is ignored.",
       FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_SEND_BUFFER_SIZE] =
+      g_param_spec_uint ("send-buffer-size", "Send buffer size",
+      "Size of the SCTP socket send buffer in bytes", 0, G_MAXINT,
+      DEFAULT_SEND_BUFFER_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  properties[PROP_RECEIVE_BUFFER_SIZE] =
+      g_param_spec_uint ("receive-buffer-size", "Receive buffer size",
+      "Size of the SCTP socket receive buffer in bytes", 0, G_MAXINT,
+      DEFAULT_RECEIVE_BUFFER_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+  properties[PROP_CWND] =
+      g_param_spec_uint ("cwnd", "Congestion window",
+      "Congestion window of the primary path in bytes", 0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  properties[PROP_RTT] =
+      g_param_spec_uint ("rtt", "Round trip time",
+      "Smoothed round trip time of the primary path in milliseconds", 0,
+      G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  properties[PROP_QUEUED_BYTES] =
+      g_param_spec_uint ("queued-bytes", "Queued bytes",
+      "Number of bytes queued in the send buffer waiting to be sent or "
+      "acknowledged", 0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 }
 
@@ -222,7 +264,10 @@ gst_sctp_association_init (GstSctpAssociation * self)
 
   self->local_port = DEFAULT_LOCAL_SCTP_PORT;
   self->remote_port = DEFAULT_REMOTE_SCTP_PORT;
+  self->send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
+  self->receive_buffer_size = DEFAULT_RECEIVE_BUFFER_SIZE;
   self->sctp_ass_sock = NULL;
+  self->sctp_assoc_id = SCTP_FUTURE_ASSOC;
 
   g_mutex_init (&self->association_mutex);
 
@@ -284,6 +329,12 @@ gst_sctp_association_set_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       self->use_sock_stream = g_value_get_boolean (value);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      self->send_buffer_size = g_value_get_uint (value);
+      break;
+    case PROP_RECEIVE_BUFFER_SIZE:
+      self->receive_buffer_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -293,6 +344,16 @@ gst_sctp_association_set_property (GObject * object, guint prop_id,
   if (prop_id == PROP_LOCAL_PORT || prop_id == PROP_REMOTE_PORT)
     maybe_set_state_to_ready (self);
 
+  /* Buffer sizes can be changed on a running association */
+  if (self->sctp_ass_sock) {
+    if (prop_id == PROP_SEND_BUFFER_SIZE)
+      set_socket_buffer_size (self, self->sctp_ass_sock, SO_SNDBUF,
+          g_value_get_uint (value));
+    else if (prop_id == PROP_RECEIVE_BUFFER_SIZE)
+      set_socket_buffer_size (self, self->sctp_ass_sock, SO_RCVBUF,
+          g_value_get_uint (value));
+  }
+
   return;
 
 error:
@@ -341,6 +402,29 @@ gst_sctp_association_get_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       g_value_set_boolean (value, self->use_sock_stream);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      g_value_set_uint (value, self->send_buffer_size);
+      break;
+    case PROP_RECEIVE_BUFFER_SIZE:
+      g_value_set_uint (value, self->receive_buffer_size);
+      break;
+    case PROP_CWND:{
+      struct sctp_status status;
+
+      g_value_set_uint (value,
+          get_status (self, &status) ? status.sstat_primary.spinfo_cwnd : 0);
+      break;
+    }
+    case PROP_RTT:{
+      struct sctp_status status;
+
+      g_value_set_uint (value,
+          get_status (self, &status) ? status.sstat_primary.spinfo_srtt : 0);
+      break;
+    }
+    case PROP_QUEUED_BYTES:
+      g_value_set_uint (value, get_queued_bytes (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -462,8 +546,9 @@ gst_sctp_association_send_data (GstSctpAssociation * self, const guint8 * buf,
 {
   GstFlowReturn flow_ret;
   struct sctp_sendv_spa spa;
-  gint32 bytes_sent = 0;
+  guint32 bytes_sent = 0;
   struct sockaddr_conn remote_addr;
+  guint16 flags;
 
   g_mutex_lock (&self->association_mutex);
   if (self->state != GST_SCTP_ASSOCIATION_STATE_CONNECTED) {
@@ -483,15 +568,11 @@ gst_sctp_association_send_data (GstSctpAssociation * self, const guint8 * buf,
   remote_addr = get_sctp_socket_address (self, self->remote_port);
   g_mutex_unlock (&self->association_mutex);
 
-  /* TODO: We probably want to split too large chunks into multiple packets
-   * and only set the SCTP_EOR flag on the last one. Firefox is using 0x4000
-   * as the maximum packet size
-   */
   memset (&spa, 0, sizeof (spa));
 
+  flags = ordered ? 0 : SCTP_UNORDERED;
   spa.sendv_sndinfo.snd_ppid = g_htonl (ppid);
   spa.sendv_sndinfo.snd_sid = stream_id;
-  spa.sendv_sndinfo.snd_flags = SCTP_EOR | (ordered ? 0 : SCTP_UNORDERED);
   spa.sendv_sndinfo.snd_context = 0;
   spa.sendv_sndinfo.snd_assoc_id = 0;
   spa.sendv_flags = SCTP_SEND_SNDINFO_VALID;
@@ -506,24 +587,39 @@ gst_sctp_association_send_data (GstSctpAssociation * self, const guint8 * buf,
       spa.sendv_prinfo.pr_policy = SCTP_PR_SCTP_BUF;
   }
 
-  bytes_sent =
-      usrsctp_sendv (self->sctp_ass_sock, buf, length,
-      (struct sockaddr *) &remote_addr, 1, (void *) &spa,
-      (socklen_t) sizeof (struct sctp_sendv_spa), SCTP_SENDV_SPA, 0);
-  if (bytes_sent < 0) {
-    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      bytes_sent = 0;
-      /* Resending this buffer is taken care of by the gstsctpenc */
-      flow_ret = GST_FLOW_OK;
-      goto end;
-    } else {
-      GST_ERROR_OBJECT (self, "Error sending data on stream %u: (%u) %s",
-          stream_id, errno, g_strerror (errno));
-      flow_ret = GST_FLOW_ERROR;
-      goto end;
-    }
-  }
+  /* Large messages are passed on in parts of at most MAX_SEND_CHUNK_SIZE
+   * bytes. With SCTP_EXPLICIT_EOR usrsctp keeps appending to the same message
+   * until a part with SCTP_EOR is sent, so if we stop early because the send
+   * buffer is full the caller simply continues with the remaining bytes. */
   flow_ret = GST_FLOW_OK;
+  do {
+    guint32 chunk_size = MIN (length - bytes_sent, MAX_SEND_CHUNK_SIZE);
+    gboolean eor = (bytes_sent + chunk_size == length);
+    gint32 ret;
+
+    spa.sendv_sndinfo.snd_flags = flags | (eor ? SCTP_EOR : 0);
+
+    ret =
+        usrsctp_sendv (self->sctp_ass_sock, buf + bytes_sent, chunk_size,
+        (struct sockaddr *) &remote_addr, 1, (void *) &spa,
+        (socklen_t) sizeof (struct sctp_sendv_spa), SCTP_SENDV_SPA, 0);
+    if (ret < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        /* Resending the rest of this buffer is taken care of by the
+         * gstsctpenc */
+        goto end;
+      } else {
+        GST_ERROR_OBJECT (self, "Error sending data on stream %u: (%u) %s",
+            stream_id, errno, g_strerror (errno));
+        flow_ret = GST_FLOW_ERROR;
+        goto end;
+      }
+    }
+
+    bytes_sent += ret;
+    if ((guint32) ret < chunk_size)
+      break;
+  } while (bytes_sent < length);
 
 end:
   if (bytes_sent_)
@@ -570,7 +666,6 @@ create_sctp_socket (GstSctpAssociation * self)
   struct linger l;
   struct sctp_event event;
   struct sctp_assoc_value stream_reset;
-  int buf_size = 1024 * 1024;
   int value = 1;
   guint16 event_types[] = {
     SCTP_ASSOC_CHANGE,
@@ -599,18 +694,11 @@ create_sctp_socket (GstSctpAssociation * self)
     goto error;
   }
 
-  if (usrsctp_setsockopt (sock, SOL_SOCKET, SO_RCVBUF,
-          (const void *) &buf_size, sizeof (buf_size)) < 0) {
-    GST_ERROR_OBJECT (self, "Could not change receive buffer size: (%u) %s",
-        errno, g_strerror (errno));
+  if (!set_socket_buffer_size (self, sock, SO_RCVBUF,
+          self->receive_buffer_size))
     goto error;
-  }
-  if (usrsctp_setsockopt (sock, SOL_SOCKET, SO_SNDBUF,
-          (const void *) &buf_size, sizeof (buf_size)) < 0) {
-    GST_ERROR_OBJECT (self, "Could not change send buffer size: (%u) %s",
-        errno, g_strerror (errno));
+  if (!set_socket_buffer_size (self, sock, SO_SNDBUF, self->send_buffer_size))
     goto error;
-  }
 
   /* Properly return errors */
   if (usrsctp_set_non_blocking (sock, 1) < 0) {
@@ -681,6 +769,80 @@ error:
   return NULL;
 }
 
+static gboolean
+set_socket_buffer_size (GstSctpAssociation * self, struct socket *sock,
+    int option, guint size)
+{
+  int buf_size = size;
+
+  if (usrsctp_setsockopt (sock, SOL_SOCKET, option,
+          (const void *) &buf_size, sizeof (buf_size)) < 0) {
+    GST_ERROR_OBJECT (self, "Could not change %s buffer size to %u: (%u) %s",
+        option == SO_SNDBUF ? "send" : "receive", size, errno,
+        g_strerror (errno));
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (self, "%s buffer size set to %u",
+      option == SO_SNDBUF ? "Send" : "Receive", size);
+
+  return TRUE;
+}
+
+static gboolean
+get_status (GstSctpAssociation * self, struct sctp_status *status)
+{
+  struct socket *sock;
+  socklen_t opt_len = (socklen_t) sizeof (struct sctp_status);
+
+  memset (status, 0, sizeof (struct sctp_status));
+
+  g_mutex_lock (&self->association_mutex);
+  sock = self->sctp_ass_sock;
+  status->sstat_assoc_id = self->sctp_assoc_id;
+  g_mutex_unlock (&self->association_mutex);
+
+  if (!sock || self->state != GST_SCTP_ASSOCIATION_STATE_CONNECTED)
+    return FALSE;
+
+  if (usrsctp_getsockopt (sock, IPPROTO_SCTP, SCTP_STATUS, status,
+          &opt_len) < 0) {
+    GST_DEBUG_OBJECT (self, "usrsctp_getsockopt(SCTP_STATUS) error: (%u) %s",
+        errno, g_strerror (errno));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static guint
+get_queued_bytes (GstSctpAssociation * self)
+{
+  struct socket *sock;
+  struct sctp_sockstat sockstat;
+  socklen_t opt_len = (socklen_t) sizeof (struct sctp_sockstat);
+
+  memset (&sockstat, 0, sizeof (sockstat));
+
+  g_mutex_lock (&self->association_mutex);
+  sock = self->sctp_ass_sock;
+  sockstat.ss_assoc_id = self->sctp_assoc_id;
+  g_mutex_unlock (&self->association_mutex);
+
+  if (!sock || self->state != GST_SCTP_ASSOCIATION_STATE_CONNECTED)
+    return 0;
+
+  if (usrsctp_getsockopt (sock, IPPROTO_SCTP, SCTP_GET_SNDBUF_USE, &sockstat,
+          &opt_len) < 0) {
+    GST_DEBUG_OBJECT (self,
+        "usrsctp_getsockopt(SCTP_GET_SNDBUF_USE) error: (%u) %s", errno,
+        g_strerror (errno));
+    return 0;
+  }
+
+  return sockstat.ss_total_sndbuf;
+}
+
 static struct sockaddr_conn
 get_sctp_socket_address (GstSctpAssociation * gst_sctp_association,
     guint16 port)
@@ -878,6 +1040,7 @@ handle_association_changed (GstSctpAssociation * self,
       GST_DEBUG_OBJECT (self, "SCTP_COMM_UP");
       g_mutex_lock (&self->association_mutex);
       if (self->state == GST_SCTP_ASSOCIATION_STATE_CONNECTING) {
+        self->sctp_assoc_id = sac->sac_assoc_id;
         change_state = TRUE;
         new_state = GST_SCTP_ASSOCIATION_STATE_CONNECTED;
         GST_DEBUG_OBJECT (self, "SCTP association connected!");
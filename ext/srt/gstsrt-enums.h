@@ -62,6 +62,19 @@ typedef enum
   GST_SRT_KEY_LENGTH_32 = 32,
 } GstSRTKeyLength;
 
+/**
+ * GstSRTCallerDropPolicy:
+ * @GST_SRT_CALLER_DROP_POLICY_DROP_OLDEST: drop the oldest queued message
+ * @GST_SRT_CALLER_DROP_POLICY_DISCONNECT: disconnect the caller
+ *
+ * What to do when the send queue of a caller is full.
+ */
+typedef enum
+{
+  GST_SRT_CALLER_DROP_POLICY_DROP_OLDEST,
+  GST_SRT_CALLER_DROP_POLICY_DISCONNECT,
+} GstSRTCallerDropPolicy;
+
 G_END_DECLS
 
 #endif // __GST_SRT_ENUM_H__
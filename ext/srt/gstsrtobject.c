@@ -49,6 +49,8 @@ enum
   PROP_STATS,
   PROP_WAIT_FOR_CONNECTION,
   PROP_STREAMID,
+  PROP_CALLER_QUEUE_SIZE,
+  PROP_CALLER_DROP_POLICY,
   PROP_LAST
 };
 
@@ -58,8 +60,17 @@ typedef struct
   gint poll_id;
   GSocketAddress *sockaddr;
   gboolean sent_headers;
+
+  /* queued messages (GBytes), when caller-queue-size is set */
+  GQueue queue;
+  gsize queued_bytes;
+  guint64 dropped_messages;
+  gboolean backlogged;
 } SRTCaller;
 
+/* Upper bound of a sender thread wait, so that it notices being stopped */
+#define SENDER_POLL_TIMEOUT 100
+
 static GstStructure *gst_srt_object_accumulate_stats (GstSRTObject * srtobject,
     SRTSOCKET srtsock);
 
@@ -70,6 +81,7 @@ srt_caller_new (void)
   caller->sock = SRT_INVALID_SOCK;
   caller->poll_id = SRT_ERROR;
   caller->sent_headers = FALSE;
+  g_queue_init (&caller->queue);
 
   return caller;
 }
@@ -81,6 +93,9 @@ srt_caller_free (SRTCaller * caller)
 
   g_clear_object (&caller->sockaddr);
 
+  g_queue_foreach (&caller->queue, (GFunc) g_bytes_unref, NULL);
+  g_queue_clear (&caller->queue);
+
   if (caller->sock != SRT_INVALID_SOCK) {
     srt_close (caller->sock);
   }
@@ -108,6 +123,173 @@ srt_caller_signal_removed (SRTCaller * caller, GstSRTObject * srtobject)
       caller->sockaddr);
 }
 
+/* called with sock_lock */
+static void
+gst_srt_object_remove_caller (GstSRTObject * srtobject, SRTCaller * caller)
+{
+  if (caller->backlogged) {
+    srt_epoll_remove_usock (srtobject->sender_poll_id, caller->sock);
+    srtobject->n_backlogged--;
+  }
+
+  srtobject->callers = g_list_remove (srtobject->callers, caller);
+  srt_caller_signal_removed (caller, srtobject);
+  srt_caller_free (caller);
+}
+
+/* Sends queued messages until the socket would block. Returns FALSE if the
+ * caller is gone. Called with sock_lock. */
+static gboolean
+srt_caller_flush_queue (SRTCaller * caller, GstSRTObject * srtobject)
+{
+  GBytes *msg;
+
+  while ((msg = g_queue_peek_head (&caller->queue)) != NULL) {
+    gsize size;
+    const gchar *data = g_bytes_get_data (msg, &size);
+
+    if (srt_sendmsg2 (caller->sock, data, size, 0) == SRT_ERROR) {
+      if (srt_getlasterror (NULL) == SRT_EASYNCSND)
+        break;
+
+      GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
+          caller->sock, srt_getlasterror_str ());
+      return FALSE;
+    }
+
+    g_queue_pop_head (&caller->queue);
+    caller->queued_bytes -= size;
+    g_bytes_unref (msg);
+  }
+
+  /* Only backlogged callers are polled by the sender thread, polling a
+   * writable socket would just spin */
+  if (!g_queue_is_empty (&caller->queue) && !caller->backlogged) {
+    gint flag = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+
+    if (srt_epoll_add_usock (srtobject->sender_poll_id, caller->sock, &flag)) {
+      GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
+          caller->sock, srt_getlasterror_str ());
+      return FALSE;
+    }
+
+    caller->backlogged = TRUE;
+    if (srtobject->n_backlogged++ == 0)
+      g_cond_signal (&srtobject->sender_cond);
+  } else if (g_queue_is_empty (&caller->queue) && caller->backlogged) {
+    srt_epoll_remove_usock (srtobject->sender_poll_id, caller->sock);
+    caller->backlogged = FALSE;
+    srtobject->n_backlogged--;
+  }
+
+  return TRUE;
+}
+
+/* Appends a message to the queue of the caller, applying the drop policy
+ * when the queue is full. Returns FALSE if the caller has to be
+ * disconnected. Called with sock_lock. */
+static gboolean
+srt_caller_queue_message (SRTCaller * caller, GstSRTObject * srtobject,
+    GBytes * msg)
+{
+  if (g_queue_get_length (&caller->queue) >= srtobject->caller_queue_size) {
+    GBytes *oldest;
+
+    if (srtobject->caller_drop_policy == GST_SRT_CALLER_DROP_POLICY_DISCONNECT) {
+      GST_WARNING_OBJECT (srtobject->element,
+          "Queue of caller %d is full, disconnecting", caller->sock);
+      g_bytes_unref (msg);
+      return FALSE;
+    }
+
+    oldest = g_queue_pop_head (&caller->queue);
+    caller->queued_bytes -= g_bytes_get_size (oldest);
+    caller->dropped_messages++;
+    g_bytes_unref (oldest);
+
+    GST_LOG_OBJECT (srtobject->element, "Queue of caller %d is full, dropped "
+        "oldest message", caller->sock);
+  }
+
+  caller->queued_bytes += g_bytes_get_size (msg);
+  g_queue_push_tail (&caller->queue, msg);
+
+  return TRUE;
+}
+
+static gpointer
+sender_thread_func (gpointer data)
+{
+  GstSRTObject *srtobject = data;
+
+  g_mutex_lock (&srtobject->sock_lock);
+
+  while (srtobject->sender_running) {
+    SRTSOCKET wsocks[16];
+    gint wsocklen = G_N_ELEMENTS (wsocks);
+    GList *item;
+    gint ret;
+
+    if (srtobject->n_backlogged == 0) {
+      g_cond_wait (&srtobject->sender_cond, &srtobject->sock_lock);
+      continue;
+    }
+
+    g_mutex_unlock (&srtobject->sock_lock);
+    ret = srt_epoll_wait (srtobject->sender_poll_id, NULL, NULL, wsocks,
+        &wsocklen, SENDER_POLL_TIMEOUT, NULL, 0, NULL, 0);
+    g_mutex_lock (&srtobject->sock_lock);
+
+    if (ret < 0)
+      continue;
+
+    item = srtobject->callers;
+    while (item != NULL) {
+      SRTCaller *caller = item->data;
+      item = item->next;
+
+      if (!caller->backlogged)
+        continue;
+
+      if (!srt_caller_flush_queue (caller, srtobject))
+        gst_srt_object_remove_caller (srtobject, caller);
+    }
+  }
+
+  g_mutex_unlock (&srtobject->sock_lock);
+
+  return NULL;
+}
+
+/* called with sock_lock */
+static gboolean
+gst_srt_object_start_sender (GstSRTObject * srtobject, GError ** error)
+{
+  if (srtobject->sender_thread)
+    return TRUE;
+
+  srtobject->sender_poll_id = srt_epoll_create ();
+  if (srtobject->sender_poll_id == SRT_ERROR) {
+    g_set_error (error, GST_LIBRARY_ERROR, GST_LIBRARY_ERROR_INIT, "%s",
+        srt_getlasterror_str ());
+    return FALSE;
+  }
+
+  srtobject->sender_running = TRUE;
+  srtobject->sender_thread =
+      g_thread_try_new ("GstSRTObjectSender", sender_thread_func, srtobject,
+      error);
+
+  if (srtobject->sender_thread == NULL) {
+    srtobject->sender_running = FALSE;
+    srt_epoll_release (srtobject->sender_poll_id);
+    srtobject->sender_poll_id = SRT_ERROR;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 struct srt_constant_params
 {
   const gchar *name;
@@ -224,8 +406,12 @@ gst_srt_object_new (GstElement * element)
   srtobject->listener_poll_id = SRT_ERROR;
   srtobject->sent_headers = FALSE;
   srtobject->wait_for_connection = GST_SRT_DEFAULT_WAIT_FOR_CONNECTION;
+  srtobject->caller_queue_size = GST_SRT_DEFAULT_CALLER_QUEUE_SIZE;
+  srtobject->caller_drop_policy = GST_SRT_DEFAULT_CALLER_DROP_POLICY;
+  srtobject->sender_poll_id = SRT_ERROR;
 
   g_cond_init (&srtobject->sock_cond);
+  g_cond_init (&srtobject->sender_cond);
   return srtobject;
 }
 
@@ -240,6 +426,7 @@ gst_srt_object_destroy (GstSRTObject * srtobject)
   }
 
   g_cond_clear (&srtobject->sock_cond);
+  g_cond_clear (&srtobject->sender_cond);
 
   GST_DEBUG_OBJECT (srtobject->element, "Destroying srtobject");
   gst_structure_free (srtobject->parameters);
@@ -294,6 +481,12 @@ gst_srt_object_set_property_helper (GstSRTObject * srtobject,
     case PROP_STREAMID:
       gst_structure_set_value (srtobject->parameters, "streamid", value);
       break;
+    case PROP_CALLER_QUEUE_SIZE:
+      srtobject->caller_queue_size = g_value_get_uint (value);
+      break;
+    case PROP_CALLER_DROP_POLICY:
+      srtobject->caller_drop_policy = g_value_get_enum (value);
+      break;
     default:
       goto err;
   }
@@ -378,6 +571,12 @@ gst_srt_object_get_property_helper (GstSRTObject * srtobject,
           gst_structure_get_string (srtobject->parameters, "streamid"));
       break;
     }
+    case PROP_CALLER_QUEUE_SIZE:
+      g_value_set_uint (value, srtobject->caller_queue_size);
+      break;
+    case PROP_CALLER_DROP_POLICY:
+      g_value_set_enum (value, srtobject->caller_drop_policy);
+      break;
     default:
       goto err;
   }
@@ -529,6 +728,45 @@ gst_srt_object_install_properties_helper (GObjectClass * gobject_class)
           G_PARAM_STATIC_STRINGS));
 }
 
+/* Properties that only make sense for srtsink */
+void
+gst_srt_object_install_sink_properties_helper (GObjectClass * gobject_class)
+{
+  /**
+   * GstSRTSink:caller-queue-size:
+   *
+   * In listener mode, the maximum number of messages queued for each
+   * caller. When non-zero, every caller gets its own send queue which is
+   * serviced by a dedicated thread, so a slow caller does not block the
+   * stream for the other callers. When 0, the data is sent synchronously to
+   * all callers.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_CALLER_QUEUE_SIZE,
+      g_param_spec_uint ("caller-queue-size", "Caller queue size",
+          "Maximum number of messages queued per caller in listener mode "
+          "(0 = send synchronously)", 0, G_MAXUINT,
+          GST_SRT_DEFAULT_CALLER_QUEUE_SIZE,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstSRTSink:caller-drop-policy:
+   *
+   * What to do when the queue of a caller is full, see
+   * #GstSRTSink:caller-queue-size.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_CALLER_DROP_POLICY,
+      g_param_spec_enum ("caller-drop-policy", "Caller drop policy",
+          "What to do when the queue of a caller is full",
+          GST_TYPE_SRT_CALLER_DROP_POLICY, GST_SRT_DEFAULT_CALLER_DROP_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  gst_type_mark_as_plugin_api (GST_TYPE_SRT_CALLER_DROP_POLICY, 0);
+}
+
 static void
 gst_srt_object_set_enum_value (GstStructure * s, GType enum_type,
     gconstpointer key, gconstpointer value)
@@ -1124,6 +1362,21 @@ gst_srt_object_close (GstSRTObject * srtobject)
     g_mutex_lock (&srtobject->sock_lock);
   }
 
+  if (srtobject->sender_thread) {
+    GThread *thread = g_steal_pointer (&srtobject->sender_thread);
+    srtobject->sender_running = FALSE;
+    g_cond_signal (&srtobject->sender_cond);
+    g_mutex_unlock (&srtobject->sock_lock);
+    g_thread_join (thread);
+    g_mutex_lock (&srtobject->sock_lock);
+  }
+
+  if (srtobject->sender_poll_id != SRT_ERROR) {
+    srt_epoll_release (srtobject->sender_poll_id);
+    srtobject->sender_poll_id = SRT_ERROR;
+  }
+  srtobject->n_backlogged = 0;
+
   if (srtobject->listener_sock != SRT_INVALID_SOCK) {
     GST_DEBUG_OBJECT (srtobject->element, "Closing SRT listener socket (0x%x)",
         srtobject->listener_sock);
@@ -1175,19 +1428,17 @@ gst_srt_object_wait_caller (GstSRTObject * srtobject,
   return ret;
 }
 
-gssize
-gst_srt_object_read (GstSRTObject * srtobject,
-    guint8 * data, gsize size, GCancellable * cancellable, GError ** error)
+/* Waits until a connected socket has data to read. Returns 1 with the
+ * socket in @rsock_out, 0 when the connection is gone or the wait was
+ * cancelled and -1 on error. */
+static gint
+gst_srt_object_wait_readable (GstSRTObject * srtobject,
+    GCancellable * cancellable, SRTSOCKET * rsock_out, GError ** error)
 {
-  gssize len = 0;
   gint poll_timeout;
   GstSRTConnectionMode connection_mode = GST_SRT_CONNECTION_MODE_NONE;
   gint poll_id = SRT_ERROR;
 
-  /* Only source element can read data */
-  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
-          (srtobject->element)) == GST_URI_SRC, -1);
-
   GST_OBJECT_LOCK (srtobject->element);
 
   gst_structure_get_enum (srtobject->parameters, "mode",
@@ -1264,7 +1515,27 @@ gst_srt_object_read (GstSRTObject * srtobject,
         continue;
     }
 
+    *rsock_out = rsock;
+    return 1;
+  }
+
+  return 0;
+}
+
+gssize
+gst_srt_object_read (GstSRTObject * srtobject,
+    guint8 * data, gsize size, GCancellable * cancellable, GError ** error)
+{
+  SRTSOCKET rsock;
+  gssize len;
+  gint ret;
+
+  /* Only source element can read data */
+  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SRC, -1);
 
+  while ((ret = gst_srt_object_wait_readable (srtobject, cancellable, &rsock,
+              error)) > 0) {
     len = srt_recvmsg (rsock, (char *) (data), size);
 
     if (len == SRT_ERROR) {
@@ -1277,12 +1548,114 @@ gst_srt_object_read (GstSRTObject * srtobject,
         return -1;
       }
     }
-    break;
+
+    return len;
   }
 
+  return ret;
+}
+
+/* Receives one message from @rsock into a buffer of @pool, which is sized
+ * to the message. Returns the length of the message, 0 or SRT_ERROR if
+ * nothing was received, and -2 if no buffer could be acquired. */
+static gssize
+gst_srt_object_recv_buffer (GstSRTObject * srtobject, SRTSOCKET rsock,
+    GstBufferPool * pool, GstBuffer ** buffer)
+{
+  GstMapInfo info;
+  gssize len;
+
+  *buffer = NULL;
+
+  if (gst_buffer_pool_acquire_buffer (pool, buffer, NULL) != GST_FLOW_OK)
+    return -2;
+
+  if (!gst_buffer_map (*buffer, &info, GST_MAP_WRITE)) {
+    gst_clear_buffer (buffer);
+    return -2;
+  }
+
+  len = srt_recvmsg (rsock, (char *) info.data, info.size);
+
+  gst_buffer_unmap (*buffer, &info);
+
+  if (len <= 0) {
+    gst_clear_buffer (buffer);
+    return len;
+  }
+
+  gst_buffer_resize (*buffer, 0, len);
+
   return len;
 }
 
+/* Reads at least one message, then drains every message that is already
+ * queued on the socket without waiting again. Each message is received into
+ * its own buffer from @pool, whose buffers have to be large enough for a
+ * message. Returns the number of buffers stored in @buffers, 0 when the
+ * connection is gone and -1 on error. */
+gint
+gst_srt_object_read_list (GstSRTObject * srtobject, GstBufferPool * pool,
+    GstBuffer ** buffers, guint max_messages, GCancellable * cancellable,
+    GError ** error)
+{
+  SRTSOCKET rsock;
+  gint n_messages = 0;
+  gsize total;
+  gssize len;
+  gint ret;
+
+  /* Only source element can read data */
+  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SRC, -1);
+  g_return_val_if_fail (max_messages > 0, -1);
+
+  while ((ret = gst_srt_object_wait_readable (srtobject, cancellable, &rsock,
+              error)) > 0) {
+    len = gst_srt_object_recv_buffer (srtobject, rsock, pool, &buffers[0]);
+
+    if (len == -2) {
+      g_set_error (error, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_READ,
+          "Failed to acquire a buffer");
+      return -1;
+    } else if (len == SRT_ERROR) {
+      gint srt_errno = srt_getlasterror (NULL);
+      if (srt_errno == SRT_EASYNCRCV) {
+        continue;
+      } else {
+        g_set_error (error, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_READ,
+            "Failed to receive from SRT socket: %s", srt_getlasterror_str ());
+        return -1;
+      }
+    } else if (len == 0) {
+      return 0;
+    }
+
+    n_messages = 1;
+    total = len;
+
+    /* The socket is non-blocking, keep reading until it would block so that
+     * a single wakeup delivers everything that arrived meanwhile. Errors are
+     * left for the next call, which checks the socket state after polling. */
+    while (n_messages < max_messages) {
+      len = gst_srt_object_recv_buffer (srtobject, rsock, pool,
+          &buffers[n_messages]);
+      if (len <= 0)
+        break;
+
+      n_messages++;
+      total += len;
+    }
+
+    GST_LOG_OBJECT (srtobject->element, "read %d messages, %" G_GSIZE_FORMAT
+        " bytes", n_messages, total);
+
+    return n_messages;
+  }
+
+  return ret;
+}
+
 void
 gst_srt_object_wakeup (GstSRTObject * srtobject, GCancellable * cancellable)
 {
@@ -1356,20 +1729,33 @@ gst_srt_object_send_headers (GstSRTObject * srtobject, SRTSOCKET sock,
   return TRUE;
 }
 
+static gsize
+gst_srt_object_messages_size (const GstMapInfo * maps, guint n_maps)
+{
+  gsize size = 0;
+  guint i;
+
+  for (i = 0; i < n_maps; i++)
+    size += maps[i].size;
+
+  return size;
+}
+
+/* The @n_maps messages in @maps are sent separately, a message larger than
+ * the payload size is split over several SRT messages */
 static gssize
 gst_srt_object_write_to_callers (GstSRTObject * srtobject,
-    GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+    GstBufferList * headers, const GstMapInfo * maps, guint n_maps,
+    GCancellable * cancellable, GError ** error)
 {
   GList *callers;
 
   g_mutex_lock (&srtobject->sock_lock);
   callers = srtobject->callers;
   while (callers != NULL) {
-    gssize len = 0;
-    const guint8 *msg = mapinfo->data;
     gint sent;
     gint payload_size, optlen = 1;
+    guint i;
 
     SRTCaller *caller = callers->data;
     callers = callers->next;
@@ -1392,42 +1778,172 @@ gst_srt_object_write_to_callers (GstSRTObject * srtobject,
       goto err;
     }
 
-    while (len < mapinfo->size) {
-      gint rest = MIN (mapinfo->size - len, payload_size);
-      sent = srt_sendmsg2 (caller->sock, (char *) (msg + len), rest, 0);
-      if (sent < 0) {
-        GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
-            caller->sock, srt_getlasterror_str ());
-        goto err;
+    for (i = 0; i < n_maps; i++) {
+      const guint8 *msg = maps[i].data;
+      gsize len = 0;
+
+      while (len < maps[i].size) {
+        gint rest = MIN (maps[i].size - len, payload_size);
+        sent = srt_sendmsg2 (caller->sock, (char *) (msg + len), rest, 0);
+        if (sent < 0) {
+          GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
+              caller->sock, srt_getlasterror_str ());
+          goto err;
+        }
+        len += sent;
       }
-      len += sent;
     }
 
     continue;
 
   err:
-    srtobject->callers = g_list_remove (srtobject->callers, caller);
-    srt_caller_signal_removed (caller, srtobject);
-    srt_caller_free (caller);
+    gst_srt_object_remove_caller (srtobject, caller);
   }
 
   g_mutex_unlock (&srtobject->sock_lock);
-  return mapinfo->size;
+  return gst_srt_object_messages_size (maps, n_maps);
 
 cancelled:
   g_mutex_unlock (&srtobject->sock_lock);
   return -1;
 }
 
+/* called with sock_lock */
+static gboolean
+srt_caller_queue_headers (SRTCaller * caller, GstSRTObject * srtobject,
+    GstBufferList * headers)
+{
+  guint size, i;
+
+  if (!headers)
+    return TRUE;
+
+  size = gst_buffer_list_length (headers);
+
+  GST_DEBUG_OBJECT (srtobject->element, "Queuing %u stream headers", size);
+
+  for (i = 0; i < size; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (headers, i);
+    GstMapInfo mapinfo;
+    GBytes *msg;
+
+    if (!gst_buffer_map (buffer, &mapinfo, GST_MAP_READ)) {
+      GST_ELEMENT_ERROR (srtobject->element, RESOURCE, READ,
+          ("Could not map the input stream"), (NULL));
+      return FALSE;
+    }
+
+    msg = g_bytes_new (mapinfo.data, mapinfo.size);
+    gst_buffer_unmap (buffer, &mapinfo);
+
+    if (!srt_caller_queue_message (caller, srtobject, msg))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Same as gst_srt_object_write_to_callers() but the messages are appended to
+ * the queue of each caller, which is sent as far as possible without
+ * blocking. The rest is sent by the sender thread. Each message is copied
+ * once and shared by all the queues. */
+static gssize
+gst_srt_object_queue_to_callers (GstSRTObject * srtobject,
+    GstBufferList * headers, const GstMapInfo * maps, guint n_maps,
+    GCancellable * cancellable, GError ** error)
+{
+  GList *callers;
+  GBytes **bytes;
+  gssize ret;
+  guint i;
+
+  g_mutex_lock (&srtobject->sock_lock);
+
+  if (!gst_srt_object_start_sender (srtobject, error)) {
+    g_mutex_unlock (&srtobject->sock_lock);
+    return -1;
+  }
+
+  bytes = g_new (GBytes *, n_maps);
+  for (i = 0; i < n_maps; i++)
+    bytes[i] = g_bytes_new (maps[i].data, maps[i].size);
+
+  ret = gst_srt_object_messages_size (maps, n_maps);
+
+  callers = srtobject->callers;
+  while (callers != NULL) {
+    gint payload_size, optlen = 1;
+
+    SRTCaller *caller = callers->data;
+    callers = callers->next;
+
+    if (g_cancellable_is_cancelled (cancellable)) {
+      goto cancelled;
+    }
+
+    if (!caller->sent_headers) {
+      if (!srt_caller_queue_headers (caller, srtobject, headers)) {
+        goto err;
+      }
+      caller->sent_headers = TRUE;
+    }
+
+    if (srt_getsockflag (caller->sock, SRTO_PAYLOADSIZE, &payload_size,
+            &optlen)) {
+      GST_WARNING_OBJECT (srtobject->element, "%s", srt_getlasterror_str ());
+      goto err;
+    }
+
+    for (i = 0; i < n_maps; i++) {
+      gsize size = g_bytes_get_size (bytes[i]);
+      gsize offset = 0;
+
+      while (offset < size) {
+        gsize rest = MIN (size - offset, payload_size);
+
+        if (!srt_caller_queue_message (caller, srtobject,
+                g_bytes_new_from_bytes (bytes[i], offset, rest))) {
+          goto err;
+        }
+        offset += rest;
+      }
+    }
+
+    if (!srt_caller_flush_queue (caller, srtobject)) {
+      goto err;
+    }
+
+    continue;
+
+  err:
+    gst_srt_object_remove_caller (srtobject, caller);
+  }
+
+out:
+  g_mutex_unlock (&srtobject->sock_lock);
+  for (i = 0; i < n_maps; i++)
+    g_bytes_unref (bytes[i]);
+  g_free (bytes);
+  return ret;
+
+cancelled:
+  ret = -1;
+  goto out;
+}
+
+/* Polls only before the first chunk and when the send buffer is full, the
+ * remaining chunks and messages of the same write go out back-to-back. */
 static gssize
 gst_srt_object_write_one (GstSRTObject * srtobject,
-    GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+    GstBufferList * headers, const GstMapInfo * maps, guint n_maps,
+    GCancellable * cancellable, GError ** error)
 {
-  gssize len = 0;
+  gssize total = 0;
   gint poll_timeout;
-  const guint8 *msg = mapinfo->data;
-  gint payload_size, optlen = 1;
+  gint payload_size = GST_SRT_DEFAULT_MSG_SIZE, optlen = 1;
+  SRTSOCKET wsock = SRT_INVALID_SOCK;
+  gboolean need_poll = TRUE;
+  guint i;
 
   GST_OBJECT_LOCK (srtobject->element);
   if (!gst_structure_get_int (srtobject->parameters, "poll-timeout",
@@ -1444,79 +1960,99 @@ gst_srt_object_write_one (GstSRTObject * srtobject,
     srtobject->sent_headers = TRUE;
   }
 
-  while (len < mapinfo->size) {
-    SRTSOCKET wsock;
-    gint wsocklen = 1;
+  for (i = 0; i < n_maps; i++) {
+    const guint8 *msg = maps[i].data;
+    gsize len = 0;
 
-    gint sent;
-    gint rest;
+    while (len < maps[i].size) {
+      gint sent;
+      gint rest;
 
-    if (g_cancellable_is_cancelled (cancellable)) {
-      break;
-    }
+      if (g_cancellable_is_cancelled (cancellable)) {
+        goto out;
+      }
 
-    if (srt_epoll_wait (srtobject->poll_id, 0, 0, &wsock,
-            &wsocklen, poll_timeout, NULL, 0, NULL, 0) < 0) {
-      continue;
-    }
+      if (need_poll) {
+        gint wsocklen = 1;
 
-    if (srt_getsockflag (wsock, SRTO_PAYLOADSIZE, &payload_size, &optlen)) {
-      GST_WARNING_OBJECT (srtobject->element, "%s", srt_getlasterror_str ());
-      break;
-    }
+        if (srt_epoll_wait (srtobject->poll_id, 0, 0, &wsock,
+                &wsocklen, poll_timeout, NULL, 0, NULL, 0) < 0) {
+          continue;
+        }
 
-    rest = MIN (mapinfo->size - len, payload_size);
+        switch (srt_getsockstate (wsock)) {
+          case SRTS_BROKEN:
+          case SRTS_NONEXIST:
+          case SRTS_CLOSED:
+            GST_WARNING_OBJECT (srtobject->element,
+                "Invalid SRT socket. Trying to reconnect");
+            gst_srt_object_close (srtobject);
+            if (!gst_srt_object_open_internal (srtobject, cancellable,
+                    error)) {
+              return -1;
+            }
+            continue;
+          case SRTS_CONNECTED:
+            /* good to go */
+            GST_LOG_OBJECT (srtobject->element, "good to go");
+            break;
+          default:
+            GST_WARNING_OBJECT (srtobject->element, "not ready");
+            /* not-ready */
+            continue;
+        }
 
-    switch (srt_getsockstate (wsock)) {
-      case SRTS_BROKEN:
-      case SRTS_NONEXIST:
-      case SRTS_CLOSED:
-        GST_WARNING_OBJECT (srtobject->element,
-            "Invalid SRT socket. Trying to reconnect");
-        gst_srt_object_close (srtobject);
-        if (!gst_srt_object_open_internal (srtobject, cancellable, error)) {
-          return -1;
+        if (srt_getsockflag (wsock, SRTO_PAYLOADSIZE, &payload_size,
+                &optlen)) {
+          GST_WARNING_OBJECT (srtobject->element, "%s",
+              srt_getlasterror_str ());
+          goto out;
         }
-        continue;
-      case SRTS_CONNECTED:
-        /* good to go */
-        GST_LOG_OBJECT (srtobject->element, "good to go");
-        break;
-      default:
-        GST_WARNING_OBJECT (srtobject->element, "not ready");
-        /* not-ready */
-        continue;
-    }
 
-    sent = srt_sendmsg2 (wsock, (char *) (msg + len), rest, 0);
-    if (sent < 0) {
-      GST_ELEMENT_ERROR (srtobject->element, RESOURCE, WRITE, NULL,
-          ("%s", srt_getlasterror_str ()));
-      break;
+        need_poll = FALSE;
+      }
+
+      rest = MIN (maps[i].size - len, payload_size);
+
+      sent = srt_sendmsg2 (wsock, (char *) (msg + len), rest, 0);
+      if (sent < 0) {
+        gint srt_errno = srt_getlasterror (NULL);
+
+        if (srt_errno == SRT_EASYNCSND || srt_errno == SRT_ECONNLOST) {
+          /* wait for room or let the state check above reconnect */
+          need_poll = TRUE;
+          continue;
+        }
+
+        GST_ELEMENT_ERROR (srtobject->element, RESOURCE, WRITE, NULL,
+            ("%s", srt_getlasterror_str ()));
+        goto out;
+      }
+      len += sent;
+      total += sent;
     }
-    len += sent;
   }
 
-  return len;
+out:
+  return total;
 }
 
-gssize
-gst_srt_object_write (GstSRTObject * srtobject,
-    GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+/* Writes @n_maps messages, with a single wait for the connection */
+static gssize
+gst_srt_object_write_messages (GstSRTObject * srtobject,
+    GstBufferList * headers, const GstMapInfo * maps, guint n_maps,
+    GCancellable * cancellable, GError ** error)
 {
   gssize len = 0;
   GstSRTConnectionMode connection_mode = GST_SRT_CONNECTION_MODE_NONE;
   gboolean wait_for_connection;
-
-  /* Only sink element can write data */
-  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
-          (srtobject->element)) == GST_URI_SINK, -1);
+  guint caller_queue_size;
 
   GST_OBJECT_LOCK (srtobject->element);
   gst_structure_get_enum (srtobject->parameters, "mode",
       GST_TYPE_SRT_CONNECTION_MODE, (gint *) & connection_mode);
   wait_for_connection = srtobject->wait_for_connection;
+  caller_queue_size = srtobject->caller_queue_size;
   GST_OBJECT_UNLOCK (srtobject->element);
 
   if (connection_mode == GST_SRT_CONNECTION_MODE_LISTENER) {
@@ -1524,18 +2060,130 @@ gst_srt_object_write (GstSRTObject * srtobject,
       if (!gst_srt_object_wait_caller (srtobject, cancellable, error))
         return -1;
     }
-    len =
-        gst_srt_object_write_to_callers (srtobject, headers, mapinfo,
-        cancellable, error);
+    if (caller_queue_size > 0)
+      len =
+          gst_srt_object_queue_to_callers (srtobject, headers, maps, n_maps,
+          cancellable, error);
+    else
+      len =
+          gst_srt_object_write_to_callers (srtobject, headers, maps, n_maps,
+          cancellable, error);
   } else {
     len =
-        gst_srt_object_write_one (srtobject, headers, mapinfo, cancellable,
-        error);
+        gst_srt_object_write_one (srtobject, headers, maps, n_maps,
+        cancellable, error);
   }
 
   return len;
 }
 
+gssize
+gst_srt_object_write (GstSRTObject * srtobject,
+    GstBufferList * headers,
+    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+{
+  /* Only sink element can write data */
+  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SINK, -1);
+
+  return gst_srt_object_write_messages (srtobject, headers, mapinfo, 1,
+      cancellable, error);
+}
+
+/* Sends the buffers of @list with a single poll and lock for the whole list.
+ * Consecutive buffers smaller than a message, such as single MPEG-TS
+ * packets, are packed into messages of up to GST_SRT_DEFAULT_MSG_SIZE bytes.
+ * Larger buffers are mapped and sent without copying them. Header buffers
+ * keep a message of their own, and are skipped when stream headers are in
+ * use as they are already sent on connection. */
+gssize
+gst_srt_object_write_list (GstSRTObject * srtobject,
+    GstBufferList * headers,
+    GstBufferList * list, GCancellable * cancellable, GError ** error)
+{
+  GstBuffer **buffers;
+  GstMapInfo *maps;
+  guint8 *packed;
+  gsize packed_size = 0, packed_len = 0;
+  gboolean packing = FALSE;
+  guint i, n_buffers, n_maps = 0;
+  gssize len = 0;
+
+  /* Only sink element can write data */
+  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SINK, -1);
+
+  n_buffers = gst_buffer_list_length (list);
+  /* packed messages have no buffer */
+  buffers = g_new0 (GstBuffer *, n_buffers);
+  maps = g_new0 (GstMapInfo, n_buffers);
+
+  for (i = 0; i < n_buffers; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+    gsize size = gst_buffer_get_size (buffer);
+
+    if (size < GST_SRT_DEFAULT_MSG_SIZE &&
+        !GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_HEADER))
+      packed_size += size;
+  }
+  packed = g_malloc (packed_size);
+
+  for (i = 0; i < n_buffers; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+    gsize size = gst_buffer_get_size (buffer);
+    gboolean is_header = GST_BUFFER_FLAG_IS_SET (buffer,
+        GST_BUFFER_FLAG_HEADER);
+
+    if (headers && is_header)
+      continue;
+
+    if (size == 0)
+      continue;
+
+    if (size >= GST_SRT_DEFAULT_MSG_SIZE || is_header) {
+      if (!gst_buffer_map (buffer, &maps[n_maps], GST_MAP_READ)) {
+        GST_ELEMENT_ERROR (srtobject->element, RESOURCE, READ,
+            ("Could not map the input stream"), (NULL));
+        len = -1;
+        goto out;
+      }
+      buffers[n_maps++] = buffer;
+      packing = FALSE;
+      continue;
+    }
+
+    /* start a new message when the buffer doesn't fit in the current one */
+    if (!packing || maps[n_maps - 1].size + size > GST_SRT_DEFAULT_MSG_SIZE) {
+      maps[n_maps].data = packed + packed_len;
+      maps[n_maps].size = 0;
+      n_maps++;
+      packing = TRUE;
+    }
+
+    gst_buffer_extract (buffer, 0, packed + packed_len, size);
+    packed_len += size;
+    maps[n_maps - 1].size += size;
+  }
+
+  GST_LOG_OBJECT (srtobject->element, "sending %u buffers as %u messages",
+      n_buffers, n_maps);
+
+  if (n_maps > 0)
+    len = gst_srt_object_write_messages (srtobject, headers, maps, n_maps,
+        cancellable, error);
+
+out:
+  for (i = 0; i < n_maps; i++) {
+    if (buffers[i])
+      gst_buffer_unmap (buffers[i], &maps[i]);
+  }
+  g_free (packed);
+  g_free (maps);
+  g_free (buffers);
+
+  return len;
+}
+
 static GstStructure *
 get_stats_for_srtsock (SRTSOCKET srtsock, gboolean is_sender, guint64 * bytes)
 {
@@ -1629,6 +2277,17 @@ gst_srt_object_get_stats (GstSRTObject * srtobject)
 
       tmp = get_stats_for_srtsock (caller->sock, is_sender, &bytes);
 
+      if (is_sender && srtobject->caller_queue_size > 0) {
+        gst_structure_set (tmp,
+            /* messages waiting in the send queue of the caller */
+            "queued-messages", G_TYPE_UINT,
+            g_queue_get_length (&caller->queue),
+            /* bytes waiting in the send queue of the caller */
+            "queued-bytes", G_TYPE_UINT64, (guint64) caller->queued_bytes,
+            /* messages dropped because the queue was full */
+            "dropped-messages", G_TYPE_UINT64, caller->dropped_messages, NULL);
+      }
+
       g_value_array_append (callers_stats, NULL);
       v = g_value_array_get_nth (callers_stats, callers_stats->n_values - 1);
       g_value_init (v, GST_TYPE_STRUCTURE);
@@ -42,6 +42,8 @@ G_BEGIN_DECLS
 #define GST_SRT_DEFAULT_LATENCY 125
 #define GST_SRT_DEFAULT_MSG_SIZE 1316
 #define GST_SRT_DEFAULT_WAIT_FOR_CONNECTION (TRUE)
+#define GST_SRT_DEFAULT_CALLER_QUEUE_SIZE 0
+#define GST_SRT_DEFAULT_CALLER_DROP_POLICY GST_SRT_CALLER_DROP_POLICY_DROP_OLDEST
 
 typedef struct _GstSRTObject GstSRTObject;
 
@@ -72,6 +74,16 @@ struct _GstSRTObject
 
   gboolean                     wait_for_connection;
 
+  /* Send queues of the callers, serviced by the sender thread, protected by
+   * sock_lock */
+  guint                        caller_queue_size;
+  GstSRTCallerDropPolicy       caller_drop_policy;
+  GThread                      *sender_thread;
+  gint                          sender_poll_id;
+  gboolean                      sender_running;
+  guint                         n_backlogged;
+  GCond                         sender_cond;
+
   guint64                      previous_bytes;
 };
 
@@ -95,6 +107,8 @@ gboolean        gst_srt_object_get_property_helper (GstSRTObject *srtobject,
 
 void            gst_srt_object_install_properties_helper (GObjectClass *gobject_class);
 
+void            gst_srt_object_install_sink_properties_helper (GObjectClass *gobject_class);
+
 gboolean        gst_srt_object_set_uri (GstSRTObject * srtobject, const gchar *uri, GError ** err);
 
 gssize          gst_srt_object_read     (GstSRTObject * srtobject,
@@ -102,12 +116,25 @@ gssize          gst_srt_object_read     (GstSRTObject * srtobject,
                                          GCancellable *cancellable,
                                          GError **err);
 
+gint            gst_srt_object_read_list (GstSRTObject * srtobject,
+                                          GstBufferPool * pool,
+                                          GstBuffer ** buffers,
+                                          guint max_messages,
+                                          GCancellable *cancellable,
+                                          GError **err);
+
 gssize          gst_srt_object_write    (GstSRTObject * srtobject,
                                          GstBufferList * headers,
                                          const GstMapInfo * mapinfo,
                                          GCancellable *cancellable,
                                          GError **err);
 
+gssize          gst_srt_object_write_list (GstSRTObject * srtobject,
+                                           GstBufferList * headers,
+                                           GstBufferList * list,
+                                           GCancellable *cancellable,
+                                           GError **err);
+
 void            gst_srt_object_wakeup   (GstSRTObject * srtobject,
                                          GCancellable *cancellable);
 
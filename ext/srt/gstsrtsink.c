@@ -36,6 +36,11 @@
  * gst-launch-1.0 -v audiotestsrc ! srtsink uri=srt://:port
  * ]| This pipeline shows how to wait SRT callers.
  *
+ * |[
+ * gst-launch-1.0 -v videotestsrc ! x264enc ! mpegtsmux ! srtsink uri=srt://:port caller-queue-size=1000 caller-drop-policy=drop-oldest
+ * ]| This pipeline shows how to serve many SRT callers, where a slow caller
+ * loses data instead of blocking the stream for the others.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -196,6 +201,31 @@ gst_srt_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   return ret;
 }
 
+static GstFlowReturn
+gst_srt_sink_render_list (GstBaseSink * sink, GstBufferList * list)
+{
+  GstSRTSink *self = GST_SRT_SINK (sink);
+  GError *error = NULL;
+
+  if (g_cancellable_is_cancelled (self->cancellable))
+    return GST_FLOW_FLUSHING;
+
+  GST_TRACE_OBJECT (self, "sending list of %u buffers",
+      gst_buffer_list_length (list));
+
+  if (gst_srt_object_write_list (self->srtobject, self->headers, list,
+          self->cancellable, &error) < 0) {
+    if (error) {
+      GST_ELEMENT_ERROR (self, RESOURCE, WRITE, (NULL), ("%s",
+              error->message));
+      g_clear_error (&error);
+    }
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
 static gboolean
 gst_srt_sink_unlock (GstBaseSink * bsink)
 {
@@ -305,6 +335,7 @@ gst_srt_sink_class_init (GstSRTSinkClass * klass)
       2, G_TYPE_INT, G_TYPE_SOCKET_ADDRESS);
 
   gst_srt_object_install_properties_helper (gobject_class);
+  gst_srt_object_install_sink_properties_helper (gobject_class);
 
   gst_element_class_add_static_pad_template (gstelement_class, &sink_template);
   gst_element_class_set_metadata (gstelement_class,
@@ -315,6 +346,8 @@ gst_srt_sink_class_init (GstSRTSinkClass * klass)
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_srt_sink_start);
   gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_srt_sink_stop);
   gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_srt_sink_render);
+  gstbasesink_class->render_list =
+      GST_DEBUG_FUNCPTR (gst_srt_sink_render_list);
   gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_srt_sink_unlock);
   gstbasesink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_srt_sink_unlock_stop);
   gstbasesink_class->set_caps = GST_DEBUG_FUNCPTR (gst_srt_sink_set_caps);
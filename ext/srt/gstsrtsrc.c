@@ -55,6 +55,9 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
 #define GST_CAT_DEFAULT gst_debug_srt_src
 GST_DEBUG_CATEGORY (GST_CAT_DEFAULT);
 
+/* Maximum number of messages pushed as one buffer list per wakeup */
+#define GST_SRT_SRC_MAX_MESSAGES 32
+
 enum
 {
   SIG_CALLER_ADDED,
@@ -107,61 +110,150 @@ gst_srt_src_stop (GstBaseSrc * bsrc)
 
   gst_srt_object_close (self->srtobject);
 
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_clear_object (&self->pool);
+  }
+
+  return TRUE;
+}
+
+/* Each message is received into its own pooled buffer, so that the buffers
+ * pushed downstream only hold on to the memory of their message */
+static gboolean
+gst_srt_src_ensure_pool (GstSRTSrc * self)
+{
+  GstStructure *config;
+  guint size;
+
+  /* Large enough for a live mode message whatever the blocksize */
+  size = gst_base_src_get_blocksize (GST_BASE_SRC (self));
+  size = MAX (size, SRT_LIVE_MAX_PLSIZE);
+
+  if (self->pool) {
+    guint pool_size;
+
+    config = gst_buffer_pool_get_config (self->pool);
+    gst_buffer_pool_config_get_params (config, NULL, &pool_size, NULL, NULL);
+    gst_structure_free (config);
+
+    if (pool_size == size)
+      return TRUE;
+
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_clear_object (&self->pool);
+  }
+
+  self->pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (self->pool);
+  gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+
+  if (!gst_buffer_pool_set_config (self->pool, config) ||
+      !gst_buffer_pool_set_active (self->pool, TRUE)) {
+    gst_clear_object (&self->pool);
+    return FALSE;
+  }
+
   return TRUE;
 }
 
+/* basesrc only timestamps the first buffer of a list, so the messages
+ * drained by one read all get the running time they were received at */
+static void
+gst_srt_src_timestamp_messages (GstSRTSrc * self, GstBuffer ** buffers,
+    gint n_messages)
+{
+  GstClock *clock;
+  GstClockTime base_time, now, running_time;
+  gint i;
+
+  if (!gst_base_src_get_do_timestamp (GST_BASE_SRC (self)))
+    return;
+
+  clock = gst_element_get_clock (GST_ELEMENT (self));
+  if (!clock)
+    return;
+
+  base_time = gst_element_get_base_time (GST_ELEMENT (self));
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+
+  running_time = now > base_time ? now - base_time : 0;
+
+  for (i = 0; i < n_messages; i++) {
+    GST_BUFFER_PTS (buffers[i]) = running_time;
+    GST_BUFFER_DTS (buffers[i]) = running_time;
+  }
+}
+
 static GstFlowReturn
-gst_srt_src_fill (GstPushSrc * src, GstBuffer * outbuf)
+gst_srt_src_create (GstPushSrc * src, GstBuffer ** outbuf)
 {
   GstSRTSrc *self = GST_SRT_SRC (src);
+  GstBaseSrc *bsrc = GST_BASE_SRC (src);
   GstFlowReturn ret = GST_FLOW_OK;
-  GstMapInfo info;
+  GstBuffer *buffers[GST_SRT_SRC_MAX_MESSAGES];
   GError *err = NULL;
-  gssize recv_len;
+  gint n_messages;
 
   if (g_cancellable_is_cancelled (self->cancellable)) {
-    ret = GST_FLOW_FLUSHING;
+    return GST_FLOW_FLUSHING;
   }
 
-  if (!gst_buffer_map (outbuf, &info, GST_MAP_WRITE)) {
+  if (!gst_srt_src_ensure_pool (self)) {
     GST_ELEMENT_ERROR (src, RESOURCE, READ,
-        ("Could not map the buffer for writing "), (NULL));
-    ret = GST_FLOW_ERROR;
-    goto out;
+        ("Could not create a buffer pool"), (NULL));
+    return GST_FLOW_ERROR;
   }
 
-  recv_len = gst_srt_object_read (self->srtobject, info.data,
-      gst_buffer_get_size (outbuf), self->cancellable, &err);
-
-  gst_buffer_unmap (outbuf, &info);
+  n_messages = gst_srt_object_read_list (self->srtobject, self->pool,
+      buffers, GST_SRT_SRC_MAX_MESSAGES, self->cancellable, &err);
 
   if (g_cancellable_is_cancelled (self->cancellable)) {
     ret = GST_FLOW_FLUSHING;
     goto out;
   }
 
-  if (recv_len < 0) {
+  if (n_messages < 0) {
     GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), ("%s", err->message));
-    ret = GST_FLOW_ERROR;
     g_clear_error (&err);
-    goto out;
-  } else if (recv_len == 0) {
-    ret = GST_FLOW_EOS;
-    goto out;
+    return GST_FLOW_ERROR;
+  } else if (n_messages == 0) {
+    return GST_FLOW_EOS;
   }
 
-  gst_buffer_resize (outbuf, 0, recv_len);
+  if (n_messages == 1) {
+    *outbuf = buffers[0];
+
+    GST_LOG_OBJECT (src,
+        "filled buffer from _get of size %" G_GSIZE_FORMAT ", ts %"
+        GST_TIME_FORMAT ", dur %" GST_TIME_FORMAT
+        ", offset %" G_GINT64_FORMAT ", offset_end %" G_GINT64_FORMAT,
+        gst_buffer_get_size (*outbuf),
+        GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (*outbuf)),
+        GST_TIME_ARGS (GST_BUFFER_DURATION (*outbuf)),
+        GST_BUFFER_OFFSET (*outbuf), GST_BUFFER_OFFSET_END (*outbuf));
+  } else {
+    GstBufferList *list = gst_buffer_list_new_sized (n_messages);
+    gint i;
+
+    gst_srt_src_timestamp_messages (self, buffers, n_messages);
+
+    for (i = 0; i < n_messages; i++)
+      gst_buffer_list_add (list, buffers[i]);
+
+    GST_LOG_OBJECT (src, "received %d messages, %" G_GSIZE_FORMAT " bytes",
+        n_messages, gst_buffer_list_calculate_size (list));
+
+    gst_base_src_submit_buffer_list (bsrc, list);
+  }
 
-  GST_LOG_OBJECT (src,
-      "filled buffer from _get of size %" G_GSIZE_FORMAT ", ts %"
-      GST_TIME_FORMAT ", dur %" GST_TIME_FORMAT
-      ", offset %" G_GINT64_FORMAT ", offset_end %" G_GINT64_FORMAT,
-      gst_buffer_get_size (outbuf),
-      GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (outbuf)),
-      GST_TIME_ARGS (GST_BUFFER_DURATION (outbuf)),
-      GST_BUFFER_OFFSET (outbuf), GST_BUFFER_OFFSET_END (outbuf));
+  return GST_FLOW_OK;
 
 out:
+  while (n_messages > 0)
+    gst_buffer_unref (buffers[--n_messages]);
+  g_clear_error (&err);
   return ret;
 }
 
@@ -286,7 +378,7 @@ gst_srt_src_class_init (GstSRTSrcClass * klass)
   gstbasesrc_class->unlock = GST_DEBUG_FUNCPTR (gst_srt_src_unlock);
   gstbasesrc_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_srt_src_unlock_stop);
 
-  gstpushsrc_class->fill = GST_DEBUG_FUNCPTR (gst_srt_src_fill);
+  gstpushsrc_class->create = GST_DEBUG_FUNCPTR (gst_srt_src_create);
 }
 
 static GstURIType
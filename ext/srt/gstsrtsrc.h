@@ -49,6 +49,7 @@ struct _GstSRTSrc {
 
   GstSRTObject *srtobject;
   GCancellable *cancellable;
+  GstBufferPool *pool;
 };
 
 struct _GstSRTSrcClass {
@@ -207,6 +207,10 @@ static GstFlowReturn gst_srtp_dec_chain_rtp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstFlowReturn gst_srtp_dec_chain_rtcp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static GstFlowReturn gst_srtp_dec_chain_list_rtp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
+static GstFlowReturn gst_srtp_dec_chain_list_rtcp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
 
 static GstStateChangeReturn gst_srtp_dec_change_state (GstElement * element,
     GstStateChange transition);
@@ -379,6 +383,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtp));
   gst_pad_set_chain_function (filter->rtp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtp));
+  gst_pad_set_chain_list_function (filter->rtp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtp));
 
   filter->rtp_srcpad =
       gst_pad_new_from_static_template (&rtp_src_template, "rtp_src");
@@ -402,6 +408,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtcp));
   gst_pad_set_chain_function (filter->rtcp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtcp));
+  gst_pad_set_chain_list_function (filter->rtcp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtcp));
 
   filter->rtcp_srcpad =
       gst_pad_new_from_static_template (&rtcp_src_template, "rtcp_src");
@@ -1314,20 +1322,22 @@ gst_srtp_dec_push_early_events (GstSrtpDec * filter, GstPad * pad,
 /*
  * This function should be called while holding the filter lock
  */
+/* The packet is decrypted in place, @buf is replaced by a writable buffer */
 static gboolean
-gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad, GstBuffer * buf,
-    gboolean is_rtcp, guint32 ssrc)
+gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad,
+    GstBuffer ** bufptr, gboolean is_rtcp, guint32 ssrc)
 {
   GstMapInfo map;
   srtp_err_status_t err;
   gint size;
+  GstBuffer *buf;
 
   GST_LOG_OBJECT (pad, "Received %s buffer of size %" G_GSIZE_FORMAT
-      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP", gst_buffer_get_size (buf),
-      ssrc);
+      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP",
+      gst_buffer_get_size (*bufptr), ssrc);
 
   /* Change buffer to remove protection */
-  buf = gst_buffer_make_writable (buf);
+  buf = *bufptr = gst_buffer_make_writable (*bufptr);
 
   gst_buffer_map (buf, &map, GST_MAP_READWRITE);
   size = map.size;
@@ -1468,7 +1478,7 @@ gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
     goto push_out;
   }
 
-  if (!gst_srtp_dec_decode_buffer (filter, pad, buf, is_rtcp, ssrc)) {
+  if (!gst_srtp_dec_decode_buffer (filter, pad, &buf, is_rtcp, ssrc)) {
     GST_OBJECT_UNLOCK (filter);
     goto drop_buffer;
   }
@@ -1504,6 +1514,123 @@ drop_buffer:
   return ret;
 }
 
+typedef struct
+{
+  GstSrtpDec *filter;
+  GstPad *pad;
+  gboolean is_rtcp;
+  GstBufferList *rtp_list;
+  GstBufferList *rtcp_list;
+} DecodeListData;
+
+/* Takes the object lock for each buffer, like the single buffer path, so
+ * that key changes and other streams are not held off for a whole list */
+static gboolean
+decode_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+{
+  DecodeListData *data = user_data;
+  GstSrtpDec *filter = data->filter;
+  GstSrtpDecSsrcStream *stream;
+  GstBuffer *buf = *buffer;
+  gboolean is_rtcp = data->is_rtcp;
+  guint32 ssrc = 0;
+
+  /* the buffer is moved to one of the output lists */
+  *buffer = NULL;
+
+  GST_OBJECT_LOCK (filter);
+
+  if (!(stream = validate_buffer (filter, buf, &ssrc, &is_rtcp))) {
+    GST_OBJECT_UNLOCK (filter);
+    GST_WARNING_OBJECT (filter, "Invalid buffer, dropping");
+    gst_buffer_unref (buf);
+    return TRUE;
+  }
+
+  if (STREAM_HAS_CRYPTO (stream)) {
+    if (!gst_srtp_dec_decode_buffer (filter, data->pad, &buf, is_rtcp, ssrc)) {
+      GST_OBJECT_UNLOCK (filter);
+      gst_buffer_unref (buf);
+      return TRUE;
+    }
+
+    GST_OBJECT_UNLOCK (filter);
+
+    if (gst_srtp_get_soft_limit_reached ())
+      request_key_with_signal (filter, ssrc, SIGNAL_SOFT_LIMIT);
+  } else {
+    GST_OBJECT_UNLOCK (filter);
+  }
+
+  if (is_rtcp) {
+    if (!data->rtcp_list)
+      data->rtcp_list = gst_buffer_list_new ();
+    gst_buffer_list_add (data->rtcp_list, buf);
+  } else {
+    if (!data->rtp_list)
+      data->rtp_list = gst_buffer_list_new ();
+    gst_buffer_list_add (data->rtp_list, buf);
+  }
+
+  return TRUE;
+}
+
+/* Decodes the packets of a list one by one, they are then pushed as one list
+ * per source pad */
+static GstFlowReturn
+gst_srtp_dec_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list, gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  GstFlowReturn ret = GST_FLOW_OK;
+  DecodeListData data = { filter, pad, is_rtcp, NULL, NULL };
+
+  GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
+      gst_buffer_list_length (buf_list));
+
+  buf_list = gst_buffer_list_make_writable (buf_list);
+
+  gst_buffer_list_foreach (buf_list, decode_buffer_it, &data);
+
+  gst_buffer_list_unref (buf_list);
+
+  if (data.rtp_list) {
+    if (!filter->rtp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
+          filter->rtcp_srcpad, FALSE);
+    ret = gst_pad_push_list (filter->rtp_srcpad, data.rtp_list);
+  }
+
+  if (data.rtcp_list) {
+    GstFlowReturn rtcp_ret;
+
+    if (!filter->rtcp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
+          filter->rtp_srcpad, TRUE);
+    rtcp_ret = gst_pad_push_list (filter->rtcp_srcpad, data.rtcp_list);
+
+    /* the flow of the pad the list came in on wins */
+    if (is_rtcp || !data.rtp_list)
+      ret = rtcp_ret;
+  }
+
+  return ret;
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, FALSE);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtcp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, TRUE);
+}
+
 static GstFlowReturn
 gst_srtp_dec_chain_rtp (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
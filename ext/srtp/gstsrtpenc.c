@@ -132,6 +132,13 @@ GST_DEBUG_CATEGORY_STATIC (gst_srtp_enc_debug);
 #define DEFAULT_REPLAY_WINDOW_SIZE 128
 #define DEFAULT_ALLOW_REPEAT_TX FALSE
 
+/* Room added to every protected packet for the authentication tag and MKI */
+#define TRAILER_SIZE (SRTP_MAX_TRAILER_LEN + 10)
+
+/* Size of the pooled output buffers, large enough for a packet of a common
+ * MTU. Larger packets are allocated separately. */
+#define POOL_BUFFER_SIZE (1500 + TRAILER_SIZE)
+
 #define HAS_CRYPTO(filter) (filter->rtp_cipher != GST_SRTP_CIPHER_NULL || \
       filter->rtcp_cipher != GST_SRTP_CIPHER_NULL ||                      \
       filter->rtp_auth != GST_SRTP_AUTH_NULL ||                           \
@@ -164,7 +171,6 @@ typedef struct ProcessBufferItData
 {
   GstSrtpEnc *filter;
   GstPad *pad;
-  GstBufferList *out_list;
   GstFlowReturn flowret;
   gboolean is_rtcp;
 } ProcessBufferItData;
@@ -206,6 +212,7 @@ G_DEFINE_TYPE (GstSrtpEnc, gst_srtp_enc, GST_TYPE_ELEMENT);
 static guint gst_srtp_enc_signals[LAST_SIGNAL] = { 0 };
 
 static void gst_srtp_enc_dispose (GObject * object);
+static void gst_srtp_enc_finalize (GObject * object);
 
 static void gst_srtp_enc_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -275,6 +282,7 @@ gst_srtp_enc_class_init (GstSrtpEncClass * klass)
   gobject_class->set_property = gst_srtp_enc_set_property;
   gobject_class->get_property = gst_srtp_enc_get_property;
   gobject_class->dispose = gst_srtp_enc_dispose;
+  gobject_class->finalize = gst_srtp_enc_finalize;
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_srtp_enc_request_new_pad);
   gstelement_class->release_pad = GST_DEBUG_FUNCPTR (gst_srtp_enc_release_pad);
@@ -360,6 +368,7 @@ gst_srtp_enc_init (GstSrtpEnc * filter)
   filter->replay_window_size = DEFAULT_REPLAY_WINDOW_SIZE;
   filter->allow_repeat_tx = DEFAULT_ALLOW_REPEAT_TX;
   filter->ssrcs_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+  g_mutex_init (&filter->session_lock);
 }
 
 static guint
@@ -467,7 +476,9 @@ gst_srtp_enc_create_session (GstSrtpEnc * filter)
   /* If it is the first stream, create the session
    * If not, add the stream to the session
    */
+  g_mutex_lock (&filter->session_lock);
   ret = srtp_create (&filter->session, &policy);
+  g_mutex_unlock (&filter->session_lock);
   filter->first_session = FALSE;
 
 #ifdef HAVE_SRTP2
@@ -489,6 +500,8 @@ done:
 static void
 gst_srtp_enc_reset_no_lock (GstSrtpEnc * filter)
 {
+  g_mutex_lock (&filter->session_lock);
+
   if (!filter->first_session) {
     if (filter->session) {
       srtp_dealloc (filter->session);
@@ -498,6 +511,13 @@ gst_srtp_enc_reset_no_lock (GstSrtpEnc * filter)
     g_hash_table_remove_all (filter->ssrcs_set);
   }
 
+  if (filter->pool) {
+    gst_buffer_pool_set_active (filter->pool, FALSE);
+    gst_clear_object (&filter->pool);
+  }
+
+  g_mutex_unlock (&filter->session_lock);
+
   filter->first_session = TRUE;
   filter->key_changed = FALSE;
 }
@@ -656,6 +676,21 @@ gst_srtp_enc_dispose (GObject * object)
   G_OBJECT_CLASS (gst_srtp_enc_parent_class)->dispose (object);
 }
 
+static void
+gst_srtp_enc_finalize (GObject * object)
+{
+  GstSrtpEnc *filter = GST_SRTP_ENC (object);
+
+  if (filter->pool) {
+    gst_buffer_pool_set_active (filter->pool, FALSE);
+    gst_object_unref (filter->pool);
+  }
+
+  g_mutex_clear (&filter->session_lock);
+
+  G_OBJECT_CLASS (gst_srtp_enc_parent_class)->finalize (object);
+}
+
 static GstStructure *
 gst_srtp_enc_create_stats (GstSrtpEnc * filter)
 {
@@ -668,6 +703,8 @@ gst_srtp_enc_create_stats (GstSrtpEnc * filter)
   g_value_init (&va, GST_TYPE_ARRAY);
   g_value_init (&v, GST_TYPE_STRUCTURE);
 
+  g_mutex_lock (&filter->session_lock);
+
   if (filter->session) {
     GHashTableIter iter;
     gpointer key;
@@ -692,6 +729,8 @@ gst_srtp_enc_create_stats (GstSrtpEnc * filter)
     }
   }
 
+  g_mutex_unlock (&filter->session_lock);
+
   gst_structure_take_value (s, "streams", &va);
   g_value_unset (&v);
 
@@ -1119,38 +1158,98 @@ gst_srtp_enc_ensure_ssrc (GstSrtpEnc * filter, GstBuffer * buf)
   }
 }
 
+/* Returns TRUE if the packet can be protected inside its own memory, i.e. the
+ * buffer is writable and its memory has room for the trailer */
+static gboolean
+gst_srtp_enc_can_protect_in_place (GstBuffer * buf)
+{
+  GstMemory *mem;
+
+  if (!gst_buffer_is_writable (buf) || gst_buffer_n_memory (buf) != 1)
+    return FALSE;
+
+  mem = gst_buffer_peek_memory (buf, 0);
+  if (!gst_memory_is_writable (mem))
+    return FALSE;
+
+  return mem->maxsize - mem->offset - mem->size >= TRAILER_SIZE;
+}
+
+/* Called with the session lock */
+static GstBuffer *
+gst_srtp_enc_acquire_buffer (GstSrtpEnc * filter, gsize size_max)
+{
+  GstBuffer *bufout = NULL;
+
+  if (size_max > POOL_BUFFER_SIZE)
+    return gst_buffer_new_allocate (NULL, size_max, NULL);
+
+  if (!filter->pool) {
+    GstStructure *config;
+
+    filter->pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (filter->pool);
+    gst_buffer_pool_config_set_params (config, NULL, POOL_BUFFER_SIZE, 0, 0);
+
+    if (!gst_buffer_pool_set_config (filter->pool, config) ||
+        !gst_buffer_pool_set_active (filter->pool, TRUE)) {
+      GST_WARNING_OBJECT (filter, "Failed to activate buffer pool");
+      gst_clear_object (&filter->pool);
+    }
+  }
+
+  if (filter->pool &&
+      gst_buffer_pool_acquire_buffer (filter->pool, &bufout, NULL)
+      == GST_FLOW_OK) {
+    gst_buffer_set_size (bufout, size_max);
+    return bufout;
+  }
+
+  return gst_buffer_new_allocate (NULL, size_max, NULL);
+}
+
+/* Protects @buf, taking ownership of it. The packet is protected in place
+ * when possible, otherwise it is copied into a pooled buffer with room for
+ * the trailer.
+ *
+ * Called with the session lock
+ */
 static GstFlowReturn
 gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
     GstBuffer * buf, gboolean is_rtcp, GstBuffer ** outbuf_ptr)
 {
   GstFlowReturn ret = GST_FLOW_OK;
-  gint size_max, size;
+  gint size;
   GstBuffer *bufout = NULL;
   GstMapInfo mapout;
   srtp_err_status_t err;
 
-  /* Create a bigger buffer to add protection */
   size = gst_buffer_get_size (buf);
-  size_max = size + SRTP_MAX_TRAILER_LEN + 10;
-  bufout = gst_buffer_new_allocate (NULL, size_max, NULL);
-
-  gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
-
-  gst_buffer_extract (buf, 0, mapout.data, size);
-
-  GST_OBJECT_LOCK (filter);
-
-  gst_srtp_init_event_reporter ();
 
   if (filter->session == NULL) {
     /* The rtcp session disappeared (element shutting down) */
-    GST_OBJECT_UNLOCK (filter);
-    ret = GST_FLOW_FLUSHING;
-    goto fail;
+    gst_buffer_unref (buf);
+    return GST_FLOW_FLUSHING;
   }
 
   gst_srtp_enc_ensure_ssrc (filter, buf);
 
+  if (gst_srtp_enc_can_protect_in_place (buf)) {
+    GST_TRACE_OBJECT (pad, "Protecting in place");
+    bufout = buf;
+    gst_buffer_set_size (bufout, size + TRAILER_SIZE);
+    gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+  } else {
+    /* Create a bigger buffer to add protection */
+    bufout = gst_srtp_enc_acquire_buffer (filter, size + TRAILER_SIZE);
+    gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+    gst_buffer_extract (buf, 0, mapout.data, size);
+    gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+    gst_buffer_unref (buf);
+  }
+
+  gst_srtp_init_event_reporter ();
+
 #ifdef HAVE_SRTP2
   if (is_rtcp)
     err = srtp_protect_rtcp_mki (filter->session, mapout.data, &size,
@@ -1165,14 +1264,11 @@ gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
     err = srtp_protect (filter->session, mapout.data, &size);
 #endif
 
-  GST_OBJECT_UNLOCK (filter);
-
   gst_buffer_unmap (bufout, &mapout);
 
   if (err == srtp_err_status_ok) {
     /* Buffer protected */
     gst_buffer_set_size (bufout, size);
-    gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
 
     GST_LOG_OBJECT (pad, "Encoding %s buffer of size %d",
         is_rtcp ? "RTCP" : "RTP", size);
@@ -1201,6 +1297,22 @@ fail:
   return ret;
 }
 
+static void
+gst_srtp_enc_check_soft_limit (GstSrtpEnc * filter)
+{
+  GST_OBJECT_LOCK (filter);
+
+  if (gst_srtp_get_soft_limit_reached ()) {
+    GST_OBJECT_UNLOCK (filter);
+    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
+    GST_OBJECT_LOCK (filter);
+    if (filter->random_key && !filter->key_changed)
+      gst_srtp_enc_replace_random_key (filter);
+  }
+
+  GST_OBJECT_UNLOCK (filter);
+}
+
 static GstFlowReturn
 gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
     gboolean is_rtcp)
@@ -1211,7 +1323,8 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   GstBuffer *bufout = NULL;
 
   if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp)) != GST_FLOW_OK) {
-    goto out;
+    gst_buffer_unref (buf);
+    return ret;
   }
 
   GST_OBJECT_LOCK (filter);
@@ -1224,32 +1337,22 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
 
   GST_OBJECT_UNLOCK (filter);
 
+  g_mutex_lock (&filter->session_lock);
   ret = gst_srtp_enc_process_buffer (filter, pad, buf, is_rtcp, &bufout);
+  g_mutex_unlock (&filter->session_lock);
+
   if (ret != GST_FLOW_OK)
-    goto out;
+    return ret;
 
   /* Push buffer to source pad */
   otherpad = get_rtp_other_pad (pad);
   ret = gst_pad_push (otherpad, bufout);
-  bufout = NULL;
 
   if (ret != GST_FLOW_OK)
-    goto out;
-
-  GST_OBJECT_LOCK (filter);
-
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
+    return ret;
 
-  GST_OBJECT_UNLOCK (filter);
+  gst_srtp_enc_check_soft_limit (filter);
 
-out:
-  gst_buffer_unref (buf);
   return ret;
 }
 
@@ -1257,18 +1360,20 @@ static gboolean
 process_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
 {
   ProcessBufferItData *data = user_data;
-  GstBuffer *bufout;
+  GstBuffer *bufout = NULL;
   GstFlowReturn ret;
 
   ret = gst_srtp_enc_process_buffer (data->filter, data->pad, *buffer,
       data->is_rtcp, &bufout);
+
+  /* the input buffer is consumed, replace it by the protected one */
+  *buffer = bufout;
+
   if (ret != GST_FLOW_OK) {
     data->flowret = ret;
     return FALSE;
   }
 
-  gst_buffer_list_add (data->out_list, bufout);
-
   return TRUE;
 }
 
@@ -1279,7 +1384,6 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   GstSrtpEnc *filter = GST_SRTP_ENC (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstPad *otherpad;
-  GstBufferList *out_list = NULL;
   ProcessBufferItData process_data;
 
   GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
@@ -1301,22 +1405,22 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
 
   GST_OBJECT_UNLOCK (filter);
 
-  out_list = gst_buffer_list_new ();
+  /* Protect the buffers in the list itself, so that writable buffers can be
+   * protected in place */
+  buf_list = gst_buffer_list_make_writable (buf_list);
 
   process_data.filter = filter;
   process_data.pad = pad;
   process_data.is_rtcp = is_rtcp;
-  process_data.out_list = out_list;
   process_data.flowret = GST_FLOW_OK;
 
-  if (!gst_buffer_list_foreach (buf_list, process_buffer_it, &process_data)) {
-    ret = process_data.flowret;
-    goto out;
-  }
+  /* One lock for the whole list */
+  g_mutex_lock (&filter->session_lock);
+  gst_buffer_list_foreach (buf_list, process_buffer_it, &process_data);
+  g_mutex_unlock (&filter->session_lock);
 
-  if (!gst_buffer_list_length (out_list)) {
-    gst_buffer_list_unref (out_list);
-    ret = GST_FLOW_OK;
+  if (process_data.flowret != GST_FLOW_OK) {
+    ret = process_data.flowret;
     goto out;
   }
 
@@ -1324,23 +1428,14 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   otherpad = get_rtp_other_pad (pad);
   GST_LOG_OBJECT (pad, "Pushing buffer chain of %d",
       gst_buffer_list_length (buf_list));
-  ret = gst_pad_push_list (otherpad, out_list);
-
-  if (ret != GST_FLOW_OK) {
-    goto out;
-  }
+  ret = gst_pad_push_list (otherpad, buf_list);
 
-  GST_OBJECT_LOCK (filter);
+  if (ret != GST_FLOW_OK)
+    return ret;
 
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
+  gst_srtp_enc_check_soft_limit (filter);
 
-  GST_OBJECT_UNLOCK (filter);
+  return ret;
 
 out:
 
@@ -1375,7 +1470,6 @@ gst_srtp_enc_chain_list_rtcp (GstPad * pad, GstObject * parent,
   return gst_srtp_enc_chain_list (pad, parent, buf_list, TRUE);
 }
 
-
 /* Change state
  */
 static GstStateChangeReturn
@@ -78,6 +78,11 @@ struct _GstSrtpEnc
   guint rtcp_auth;
   GstBuffer *mki;
 
+  /* Protects session, ssrcs_set and pool. Held across the crypto
+   * operations instead of the object lock, taken after the object lock. */
+  GMutex session_lock;
+  GstBufferPool *pool;
+
   srtp_t session;
   gboolean first_session;
   gboolean key_changed;
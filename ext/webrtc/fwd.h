@@ -54,6 +54,9 @@ typedef struct _TransportSendBinClass TransportSendBinClass;
 typedef struct _TransportReceiveBin TransportReceiveBin;
 typedef struct _TransportReceiveBinClass TransportReceiveBinClass;
 
+typedef struct _TransportPacer TransportPacer;
+typedef struct _TransportPacerClass TransportPacerClass;
+
 typedef struct _WebRTCTransceiver WebRTCTransceiver;
 typedef struct _WebRTCTransceiverClass WebRTCTransceiverClass;
 
@@ -25,6 +25,8 @@
 #include "gstwebrtcstats.h"
 #include "transportstream.h"
 #include "transportreceivebin.h"
+#include "transportsendbin.h"
+#include "transportpacer.h"
 #include "utils.h"
 #include "webrtcsdp.h"
 #include "webrtctransceiver.h"
@@ -342,6 +344,7 @@ enum
   ON_ICE_CANDIDATE_SIGNAL,
   ON_NEW_TRANSCEIVER_SIGNAL,
   GET_STATS_SIGNAL,
+  GET_STATS_BY_TYPE_SIGNAL,
   ADD_TRANSCEIVER_SIGNAL,
   GET_TRANSCEIVER_SIGNAL,
   GET_TRANSCEIVERS_SIGNAL,
@@ -369,8 +372,14 @@ enum
   PROP_BUNDLE_POLICY,
   PROP_ICE_TRANSPORT_POLICY,
   PROP_ICE_AGENT,
+  PROP_STATS_UPDATE_INTERVAL,
+  PROP_RECEIVE_STREAM_THREADS,
+  PROP_PACING_BITRATE,
+  PROP_PACING_BURST_SIZE,
 };
 
+#define DEFAULT_PACING_BURST_SIZE (10 * 1200)
+
 static guint gst_webrtc_bin_signals[LAST_SIGNAL] = { 0 };
 
 typedef struct
@@ -424,6 +433,20 @@ clear_session_mid_item (SessionMidItem * item)
   g_free (item->mid);
 }
 
+typedef struct
+{
+  /* local and remote media sections and bundle parameters this m-line was
+   * last configured from */
+  gchar *key;
+  GstWebRTCRTPTransceiver *trans;
+} AppliedMediaItem;
+
+static void
+clear_applied_media_item (AppliedMediaItem * item)
+{
+  g_free (item->key);
+}
+
 typedef gboolean (*FindTransceiverFunc) (GstWebRTCRTPTransceiver * p1,
     gconstpointer data);
 
@@ -456,13 +479,56 @@ transceiver_match_for_mline (GstWebRTCRTPTransceiver * trans, guint * mline)
   return trans->mline == *mline;
 }
 
+/* The mid and mline of a transceiver must only be changed through these two
+ * functions so that the lookup tables stay in sync */
+static void
+_transceiver_set_mline (GstWebRTCBin * webrtc, GstWebRTCRTPTransceiver * trans,
+    guint mline)
+{
+  GHashTable *index = webrtc->priv->transceivers_by_mline;
+
+  if (trans->mline != -1 && trans->mline != mline
+      && g_hash_table_lookup (index, GUINT_TO_POINTER (trans->mline)) == trans)
+    g_hash_table_remove (index, GUINT_TO_POINTER (trans->mline));
+
+  trans->mline = mline;
+
+  if (mline != -1)
+    g_hash_table_insert (index, GUINT_TO_POINTER (mline), trans);
+}
+
+static void
+_transceiver_set_mid (GstWebRTCBin * webrtc, GstWebRTCRTPTransceiver * trans,
+    const gchar * mid)
+{
+  GHashTable *index = webrtc->priv->transceivers_by_mid;
+
+  if (trans->mid && g_strcmp0 (trans->mid, mid) != 0
+      && g_hash_table_lookup (index, trans->mid) == trans)
+    g_hash_table_remove (index, trans->mid);
+
+  g_free (trans->mid);
+  trans->mid = g_strdup (mid);
+
+  if (mid)
+    g_hash_table_insert (index, g_strdup (mid), trans);
+}
+
 static GstWebRTCRTPTransceiver *
 _find_transceiver_for_mline (GstWebRTCBin * webrtc, guint mlineindex)
 {
   GstWebRTCRTPTransceiver *trans;
 
-  trans = _find_transceiver (webrtc, &mlineindex,
-      (FindTransceiverFunc) transceiver_match_for_mline);
+  trans = g_hash_table_lookup (webrtc->priv->transceivers_by_mline,
+      GUINT_TO_POINTER (mlineindex));
+
+  /* a stale entry would mean someone changed the mline behind our back */
+  if (G_UNLIKELY (trans && trans->mline != mlineindex)) {
+    GST_WARNING_OBJECT (webrtc, "transceiver index out of date for "
+        "mlineindex %u", mlineindex);
+    trans = _find_transceiver (webrtc, &mlineindex,
+        (FindTransceiverFunc) transceiver_match_for_mline);
+  }
 
   GST_TRACE_OBJECT (webrtc,
       "Found transceiver %" GST_PTR_FORMAT " for mlineindex %u", trans,
@@ -471,6 +537,29 @@ _find_transceiver_for_mline (GstWebRTCBin * webrtc, guint mlineindex)
   return trans;
 }
 
+static GstWebRTCRTPTransceiver *
+_find_transceiver_for_mid (GstWebRTCBin * webrtc, const gchar * mid)
+{
+  GstWebRTCRTPTransceiver *trans;
+
+  if (!mid)
+    return NULL;
+
+  trans = g_hash_table_lookup (webrtc->priv->transceivers_by_mid, mid);
+
+  if (G_UNLIKELY (trans && g_strcmp0 (trans->mid, mid) != 0)) {
+    GST_WARNING_OBJECT (webrtc, "transceiver index out of date for mid %s",
+        mid);
+    trans = _find_transceiver (webrtc, mid,
+        (FindTransceiverFunc) match_for_mid);
+  }
+
+  GST_TRACE_OBJECT (webrtc,
+      "Found transceiver %" GST_PTR_FORMAT " for mid %s", trans, mid);
+
+  return trans;
+}
+
 typedef gboolean (*FindTransportFunc) (TransportStream * p1,
     gconstpointer data);
 
@@ -585,11 +674,38 @@ _find_data_channel_for_id (GstWebRTCBin * webrtc, gint id)
   return channel;
 }
 
+static GHashTable *
+_pad_index_for_direction (GstWebRTCBin * webrtc, GstPadDirection direction)
+{
+  return direction == GST_PAD_SRC ? webrtc->priv->src_pads_by_mline :
+      webrtc->priv->sink_pads_by_mline;
+}
+
+/* must be called with the object lock */
+static void
+_index_pad (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
+{
+  g_hash_table_insert (_pad_index_for_direction (webrtc,
+          GST_PAD_DIRECTION (pad)), GUINT_TO_POINTER (pad->mlineindex), pad);
+}
+
+/* must be called with the object lock */
+static void
+_unindex_pad (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
+{
+  GHashTable *index = _pad_index_for_direction (webrtc,
+      GST_PAD_DIRECTION (pad));
+
+  if (g_hash_table_lookup (index, GUINT_TO_POINTER (pad->mlineindex)) == pad)
+    g_hash_table_remove (index, GUINT_TO_POINTER (pad->mlineindex));
+}
+
 static void
 _add_pad_to_list (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
 {
   GST_OBJECT_LOCK (webrtc);
   webrtc->priv->pending_pads = g_list_prepend (webrtc->priv->pending_pads, pad);
+  _index_pad (webrtc, pad);
   GST_OBJECT_UNLOCK (webrtc);
 }
 
@@ -606,6 +722,10 @@ _add_pad (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
 {
   _remove_pending_pad (webrtc, pad);
 
+  GST_OBJECT_LOCK (webrtc);
+  _index_pad (webrtc, pad);
+  GST_OBJECT_UNLOCK (webrtc);
+
   if (webrtc->priv->running)
     gst_pad_set_active (GST_PAD (pad), TRUE);
   gst_element_add_pad (GST_ELEMENT (webrtc), GST_PAD (pad));
@@ -616,29 +736,27 @@ _remove_pad (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
 {
   _remove_pending_pad (webrtc, pad);
 
-  gst_element_remove_pad (GST_ELEMENT (webrtc), GST_PAD (pad));
-}
-
-typedef struct
-{
-  GstPadDirection direction;
-  guint mlineindex;
-} MLineMatch;
+  GST_OBJECT_LOCK (webrtc);
+  _unindex_pad (webrtc, pad);
+  GST_OBJECT_UNLOCK (webrtc);
 
-static gboolean
-pad_match_for_mline (GstWebRTCBinPad * pad, const MLineMatch * match)
-{
-  return GST_PAD_DIRECTION (pad) == match->direction
-      && pad->mlineindex == match->mlineindex;
+  gst_element_remove_pad (GST_ELEMENT (webrtc), GST_PAD (pad));
 }
 
 static GstWebRTCBinPad *
 _find_pad_for_mline (GstWebRTCBin * webrtc, GstPadDirection direction,
     guint mlineindex)
 {
-  MLineMatch m = { direction, mlineindex };
+  GstWebRTCBinPad *pad;
+
+  GST_OBJECT_LOCK (webrtc);
+  pad = g_hash_table_lookup (_pad_index_for_direction (webrtc, direction),
+      GUINT_TO_POINTER (mlineindex));
+  if (pad)
+    gst_object_ref (pad);
+  GST_OBJECT_UNLOCK (webrtc);
 
-  return _find_pad (webrtc, &m, (FindPadFunc) pad_match_for_mline);
+  return pad;
 }
 
 typedef struct
@@ -658,6 +776,15 @@ _find_pad_for_transceiver (GstWebRTCBin * webrtc, GstPadDirection direction,
     GstWebRTCRTPTransceiver * trans)
 {
   TransMatch m = { direction, trans };
+  GstWebRTCBinPad *pad = NULL;
+
+  /* pads are normally created for the mline of their transceiver */
+  if (trans && trans->mline != -1) {
+    pad = _find_pad_for_mline (webrtc, direction, trans->mline);
+    if (pad && pad->trans == trans)
+      return pad;
+    gst_clear_object (&pad);
+  }
 
   return _find_pad (webrtc, &m, (FindPadFunc) pad_match_for_transceiver);
 }
@@ -1653,11 +1780,11 @@ _create_webrtc_transceiver (GstWebRTCBin * webrtc,
   trans = webrtc_transceiver_new (webrtc, sender, receiver);
   rtp_trans = GST_WEBRTC_RTP_TRANSCEIVER (trans);
   rtp_trans->direction = direction;
-  rtp_trans->mline = mline;
   /* FIXME: We don't support stopping transceiver yet so they're always not stopped */
   rtp_trans->stopped = FALSE;
 
   g_ptr_array_add (webrtc->priv->transceivers, trans);
+  _transceiver_set_mline (webrtc, rtp_trans, mline);
 
   gst_object_unref (sender);
   gst_object_unref (receiver);
@@ -1702,6 +1829,60 @@ _create_transport_channel (GstWebRTCBin * webrtc, guint session_id)
   return ret;
 }
 
+static void
+_on_twcc_stats_notify (GObject * session, GParamSpec * pspec,
+    TransportStream * stream)
+{
+  GstStructure *stats = NULL;
+  guint bitrate_recv = 0;
+  gdouble loss = 0.0;
+
+  g_object_get (session, "twcc-stats", &stats, NULL);
+  if (!stats)
+    return;
+
+  if (gst_structure_get_double (stats, "packet-loss-pct", &loss)) {
+    gst_structure_get_uint (stats, "bitrate-recv", &bitrate_recv);
+    transport_pacer_update_feedback (stream->send_bin->pacer, bitrate_recv,
+        loss);
+  }
+
+  gst_structure_free (stats);
+}
+
+/* with the object lock */
+static void
+_configure_pacer (GstWebRTCBin * webrtc, TransportStream * stream)
+{
+  g_object_set (stream->send_bin->pacer, "bitrate",
+      webrtc->priv->pacing_bitrate, "burst-size",
+      webrtc->priv->pacing_burst_size, NULL);
+}
+
+static void
+_setup_pacing (GstWebRTCBin * webrtc, TransportStream * stream)
+{
+  GObject *session = NULL;
+
+  GST_OBJECT_LOCK (webrtc);
+  _configure_pacer (webrtc, stream);
+  GST_OBJECT_UNLOCK (webrtc);
+
+  /* Lower the pacing rate on loss when rtpbin provides transport-wide
+   * congestion control feedback */
+  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
+      stream->session_id, &session);
+  if (!session)
+    return;
+
+  if (g_object_class_find_property (G_OBJECT_GET_CLASS (session),
+          "twcc-stats")) {
+    g_signal_connect_object (session, "notify::twcc-stats",
+        G_CALLBACK (_on_twcc_stats_notify), stream, 0);
+  }
+  g_object_unref (session);
+}
+
 static TransportStream *
 _get_or_create_rtp_transport_channel (GstWebRTCBin * webrtc, guint session_id)
 {
@@ -1727,6 +1908,8 @@ _get_or_create_rtp_transport_channel (GstWebRTCBin * webrtc, guint session_id)
             GST_ELEMENT (ret->send_bin), "rtcp_sink"))
       g_warn_if_reached ();
     g_free (pad_name);
+
+    _setup_pacing (webrtc, ret);
   }
 
   gst_element_sync_state_with_parent (GST_ELEMENT (ret->send_bin));
@@ -2631,39 +2814,34 @@ _create_offer_task (GstWebRTCBin * webrtc, const GstStructure * options)
       if (g_strcmp0 (gst_sdp_media_get_media (last_media), "audio") == 0
           || g_strcmp0 (gst_sdp_media_get_media (last_media), "video") == 0) {
         const gchar *last_mid;
-        int j;
         last_mid = gst_sdp_media_get_attribute_val (last_media, "mid");
 
-        for (j = 0; j < webrtc->priv->transceivers->len; j++) {
-          trans = g_ptr_array_index (webrtc->priv->transceivers, j);
-
-          if (trans->mid && g_strcmp0 (trans->mid, last_mid) == 0) {
-            GstSDPMedia *media;
+        trans = _find_transceiver_for_mid (webrtc, last_mid);
+        if (trans) {
+          GstSDPMedia *media;
 
-            g_assert (!g_list_find (seen_transceivers, trans));
+          g_assert (!g_list_find (seen_transceivers, trans));
 
-            GST_LOG_OBJECT (webrtc, "using previous negotiatied transceiver %"
-                GST_PTR_FORMAT " with mid %s into media index %u", trans,
-                trans->mid, media_idx);
+          GST_LOG_OBJECT (webrtc, "using previous negotiatied transceiver %"
+              GST_PTR_FORMAT " with mid %s into media index %u", trans,
+              trans->mid, media_idx);
 
-            /* FIXME: deal with format changes */
-            gst_sdp_media_copy (last_media, &media);
-            _media_replace_direction (media, trans->direction);
+          /* FIXME: deal with format changes */
+          gst_sdp_media_copy (last_media, &media);
+          _media_replace_direction (media, trans->direction);
 
-            if (bundled_mids) {
-              const gchar *mid = gst_sdp_media_get_attribute_val (media, "mid");
+          if (bundled_mids) {
+            const gchar *mid = gst_sdp_media_get_attribute_val (media, "mid");
 
-              g_assert (mid);
-              g_string_append_printf (bundled_mids, " %s", mid);
-            }
+            g_assert (mid);
+            g_string_append_printf (bundled_mids, " %s", mid);
+          }
 
-            gst_sdp_message_add_media (ret, media);
-            media_idx++;
+          gst_sdp_message_add_media (ret, media);
+          media_idx++;
 
-            gst_sdp_media_free (media);
-            seen_transceivers = g_list_prepend (seen_transceivers, trans);
-            break;
-          }
+          gst_sdp_media_free (media);
+          seen_transceivers = g_list_prepend (seen_transceivers, trans);
         }
       } else if (g_strcmp0 (gst_sdp_media_get_media (last_media),
               "application") == 0) {
@@ -3066,9 +3244,7 @@ _create_answer_task (GstWebRTCBin * webrtc, const GstStructure * options)
       offer_caps = _rtp_caps_from_media (offer_media);
 
       if (last_answer && i < gst_sdp_message_medias_len (last_answer)
-          && (rtp_trans =
-              _find_transceiver (webrtc, mid,
-                  (FindTransceiverFunc) match_for_mid))) {
+          && (rtp_trans = _find_transceiver_for_mid (webrtc, mid))) {
         const GstSDPMedia *last_media =
             gst_sdp_message_get_media (last_answer, i);
         const gchar *last_mid =
@@ -3424,15 +3600,12 @@ _find_transceiver_for_sdp_media (GstWebRTCBin * webrtc,
     const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
 
     if (g_strcmp0 (attr->key, "mid") == 0) {
-      if ((ret =
-              _find_transceiver (webrtc, attr->value,
-                  (FindTransceiverFunc) match_for_mid)))
+      if ((ret = _find_transceiver_for_mid (webrtc, attr->value)))
         goto out;
     }
   }
 
-  ret = _find_transceiver (webrtc, &media_idx,
-      (FindTransceiverFunc) transceiver_match_for_mline);
+  ret = _find_transceiver_for_mline (webrtc, media_idx);
 
 out:
   GST_TRACE_OBJECT (webrtc, "Found transceiver %" GST_PTR_FORMAT, ret);
@@ -3786,15 +3959,13 @@ _update_transceiver_from_sdp_media (GstWebRTCBin * webrtc,
   ReceiveState receive_state = RECEIVE_STATE_UNSET;
   int i;
 
-  rtp_trans->mline = media_idx;
+  _transceiver_set_mline (webrtc, rtp_trans, media_idx);
 
   for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
     const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
 
-    if (g_strcmp0 (attr->key, "mid") == 0) {
-      g_free (rtp_trans->mid);
-      rtp_trans->mid = g_strdup (attr->value);
-    }
+    if (g_strcmp0 (attr->key, "mid") == 0)
+      _transceiver_set_mid (webrtc, rtp_trans, attr->value);
   }
 
   {
@@ -3957,7 +4128,7 @@ _update_transceiver_from_sdp_media (GstWebRTCBin * webrtc,
 
     }
 
-    rtp_trans->mline = media_idx;
+    _transceiver_set_mline (webrtc, rtp_trans, media_idx);
     rtp_trans->current_direction = new_dir;
   }
 
@@ -4164,6 +4335,68 @@ done:
   return;
 }
 
+static gchar *
+_get_applied_media_key (GstWebRTCBin * webrtc, guint media_idx,
+    GStrv bundled, guint bundle_idx)
+{
+  const GstSDPMessage *local, *remote;
+  gchar *local_text, *remote_text, *key;
+
+  if (!webrtc->current_local_description
+      || !webrtc->current_remote_description)
+    return NULL;
+
+  local = webrtc->current_local_description->sdp;
+  remote = webrtc->current_remote_description->sdp;
+  if (media_idx >= gst_sdp_message_medias_len (local)
+      || media_idx >= gst_sdp_message_medias_len (remote))
+    return NULL;
+
+  local_text =
+      gst_sdp_media_as_text (gst_sdp_message_get_media (local, media_idx));
+  remote_text =
+      gst_sdp_media_as_text (gst_sdp_message_get_media (remote, media_idx));
+  key = g_strdup_printf ("%s\n%s\nbundle %d %u", local_text, remote_text,
+      bundled != NULL, bundle_idx);
+  g_free (local_text);
+  g_free (remote_text);
+
+  return key;
+}
+
+static gboolean
+_applied_media_is_unchanged (GstWebRTCBin * webrtc, guint media_idx,
+    const gchar * key, GstWebRTCRTPTransceiver * trans)
+{
+  AppliedMediaItem *item;
+
+  if (!key || !trans || media_idx >= webrtc->priv->applied_media->len)
+    return FALSE;
+
+  item = &g_array_index (webrtc->priv->applied_media, AppliedMediaItem,
+      media_idx);
+
+  return item->trans == trans && trans->mline == media_idx && item->key
+      && g_strcmp0 (item->key, key) == 0;
+}
+
+/* takes ownership of @key */
+static void
+_set_applied_media (GstWebRTCBin * webrtc, guint media_idx, gchar * key,
+    GstWebRTCRTPTransceiver * trans)
+{
+  AppliedMediaItem *item;
+
+  if (media_idx >= webrtc->priv->applied_media->len)
+    g_array_set_size (webrtc->priv->applied_media, media_idx + 1);
+
+  item = &g_array_index (webrtc->priv->applied_media, AppliedMediaItem,
+      media_idx);
+  g_free (item->key);
+  item->key = key;
+  item->trans = trans;
+}
+
 static gboolean
 _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
     GstWebRTCSessionDescription * sdp)
@@ -4173,6 +4406,7 @@ _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
   GStrv bundled = NULL;
   guint bundle_idx = 0;
   TransportStream *bundle_stream = NULL;
+  guint n_skipped = 0;
 
   /* FIXME: With some peers, it's possible we could have
    * multiple bundles to deal with, although I've never seen one yet */
@@ -4210,6 +4444,7 @@ _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
     TransportStream *stream;
     GstWebRTCRTPTransceiver *trans;
     guint transport_idx;
+    gchar *key;
 
     /* skip rejected media */
     if (gst_sdp_media_get_port (media) == 0)
@@ -4224,6 +4459,22 @@ _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
 
     stream = _get_or_create_transport_stream (webrtc, transport_idx,
         _message_media_is_datachannel (sdp->sdp, transport_idx));
+
+    /* Renegotiations usually only touch a few m-lines. If neither the local
+     * nor the remote media section changed since they were last applied to
+     * the same transceiver, there is nothing to reconfigure. We only need to
+     * account for it in the activity of the (bundled) transport */
+    key = _get_applied_media_key (webrtc, i, bundled, bundle_idx);
+    if (_applied_media_is_unchanged (webrtc, i, key, trans)) {
+      if (trans->current_direction != GST_WEBRTC_RTP_TRANSCEIVER_DIRECTION_NONE
+          && trans->current_direction !=
+          GST_WEBRTC_RTP_TRANSCEIVER_DIRECTION_INACTIVE)
+        stream->active = TRUE;
+      g_free (key);
+      n_skipped++;
+      continue;
+    }
+
     if (!bundled) {
       /* When bundling, these were all set up above, but when not
        * bundling we need to do it now */
@@ -4236,6 +4487,7 @@ _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
 
     if (source == SDP_LOCAL && sdp->type == GST_WEBRTC_SDP_TYPE_OFFER && !trans) {
       GST_ERROR ("State mismatch.  Could not find local transceiver by mline.");
+      g_free (key);
       goto done;
     } else {
       if (g_strcmp0 (gst_sdp_media_get_media (media), "audio") == 0 ||
@@ -4259,14 +4511,20 @@ _update_transceivers_from_sdp (GstWebRTCBin * webrtc, SDPSource source,
 
         _update_transceiver_from_sdp_media (webrtc, sdp->sdp, i, stream,
             trans, bundled, bundle_idx);
+        _set_applied_media (webrtc, i, key, trans);
+        key = NULL;
       } else if (_message_media_is_datachannel (sdp->sdp, i)) {
         _update_data_channel_from_sdp_media (webrtc, sdp->sdp, i, stream);
       } else {
         GST_ERROR_OBJECT (webrtc, "Unknown media type in SDP at index %u", i);
       }
     }
+    g_free (key);
   }
 
+  GST_DEBUG_OBJECT (webrtc, "skipped %u unchanged media sections out of %u",
+      n_skipped, gst_sdp_message_medias_len (sdp->sdp));
+
   if (bundle_stream && bundle_stream->active == FALSE) {
     /* No bundled mline marked the bundle as active, so block the receive bin, as
      * this bundle is completely inactive */
@@ -4560,11 +4818,8 @@ _set_description_task (GstWebRTCBin * webrtc, struct set_description *sd)
 
           if (split[0] && sscanf (split[0], "%u", &ssrc) && split[1]
               && g_str_has_prefix (split[1], "cname:")) {
-            SsrcMapItem ssrc_item;
-
-            ssrc_item.media_idx = i;
-            ssrc_item.ssrc = ssrc;
-            g_array_append_val (item->remote_ssrcmap, ssrc_item);
+            g_hash_table_insert (item->remote_ssrcmap,
+                GUINT_TO_POINTER (ssrc), GUINT_TO_POINTER (i));
           }
           g_strfreev (split);
         }
@@ -4881,19 +5136,10 @@ _on_local_ice_candidate_cb (GstWebRTCICE * ice, guint session_id,
   }
 }
 
-/* https://www.w3.org/TR/webrtc/#dfn-stats-selection-algorithm */
-static GstStructure *
-_get_stats_from_selector (GstWebRTCBin * webrtc, gpointer selector)
-{
-  if (selector)
-    GST_FIXME_OBJECT (webrtc, "Implement stats selection");
-
-  return gst_structure_copy (webrtc->priv->stats);
-}
-
 struct get_stats
 {
   GstPad *pad;
+  GstWebRTCStatsType type;
   GstPromise *promise;
 };
 
@@ -4907,42 +5153,26 @@ _free_get_stats (struct get_stats *stats)
   g_free (stats);
 }
 
-/* https://www.w3.org/TR/webrtc/#dom-rtcpeerconnection-getstats() */
+/* https://www.w3.org/TR/webrtc/#dom-rtcpeerconnection-getstats()
+ * https://www.w3.org/TR/webrtc/#dfn-stats-selection-algorithm */
 static void
 _get_stats_task (GstWebRTCBin * webrtc, struct get_stats *stats)
 {
   GstStructure *s;
-  gpointer selector = NULL;
-
-  gst_webrtc_bin_update_stats (webrtc);
-
-  if (stats->pad) {
-    GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (stats->pad);
-
-    if (wpad->trans) {
-      if (GST_PAD_DIRECTION (wpad) == GST_PAD_SRC) {
-        selector = wpad->trans->receiver;
-      } else {
-        selector = wpad->trans->sender;
-      }
-    }
-  }
 
-  s = _get_stats_from_selector (webrtc, selector);
+  s = gst_webrtc_bin_create_stats (webrtc, stats->pad, stats->type);
   gst_promise_reply (stats->promise, s);
 }
 
 static void
-gst_webrtc_bin_get_stats (GstWebRTCBin * webrtc, GstPad * pad,
-    GstPromise * promise)
+_queue_get_stats (GstWebRTCBin * webrtc, GstPad * pad,
+    GstWebRTCStatsType type, GstPromise * promise)
 {
   struct get_stats *stats;
 
-  g_return_if_fail (promise != NULL);
-  g_return_if_fail (pad == NULL || GST_IS_WEBRTC_BIN_PAD (pad));
-
   stats = g_new0 (struct get_stats, 1);
   stats->promise = gst_promise_ref (promise);
+  stats->type = type;
   /* FIXME: check that pad exists in element */
   if (pad)
     stats->pad = gst_object_ref (pad);
@@ -4961,6 +5191,26 @@ gst_webrtc_bin_get_stats (GstWebRTCBin * webrtc, GstPad * pad,
   }
 }
 
+static void
+gst_webrtc_bin_get_stats (GstWebRTCBin * webrtc, GstPad * pad,
+    GstPromise * promise)
+{
+  g_return_if_fail (promise != NULL);
+  g_return_if_fail (pad == NULL || GST_IS_WEBRTC_BIN_PAD (pad));
+
+  _queue_get_stats (webrtc, pad, 0, promise);
+}
+
+static void
+gst_webrtc_bin_get_stats_by_type (GstWebRTCBin * webrtc, GstPad * pad,
+    GstWebRTCStatsType type, GstPromise * promise)
+{
+  g_return_if_fail (promise != NULL);
+  g_return_if_fail (pad == NULL || GST_IS_WEBRTC_BIN_PAD (pad));
+
+  _queue_get_stats (webrtc, pad, type, promise);
+}
+
 static GstWebRTCRTPTransceiver *
 gst_webrtc_bin_add_transceiver (GstWebRTCBin * webrtc,
     GstWebRTCRTPTransceiverDirection direction, GstCaps * caps)
@@ -5189,8 +5439,7 @@ on_rtpbin_pad_added (GstElement * rtpbin, GstPad * new_pad,
     TransportStream *stream;
     GstWebRTCBinPad *pad;
     guint media_idx = 0;
-    gboolean found_ssrc = FALSE;
-    guint i;
+    gpointer value;
 
     if (sscanf (new_pad_name, "recv_rtp_src_%u_%u_%u", &session_id, &ssrc,
             &pt) != 3) {
@@ -5204,17 +5453,10 @@ on_rtpbin_pad_added (GstElement * rtpbin, GstPad * new_pad,
 
     media_idx = session_id;
 
-    for (i = 0; i < stream->remote_ssrcmap->len; i++) {
-      SsrcMapItem *item =
-          &g_array_index (stream->remote_ssrcmap, SsrcMapItem, i);
-      if (item->ssrc == ssrc) {
-        media_idx = item->media_idx;
-        found_ssrc = TRUE;
-        break;
-      }
-    }
-
-    if (!found_ssrc) {
+    if (g_hash_table_lookup_extended (stream->remote_ssrcmap,
+            GUINT_TO_POINTER (ssrc), NULL, &value)) {
+      media_idx = GPOINTER_TO_UINT (value);
+    } else {
       GST_WARNING_OBJECT (webrtc, "Could not find ssrc %u", ssrc);
     }
 
@@ -5284,8 +5526,7 @@ on_rtpbin_request_aux_sender (GstElement * rtpbin, guint session_id,
   GstWebRTCRTPTransceiver *trans;
 
   stream = _find_transport_for_session (webrtc, session_id);
-  trans = _find_transceiver (webrtc, &session_id,
-      (FindTransceiverFunc) transceiver_match_for_mline);
+  trans = _find_transceiver_for_mline (webrtc, session_id);
 
   if (stream)
     have_rtx = transport_stream_get_pt (stream, "RTX") != 0;
@@ -5474,8 +5715,7 @@ on_rtpbin_request_fec_encoder (GstElement * rtpbin, guint session_id,
   GstWebRTCRTPTransceiver *trans;
 
   stream = _find_transport_for_session (webrtc, session_id);
-  trans = _find_transceiver (webrtc, &session_id,
-      (FindTransceiverFunc) transceiver_match_for_mline);
+  trans = _find_transceiver_for_mline (webrtc, session_id);
 
   if (stream) {
     ulpfec_pt = transport_stream_get_pt (stream, "ULPFEC");
@@ -5543,11 +5783,23 @@ on_rtpbin_request_fec_encoder (GstElement * rtpbin, guint session_id,
   return ret;
 }
 
+/* Releases the per stream receive queue of a remote SSRC that left */
+static void
+_clear_receive_ssrc (GstWebRTCBin * webrtc, guint session_id, guint ssrc)
+{
+  TransportStream *stream = _find_transport_for_session (webrtc, session_id);
+
+  if (stream && stream->receive_bin)
+    transport_receive_bin_clear_ssrc (stream->receive_bin, ssrc);
+}
+
 static void
 on_rtpbin_bye_ssrc (GstElement * rtpbin, guint session_id, guint ssrc,
     GstWebRTCBin * webrtc)
 {
   GST_INFO_OBJECT (webrtc, "session %u ssrc %u received bye", session_id, ssrc);
+
+  _clear_receive_ssrc (webrtc, session_id, ssrc);
 }
 
 static void
@@ -5605,6 +5857,8 @@ on_rtpbin_timeout (GstElement * rtpbin, guint session_id, guint ssrc,
     GstWebRTCBin * webrtc)
 {
   GST_INFO_OBJECT (webrtc, "session %u ssrc %u timeout", session_id, ssrc);
+
+  _clear_receive_ssrc (webrtc, session_id, ssrc);
 }
 
 static void
@@ -5629,8 +5883,7 @@ on_rtpbin_new_jitterbuffer (GstElement * rtpbin, GstElement * jitterbuffer,
 {
   GstWebRTCRTPTransceiver *trans;
 
-  trans = _find_transceiver (webrtc, &session_id,
-      (FindTransceiverFunc) transceiver_match_for_mline);
+  trans = _find_transceiver_for_mline (webrtc, session_id);
 
   if (trans) {
     /* We don't set do-retransmission on rtpbin as we want per-session control */
@@ -5864,6 +6117,36 @@ gst_webrtc_bin_set_property (GObject * object, guint prop_id,
           webrtc->ice_transport_policy ==
           GST_WEBRTC_ICE_TRANSPORT_POLICY_RELAY ? TRUE : FALSE, NULL);
       break;
+    case PROP_STATS_UPDATE_INTERVAL:
+      GST_OBJECT_LOCK (webrtc);
+      webrtc->priv->stats_update_interval =
+          (gint64) g_value_get_uint (value) * 1000;
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
+    case PROP_RECEIVE_STREAM_THREADS:
+      GST_OBJECT_LOCK (webrtc);
+      webrtc->priv->receive_stream_threads = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
+    case PROP_PACING_BITRATE:
+    case PROP_PACING_BURST_SIZE:{
+      int i;
+
+      PC_LOCK (webrtc);
+      GST_OBJECT_LOCK (webrtc);
+      if (prop_id == PROP_PACING_BITRATE)
+        webrtc->priv->pacing_bitrate = g_value_get_uint (value);
+      else
+        webrtc->priv->pacing_burst_size = g_value_get_uint (value);
+      for (i = 0; i < webrtc->priv->transports->len; i++) {
+        TransportStream *stream =
+            g_ptr_array_index (webrtc->priv->transports, i);
+        _configure_pacer (webrtc, stream);
+      }
+      GST_OBJECT_UNLOCK (webrtc);
+      PC_UNLOCK (webrtc);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5931,6 +6214,26 @@ gst_webrtc_bin_get_property (GObject * object, guint prop_id,
     case PROP_ICE_AGENT:
       g_value_set_object (value, webrtc->priv->ice);
       break;
+    case PROP_STATS_UPDATE_INTERVAL:
+      GST_OBJECT_LOCK (webrtc);
+      g_value_set_uint (value, webrtc->priv->stats_update_interval / 1000);
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
+    case PROP_RECEIVE_STREAM_THREADS:
+      GST_OBJECT_LOCK (webrtc);
+      g_value_set_boolean (value, webrtc->priv->receive_stream_threads);
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
+    case PROP_PACING_BITRATE:
+      GST_OBJECT_LOCK (webrtc);
+      g_value_set_uint (value, webrtc->priv->pacing_bitrate);
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
+    case PROP_PACING_BURST_SIZE:
+      GST_OBJECT_LOCK (webrtc);
+      g_value_set_uint (value, webrtc->priv->pacing_burst_size);
+      GST_OBJECT_UNLOCK (webrtc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5973,6 +6276,12 @@ gst_webrtc_bin_dispose (GObject * object)
 
   g_clear_object (&webrtc->priv->sctp_transport);
 
+  /* our pads are about to be removed by the parent class */
+  GST_OBJECT_LOCK (webrtc);
+  g_hash_table_remove_all (webrtc->priv->src_pads_by_mline);
+  g_hash_table_remove_all (webrtc->priv->sink_pads_by_mline);
+  GST_OBJECT_UNLOCK (webrtc);
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -5989,6 +6298,15 @@ gst_webrtc_bin_finalize (GObject * object)
     g_ptr_array_free (webrtc->priv->transceivers, TRUE);
   webrtc->priv->transceivers = NULL;
 
+  g_clear_pointer (&webrtc->priv->transceivers_by_mid, g_hash_table_unref);
+  g_clear_pointer (&webrtc->priv->transceivers_by_mline, g_hash_table_unref);
+  g_clear_pointer (&webrtc->priv->src_pads_by_mline, g_hash_table_unref);
+  g_clear_pointer (&webrtc->priv->sink_pads_by_mline, g_hash_table_unref);
+
+  if (webrtc->priv->applied_media)
+    g_array_free (webrtc->priv->applied_media, TRUE);
+  webrtc->priv->applied_media = NULL;
+
   if (webrtc->priv->data_channels)
     g_ptr_array_free (webrtc->priv->data_channels, TRUE);
   webrtc->priv->data_channels = NULL;
@@ -6043,6 +6361,7 @@ gst_webrtc_bin_finalize (GObject * object)
   if (webrtc->priv->stats)
     gst_structure_free (webrtc->priv->stats);
   webrtc->priv->stats = NULL;
+  g_clear_pointer (&webrtc->priv->session_stats, g_hash_table_unref);
 
   g_mutex_clear (ICE_GET_LOCK (webrtc));
   g_mutex_clear (PC_GET_LOCK (webrtc));
@@ -6199,6 +6518,73 @@ gst_webrtc_bin_class_init (GstWebRTCBinClass * klass)
           "The WebRTC ICE agent",
           GST_TYPE_WEBRTC_ICE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstWebRTCBin:stats-update-interval:
+   *
+   * Minimum time in milliseconds between two retrievals of the RTP
+   * statistics.  Statistics requested more often than this reuse the
+   * previously retrieved values.  0 retrieves new values for every request.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_STATS_UPDATE_INTERVAL,
+      g_param_spec_uint ("stats-update-interval", "Stats Update Interval",
+          "Minimum time in milliseconds between two retrievals of the RTP "
+          "statistics (0 = always retrieve)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCBin:receive-stream-threads:
+   *
+   * Demultiplex the decrypted RTP of each transport by SSRC and hand every
+   * stream to the RTP session and its jitterbuffer from a dedicated thread.
+   * Useful when a single bundled transport carries many high bitrate
+   * streams.  Only applies to transports created after it is set.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_RECEIVE_STREAM_THREADS,
+      g_param_spec_boolean ("receive-stream-threads", "Receive Stream Threads",
+          "Process the received RTP of each stream in its own thread",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCBin:pacing-bitrate:
+   *
+   * Rate in bits per second at which the RTP of each transport is sent out.
+   * Bursts larger than #GstWebRTCBin:pacing-burst-size, like keyframes, are
+   * spread over time at this rate instead of being sent at once.  The rate
+   * is lowered on packet loss when transport-wide congestion control
+   * feedback is available.  The time spent in the pacer is reported in the
+   * transport statistics.  Upstream is not blocked by pacing: once 5MB are
+   * waiting to be sent, further packets are dropped and counted in the
+   * packets-dropped field of the pacer statistics.  0 disables pacing.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_PACING_BITRATE,
+      g_param_spec_uint ("pacing-bitrate", "Pacing Bitrate",
+          "Rate in bits per second to pace outgoing RTP at (0 = no pacing)",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCBin:pacing-burst-size:
+   *
+   * Number of bytes that can be sent back to back when pacing.  Packets
+   * larger than this are still sent, one at a time.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_PACING_BURST_SIZE,
+      g_param_spec_uint ("pacing-burst-size", "Pacing Burst Size",
+          "Number of bytes that can be sent back to back when pacing",
+          0, G_MAXUINT, DEFAULT_PACING_BURST_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstWebRTCBin::create-offer:
    * @object: the #webrtcbin
@@ -6272,6 +6658,11 @@ gst_webrtc_bin_class_init (GstWebRTCBinClass * klass)
    * and is constantly changing these statistics may be changed to fit with
    * the latest spec.
    *
+   * If @pad is not %NULL, only the statistics selected for the sender (sink
+   * pads) or receiver (src pads) of that pad are returned following
+   * https://www.w3.org/TR/webrtc/#dfn-stats-selection-algorithm.  The RTP
+   * statistics are retrieved at most once per #GstWebRTCBin:stats-update-interval.
+   *
    * Each field key is a unique identifier for each RTCStats
    * (https://www.w3.org/TR/webrtc/#rtcstats-dictionary) value (another
    * GstStructure) in the RTCStatsReport
@@ -6328,6 +6719,16 @@ gst_webrtc_bin_class_init (GstWebRTCBinClass * klass)
    *
    *  "local-id"            G_TYPE_STRING               identifier for the associated RTCInboundRTPSTreamStats
    *
+   * RTCTransportStats supported fields (https://w3c.github.io/webrtc-stats/#transportstats-dict*)
+   *
+   *  "pacer-stats"         GST_TYPE_STRUCTURE          statistics of the send pacer of the transport, including
+   *                                                    "average-queue-delay" and "max-queue-delay" in nanoseconds (Since: 1.18)
+   *
+   * RTCIceCandidatePairStats supported fields (https://w3c.github.io/webrtc-stats/#candidatepair-dict*)
+   *
+   *  "gathering-time"      G_TYPE_UINT64               nanoseconds taken to gather the local candidates (Since: 1.18)
+   *  "connection-time"     G_TYPE_UINT64               nanoseconds from the first connectivity check until connected (Since: 1.18)
+   *
    */
   gst_webrtc_bin_signals[GET_STATS_SIGNAL] =
       g_signal_new_class_handler ("get-stats",
@@ -6335,6 +6736,27 @@ gst_webrtc_bin_class_init (GstWebRTCBinClass * klass)
       G_CALLBACK (gst_webrtc_bin_get_stats), NULL, NULL, NULL,
       G_TYPE_NONE, 2, GST_TYPE_PAD, GST_TYPE_PROMISE);
 
+  /**
+   * GstWebRTCBin::get-stats-by-type:
+   * @object: the #webrtcbin
+   * @pad: (nullable): A #GstPad to get the stats for, or %NULL for all
+   * @type: the #GstWebRTCStatsType to retrieve
+   * @promise: a #GstPromise for the result
+   *
+   * Like #GstWebRTCBin::get-stats but the result only contains the
+   * statistics of @type.  Only the statistics needed for @type are
+   * generated, which makes this cheaper than filtering the complete report
+   * in large sessions.
+   *
+   * Since: 1.18
+   */
+  gst_webrtc_bin_signals[GET_STATS_BY_TYPE_SIGNAL] =
+      g_signal_new_class_handler ("get-stats-by-type",
+      G_TYPE_FROM_CLASS (klass), G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_CALLBACK (gst_webrtc_bin_get_stats_by_type), NULL, NULL, NULL,
+      G_TYPE_NONE, 3, GST_TYPE_PAD, GST_TYPE_WEBRTC_STATS_TYPE,
+      GST_TYPE_PROMISE);
+
   /**
    * GstWebRTCBin::on-negotiation-needed:
    * @object: the #webrtcbin
@@ -6503,6 +6925,19 @@ gst_webrtc_bin_init (GstWebRTCBin * webrtc)
 
   webrtc->priv->transceivers =
       g_ptr_array_new_with_free_func ((GDestroyNotify) _unparent_and_unref);
+  webrtc->priv->transceivers_by_mid =
+      g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  webrtc->priv->transceivers_by_mline =
+      g_hash_table_new (g_direct_hash, g_direct_equal);
+  webrtc->priv->src_pads_by_mline =
+      g_hash_table_new (g_direct_hash, g_direct_equal);
+  webrtc->priv->sink_pads_by_mline =
+      g_hash_table_new (g_direct_hash, g_direct_equal);
+  webrtc->priv->pacing_burst_size = DEFAULT_PACING_BURST_SIZE;
+  webrtc->priv->applied_media =
+      g_array_new (FALSE, TRUE, sizeof (AppliedMediaItem));
+  g_array_set_clear_func (webrtc->priv->applied_media,
+      (GDestroyNotify) clear_applied_media_item);
   webrtc->priv->transports =
       g_ptr_array_new_with_free_func ((GDestroyNotify) _transport_free);
 
@@ -97,6 +97,9 @@ struct _GstWebRTCBinPrivate
 
   gboolean bundle;
   GPtrArray *transceivers;
+  /* lookup tables into transceivers, not holding references */
+  GHashTable *transceivers_by_mid;
+  GHashTable *transceivers_by_mline;
   GArray *session_mid_map;
   GPtrArray *transports;
   GPtrArray *data_channels;
@@ -129,6 +132,14 @@ struct _GstWebRTCBinPrivate
 
   GList *pending_pads;
   GList *pending_sink_transceivers;
+  /* mlineindex -> GstWebRTCBinPad for both pending and added pads, not
+   * holding references. Protected by the object lock */
+  GHashTable *src_pads_by_mline;
+  GHashTable *sink_pads_by_mline;
+
+  /* media sections as applied by the last stable description, used to skip
+   * unchanged m-lines on renegotiation. Array of AppliedMediaItem's */
+  GArray *applied_media;
 
   /* count of the number of media streams we've offered for uniqueness */
   /* FIXME: overflow? */
@@ -138,7 +149,23 @@ struct _GstWebRTCBinPrivate
   GstWebRTCSessionDescription *last_generated_offer;
   GstWebRTCSessionDescription *last_generated_answer;
 
+  /* last complete statistics report and when it was generated */
   GstStructure *stats;
+  gint64 stats_time;
+  /* rtp session id -> SessionStats, see gstwebrtcstats.c */
+  GHashTable *session_stats;
+  guint stats_generation;
+  /* in microseconds, protected by the object lock */
+  gint64 stats_update_interval;
+
+  /* whether new transports receive each stream in its own thread,
+   * protected by the object lock */
+  gboolean receive_stream_threads;
+
+  /* send pacing configuration for new and existing transports,
+   * protected by the object lock */
+  guint pacing_bitrate;
+  guint pacing_burst_size;
 };
 
 typedef void (*GstWebRTCBinFunc) (GstWebRTCBin * webrtc, gpointer data);
@@ -24,6 +24,7 @@
 #include "gstwebrtcice.h"
 /* libnice */
 #include <agent.h>
+#include <interfaces.h>
 #include "icestream.h"
 #include "nicetransport.h"
 
@@ -33,10 +34,24 @@
  */
 
 static GstUri *_validate_turn_server (GstWebRTCICE * ice, const gchar * s);
+static void _on_new_candidate (NiceAgent * agent, NiceCandidate * candidate,
+    GstWebRTCICE * ice);
 
 #define GST_CAT_DEFAULT gst_webrtc_ice_debug
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 
+/* nice_agent_new_full() and the nomination mode are only available since
+ * 0.1.15 */
+#ifdef NICE_CHECK_VERSION
+#if NICE_CHECK_VERSION (0, 1, 15)
+#define HAVE_NICE_NOMINATION_MODE 1
+#endif
+#endif
+
+#define DEFAULT_CHECK_PACING 20
+#define DEFAULT_LOCAL_ADDRESS_CACHE_TIME 0
+#define DEFAULT_AGGRESSIVE_NOMINATION TRUE
+
 GQuark
 gst_webrtc_ice_error_quark (void)
 {
@@ -63,6 +78,9 @@ enum
   PROP_FORCE_RELAY,
   PROP_ICE_TCP,
   PROP_ICE_UDP,
+  PROP_CHECK_PACING,
+  PROP_LOCAL_ADDRESS_CACHE_TIME,
+  PROP_AGGRESSIVE_NOMINATION,
 };
 
 static guint gst_webrtc_ice_signals[LAST_SIGNAL] = { 0 };
@@ -78,6 +96,12 @@ struct _GstWebRTCICEPrivate
   GMainLoop *loop;
   GMutex lock;
   GCond cond;
+
+  guint local_address_cache_time;
+  gboolean aggressive_nomination;
+  /* whether the agent was given an explicit list of local addresses, either
+   * by the application or from the cache */
+  gboolean have_local_addresses;
 };
 
 #define gst_webrtc_ice_parent_class parent_class
@@ -276,6 +300,111 @@ _create_nice_stream_item (GstWebRTCICE * ice, guint session_id)
   return _find_item (ice, item.session_id, item.nice_stream_id, item.stream);
 }
 
+/* Local interface enumeration shared by all agents in the process, libnice
+ * otherwise enumerates the interfaces again for every agent */
+static GList *cached_local_addresses = NULL;
+static gint64 cached_local_addresses_time = 0;
+G_LOCK_DEFINE_STATIC (cached_local_addresses);
+
+static GList *
+_get_local_addresses (guint cache_time)
+{
+  GList *ret;
+  gint64 now;
+
+  G_LOCK (cached_local_addresses);
+
+  now = g_get_monotonic_time ();
+  if (!cached_local_addresses
+      || now - cached_local_addresses_time >
+      (gint64) cache_time * G_USEC_PER_SEC) {
+    g_list_free_full (cached_local_addresses, g_free);
+    cached_local_addresses = nice_interfaces_get_local_ips (FALSE);
+    cached_local_addresses_time = g_get_monotonic_time ();
+    GST_DEBUG ("enumerated %u local addresses in %" G_GINT64_FORMAT " us",
+        g_list_length (cached_local_addresses),
+        cached_local_addresses_time - now);
+  }
+
+  ret = g_list_copy_deep (cached_local_addresses, (GCopyFunc) g_strdup, NULL);
+
+  G_UNLOCK (cached_local_addresses);
+
+  return ret;
+}
+
+static void
+_add_cached_local_addresses (GstWebRTCICE * ice)
+{
+  GList *addresses, *l;
+
+  addresses = _get_local_addresses (ice->priv->local_address_cache_time);
+
+  for (l = addresses; l; l = l->next) {
+    NiceAddress nice_addr;
+
+    nice_address_init (&nice_addr);
+    if (!nice_address_set_from_string (&nice_addr, l->data))
+      continue;
+
+    nice_agent_add_local_address (ice->priv->nice_agent, &nice_addr);
+  }
+
+  ice->priv->have_local_addresses = TRUE;
+
+  g_list_free_full (addresses, g_free);
+}
+
+static NiceAgent *
+_create_nice_agent (GstWebRTCICE * ice)
+{
+  NiceAgent *agent;
+
+#ifdef HAVE_NICE_NOMINATION_MODE
+  agent = nice_agent_new_full (ice->priv->main_context,
+      NICE_COMPATIBILITY_RFC5245,
+      ice->priv->aggressive_nomination ? 0 :
+      NICE_AGENT_OPTION_REGULAR_NOMINATION);
+#else
+  agent = nice_agent_new (ice->priv->main_context, NICE_COMPATIBILITY_RFC5245);
+#endif
+  g_signal_connect (agent, "new-candidate-full",
+      G_CALLBACK (_on_new_candidate), ice);
+
+  return agent;
+}
+
+/* The nomination mode can only be chosen when creating the agent, so replace
+ * it as long as nothing references it yet */
+static gboolean
+_recreate_nice_agent (GstWebRTCICE * ice)
+{
+  static const gchar *props[] = { "controlling-mode", "force-relay",
+    "ice-tcp", "ice-udp", "stun-pacing-timer"
+  };
+  NiceAgent *agent;
+  guint i;
+
+  if (ice->priv->nice_stream_map->len > 0 || ice->priv->have_local_addresses)
+    return FALSE;
+
+  agent = _create_nice_agent (ice);
+
+  for (i = 0; i < G_N_ELEMENTS (props); i++) {
+    GValue value = G_VALUE_INIT;
+
+    g_object_get_property (G_OBJECT (ice->priv->nice_agent), props[i], &value);
+    g_object_set_property (G_OBJECT (agent), props[i], &value);
+    g_value_unset (&value);
+  }
+
+  g_signal_handlers_disconnect_by_data (ice->priv->nice_agent, ice);
+  g_object_unref (ice->priv->nice_agent);
+  ice->priv->nice_agent = agent;
+
+  return TRUE;
+}
+
 static void
 _parse_userinfo (const gchar * userinfo, gchar ** user, gchar ** pass)
 {
@@ -685,6 +814,8 @@ gst_webrtc_ice_add_local_ip_address (GstWebRTCICE * ice, const gchar * address)
     ret = nice_agent_add_local_address (ice->priv->nice_agent, &nice_addr);
     if (!ret) {
       GST_ERROR_OBJECT (ice, "Failed to add local address to NiceAgent");
+    } else {
+      ice->priv->have_local_addresses = TRUE;
     }
   } else {
     GST_ERROR_OBJECT (ice, "Failed to initialize NiceAddress [%s]", address);
@@ -725,6 +856,10 @@ gst_webrtc_ice_gather_candidates (GstWebRTCICE * ice,
   GST_DEBUG_OBJECT (ice, "gather candidates for stream %u",
       item->nice_stream_id);
 
+  if (ice->priv->local_address_cache_time > 0
+      && !ice->priv->have_local_addresses)
+    _add_cached_local_addresses (ice);
+
   return gst_webrtc_ice_stream_gather_candidates (stream);
 }
 
@@ -866,6 +1001,31 @@ gst_webrtc_ice_set_property (GObject * object, guint prop_id,
       g_object_set_property (G_OBJECT (ice->priv->nice_agent),
           "ice-udp", value);
       break;
+    case PROP_CHECK_PACING:
+      g_object_set_property (G_OBJECT (ice->priv->nice_agent),
+          "stun-pacing-timer", value);
+      break;
+    case PROP_LOCAL_ADDRESS_CACHE_TIME:
+      ice->priv->local_address_cache_time = g_value_get_uint (value);
+      break;
+    case PROP_AGGRESSIVE_NOMINATION:{
+      gboolean aggressive = g_value_get_boolean (value);
+
+      if (aggressive == ice->priv->aggressive_nomination)
+        break;
+#ifdef HAVE_NICE_NOMINATION_MODE
+      ice->priv->aggressive_nomination = aggressive;
+      if (!_recreate_nice_agent (ice)) {
+        GST_WARNING_OBJECT (ice, "Can't change the nomination mode once "
+            "streams or local addresses have been added");
+        ice->priv->aggressive_nomination = !aggressive;
+      }
+#else
+      GST_WARNING_OBJECT (ice, "Changing the nomination mode requires "
+          "libnice >= 0.1.15");
+#endif
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -910,6 +1070,16 @@ gst_webrtc_ice_get_property (GObject * object, guint prop_id,
       g_object_get_property (G_OBJECT (ice->priv->nice_agent),
           "ice-udp", value);
       break;
+    case PROP_CHECK_PACING:
+      g_object_get_property (G_OBJECT (ice->priv->nice_agent),
+          "stun-pacing-timer", value);
+      break;
+    case PROP_LOCAL_ADDRESS_CACHE_TIME:
+      g_value_set_uint (value, ice->priv->local_address_cache_time);
+      break;
+    case PROP_AGGRESSIVE_NOMINATION:
+      g_value_set_boolean (value, ice->priv->aggressive_nomination);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -949,10 +1119,7 @@ gst_webrtc_ice_constructed (GObject * object)
 
   _start_thread (ice);
 
-  ice->priv->nice_agent = nice_agent_new (ice->priv->main_context,
-      NICE_COMPATIBILITY_RFC5245);
-  g_signal_connect (ice->priv->nice_agent, "new-candidate-full",
-      G_CALLBACK (_on_new_candidate), ice);
+  ice->priv->nice_agent = _create_nice_agent (ice);
 
   G_OBJECT_CLASS (parent_class)->constructed (object);
 }
@@ -1010,6 +1177,59 @@ gst_webrtc_ice_class_init (GstWebRTCICEClass * klass)
           "Whether the agent should use ICE-UDP when gathering candidates",
           TRUE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstWebRTCICE:check-pacing:
+   *
+   * Ta, the interval in milliseconds between two consecutive connectivity
+   * checks or STUN/TURN transactions.  Lower values speed up connection
+   * establishment when there are many candidate pairs, at the cost of
+   * burstier traffic.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_CHECK_PACING,
+      g_param_spec_uint ("check-pacing", "Check pacing",
+          "Interval in ms between connectivity checks (Ta)", 1, G_MAXUINT,
+          DEFAULT_CHECK_PACING, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCICE:local-address-cache-time:
+   *
+   * The time in seconds that the list of local interface addresses is reused
+   * for gathering host candidates.  The list is shared by all agents in the
+   * process, avoiding enumerating the interfaces for each new connection.
+   * 0 enumerates the interfaces every time.  Has no effect once local
+   * addresses were added with #GstWebRTCICE::add-local-ip-address.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_LOCAL_ADDRESS_CACHE_TIME,
+      g_param_spec_uint ("local-address-cache-time",
+          "Local address cache time",
+          "Time in seconds to reuse the enumerated local addresses "
+          "(0 = disabled)", 0, G_MAXUINT, DEFAULT_LOCAL_ADDRESS_CACHE_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCICE:aggressive-nomination:
+   *
+   * Whether the controlling agent nominates every candidate pair it sends a
+   * check on, instead of first checking and then nominating the best one.
+   * Aggressive nomination establishes the connection with fewer round trips.
+   * Can only be changed before any stream is added, and requires
+   * libnice >= 0.1.15.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_AGGRESSIVE_NOMINATION,
+      g_param_spec_boolean ("aggressive-nomination", "Aggressive nomination",
+          "Whether to use aggressive instead of regular nomination",
+          DEFAULT_AGGRESSIVE_NOMINATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstWebRTCICE::on-ice-candidate:
    * @object: the #GstWebRTCBin
@@ -1044,6 +1264,9 @@ gst_webrtc_ice_init (GstWebRTCICE * ice)
   g_mutex_init (&ice->priv->lock);
   g_cond_init (&ice->priv->cond);
 
+  ice->priv->local_address_cache_time = DEFAULT_LOCAL_ADDRESS_CACHE_TIME;
+  ice->priv->aggressive_nomination = DEFAULT_AGGRESSIVE_NOMINATION;
+
   ice->turn_servers =
       g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
       (GDestroyNotify) gst_uri_unref);
@@ -26,8 +26,11 @@
 
 #include "gstwebrtcstats.h"
 #include "gstwebrtcbin.h"
+#include "icestream.h"
+#include "nicetransport.h"
 #include "transportstream.h"
 #include "transportreceivebin.h"
+#include "transportsendbin.h"
 #include "utils.h"
 #include "webrtctransceiver.h"
 
@@ -68,6 +71,30 @@ _set_base_stats (GstStructure * s, GstWebRTCStatsType type, double ts,
   g_free (name);
 }
 
+typedef struct
+{
+  GstWebRTCBin *webrtc;
+  GstStructure *s;
+  /* the pad the statistics are selected for or %NULL for all pads */
+  GstPad *pad;
+  /* the only type of statistics to generate or 0 for all types */
+  GstWebRTCStatsType type;
+  gint64 now;
+  gint64 update_interval;
+} StatsContext;
+
+static gboolean
+_stats_type_wanted (StatsContext * ctx, GstWebRTCStatsType type)
+{
+  return ctx->type == 0 || ctx->type == type;
+}
+
+static gboolean
+_stats_have_id (StatsContext * ctx, const gchar * id)
+{
+  return gst_structure_has_field (ctx->s, id);
+}
+
 static GstStructure *
 _get_peer_connection_stats (GstWebRTCBin * webrtc)
 {
@@ -88,17 +115,16 @@ _get_peer_connection_stats (GstWebRTCBin * webrtc)
 /* https://www.w3.org/TR/webrtc-stats/#inboundrtpstats-dict*
    https://www.w3.org/TR/webrtc-stats/#outboundrtpstats-dict* */
 static void
-_get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
+_get_stats_from_rtp_source_stats (StatsContext * ctx,
     const GstStructure * source_stats, const gchar * codec_id,
-    const gchar * transport_id, GstStructure * s)
+    const gchar * transport_id, double ts)
 {
+  GstStructure *s = ctx->s;
   guint ssrc, fir, pli, nack, jitter;
   int lost, clock_rate;
   guint64 packets, bytes;
   gboolean internal;
-  double ts;
 
-  gst_structure_get_double (s, "timestamp", &ts);
   gst_structure_get (source_stats, "ssrc", G_TYPE_UINT, &ssrc, "clock-rate",
       G_TYPE_INT, &clock_rate, "internal", G_TYPE_BOOLEAN, &internal, NULL);
 
@@ -106,6 +132,10 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
     GstStructure *r_in, *out;
     gchar *out_id, *r_in_id;
 
+    if (!_stats_type_wanted (ctx, GST_WEBRTC_STATS_OUTBOUND_RTP)
+        && !_stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_INBOUND_RTP))
+      return;
+
     out_id = g_strdup_printf ("rtp-outbound-stream-stats_%u", ssrc);
     r_in_id = g_strdup_printf ("rtp-remote-inbound-stream-stats_%u", ssrc);
 
@@ -180,8 +210,10 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
     double              totalEncodeTime;
     double              averageRTCPInterval;
 */
-    gst_structure_set (s, out_id, GST_TYPE_STRUCTURE, out, NULL);
-    gst_structure_set (s, r_in_id, GST_TYPE_STRUCTURE, r_in, NULL);
+    if (_stats_type_wanted (ctx, GST_WEBRTC_STATS_OUTBOUND_RTP))
+      gst_structure_set (s, out_id, GST_TYPE_STRUCTURE, out, NULL);
+    if (_stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_INBOUND_RTP))
+      gst_structure_set (s, r_in_id, GST_TYPE_STRUCTURE, r_in, NULL);
 
     gst_structure_free (out);
     gst_structure_free (r_in);
@@ -193,6 +225,10 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
     gchar *r_out_id, *in_id;
     gboolean have_rb = FALSE, have_sr = FALSE;
 
+    if (!_stats_type_wanted (ctx, GST_WEBRTC_STATS_INBOUND_RTP)
+        && !_stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_OUTBOUND_RTP))
+      return;
+
     gst_structure_get (source_stats, "have-rb", G_TYPE_BOOLEAN, &have_rb,
         "have-sr", G_TYPE_BOOLEAN, &have_sr, NULL);
 
@@ -290,8 +326,10 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
 
     gst_structure_set (r_out, "local-id", G_TYPE_STRING, in_id, NULL);
 
-    gst_structure_set (s, in_id, GST_TYPE_STRUCTURE, in, NULL);
-    gst_structure_set (s, r_out_id, GST_TYPE_STRUCTURE, r_out, NULL);
+    if (_stats_type_wanted (ctx, GST_WEBRTC_STATS_INBOUND_RTP))
+      gst_structure_set (s, in_id, GST_TYPE_STRUCTURE, in, NULL);
+    if (_stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_OUTBOUND_RTP))
+      gst_structure_set (s, r_out_id, GST_TYPE_STRUCTURE, r_out, NULL);
 
     gst_structure_free (in);
     gst_structure_free (r_out);
@@ -303,16 +341,19 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
 
 /* https://www.w3.org/TR/webrtc-stats/#candidatepair-dict* */
 static gchar *
-_get_stats_from_ice_transport (GstWebRTCBin * webrtc,
-    GstWebRTCICETransport * transport, GstStructure * s)
+_get_stats_from_ice_transport (StatsContext * ctx,
+    GstWebRTCICETransport * transport)
 {
   GstStructure *stats;
   gchar *id;
-  double ts;
-
-  gst_structure_get_double (s, "timestamp", &ts);
+  double ts = ctx->now / 1000.0;
 
   id = g_strdup_printf ("ice-candidate-pair_%s", GST_OBJECT_NAME (transport));
+  /* bundled streams share the transport */
+  if (!_stats_type_wanted (ctx, GST_WEBRTC_STATS_TRANSPORT)
+      || _stats_have_id (ctx, id))
+    return id;
+
   stats = gst_structure_new_empty (id);
   _set_base_stats (stats, GST_WEBRTC_STATS_TRANSPORT, ts, id);
 
@@ -362,7 +403,22 @@ _get_stats_from_ice_transport (GstWebRTCBin * webrtc,
 };
 */
 
-  gst_structure_set (s, id, GST_TYPE_STRUCTURE, stats, NULL);
+  if (GST_IS_WEBRTC_NICE_TRANSPORT (transport)) {
+    GstWebRTCNiceTransport *nice = GST_WEBRTC_NICE_TRANSPORT (transport);
+    GstClockTime gathering_time, connection_time;
+
+    /* not part of the spec, time spent in ICE before media can flow */
+    gst_webrtc_ice_stream_get_timing (nice->stream, &gathering_time,
+        &connection_time);
+    if (GST_CLOCK_TIME_IS_VALID (gathering_time))
+      gst_structure_set (stats, "gathering-time", G_TYPE_UINT64,
+          gathering_time, NULL);
+    if (GST_CLOCK_TIME_IS_VALID (connection_time))
+      gst_structure_set (stats, "connection-time", G_TYPE_UINT64,
+          connection_time, NULL);
+  }
+
+  gst_structure_set (ctx->s, id, GST_TYPE_STRUCTURE, stats, NULL);
   gst_structure_free (stats);
 
   return id;
@@ -370,17 +426,19 @@ _get_stats_from_ice_transport (GstWebRTCBin * webrtc,
 
 /* https://www.w3.org/TR/webrtc-stats/#dom-rtctransportstats */
 static gchar *
-_get_stats_from_dtls_transport (GstWebRTCBin * webrtc,
-    GstWebRTCDTLSTransport * transport, GstStructure * s)
+_get_stats_from_dtls_transport (StatsContext * ctx, TransportStream * stream,
+    GstWebRTCDTLSTransport * transport)
 {
   GstStructure *stats;
   gchar *id;
-  double ts;
+  double ts = ctx->now / 1000.0;
   gchar *ice_id;
 
-  gst_structure_get_double (s, "timestamp", &ts);
-
   id = g_strdup_printf ("transport-stats_%s", GST_OBJECT_NAME (transport));
+  if (!_stats_type_wanted (ctx, GST_WEBRTC_STATS_TRANSPORT)
+      || _stats_have_id (ctx, id))
+    return id;
+
   stats = gst_structure_new_empty (id);
   _set_base_stats (stats, GST_WEBRTC_STATS_TRANSPORT, ts, id);
 
@@ -416,85 +474,166 @@ _get_stats_from_dtls_transport (GstWebRTCBin * webrtc,
     boolean             deleted = false;
 */
 
-  gst_structure_set (s, id, GST_TYPE_STRUCTURE, stats, NULL);
+  if (stream->send_bin && transport == stream->transport) {
+    GstStructure *pacer_stats;
+
+    g_object_get (stream->send_bin->pacer, "stats", &pacer_stats, NULL);
+    gst_structure_set (stats, "pacer-stats", GST_TYPE_STRUCTURE, pacer_stats,
+        NULL);
+    gst_structure_free (pacer_stats);
+  }
+
+  gst_structure_set (ctx->s, id, GST_TYPE_STRUCTURE, stats, NULL);
   gst_structure_free (stats);
 
-  ice_id = _get_stats_from_ice_transport (webrtc, transport->transport, s);
+  ice_id = _get_stats_from_ice_transport (ctx, transport->transport);
   g_free (ice_id);
 
   return id;
 }
 
+typedef struct
+{
+  GValueArray *source_stats;
+  gint64 update_time;
+  guint generation;
+} SessionStats;
+
 static void
-_get_stats_from_transport_channel (GstWebRTCBin * webrtc,
-    TransportStream * stream, const gchar * codec_id, guint ssrc,
-    GstStructure * s)
+_free_session_stats (SessionStats * item)
+{
+  if (item->source_stats)
+    g_value_array_free (item->source_stats);
+  g_free (item);
+}
+
+/* Retrieving the statistics from the rtpsession walks all its sources under
+ * the session lock.  The result is cached per session so that bundled
+ * streams only retrieve them once for each report and reports requested
+ * within the update interval reuse the previous values. */
+static SessionStats *
+_get_session_stats (StatsContext * ctx, guint session_id)
+{
+  GstWebRTCBinPrivate *priv = ctx->webrtc->priv;
+  SessionStats *item;
+  GObject *rtp_session = NULL;
+  GstStructure *rtp_stats = NULL;
+  GValueArray *source_stats = NULL;
+
+  if (!priv->session_stats)
+    priv->session_stats = g_hash_table_new_full (g_direct_hash,
+        g_direct_equal, NULL, (GDestroyNotify) _free_session_stats);
+
+  item = g_hash_table_lookup (priv->session_stats,
+      GUINT_TO_POINTER (session_id));
+  if (item && (item->generation == priv->stats_generation
+          || ctx->now - item->update_time < ctx->update_interval))
+    return item;
+
+  g_signal_emit_by_name (ctx->webrtc->rtpbin, "get-internal-session",
+      session_id, &rtp_session);
+  if (!rtp_session)
+    return item;
+
+  g_object_get (rtp_session, "stats", &rtp_stats, NULL);
+  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
+      &source_stats, NULL);
+
+  GST_DEBUG_OBJECT (ctx->webrtc, "retrieved stats from rtp session %"
+      GST_PTR_FORMAT " with %u rtp sources", rtp_session,
+      source_stats ? source_stats->n_values : 0);
+
+  if (!item) {
+    item = g_new0 (SessionStats, 1);
+    g_hash_table_insert (priv->session_stats, GUINT_TO_POINTER (session_id),
+        item);
+  } else if (item->source_stats) {
+    g_value_array_free (item->source_stats);
+  }
+  item->source_stats = source_stats;
+  item->update_time = ctx->now;
+  item->generation = priv->stats_generation;
+
+  g_object_unref (rtp_session);
+  gst_structure_free (rtp_stats);
+
+  return item;
+}
+
+static gboolean
+_rtp_stats_wanted (StatsContext * ctx)
+{
+  return _stats_type_wanted (ctx, GST_WEBRTC_STATS_INBOUND_RTP)
+      || _stats_type_wanted (ctx, GST_WEBRTC_STATS_OUTBOUND_RTP)
+      || _stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_INBOUND_RTP)
+      || _stats_type_wanted (ctx, GST_WEBRTC_STATS_REMOTE_OUTBOUND_RTP);
+}
+
+static void
+_get_stats_from_transport_channel (StatsContext * ctx,
+    TransportStream * stream, const gchar * codec_id, guint ssrc)
 {
   GstWebRTCDTLSTransport *transport;
-  GObject *rtp_session;
-  GstStructure *rtp_stats;
-  GValueArray *source_stats;
+  SessionStats *session_stats;
   gchar *transport_id;
-  double ts;
   int i;
 
-  gst_structure_get_double (s, "timestamp", &ts);
-
   transport = stream->transport;
-  if (!transport)
-    transport = stream->transport;
   if (!transport)
     return;
 
-  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
-      stream->session_id, &rtp_session);
-  g_object_get (rtp_session, "stats", &rtp_stats, NULL);
+  GST_DEBUG_OBJECT (ctx->webrtc, "retrieving rtp stream stats from transport %"
+      GST_PTR_FORMAT " with transport %" GST_PTR_FORMAT, stream, transport);
 
-  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
-      &source_stats, NULL);
+  transport_id = _get_stats_from_dtls_transport (ctx, stream, transport);
 
-  GST_DEBUG_OBJECT (webrtc, "retrieving rtp stream stats from transport %"
-      GST_PTR_FORMAT " rtp session %" GST_PTR_FORMAT " with %u rtp sources, "
-      "transport %" GST_PTR_FORMAT, stream, rtp_session, source_stats->n_values,
-      transport);
+  if (!_rtp_stats_wanted (ctx))
+    goto out;
 
-  transport_id = _get_stats_from_dtls_transport (webrtc, transport, s);
+  session_stats = _get_session_stats (ctx, stream->session_id);
+  if (!session_stats || !session_stats->source_stats)
+    goto out;
 
   /* construct stats objects */
-  for (i = 0; i < source_stats->n_values; i++) {
+  for (i = 0; i < session_stats->source_stats->n_values; i++) {
     const GstStructure *stats;
-    const GValue *val = g_value_array_get_nth (source_stats, i);
+    const GValue *val =
+        g_value_array_get_nth (session_stats->source_stats, i);
     guint stats_ssrc = 0;
+    gboolean internal = FALSE;
 
     stats = gst_value_get_structure (val);
 
     /* skip foreign sources */
-    gst_structure_get (stats, "ssrc", G_TYPE_UINT, &stats_ssrc, NULL);
+    gst_structure_get (stats, "ssrc", G_TYPE_UINT, &stats_ssrc, "internal",
+        G_TYPE_BOOLEAN, &internal, NULL);
     if (ssrc && stats_ssrc && ssrc != stats_ssrc)
       continue;
 
-    _get_stats_from_rtp_source_stats (webrtc, stats, codec_id, transport_id, s);
+    /* a sender only selects the local sources and a receiver the remote ones
+     * https://www.w3.org/TR/webrtc/#dfn-stats-selection-algorithm */
+    if (ctx->pad && internal != (GST_PAD_DIRECTION (ctx->pad) == GST_PAD_SINK))
+      continue;
+
+    _get_stats_from_rtp_source_stats (ctx, stats, codec_id, transport_id,
+        session_stats->update_time / 1000.0);
   }
 
-  g_object_unref (rtp_session);
-  gst_structure_free (rtp_stats);
-  g_value_array_free (source_stats);
+out:
   g_free (transport_id);
 }
 
 /* https://www.w3.org/TR/webrtc-stats/#codec-dict* */
 static void
-_get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
-    GstStructure * s, gchar ** out_id, guint * out_ssrc)
+_get_codec_stats_from_pad (StatsContext * ctx, GstPad * pad,
+    gchar ** out_id, guint * out_ssrc)
 {
   GstStructure *stats;
   GstCaps *caps;
   gchar *id;
-  double ts;
+  double ts = ctx->now / 1000.0;
   guint ssrc = 0;
 
-  gst_structure_get_double (s, "timestamp", &ts);
-
   stats = gst_structure_new_empty ("unused");
   id = g_strdup_printf ("codec-stats-%s", GST_OBJECT_NAME (pad));
   _set_base_stats (stats, GST_WEBRTC_STATS_CODEC, ts, id);
@@ -519,7 +658,8 @@ _get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
   if (caps)
     gst_caps_unref (caps);
 
-  gst_structure_set (s, id, GST_TYPE_STRUCTURE, stats, NULL);
+  if (_stats_type_wanted (ctx, GST_WEBRTC_STATS_CODEC))
+    gst_structure_set (ctx->s, id, GST_TYPE_STRUCTURE, stats, NULL);
   gst_structure_free (stats);
 
   if (out_id)
@@ -532,14 +672,14 @@ _get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
 }
 
 static gboolean
-_get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
+_get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, StatsContext * ctx)
 {
   GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (pad);
   TransportStream *stream;
   gchar *codec_id;
   guint ssrc;
 
-  _get_codec_stats_from_pad (webrtc, pad, s, &codec_id, &ssrc);
+  _get_codec_stats_from_pad (ctx, pad, &codec_id, &ssrc);
 
   if (!wpad->trans)
     goto out;
@@ -548,43 +688,74 @@ _get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
   if (!stream)
     goto out;
 
-  _get_stats_from_transport_channel (webrtc, stream, codec_id, ssrc, s);
+  _get_stats_from_transport_channel (ctx, stream, codec_id, ssrc);
 
 out:
   g_free (codec_id);
   return TRUE;
 }
 
-void
-gst_webrtc_bin_update_stats (GstWebRTCBin * webrtc)
+GstStructure *
+gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc, GstPad * pad,
+    GstWebRTCStatsType type)
 {
-  GstStructure *s = gst_structure_new_empty ("application/x-webrtc-stats");
-  double ts = monotonic_time_as_double_milliseconds ();
-  GstStructure *pc_stats;
+  GstWebRTCBinPrivate *priv = webrtc->priv;
+  GstStructure *s;
+  StatsContext ctx;
+  double ts;
 
   _init_debug ();
 
-  gst_structure_set (s, "timestamp", G_TYPE_DOUBLE, ts, NULL);
+  ctx.webrtc = webrtc;
+  ctx.pad = pad;
+  ctx.type = type;
+  ctx.now = g_get_monotonic_time ();
+  GST_OBJECT_LOCK (webrtc);
+  ctx.update_interval = priv->stats_update_interval;
+  GST_OBJECT_UNLOCK (webrtc);
+
+  /* a complete report that is recent enough is handed out again */
+  if (!pad && type == 0 && priv->stats
+      && ctx.now - priv->stats_time < ctx.update_interval) {
+    GST_LOG_OBJECT (webrtc, "reusing stats from %" G_GINT64_FORMAT,
+        priv->stats_time);
+    return gst_structure_copy (priv->stats);
+  }
+
+  s = gst_structure_new_empty ("application/x-webrtc-stats");
+  ctx.s = s;
+  ts = ctx.now / 1000.0;
+  priv->stats_generation++;
 
   /* FIXME: better unique IDs */
-  /* FIXME: rate limitting stat updates? */
   /* FIXME: all stats need to be kept forever */
 
-  GST_DEBUG_OBJECT (webrtc, "updating stats at time %f", ts);
+  GST_DEBUG_OBJECT (webrtc, "updating stats at time %f for pad %"
+      GST_PTR_FORMAT " and type %u", ts, pad, type);
 
-  if ((pc_stats = _get_peer_connection_stats (webrtc))) {
-    const gchar *id = "peer-connection-stats";
-    _set_base_stats (pc_stats, GST_WEBRTC_STATS_PEER_CONNECTION, ts, id);
-    gst_structure_set (s, id, GST_TYPE_STRUCTURE, pc_stats, NULL);
-    gst_structure_free (pc_stats);
-  }
+  if (pad) {
+    _get_stats_from_pad (webrtc, pad, &ctx);
+  } else {
+    GstStructure *pc_stats;
+
+    if (_stats_type_wanted (&ctx, GST_WEBRTC_STATS_PEER_CONNECTION)
+        && (pc_stats = _get_peer_connection_stats (webrtc))) {
+      const gchar *id = "peer-connection-stats";
+      _set_base_stats (pc_stats, GST_WEBRTC_STATS_PEER_CONNECTION, ts, id);
+      gst_structure_set (s, id, GST_TYPE_STRUCTURE, pc_stats, NULL);
+      gst_structure_free (pc_stats);
+    }
 
-  gst_element_foreach_pad (GST_ELEMENT (webrtc),
-      (GstElementForeachPadFunc) _get_stats_from_pad, s);
+    gst_element_foreach_pad (GST_ELEMENT (webrtc),
+        (GstElementForeachPadFunc) _get_stats_from_pad, &ctx);
+  }
 
-  gst_structure_remove_field (s, "timestamp");
+  if (!pad && type == 0) {
+    if (priv->stats)
+      gst_structure_free (priv->stats);
+    priv->stats = gst_structure_copy (s);
+    priv->stats_time = ctx.now;
+  }
 
-  if (webrtc->priv->stats)
-    gst_structure_free (webrtc->priv->stats);
-  webrtc->priv->stats = s;
+  return s;
 }
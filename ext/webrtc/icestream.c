@@ -46,6 +46,14 @@ struct _GstWebRTCICEStreamPrivate
 {
   gboolean gathered;
   GList *transports;
+  /* the agent the signal handlers are connected to */
+  NiceAgent *agent;
+
+  /* monotonic times in us, 0 if not reached yet */
+  gint64 gathering_start;
+  gint64 gathering_done;
+  gint64 checking_start;
+  gint64 connected;
 };
 
 #define gst_webrtc_ice_stream_parent_class parent_class
@@ -93,6 +101,20 @@ gst_webrtc_ice_stream_get_property (GObject * object, guint prop_id,
   }
 }
 
+static void
+gst_webrtc_ice_stream_dispose (GObject * object)
+{
+  GstWebRTCICEStream *stream = GST_WEBRTC_ICE_STREAM (object);
+
+  if (stream->priv->agent) {
+    g_signal_handlers_disconnect_by_data (stream->priv->agent, stream);
+    g_object_unref (stream->priv->agent);
+    stream->priv->agent = NULL;
+  }
+
+  G_OBJECT_CLASS (parent_class)->dispose (object);
+}
+
 static void
 gst_webrtc_ice_stream_finalize (GObject * object)
 {
@@ -113,6 +135,11 @@ _on_candidate_gathering_done (NiceAgent * agent, guint stream_id,
   if (stream_id != ice->stream_id)
     return;
 
+  GST_OBJECT_LOCK (ice);
+  if (!ice->priv->gathering_done)
+    ice->priv->gathering_done = g_get_monotonic_time ();
+  GST_OBJECT_UNLOCK (ice);
+
   GST_DEBUG_OBJECT (ice, "%u gathering done", stream_id);
 
   ice->priv->gathered = TRUE;
@@ -125,6 +152,60 @@ _on_candidate_gathering_done (NiceAgent * agent, guint stream_id,
   }
 }
 
+static void
+_on_component_state_changed (NiceAgent * agent, guint stream_id,
+    NiceComponentType component, NiceComponentState state,
+    GstWebRTCICEStream * ice)
+{
+  gint64 now;
+
+  if (stream_id != ice->stream_id)
+    return;
+
+  now = g_get_monotonic_time ();
+
+  GST_OBJECT_LOCK (ice);
+  if (state == NICE_COMPONENT_STATE_CONNECTING && !ice->priv->checking_start) {
+    ice->priv->checking_start = now;
+  } else if ((state == NICE_COMPONENT_STATE_CONNECTED
+          || state == NICE_COMPONENT_STATE_READY) && !ice->priv->connected) {
+    ice->priv->connected = now;
+    GST_DEBUG_OBJECT (ice, "%u connected after %" G_GINT64_FORMAT " us of "
+        "checks", stream_id, ice->priv->checking_start ?
+        now - ice->priv->checking_start : 0);
+  }
+  GST_OBJECT_UNLOCK (ice);
+}
+
+/* Times are GST_CLOCK_TIME_NONE until the respective phase has finished.  The
+ * connection time is measured from the first connectivity check. */
+void
+gst_webrtc_ice_stream_get_timing (GstWebRTCICEStream * stream,
+    GstClockTime * gathering_time, GstClockTime * connection_time)
+{
+  GstWebRTCICEStreamPrivate *priv;
+
+  g_return_if_fail (GST_IS_WEBRTC_ICE_STREAM (stream));
+
+  priv = stream->priv;
+
+  GST_OBJECT_LOCK (stream);
+  if (gathering_time) {
+    if (priv->gathering_start && priv->gathering_done)
+      *gathering_time =
+          (priv->gathering_done - priv->gathering_start) * GST_USECOND;
+    else
+      *gathering_time = GST_CLOCK_TIME_NONE;
+  }
+  if (connection_time) {
+    if (priv->checking_start && priv->connected)
+      *connection_time = (priv->connected - priv->checking_start) * GST_USECOND;
+    else
+      *connection_time = GST_CLOCK_TIME_NONE;
+  }
+  GST_OBJECT_UNLOCK (stream);
+}
+
 GstWebRTCICETransport *
 gst_webrtc_ice_stream_find_transport (GstWebRTCICEStream * stream,
     GstWebRTCICEComponent component)
@@ -157,11 +238,13 @@ gst_webrtc_ice_stream_constructed (GObject * object)
   GstWebRTCICEStream *stream = GST_WEBRTC_ICE_STREAM (object);
   NiceAgent *agent;
 
+  /* keep the agent so that dispose can disconnect from it */
   g_object_get (stream->ice, "agent", &agent, NULL);
   g_signal_connect (agent, "candidate-gathering-done",
       G_CALLBACK (_on_candidate_gathering_done), stream);
-
-  g_object_unref (agent);
+  g_signal_connect (agent, "component-state-changed",
+      G_CALLBACK (_on_component_state_changed), stream);
+  stream->priv->agent = agent;
 
   G_OBJECT_CLASS (parent_class)->constructed (object);
 }
@@ -179,6 +262,11 @@ gst_webrtc_ice_stream_gather_candidates (GstWebRTCICEStream * stream)
   if (stream->priv->gathered)
     return TRUE;
 
+  GST_OBJECT_LOCK (stream);
+  if (!stream->priv->gathering_start)
+    stream->priv->gathering_start = g_get_monotonic_time ();
+  GST_OBJECT_UNLOCK (stream);
+
   for (l = stream->priv->transports; l; l = l->next) {
     GstWebRTCICETransport *trans = l->data;
 
@@ -204,6 +292,7 @@ gst_webrtc_ice_stream_class_init (GstWebRTCICEStreamClass * klass)
   gobject_class->constructed = gst_webrtc_ice_stream_constructed;
   gobject_class->get_property = gst_webrtc_ice_stream_get_property;
   gobject_class->set_property = gst_webrtc_ice_stream_set_property;
+  gobject_class->dispose = gst_webrtc_ice_stream_dispose;
   gobject_class->finalize = gst_webrtc_ice_stream_finalize;
 
   g_object_class_install_property (gobject_class,
@@ -57,6 +57,9 @@ GstWebRTCICEStream *        gst_webrtc_ice_stream_new                   (GstWebR
 GstWebRTCICETransport *     gst_webrtc_ice_stream_find_transport        (GstWebRTCICEStream * stream,
                                                                          GstWebRTCICEComponent component);
 gboolean                    gst_webrtc_ice_stream_gather_candidates     (GstWebRTCICEStream * ice);
+void                        gst_webrtc_ice_stream_get_timing            (GstWebRTCICEStream * stream,
+                                                                         GstClockTime * gathering_time,
+                                                                         GstClockTime * connection_time);
 
 G_END_DECLS
 
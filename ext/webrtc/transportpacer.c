@@ -0,0 +1,649 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "transportpacer.h"
+
+/*
+ * Spreads the outgoing RTP packets of a transport over time with a token
+ * bucket.  The bucket fills at the pacing bitrate and holds at most
+ * burst-size bytes, so a keyframe of hundreds of packets leaves at the
+ * pacing rate instead of all at once.  The bucket always holds at least the
+ * packet that is next in line, so a burst-size below the packet size only
+ * disables back to back sending.  Packets that waited longer than
+ * max-delay are sent regardless to bound the added latency.
+ *
+ * Upstream is never blocked: when more than 5MB are waiting, new packets are
+ * dropped and counted in the packets-dropped statistic.  This only happens
+ * when the pacing bitrate is far below the rate of the sent media.
+ *
+ * Without a pacing bitrate the packets pass through in the streaming thread
+ * of upstream.
+ *
+ * The pacing rate starts at the configured bitrate and follows the loss
+ * based controller of draft-ietf-rmcat-gcc when congestion feedback is
+ * provided with transport_pacer_update_feedback().
+ */
+
+#define GST_CAT_DEFAULT gst_webrtc_transport_pacer_debug
+GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
+
+#define transport_pacer_parent_class parent_class
+G_DEFINE_TYPE_WITH_CODE (TransportPacer, transport_pacer, GST_TYPE_ELEMENT,
+    GST_DEBUG_CATEGORY_INIT (gst_webrtc_transport_pacer_debug,
+        "webrtctransportpacer", 0, "webrtctransportpacer"););
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("application/x-rtp"));
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("application/x-rtp"));
+
+enum
+{
+  PROP_0,
+  PROP_BITRATE,
+  PROP_BURST_SIZE,
+  PROP_MAX_DELAY,
+  PROP_STATS,
+};
+
+#define DEFAULT_BITRATE 0
+#define DEFAULT_BURST_SIZE (10 * 1200)
+#define DEFAULT_MAX_DELAY (200 * GST_MSECOND)
+
+/* never pace below this, whatever the feedback */
+#define MIN_BITRATE (30 * 1000)
+#define MAX_QUEUED_BYTES (5 * 1024 * 1024)
+
+#define PACER_LOCK(p) g_mutex_lock (&(p)->lock)
+#define PACER_UNLOCK(p) g_mutex_unlock (&(p)->lock)
+
+typedef struct
+{
+  GstMiniObject *object;
+  gsize size;
+  gint64 enqueue_time;
+} PacerItem;
+
+static void
+_free_pacer_item (PacerItem * item)
+{
+  if (item->object)
+    gst_mini_object_unref (item->object);
+  g_free (item);
+}
+
+/* with the pacer lock */
+static void
+_clear_queue (TransportPacer * pacer)
+{
+  PacerItem *item;
+
+  while ((item = g_queue_pop_head (&pacer->queue)))
+    _free_pacer_item (item);
+  pacer->queued_bytes = 0;
+}
+
+/* with the pacer lock */
+static gboolean
+_can_pass_through (TransportPacer * pacer)
+{
+  return pacer->target_bitrate == 0 && !pacer->pushing
+      && g_queue_is_empty (&pacer->queue);
+}
+
+/* with the pacer lock */
+static gboolean
+_enqueue (TransportPacer * pacer, GstMiniObject * object, gsize size)
+{
+  PacerItem *item;
+
+  if (size && pacer->queued_bytes + size > MAX_QUEUED_BYTES) {
+    GST_WARNING_OBJECT (pacer, "Pacer queue overrun. Dropping data");
+    pacer->packets_dropped++;
+    gst_mini_object_unref (object);
+    return FALSE;
+  }
+
+  item = g_new0 (PacerItem, 1);
+  item->object = object;
+  item->size = size;
+  item->enqueue_time = g_get_monotonic_time ();
+
+  g_queue_push_tail (&pacer->queue, item);
+  pacer->queued_bytes += size;
+  g_cond_signal (&pacer->cond);
+
+  return TRUE;
+}
+
+/* with the pacer lock. The bucket can grow to the size of the next packet
+ * even with a smaller burst-size, otherwise that packet could never be sent */
+static void
+_refill_tokens (TransportPacer * pacer, gint64 now, gsize next_size)
+{
+  gint64 elapsed = now - pacer->last_refill;
+
+  if (elapsed <= 0)
+    return;
+
+  pacer->tokens += gst_util_uint64_scale (elapsed, pacer->bitrate,
+      8 * G_USEC_PER_SEC);
+  pacer->tokens = MIN (pacer->tokens, MAX (pacer->burst_size, next_size));
+  pacer->last_refill = now;
+}
+
+static void
+transport_pacer_loop (GstPad * pad)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (GST_PAD_PARENT (pad));
+  GstFlowReturn ret = GST_FLOW_OK;
+  PacerItem *item;
+  gint64 now;
+
+  PACER_LOCK (pacer);
+  while (TRUE) {
+    gint64 max_delay, wait_until;
+
+    if (pacer->flushing)
+      goto flushing;
+
+    item = g_queue_peek_head (&pacer->queue);
+    if (!item || pacer->pushing) {
+      g_cond_wait (&pacer->cond, &pacer->lock);
+      continue;
+    }
+
+    /* serialized events and anything queued before pacing was disabled
+     * go out right away */
+    if (!GST_IS_BUFFER (item->object) || pacer->bitrate == 0)
+      break;
+
+    now = g_get_monotonic_time ();
+    _refill_tokens (pacer, now, item->size);
+    if (pacer->tokens >= item->size) {
+      pacer->tokens -= item->size;
+      break;
+    }
+
+    max_delay = pacer->max_delay / GST_USECOND;
+    if (now - item->enqueue_time >= max_delay) {
+      GST_LOG_OBJECT (pacer, "packet exceeded the maximum delay, sending");
+      pacer->tokens = 0;
+      break;
+    }
+
+    wait_until = now + gst_util_uint64_scale_ceil (item->size - pacer->tokens,
+        8 * G_USEC_PER_SEC, pacer->bitrate);
+    wait_until = MIN (wait_until, item->enqueue_time + max_delay);
+    g_cond_wait_until (&pacer->cond, &pacer->lock, wait_until);
+  }
+
+  g_queue_pop_head (&pacer->queue);
+  pacer->queued_bytes -= item->size;
+  if (GST_IS_BUFFER (item->object)) {
+    GstClockTime delay;
+
+    now = g_get_monotonic_time ();
+    delay = (now - item->enqueue_time) * GST_USECOND;
+    pacer->packets_sent++;
+    pacer->total_delay += delay;
+    pacer->max_seen_delay = MAX (pacer->max_seen_delay, delay);
+  }
+  pacer->pushing = TRUE;
+  PACER_UNLOCK (pacer);
+
+  if (GST_IS_BUFFER (item->object)) {
+    ret = gst_pad_push (pacer->srcpad, GST_BUFFER (item->object));
+  } else {
+    GstEvent *event = GST_EVENT (item->object);
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_EOS)
+      ret = GST_FLOW_EOS;
+    gst_pad_push_event (pacer->srcpad, event);
+  }
+  item->object = NULL;
+  _free_pacer_item (item);
+
+  PACER_LOCK (pacer);
+  pacer->pushing = FALSE;
+  g_cond_broadcast (&pacer->cond);
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_NOT_LINKED) {
+    GST_DEBUG_OBJECT (pacer, "pausing task, reason %s",
+        gst_flow_get_name (ret));
+    pacer->src_ret = ret;
+    PACER_UNLOCK (pacer);
+    gst_pad_pause_task (pacer->srcpad);
+    return;
+  }
+  PACER_UNLOCK (pacer);
+  return;
+
+flushing:
+  {
+    GST_DEBUG_OBJECT (pacer, "pausing task, flushing");
+    PACER_UNLOCK (pacer);
+    gst_pad_pause_task (pacer->srcpad);
+    return;
+  }
+}
+
+/* with the pacer lock, returns whether data should be accepted */
+static gboolean
+_check_src_ret (TransportPacer * pacer, GstFlowReturn * ret)
+{
+  *ret = pacer->src_ret;
+  if (pacer->flushing)
+    *ret = GST_FLOW_FLUSHING;
+
+  return *ret == GST_FLOW_OK || *ret == GST_FLOW_NOT_LINKED;
+}
+
+static GstFlowReturn
+_push_through (TransportPacer * pacer, GstBuffer * buffer,
+    GstBufferList * list)
+{
+  GstFlowReturn ret;
+
+  pacer->pushing = TRUE;
+  PACER_UNLOCK (pacer);
+
+  if (buffer)
+    ret = gst_pad_push (pacer->srcpad, buffer);
+  else
+    ret = gst_pad_push_list (pacer->srcpad, list);
+
+  PACER_LOCK (pacer);
+  pacer->pushing = FALSE;
+  g_cond_broadcast (&pacer->cond);
+  PACER_UNLOCK (pacer);
+
+  return ret;
+}
+
+static GstFlowReturn
+transport_pacer_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (parent);
+  GstFlowReturn ret;
+
+  PACER_LOCK (pacer);
+  if (!_check_src_ret (pacer, &ret)) {
+    PACER_UNLOCK (pacer);
+    gst_buffer_unref (buffer);
+    return ret;
+  }
+
+  if (_can_pass_through (pacer))
+    return _push_through (pacer, buffer, NULL);
+
+  _enqueue (pacer, GST_MINI_OBJECT_CAST (buffer),
+      gst_buffer_get_size (buffer));
+  PACER_UNLOCK (pacer);
+
+  return ret;
+}
+
+static GstFlowReturn
+transport_pacer_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (parent);
+  GstFlowReturn ret;
+  guint i, len;
+
+  PACER_LOCK (pacer);
+  if (!_check_src_ret (pacer, &ret)) {
+    PACER_UNLOCK (pacer);
+    gst_buffer_list_unref (list);
+    return ret;
+  }
+
+  if (_can_pass_through (pacer))
+    return _push_through (pacer, NULL, list);
+
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+
+    _enqueue (pacer, GST_MINI_OBJECT_CAST (gst_buffer_ref (buffer)),
+        gst_buffer_get_size (buffer));
+  }
+  PACER_UNLOCK (pacer);
+
+  gst_buffer_list_unref (list);
+
+  return ret;
+}
+
+static gboolean
+transport_pacer_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (parent);
+  gboolean ret = TRUE;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      ret = gst_pad_push_event (pacer->srcpad, event);
+
+      PACER_LOCK (pacer);
+      pacer->flushing = TRUE;
+      pacer->src_ret = GST_FLOW_FLUSHING;
+      g_cond_broadcast (&pacer->cond);
+      PACER_UNLOCK (pacer);
+
+      gst_pad_pause_task (pacer->srcpad);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      ret = gst_pad_push_event (pacer->srcpad, event);
+
+      PACER_LOCK (pacer);
+      _clear_queue (pacer);
+      pacer->flushing = FALSE;
+      pacer->src_ret = GST_FLOW_OK;
+      PACER_UNLOCK (pacer);
+
+      gst_pad_start_task (pacer->srcpad,
+          (GstTaskFunction) transport_pacer_loop, pacer->srcpad, NULL);
+      break;
+    default:
+      if (!GST_EVENT_IS_SERIALIZED (event))
+        return gst_pad_event_default (pad, parent, event);
+
+      PACER_LOCK (pacer);
+      if (pacer->flushing) {
+        PACER_UNLOCK (pacer);
+        gst_event_unref (event);
+        return FALSE;
+      }
+      if (_can_pass_through (pacer)) {
+        pacer->pushing = TRUE;
+        PACER_UNLOCK (pacer);
+
+        ret = gst_pad_push_event (pacer->srcpad, event);
+
+        PACER_LOCK (pacer);
+        pacer->pushing = FALSE;
+        g_cond_broadcast (&pacer->cond);
+        PACER_UNLOCK (pacer);
+        break;
+      }
+      _enqueue (pacer, GST_MINI_OBJECT_CAST (event), 0);
+      PACER_UNLOCK (pacer);
+      break;
+  }
+
+  return ret;
+}
+
+void
+transport_pacer_update_feedback (TransportPacer * pacer,
+    guint received_bitrate, gdouble packet_loss_pct)
+{
+  guint bitrate;
+
+  g_return_if_fail (pacer != NULL);
+
+  PACER_LOCK (pacer);
+  if (pacer->target_bitrate == 0) {
+    PACER_UNLOCK (pacer);
+    return;
+  }
+
+  bitrate = pacer->bitrate;
+  if (packet_loss_pct > 10.0) {
+    /* back off from what actually made it through */
+    if (received_bitrate)
+      bitrate = MIN (bitrate, received_bitrate);
+    bitrate = bitrate * (1.0 - 0.5 * packet_loss_pct / 100.0);
+  } else if (packet_loss_pct < 2.0) {
+    bitrate = bitrate * 1.05;
+  }
+  bitrate = CLAMP (bitrate, MIN (MIN_BITRATE, pacer->target_bitrate),
+      pacer->target_bitrate);
+
+  if (bitrate != pacer->bitrate) {
+    GST_DEBUG_OBJECT (pacer, "pacing bitrate %u -> %u for %.1f%% loss, "
+        "received %u", pacer->bitrate, bitrate, packet_loss_pct,
+        received_bitrate);
+    pacer->bitrate = bitrate;
+    g_cond_broadcast (&pacer->cond);
+  }
+  PACER_UNLOCK (pacer);
+}
+
+static GstStructure *
+_get_stats (TransportPacer * pacer)
+{
+  PacerItem *head;
+  GstClockTime queue_delay = 0, average_delay = 0;
+
+  head = g_queue_peek_head (&pacer->queue);
+  if (head)
+    queue_delay = (g_get_monotonic_time () - head->enqueue_time) * GST_USECOND;
+  if (pacer->packets_sent)
+    average_delay = pacer->total_delay / pacer->packets_sent;
+
+  return gst_structure_new ("application/x-webrtc-pacer-stats",
+      "target-bitrate", G_TYPE_UINT, pacer->target_bitrate,
+      "bitrate", G_TYPE_UINT, pacer->bitrate,
+      "queued-packets", G_TYPE_UINT, g_queue_get_length (&pacer->queue),
+      "queued-bytes", G_TYPE_UINT64, pacer->queued_bytes,
+      "packets-sent", G_TYPE_UINT64, pacer->packets_sent,
+      "packets-dropped", G_TYPE_UINT64, pacer->packets_dropped,
+      "queue-delay", G_TYPE_UINT64, queue_delay,
+      "average-queue-delay", G_TYPE_UINT64, average_delay,
+      "max-queue-delay", G_TYPE_UINT64, pacer->max_seen_delay, NULL);
+}
+
+static void
+transport_pacer_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (object);
+
+  PACER_LOCK (pacer);
+  switch (prop_id) {
+    case PROP_BITRATE:
+      pacer->target_bitrate = g_value_get_uint (value);
+      pacer->bitrate = pacer->target_bitrate;
+      break;
+    case PROP_BURST_SIZE:
+      pacer->burst_size = g_value_get_uint (value);
+      pacer->tokens = MIN (pacer->tokens, pacer->burst_size);
+      break;
+    case PROP_MAX_DELAY:
+      pacer->max_delay = g_value_get_uint64 (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  g_cond_broadcast (&pacer->cond);
+  PACER_UNLOCK (pacer);
+}
+
+static void
+transport_pacer_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (object);
+
+  PACER_LOCK (pacer);
+  switch (prop_id) {
+    case PROP_BITRATE:
+      g_value_set_uint (value, pacer->target_bitrate);
+      break;
+    case PROP_BURST_SIZE:
+      g_value_set_uint (value, pacer->burst_size);
+      break;
+    case PROP_MAX_DELAY:
+      g_value_set_uint64 (value, pacer->max_delay);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, _get_stats (pacer));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  PACER_UNLOCK (pacer);
+}
+
+static GstStateChangeReturn
+transport_pacer_change_state (GstElement * element, GstStateChange transition)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (element);
+  GstStateChangeReturn ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      PACER_LOCK (pacer);
+      pacer->flushing = FALSE;
+      pacer->src_ret = GST_FLOW_OK;
+      pacer->tokens = pacer->burst_size;
+      pacer->last_refill = g_get_monotonic_time ();
+      PACER_UNLOCK (pacer);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      PACER_LOCK (pacer);
+      pacer->flushing = TRUE;
+      pacer->src_ret = GST_FLOW_FLUSHING;
+      g_cond_broadcast (&pacer->cond);
+      PACER_UNLOCK (pacer);
+
+      gst_pad_stop_task (pacer->srcpad);
+
+      PACER_LOCK (pacer);
+      _clear_queue (pacer);
+      PACER_UNLOCK (pacer);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      gst_pad_start_task (pacer->srcpad,
+          (GstTaskFunction) transport_pacer_loop, pacer->srcpad, NULL);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+static void
+transport_pacer_finalize (GObject * object)
+{
+  TransportPacer *pacer = TRANSPORT_PACER (object);
+
+  _clear_queue (pacer);
+  g_mutex_clear (&pacer->lock);
+  g_cond_clear (&pacer->cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+transport_pacer_class_init (TransportPacerClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  element_class->change_state = transport_pacer_change_state;
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  gst_element_class_set_metadata (element_class, "WebRTC Transport Pacer",
+      "Filter/Network/WebRTC", "Paces the RTP packets sent on a transport",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  gobject_class->get_property = transport_pacer_get_property;
+  gobject_class->set_property = transport_pacer_set_property;
+  gobject_class->finalize = transport_pacer_finalize;
+
+  g_object_class_install_property (gobject_class,
+      PROP_BITRATE,
+      g_param_spec_uint ("bitrate", "Bitrate",
+          "Target pacing bitrate in bits per second (0 = no pacing)",
+          0, G_MAXUINT, DEFAULT_BITRATE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      PROP_BURST_SIZE,
+      g_param_spec_uint ("burst-size", "Burst Size",
+          "Number of bytes that can be sent back to back, packets larger "
+          "than this are still sent one at a time",
+          0, G_MAXUINT, DEFAULT_BURST_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      PROP_MAX_DELAY,
+      g_param_spec_uint64 ("max-delay", "Maximum Delay",
+          "Maximum time a packet is held back by pacing",
+          0, G_MAXUINT64, DEFAULT_MAX_DELAY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics", "Pacing statistics",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+transport_pacer_init (TransportPacer * pacer)
+{
+  pacer->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
+  gst_pad_set_chain_function (pacer->sinkpad, transport_pacer_chain);
+  gst_pad_set_chain_list_function (pacer->sinkpad,
+      transport_pacer_chain_list);
+  gst_pad_set_event_function (pacer->sinkpad, transport_pacer_sink_event);
+  GST_PAD_SET_PROXY_CAPS (pacer->sinkpad);
+  GST_PAD_SET_PROXY_ALLOCATION (pacer->sinkpad);
+  gst_element_add_pad (GST_ELEMENT (pacer), pacer->sinkpad);
+
+  pacer->srcpad = gst_pad_new_from_static_template (&src_template, "src");
+  GST_PAD_SET_PROXY_CAPS (pacer->srcpad);
+  gst_element_add_pad (GST_ELEMENT (pacer), pacer->srcpad);
+
+  g_mutex_init (&pacer->lock);
+  g_cond_init (&pacer->cond);
+  g_queue_init (&pacer->queue);
+
+  pacer->flushing = TRUE;
+  pacer->src_ret = GST_FLOW_FLUSHING;
+  pacer->target_bitrate = pacer->bitrate = DEFAULT_BITRATE;
+  pacer->burst_size = DEFAULT_BURST_SIZE;
+  pacer->max_delay = DEFAULT_MAX_DELAY;
+}
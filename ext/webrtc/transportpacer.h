@@ -0,0 +1,77 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __TRANSPORT_PACER_H__
+#define __TRANSPORT_PACER_H__
+
+#include <gst/gst.h>
+#include "fwd.h"
+
+G_BEGIN_DECLS
+
+GType transport_pacer_get_type(void);
+#define GST_TYPE_WEBRTC_TRANSPORT_PACER (transport_pacer_get_type())
+#define TRANSPORT_PACER(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_WEBRTC_TRANSPORT_PACER,TransportPacer))
+#define TRANSPORT_PACER_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass) ,GST_TYPE_WEBRTC_TRANSPORT_PACER,TransportPacerClass))
+#define TRANSPORT_PACER_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj) ,GST_TYPE_WEBRTC_TRANSPORT_PACER,TransportPacerClass))
+
+struct _TransportPacer
+{
+  GstElement                 parent;
+
+  GstPad                    *sinkpad;
+  GstPad                    *srcpad;
+
+  GMutex                     lock;
+  GCond                      cond;
+  GQueue                     queue;         /* of PacerItem's */
+  guint64                    queued_bytes;
+  gboolean                   flushing;
+  gboolean                   pushing;       /* an item is being pushed outside the lock */
+  GstFlowReturn              src_ret;
+
+  /* configuration */
+  guint                      target_bitrate;    /* bits/s, 0 disables pacing */
+  guint                      burst_size;        /* bytes */
+  GstClockTime               max_delay;
+
+  /* token bucket, the rate is lowered from the target by loss feedback */
+  guint                      bitrate;
+  gint64                     tokens;            /* bytes */
+  gint64                     last_refill;       /* monotonic time in us */
+
+  /* statistics */
+  guint64                    packets_sent;
+  guint64                    packets_dropped;
+  GstClockTime               total_delay;
+  GstClockTime               max_seen_delay;
+};
+
+struct _TransportPacerClass
+{
+  GstElementClass            parent_class;
+};
+
+void        transport_pacer_update_feedback     (TransportPacer * pacer,
+                                                 guint received_bitrate,
+                                                 gdouble packet_loss_pct);
+
+G_END_DECLS
+
+#endif /* __TRANSPORT_PACER_H__ */
@@ -44,6 +44,22 @@
  * ;                                                               '--------'  ;
  * '---------------------------------------------------------------------------'
  *
+ * With stream-threads, the rtp_src of the rtp dtlssrtpdec is instead
+ * demultiplexed by SSRC and each stream is pushed to the rtp funnel from its
+ * own queue so that the RTP session processing and jitterbuffer insertion of
+ * the streams in a bundle are spread across threads.  Decryption stays in the
+ * single transport thread as the SRTP session is shared by all streams.
+ * The queue and funnel pad of a stream are released when webrtcbin clears its
+ * SSRC from the demuxer, which it does once the RTP session got a BYE for the
+ * SSRC or timed it out.
+ *
+ *              ,-rtpssrcdemux-,    ,--queue--,      ,-funnel-,
+ * dtlssrtpdec -o sink   src_0 o----osink  srco------o sink_0 ;
+ *              ;        src_1 o-, '---------'   ,---o sink_2 ;
+ *              '--------------' ; ,--queue--,   ;   '--------'
+ *                               '-osink  srco---'
+ *                                 '---------'
+ *
  * Do we really wnat to be *that* permissive in what we accept?
  *
  * FIXME: When and how do we want to clear the possibly stored buffers?
@@ -81,8 +97,12 @@ enum
 {
   PROP_0,
   PROP_STREAM,
+  PROP_STREAM_THREADS,
 };
 
+#define DEFAULT_STREAM_THREADS FALSE
+#define STREAM_QUEUE_MAX_BYTES (1024 * 1024)
+
 static const gchar *
 _receive_state_to_string (ReceiveState state)
 {
@@ -189,6 +209,9 @@ transport_receive_bin_set_property (GObject * object, guint prop_id,
       /* XXX: weak-ref this? */
       receive->stream = TRANSPORT_STREAM (g_value_get_object (value));
       break;
+    case PROP_STREAM_THREADS:
+      receive->stream_threads = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -207,6 +230,9 @@ transport_receive_bin_get_property (GObject * object, guint prop_id,
     case PROP_STREAM:
       g_value_set_object (value, receive->stream);
       break;
+    case PROP_STREAM_THREADS:
+      g_value_set_boolean (value, receive->stream_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -297,6 +323,89 @@ rtp_queue_overrun (GstElement * queue, TransportReceiveBin * receive)
   GST_WARNING_OBJECT (receive, "Internal receive queue overrun. Dropping data");
 }
 
+static void
+_on_ssrc_demux_pad_added (GstElement * demux, GstPad * pad,
+    TransportReceiveBin * receive)
+{
+  GstElement *queue;
+  GstPad *sinkpad, *srcpad, *funnel_pad;
+  gchar *name;
+
+  /* the rtcp_src_%u pads never receive any data */
+  name = gst_pad_get_name (pad);
+  if (!g_str_has_prefix (name, "src_")) {
+    g_free (name);
+    return;
+  }
+
+  GST_DEBUG_OBJECT (receive, "creating receive queue for stream %s", name);
+  g_free (name);
+
+  queue = gst_element_factory_make ("queue", NULL);
+  g_object_set (queue, "leaky", 2, "max-size-time", (guint64) 0,
+      "max-size-buffers", 0, "max-size-bytes", STREAM_QUEUE_MAX_BYTES, NULL);
+  g_signal_connect (queue, "overrun", G_CALLBACK (rtp_queue_overrun), receive);
+  gst_bin_add (GST_BIN (receive), queue);
+
+  srcpad = gst_element_get_static_pad (queue, "src");
+  funnel_pad = gst_element_get_request_pad (receive->rtp_funnel, "sink_%u");
+  if (gst_pad_link (srcpad, funnel_pad) != GST_PAD_LINK_OK)
+    g_warn_if_reached ();
+  gst_object_unref (funnel_pad);
+  gst_object_unref (srcpad);
+
+  gst_element_sync_state_with_parent (queue);
+
+  sinkpad = gst_element_get_static_pad (queue, "sink");
+  if (gst_pad_link (pad, sinkpad) != GST_PAD_LINK_OK)
+    g_warn_if_reached ();
+  gst_object_unref (sinkpad);
+}
+
+static void
+_on_ssrc_demux_removed_ssrc_pad (GstElement * demux, guint ssrc, GstPad * pad,
+    TransportReceiveBin * receive)
+{
+  GstElement *queue;
+  GstPad *sinkpad, *srcpad, *funnel_pad;
+
+  sinkpad = gst_pad_get_peer (pad);
+  if (!sinkpad)
+    return;
+
+  queue = gst_pad_get_parent_element (sinkpad);
+  gst_pad_unlink (pad, sinkpad);
+  gst_object_unref (sinkpad);
+  if (!queue)
+    return;
+
+  GST_DEBUG_OBJECT (receive, "removing receive queue for ssrc %u", ssrc);
+
+  srcpad = gst_element_get_static_pad (queue, "src");
+  funnel_pad = gst_pad_get_peer (srcpad);
+  gst_object_unref (srcpad);
+
+  gst_element_set_locked_state (queue, TRUE);
+  gst_element_set_state (queue, GST_STATE_NULL);
+  gst_bin_remove (GST_BIN (receive), queue);
+  gst_object_unref (queue);
+
+  if (funnel_pad) {
+    gst_element_release_request_pad (receive->rtp_funnel, funnel_pad);
+    gst_object_unref (funnel_pad);
+  }
+}
+
+void
+transport_receive_bin_clear_ssrc (TransportReceiveBin * receive, guint ssrc)
+{
+  if (!receive->rtp_ssrc_demux)
+    return;
+
+  GST_DEBUG_OBJECT (receive, "clearing ssrc %u", ssrc);
+  g_signal_emit_by_name (receive->rtp_ssrc_demux, "clear-ssrc", ssrc);
+}
+
 static void
 transport_receive_bin_constructed (GObject * object)
 {
@@ -367,9 +476,24 @@ transport_receive_bin_constructed (GObject * object)
   /* create funnel for rtp_src */
   funnel = gst_element_factory_make ("funnel", NULL);
   gst_bin_add (GST_BIN (receive), funnel);
-  if (!gst_element_link_pads (receive->stream->transport->dtlssrtpdec,
-          "rtp_src", funnel, "sink_0"))
-    g_warn_if_reached ();
+  receive->rtp_funnel = funnel;
+  if (receive->stream_threads) {
+    GstElement *demux = gst_element_factory_make ("rtpssrcdemux", NULL);
+
+    gst_bin_add (GST_BIN (receive), demux);
+    receive->rtp_ssrc_demux = demux;
+    g_signal_connect (demux, "pad-added",
+        G_CALLBACK (_on_ssrc_demux_pad_added), receive);
+    g_signal_connect (demux, "removed-ssrc-pad",
+        G_CALLBACK (_on_ssrc_demux_removed_ssrc_pad), receive);
+    if (!gst_element_link_pads (receive->stream->transport->dtlssrtpdec,
+            "rtp_src", demux, "sink"))
+      g_warn_if_reached ();
+  } else {
+    if (!gst_element_link_pads (receive->stream->transport->dtlssrtpdec,
+            "rtp_src", funnel, "sink_0"))
+      g_warn_if_reached ();
+  }
   if (!gst_element_link_pads (receive->stream->rtcp_transport->dtlssrtpdec,
           "rtp_src", funnel, "sink_1"))
     g_warn_if_reached ();
@@ -442,11 +566,19 @@ transport_receive_bin_class_init (TransportReceiveBinClass * klass)
           "The TransportStream for this receiving bin",
           transport_stream_get_type (),
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class,
+      PROP_STREAM_THREADS,
+      g_param_spec_boolean ("stream-threads", "Stream Threads",
+          "Demultiplex the received RTP by SSRC and process each stream "
+          "in its own thread", DEFAULT_STREAM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 transport_receive_bin_init (TransportReceiveBin * receive)
 {
   receive->receive_state = RECEIVE_STATE_BLOCK;
+  receive->stream_threads = DEFAULT_STREAM_THREADS;
   g_mutex_init (&receive->pad_block_lock);
 }
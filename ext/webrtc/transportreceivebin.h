@@ -52,6 +52,11 @@ struct _TransportReceiveBin
   struct pad_block          *rtcp_block;
   GMutex                     pad_block_lock;
   ReceiveState               receive_state;
+
+  /* per SSRC dispatching of the decrypted RTP */
+  gboolean                   stream_threads;
+  GstElement                *rtp_ssrc_demux;
+  GstElement                *rtp_funnel;
 };
 
 struct _TransportReceiveBinClass
@@ -61,6 +66,8 @@ struct _TransportReceiveBinClass
 
 void        transport_receive_bin_set_receive_state         (TransportReceiveBin * receive,
                                                              ReceiveState state);
+void        transport_receive_bin_clear_ssrc                (TransportReceiveBin * receive,
+                                                             guint ssrc);
 
 G_END_DECLS
 
@@ -22,6 +22,7 @@
 #endif
 
 #include "transportsendbin.h"
+#include "transportpacer.h"
 #include "utils.h"
 
 /*
@@ -29,7 +30,7 @@
  *           ;                          ,-----dtlssrtpenc---,                   ;
  * data_sink o--------------------------o data_sink         ;                   ;
  *           ;                          ;                   ;  ,---nicesink---, ;
- *  rtp_sink o--------------------------o rtp_sink_0    src o--o sink         ; ;
+ *  rtp_sink o---o pacer o--------------o rtp_sink_0    src o--o sink         ; ;
  *           ;                          ;                   ;  '--------------' ;
  *           ;   ,--outputselector--, ,-o rtcp_sink_0       ;                   ;
  *           ;   ;            src_0 o-' '-------------------'                   ;
@@ -40,6 +41,9 @@
  *
  * outputselecter is used to switch between rtcp-mux and no rtcp-mux
  *
+ * the pacer spreads the RTP over time once a pacing bitrate is set and
+ * passes it through otherwise
+ *
  * FIXME: Do we need a valve drop=TRUE for the no RTCP case?
  */
 
@@ -417,13 +421,18 @@ transport_send_bin_constructed (GObject * object)
   pad = gst_element_request_pad (transport->dtlssrtpenc, templ, "rtp_sink_0",
       NULL);
 
+  send->pacer = g_object_new (transport_pacer_get_type (), NULL);
+  gst_bin_add (GST_BIN (send), GST_ELEMENT (send->pacer));
+  if (gst_pad_link (send->pacer->srcpad, pad) != GST_PAD_LINK_OK)
+    g_warn_if_reached ();
+  gst_object_unref (pad);
+
   if (!gst_element_link_pads (GST_ELEMENT (send->outputselector), "src_0",
           GST_ELEMENT (transport->dtlssrtpenc), "rtcp_sink_0"))
     g_warn_if_reached ();
 
-  ghost = gst_ghost_pad_new ("rtp_sink", pad);
+  ghost = gst_ghost_pad_new ("rtp_sink", send->pacer->sinkpad);
   gst_element_add_pad (GST_ELEMENT (send), ghost);
-  gst_object_unref (pad);
 
   /* push the data stream onto the RTP dtls element */
   templ = _find_pad_template (transport->dtlssrtpenc,
@@ -57,6 +57,7 @@ struct _TransportSendBin
   gboolean                   rtcp_mux;
 
   GstElement                *outputselector;
+  TransportPacer            *pacer;         /* paces the outgoing RTP */
 
   TransportSendBinDTLSContext rtp_ctx;
   TransportSendBinDTLSContext rtcp_ctx;
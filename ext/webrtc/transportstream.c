@@ -201,7 +201,7 @@ transport_stream_finalize (GObject * object)
   TransportStream *stream = TRANSPORT_STREAM (object);
 
   g_array_free (stream->ptmap, TRUE);
-  g_array_free (stream->remote_ssrcmap, TRUE);
+  g_hash_table_unref (stream->remote_ssrcmap);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -212,6 +212,7 @@ transport_stream_constructed (GObject * object)
   TransportStream *stream = TRANSPORT_STREAM (object);
   GstWebRTCBin *webrtc;
   GstWebRTCICETransport *ice_trans;
+  gboolean stream_threads;
 
   stream->transport = gst_webrtc_dtls_transport_new (stream->session_id, FALSE);
   stream->rtcp_transport =
@@ -251,8 +252,11 @@ transport_stream_constructed (GObject * object)
   stream->send_bin = g_object_new (transport_send_bin_get_type (), "stream",
       stream, NULL);
   gst_object_ref_sink (stream->send_bin);
+  GST_OBJECT_LOCK (webrtc);
+  stream_threads = webrtc->priv->receive_stream_threads;
+  GST_OBJECT_UNLOCK (webrtc);
   stream->receive_bin = g_object_new (transport_receive_bin_get_type (),
-      "stream", stream, NULL);
+      "stream", stream, "stream-threads", stream_threads, NULL);
   gst_object_ref_sink (stream->receive_bin);
 
   gst_object_unref (webrtc);
@@ -312,7 +316,7 @@ transport_stream_init (TransportStream * stream)
 {
   stream->ptmap = g_array_new (FALSE, TRUE, sizeof (PtMapItem));
   g_array_set_clear_func (stream->ptmap, (GDestroyNotify) clear_ptmap_item);
-  stream->remote_ssrcmap = g_array_new (FALSE, TRUE, sizeof (SsrcMapItem));
+  stream->remote_ssrcmap = g_hash_table_new (g_direct_hash, g_direct_equal);
 }
 
 TransportStream *
@@ -37,12 +37,6 @@ typedef struct
   GstCaps *caps;
 } PtMapItem;
 
-typedef struct
-{
-  guint32 ssrc;
-  guint media_idx;
-} SsrcMapItem;
-
 struct _TransportStream
 {
   GstObject                 parent;
@@ -61,7 +55,7 @@ struct _TransportStream
   GstWebRTCDTLSTransport   *rtcp_transport;
 
   GArray                   *ptmap;                  /* array of PtMapItem's */
-  GArray                   *remote_ssrcmap;         /* array of SsrcMapItem's */
+  GHashTable               *remote_ssrcmap;         /* ssrc -> media index */
   gboolean                  output_connected;       /* whether receive bin is connected to rtpbin */
 
   GstElement               *rtxsend;
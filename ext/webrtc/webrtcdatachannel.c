@@ -77,6 +77,18 @@ typedef enum
   CHANNEL_MESSAGE_OPEN = 0x03,
 } DataChannelMessage;
 
+enum
+{
+  PROP_0,
+  PROP_COALESCE_LATENCY,
+};
+
+#define DEFAULT_COALESCE_LATENCY 0
+
+/* Pending outgoing messages are handed to sctpenc once this many are queued
+ * even if the coalescing latency did not expire yet */
+#define MAX_COALESCED_MESSAGES 64
+
 static guint16
 priority_type_to_uint (GstWebRTCPriorityType pri)
 {
@@ -312,9 +324,135 @@ _close_sctp_stream (WebRTCDataChannel * channel, gpointer user_data)
   _transport_closed (channel);
 }
 
+static void _close_procedure (WebRTCDataChannel * channel,
+    gpointer user_data);
+
+static void
+_channel_send_failed (WebRTCDataChannel * channel, const gchar * msg)
+{
+  GError *error = NULL;
+
+  g_set_error_literal (&error, GST_WEBRTC_BIN_ERROR,
+      GST_WEBRTC_BIN_ERROR_DATA_CHANNEL_FAILURE, msg);
+  _channel_store_error (channel, error);
+  _channel_enqueue_task (channel, (ChannelTask) _close_procedure, NULL, NULL);
+}
+
+/* Hands all pending messages to sctpenc as a single buffer list.
+ * Called with the send lock */
+static void
+_flush_pending_sends_unlocked (WebRTCDataChannel * channel)
+{
+  GstBufferList *list;
+
+  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+  list = channel->pending_sends;
+  channel->pending_sends = NULL;
+  if (channel->flush_id) {
+    gst_clock_id_unschedule (channel->flush_id);
+    gst_clock_id_unref (channel->flush_id);
+    channel->flush_id = NULL;
+  }
+  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+
+  if (list) {
+    GST_LOG_OBJECT (channel, "Sending %u coalesced messages",
+        gst_buffer_list_length (list));
+
+    if (gst_app_src_push_buffer_list (GST_APP_SRC (channel->appsrc),
+            list) != GST_FLOW_OK)
+      _channel_send_failed (channel, "Failed to send data");
+  }
+}
+
+static void
+_flush_pending_sends (WebRTCDataChannel * channel)
+{
+  g_mutex_lock (&channel->send_lock);
+  _flush_pending_sends_unlocked (channel);
+  g_mutex_unlock (&channel->send_lock);
+}
+
+static gboolean
+_on_flush_timeout (GstClock * clock, GstClockTime time, GstClockID id,
+    gpointer user_data)
+{
+  _flush_pending_sends (WEBRTC_DATA_CHANNEL (user_data));
+
+  return TRUE;
+}
+
+/* Called with the channel lock */
+static void
+_schedule_flush (WebRTCDataChannel * channel)
+{
+  GstClock *clock;
+
+  if (channel->flush_id)
+    return;
+
+  clock = gst_system_clock_obtain ();
+  channel->flush_id = gst_clock_new_single_shot_id (clock,
+      gst_clock_get_time (clock) + channel->coalesce_latency);
+  gst_clock_id_wait_async (channel->flush_id, _on_flush_timeout,
+      g_object_ref (channel), g_object_unref);
+  gst_object_unref (clock);
+}
+
+/* Takes ownership of @buffers and accounts them in the buffered amount.
+ * Without a coalescing latency they are sent right away, otherwise they
+ * are sent together with other messages queued within the latency */
+static void
+_channel_send_buffers (WebRTCDataChannel * channel, GstBuffer ** buffers,
+    guint n_buffers)
+{
+  gboolean flush;
+  guint i;
+
+  /* The send lock is held across the push so that messages reach the appsrc
+   * in the order they were queued here, whichever path they take */
+  g_mutex_lock (&channel->send_lock);
+
+  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+  for (i = 0; i < n_buffers; i++)
+    channel->parent.buffered_amount += gst_buffer_get_size (buffers[i]);
+
+  if (n_buffers == 1 && !channel->pending_sends
+      && channel->coalesce_latency == 0) {
+    GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+
+    if (gst_app_src_push_buffer (GST_APP_SRC (channel->appsrc),
+            buffers[0]) != GST_FLOW_OK)
+      _channel_send_failed (channel, "Failed to send data");
+    g_mutex_unlock (&channel->send_lock);
+    return;
+  }
+
+  if (!channel->pending_sends)
+    channel->pending_sends = gst_buffer_list_new_sized (MAX (n_buffers,
+            MAX_COALESCED_MESSAGES));
+  for (i = 0; i < n_buffers; i++)
+    gst_buffer_list_add (channel->pending_sends, buffers[i]);
+
+  flush = channel->coalesce_latency == 0
+      || gst_buffer_list_length (channel->pending_sends) >=
+      MAX_COALESCED_MESSAGES;
+  if (!flush)
+    _schedule_flush (channel);
+  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+
+  if (flush)
+    _flush_pending_sends_unlocked (channel);
+
+  g_mutex_unlock (&channel->send_lock);
+}
+
 static void
 _close_procedure (WebRTCDataChannel * channel, gpointer user_data)
 {
+  /* Don't hold back anything that was sent before closing */
+  _flush_pending_sends (channel);
+
   /* https://www.w3.org/TR/webrtc/#data-transport-closing-procedure */
   GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
   if (channel->parent.ready_state == GST_WEBRTC_DATA_CHANNEL_STATE_CLOSED
@@ -491,18 +629,82 @@ buffer_unmap_and_unref (struct map_info *info)
   g_free (info);
 }
 
+typedef struct
+{
+  gboolean is_string;
+  /* gchar * for strings, GBytes * for data, NULL for empty messages */
+  gpointer data;
+} ReceivedMessage;
+
 static void
-_emit_have_data (WebRTCDataChannel * channel, GBytes * data)
+received_message_free (ReceivedMessage * msg)
 {
-  gst_webrtc_data_channel_on_message_data (GST_WEBRTC_DATA_CHANNEL (channel),
-      data);
+  if (msg->is_string)
+    g_free (msg->data);
+  else if (msg->data)
+    g_bytes_unref (msg->data);
+  g_free (msg);
+}
+
+static void
+_deliver_received (WebRTCDataChannel * channel, gpointer user_data)
+{
+  GQueue received;
+  GPtrArray *data;
+  ReceivedMessage *msg;
+
+  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+  received = channel->pending_received;
+  g_queue_init (&channel->pending_received);
+  channel->deliver_scheduled = FALSE;
+  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+
+  GST_LOG_OBJECT (channel, "Delivering %u received messages",
+      received.length);
+
+  /* Consecutive data messages are emitted together, strings in between
+   * are emitted in order */
+  data = g_ptr_array_new_with_free_func ((GDestroyNotify) g_bytes_unref);
+  while ((msg = g_queue_pop_head (&received))) {
+    if (msg->is_string) {
+      gst_webrtc_data_channel_on_message_data_list (GST_WEBRTC_DATA_CHANNEL
+          (channel), data);
+      g_ptr_array_set_size (data, 0);
+
+      gst_webrtc_data_channel_on_message_string (GST_WEBRTC_DATA_CHANNEL
+          (channel), msg->data);
+      received_message_free (msg);
+    } else {
+      g_ptr_array_add (data, msg->data);
+      g_free (msg);
+    }
+  }
+  gst_webrtc_data_channel_on_message_data_list (GST_WEBRTC_DATA_CHANNEL
+      (channel), data);
+  g_ptr_array_unref (data);
 }
 
+/* Takes ownership of @data. Only one delivery task is queued at a time, all
+ * messages received until it runs are emitted from it */
 static void
-_emit_have_string (GstWebRTCDataChannel * channel, gchar * str)
+_channel_queue_received (WebRTCDataChannel * channel, gboolean is_string,
+    gpointer data)
 {
-  gst_webrtc_data_channel_on_message_string (GST_WEBRTC_DATA_CHANNEL (channel),
-      str);
+  ReceivedMessage *msg = g_new0 (ReceivedMessage, 1);
+  gboolean schedule;
+
+  msg->is_string = is_string;
+  msg->data = data;
+
+  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+  g_queue_push_tail (&channel->pending_received, msg);
+  schedule = !channel->deliver_scheduled;
+  channel->deliver_scheduled = TRUE;
+  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+
+  if (schedule)
+    _channel_enqueue_task (channel, (ChannelTask) _deliver_received, NULL,
+        NULL);
 }
 
 static GstFlowReturn
@@ -555,8 +757,7 @@ _data_channel_have_sample (WebRTCDataChannel * channel, GstSample * sample,
         ret = GST_FLOW_ERROR;
       } else {
         gchar *str = g_strndup ((gchar *) info.data, info.size);
-        _channel_enqueue_task (channel, (ChannelTask) _emit_have_string, str,
-            g_free);
+        _channel_queue_received (channel, TRUE, str);
         gst_buffer_unmap (buffer, &info);
       }
       break;
@@ -573,18 +774,15 @@ _data_channel_have_sample (WebRTCDataChannel * channel, GstSample * sample,
         GBytes *data = g_bytes_new_with_free_func (info->map_info.data,
             info->map_info.size, (GDestroyNotify) buffer_unmap_and_unref, info);
         info->buffer = gst_buffer_ref (buffer);
-        _channel_enqueue_task (channel, (ChannelTask) _emit_have_data, data,
-            (GDestroyNotify) g_bytes_unref);
+        _channel_queue_received (channel, FALSE, data);
       }
       break;
     }
     case DATA_CHANNEL_PPID_WEBRTC_BINARY_EMPTY:
-      _channel_enqueue_task (channel, (ChannelTask) _emit_have_data, NULL,
-          NULL);
+      _channel_queue_received (channel, FALSE, NULL);
       break;
     case DATA_CHANNEL_PPID_WEBRTC_STRING_EMPTY:
-      _channel_enqueue_task (channel, (ChannelTask) _emit_have_string, NULL,
-          NULL);
+      _channel_queue_received (channel, TRUE, NULL);
       break;
     default:
       g_set_error (error, GST_WEBRTC_BIN_ERROR,
@@ -711,16 +909,13 @@ _is_within_max_message_size (WebRTCDataChannel * channel, gsize size)
   return size <= channel->sctp_transport->max_message_size;
 }
 
-static void
-webrtc_data_channel_send_data (GstWebRTCDataChannel * base_channel,
-    GBytes * bytes)
+static GstBuffer *
+_create_data_buffer (WebRTCDataChannel * channel, GBytes * bytes)
 {
-  WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (base_channel);
   GstSctpSendMetaPartiallyReliability reliability;
   guint rel_param;
   guint32 ppid;
   GstBuffer *buffer;
-  GstFlowReturn ret;
 
   if (!bytes) {
     buffer = gst_buffer_new ();
@@ -730,7 +925,7 @@ webrtc_data_channel_send_data (GstWebRTCDataChannel * base_channel,
     guint8 *data;
 
     data = (guint8 *) g_bytes_get_data (bytes, &size);
-    g_return_if_fail (data != NULL);
+    g_return_val_if_fail (data != NULL, NULL);
     if (!_is_within_max_message_size (channel, size)) {
       GError *error = NULL;
       g_set_error (&error, GST_WEBRTC_BIN_ERROR,
@@ -739,7 +934,7 @@ webrtc_data_channel_send_data (GstWebRTCDataChannel * base_channel,
       _channel_store_error (channel, error);
       _channel_enqueue_task (channel, (ChannelTask) _close_procedure, NULL,
           NULL);
-      return;
+      return NULL;
     }
 
     buffer = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, data, size,
@@ -751,22 +946,51 @@ webrtc_data_channel_send_data (GstWebRTCDataChannel * base_channel,
   gst_sctp_buffer_add_send_meta (buffer, ppid, channel->parent.ordered,
       reliability, rel_param);
 
+  return buffer;
+}
+
+static void
+webrtc_data_channel_send_data (GstWebRTCDataChannel * base_channel,
+    GBytes * bytes)
+{
+  WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (base_channel);
+  GstBuffer *buffer;
+
+  buffer = _create_data_buffer (channel, bytes);
+  if (!buffer)
+    return;
+
   GST_LOG_OBJECT (channel, "Sending data using buffer %" GST_PTR_FORMAT,
       buffer);
 
-  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
-  channel->parent.buffered_amount += gst_buffer_get_size (buffer);
-  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+  _channel_send_buffers (channel, &buffer, 1);
+}
 
-  ret = gst_app_src_push_buffer (GST_APP_SRC (channel->appsrc), buffer);
+static void
+webrtc_data_channel_send_data_list (GstWebRTCDataChannel * base_channel,
+    GPtrArray * data)
+{
+  WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (base_channel);
+  GstBuffer **buffers;
+  guint i;
 
-  if (ret != GST_FLOW_OK) {
-    GError *error = NULL;
-    g_set_error (&error, GST_WEBRTC_BIN_ERROR,
-        GST_WEBRTC_BIN_ERROR_DATA_CHANNEL_FAILURE, "Failed to send data");
-    _channel_store_error (channel, error);
-    _channel_enqueue_task (channel, (ChannelTask) _close_procedure, NULL, NULL);
+  if (data->len == 0)
+    return;
+
+  buffers = g_new (GstBuffer *, data->len);
+  for (i = 0; i < data->len; i++) {
+    buffers[i] = _create_data_buffer (channel, g_ptr_array_index (data, i));
+    if (!buffers[i])
+      break;
   }
+
+  GST_LOG_OBJECT (channel, "Sending %u data messages", i);
+
+  /* Everything before a message that could not be sent still goes out, as
+   * if each message was sent separately */
+  if (i > 0)
+    _channel_send_buffers (channel, buffers, i);
+  g_free (buffers);
 }
 
 static void
@@ -778,7 +1002,6 @@ webrtc_data_channel_send_string (GstWebRTCDataChannel * base_channel,
   guint rel_param;
   guint32 ppid;
   GstBuffer *buffer;
-  GstFlowReturn ret;
 
   if (!channel->parent.negotiated)
     g_return_if_fail (channel->opened);
@@ -789,7 +1012,7 @@ webrtc_data_channel_send_string (GstWebRTCDataChannel * base_channel,
     ppid = DATA_CHANNEL_PPID_WEBRTC_STRING_EMPTY;
   } else {
     gsize size = strlen (str);
-    gchar *str_copy = g_strdup (str);
+    gchar *str_copy;
 
     if (!_is_within_max_message_size (channel, size)) {
       GError *error = NULL;
@@ -802,6 +1025,7 @@ webrtc_data_channel_send_string (GstWebRTCDataChannel * base_channel,
       return;
     }
 
+    str_copy = g_strdup (str);
     buffer =
         gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, str_copy,
         size, 0, size, str_copy, g_free);
@@ -815,19 +1039,7 @@ webrtc_data_channel_send_string (GstWebRTCDataChannel * base_channel,
   GST_TRACE_OBJECT (channel, "Sending string using buffer %" GST_PTR_FORMAT,
       buffer);
 
-  GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
-  channel->parent.buffered_amount += gst_buffer_get_size (buffer);
-  GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
-
-  ret = gst_app_src_push_buffer (GST_APP_SRC (channel->appsrc), buffer);
-
-  if (ret != GST_FLOW_OK) {
-    GError *error = NULL;
-    g_set_error (&error, GST_WEBRTC_BIN_ERROR,
-        GST_WEBRTC_BIN_ERROR_DATA_CHANNEL_FAILURE, "Failed to send string");
-    _channel_store_error (channel, error);
-    _channel_enqueue_task (channel, (ChannelTask) _close_procedure, NULL, NULL);
-  }
+  _channel_send_buffers (channel, &buffer, 1);
 }
 
 static void
@@ -928,11 +1140,62 @@ gst_webrtc_data_channel_constructed (GObject * object)
   gst_caps_unref (caps);
 }
 
+static void
+webrtc_data_channel_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (object);
+
+  switch (prop_id) {
+    case PROP_COALESCE_LATENCY:
+      GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+      channel->coalesce_latency = g_value_get_uint64 (value);
+      GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+webrtc_data_channel_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (object);
+
+  switch (prop_id) {
+    case PROP_COALESCE_LATENCY:
+      GST_WEBRTC_DATA_CHANNEL_LOCK (channel);
+      g_value_set_uint64 (value, channel->coalesce_latency);
+      GST_WEBRTC_DATA_CHANNEL_UNLOCK (channel);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 static void
 gst_webrtc_data_channel_finalize (GObject * object)
 {
   WebRTCDataChannel *channel = WEBRTC_DATA_CHANNEL (object);
 
+  if (channel->flush_id) {
+    gst_clock_id_unschedule (channel->flush_id);
+    gst_clock_id_unref (channel->flush_id);
+    channel->flush_id = NULL;
+  }
+  if (channel->pending_sends) {
+    gst_buffer_list_unref (channel->pending_sends);
+    channel->pending_sends = NULL;
+  }
+  g_mutex_clear (&channel->send_lock);
+
+  g_queue_foreach (&channel->pending_received, (GFunc) received_message_free,
+      NULL);
+  g_queue_clear (&channel->pending_received);
+
   if (channel->src_probe) {
     GstPad *pad = gst_element_get_static_pad (channel->appsrc, "src");
     gst_pad_remove_probe (pad, channel->src_probe);
@@ -959,15 +1222,31 @@ webrtc_data_channel_class_init (WebRTCDataChannelClass * klass)
 
   gobject_class->constructed = gst_webrtc_data_channel_constructed;
   gobject_class->finalize = gst_webrtc_data_channel_finalize;
+  gobject_class->set_property = webrtc_data_channel_set_property;
+  gobject_class->get_property = webrtc_data_channel_get_property;
 
   channel_class->send_data = webrtc_data_channel_send_data;
+  channel_class->send_data_list = webrtc_data_channel_send_data_list;
   channel_class->send_string = webrtc_data_channel_send_string;
   channel_class->close = webrtc_data_channel_close;
+
+  g_object_class_install_property (gobject_class,
+      PROP_COALESCE_LATENCY,
+      g_param_spec_uint64 ("coalesce-latency",
+          "Coalesce Latency",
+          "Maximum time in nanoseconds outgoing messages are held back to be "
+          "handed to the SCTP transport together with other messages "
+          "(0 = send immediately)",
+          0, G_MAXUINT64, DEFAULT_COALESCE_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 webrtc_data_channel_init (WebRTCDataChannel * channel)
 {
+  g_mutex_init (&channel->send_lock);
+  channel->coalesce_latency = DEFAULT_COALESCE_LATENCY;
+  g_queue_init (&channel->pending_received);
 }
 
 static void
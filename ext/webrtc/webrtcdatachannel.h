@@ -52,6 +52,17 @@ struct _WebRTCDataChannel
   gulong                            src_probe;
   GError                           *stored_error;
 
+  /* Coalescing of outgoing messages, protected by the channel lock.
+   * send_lock serializes pushing messages into the appsrc */
+  GMutex                            send_lock;
+  GstClockTime                      coalesce_latency;
+  GstBufferList                    *pending_sends;
+  GstClockID                        flush_id;
+
+  /* Received messages waiting to be emitted, protected by the channel lock */
+  GQueue                            pending_received;
+  gboolean                          deliver_scheduled;
+
   gpointer                          _padding[GST_PADDING];
 };
 
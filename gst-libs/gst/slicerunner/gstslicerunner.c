@@ -0,0 +1,186 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Internal helper shared by the elements that split the processing of a
+ * frame into slices: the first slice is processed by the calling thread and
+ * the other ones by a pool of n_threads - 1 threads, and
+ * gst_slice_runner_run() only returns once all of them are done.
+ *
+ * A runner must only be used from one thread at a time, usually the
+ * streaming thread of the element. Elements keep the requested number of
+ * threads as a property and call gst_slice_runner_update() before running
+ * slices, so that the runner is never replaced while in use.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstslicerunner.h"
+
+struct _GstSliceRunner
+{
+  guint n_threads;
+  GThreadPool *pool;
+
+  GMutex lock;
+  GCond cond;
+  guint pending;
+  GstSliceFunc func;
+};
+
+static void
+gst_slice_runner_worker (gpointer slice, GstSliceRunner * runner)
+{
+  runner->func (slice);
+
+  g_mutex_lock (&runner->lock);
+  if (--runner->pending == 0)
+    g_cond_signal (&runner->cond);
+  g_mutex_unlock (&runner->lock);
+}
+
+static guint
+gst_slice_runner_resolve_n_threads (guint n_threads)
+{
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  return MAX (n_threads, 1);
+}
+
+/**
+ * gst_slice_runner_new:
+ * @n_threads: the number of threads, or 0 for the number of processors
+ *
+ * Returns: (transfer full): a new #GstSliceRunner
+ */
+GstSliceRunner *
+gst_slice_runner_new (guint n_threads)
+{
+  GstSliceRunner *runner = g_new0 (GstSliceRunner, 1);
+
+  runner->n_threads = gst_slice_runner_resolve_n_threads (n_threads);
+  g_mutex_init (&runner->lock);
+  g_cond_init (&runner->cond);
+
+  if (runner->n_threads > 1) {
+    runner->pool = g_thread_pool_new ((GFunc) gst_slice_runner_worker, runner,
+        runner->n_threads - 1, FALSE, NULL);
+    if (!runner->pool)
+      runner->n_threads = 1;
+  }
+
+  return runner;
+}
+
+/**
+ * gst_slice_runner_free:
+ * @runner: (transfer full) (nullable): a #GstSliceRunner
+ *
+ * Waits for the threads of @runner and frees it.
+ */
+void
+gst_slice_runner_free (GstSliceRunner * runner)
+{
+  if (!runner)
+    return;
+
+  if (runner->pool)
+    g_thread_pool_free (runner->pool, FALSE, TRUE);
+  g_mutex_clear (&runner->lock);
+  g_cond_clear (&runner->cond);
+  g_free (runner);
+}
+
+/**
+ * gst_slice_runner_update:
+ * @runner: (transfer full) (nullable): a #GstSliceRunner
+ * @n_threads: the number of threads, or 0 for the number of processors
+ *
+ * Returns: (transfer full): @runner if it already uses @n_threads threads,
+ * otherwise a new #GstSliceRunner replacing it
+ */
+GstSliceRunner *
+gst_slice_runner_update (GstSliceRunner * runner, guint n_threads)
+{
+  if (runner &&
+      runner->n_threads == gst_slice_runner_resolve_n_threads (n_threads))
+    return runner;
+
+  gst_slice_runner_free (runner);
+
+  return gst_slice_runner_new (n_threads);
+}
+
+/**
+ * gst_slice_runner_get_n_threads:
+ * @runner: a #GstSliceRunner
+ *
+ * Returns: the number of slices @runner processes in parallel
+ */
+guint
+gst_slice_runner_get_n_threads (GstSliceRunner * runner)
+{
+  return runner->n_threads;
+}
+
+/**
+ * gst_slice_runner_run:
+ * @runner: a #GstSliceRunner
+ * @func: the function processing a slice
+ * @slices: an array of @n_slices slices
+ * @slice_size: the size of one element of @slices
+ * @n_slices: the number of slices
+ *
+ * Calls @func on every slice of @slices and waits for all of them to be
+ * processed.
+ */
+void
+gst_slice_runner_run (GstSliceRunner * runner, GstSliceFunc func,
+    gpointer slices, gsize slice_size, guint n_slices)
+{
+  guint8 *slice = slices;
+  guint i;
+
+  if (n_slices == 0)
+    return;
+
+  if (!runner->pool || n_slices == 1) {
+    for (i = 0; i < n_slices; i++)
+      func (slice + i * slice_size);
+    return;
+  }
+
+  runner->func = func;
+  g_mutex_lock (&runner->lock);
+  runner->pending = n_slices - 1;
+  g_mutex_unlock (&runner->lock);
+
+  for (i = 1; i < n_slices; i++)
+    g_thread_pool_push (runner->pool, slice + i * slice_size, NULL);
+
+  func (slice);
+
+  g_mutex_lock (&runner->lock);
+  while (runner->pending > 0)
+    g_cond_wait (&runner->cond, &runner->lock);
+  g_mutex_unlock (&runner->lock);
+}
@@ -0,0 +1,54 @@
+/* GStreamer
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_SLICE_RUNNER_H__
+#define __GST_SLICE_RUNNER_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstSliceFunc:
+ * @slice: the slice to process
+ *
+ * Processes one slice of the work passed to gst_slice_runner_run().
+ */
+typedef void (*GstSliceFunc) (gpointer slice);
+
+typedef struct _GstSliceRunner GstSliceRunner;
+
+GstSliceRunner * gst_slice_runner_new           (guint n_threads);
+
+void             gst_slice_runner_free          (GstSliceRunner * runner);
+
+GstSliceRunner * gst_slice_runner_update        (GstSliceRunner * runner,
+                                                 guint n_threads);
+
+guint            gst_slice_runner_get_n_threads (GstSliceRunner * runner);
+
+void             gst_slice_runner_run           (GstSliceRunner * runner,
+                                                 GstSliceFunc func,
+                                                 gpointer slices,
+                                                 gsize slice_size,
+                                                 guint n_slices);
+
+G_END_DECLS
+
+#endif /* __GST_SLICE_RUNNER_H__ */
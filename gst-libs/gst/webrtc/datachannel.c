@@ -49,9 +49,11 @@ enum
   SIGNAL_ON_CLOSE,
   SIGNAL_ON_ERROR,
   SIGNAL_ON_MESSAGE_DATA,
+  SIGNAL_ON_MESSAGE_DATA_LIST,
   SIGNAL_ON_MESSAGE_STRING,
   SIGNAL_ON_BUFFERED_AMOUNT_LOW,
   SIGNAL_SEND_DATA,
+  SIGNAL_SEND_DATA_LIST,
   SIGNAL_SEND_STRING,
   SIGNAL_CLOSE,
   LAST_SIGNAL,
@@ -308,6 +310,23 @@ gst_webrtc_data_channel_class_init (GstWebRTCDataChannelClass * klass)
       g_signal_new ("on-message-data", G_TYPE_FROM_CLASS (klass),
       G_SIGNAL_RUN_LAST, 0, NULL, NULL, NULL, G_TYPE_NONE, 1, G_TYPE_BYTES);
 
+  /**
+   * GstWebRTCDataChannel::on-message-data-list:
+   * @object: the #GstWebRTCDataChannel
+   * @data: a #GPtrArray of #GBytes of the data received, in order. Entries
+   *   are %NULL for empty messages
+   *
+   * Emitted with all data messages that were received since the last
+   * emission. When connected to, #GstWebRTCDataChannel::on-message-data is
+   * not emitted for these messages anymore.
+   *
+   * Since: 1.18
+   */
+  gst_webrtc_data_channel_signals[SIGNAL_ON_MESSAGE_DATA_LIST] =
+      g_signal_new ("on-message-data-list", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST, 0, NULL, NULL, NULL, G_TYPE_NONE, 1,
+      G_TYPE_PTR_ARRAY);
+
   /**
    * GstWebRTCDataChannel::on-message-string:
    * @object: the #GstWebRTCDataChannel
@@ -336,6 +355,21 @@ gst_webrtc_data_channel_class_init (GstWebRTCDataChannelClass * klass)
       G_CALLBACK (gst_webrtc_data_channel_send_data), NULL, NULL, NULL,
       G_TYPE_NONE, 1, G_TYPE_BYTES);
 
+  /**
+   * GstWebRTCDataChannel::send-data-list:
+   * @object: the #GstWebRTCDataChannel
+   * @data: a #GPtrArray of #GBytes, entries may be %NULL
+   *
+   * Send each entry of @data as a separate data message, in order.
+   *
+   * Since: 1.18
+   */
+  gst_webrtc_data_channel_signals[SIGNAL_SEND_DATA_LIST] =
+      g_signal_new_class_handler ("send-data-list", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_CALLBACK (gst_webrtc_data_channel_send_data_list), NULL, NULL, NULL,
+      G_TYPE_NONE, 1, G_TYPE_PTR_ARRAY);
+
   /**
    * GstWebRTCDataChannel::send-string:
    * @object: the #GstWebRTCDataChannel
@@ -467,6 +501,45 @@ gst_webrtc_data_channel_on_message_data (GstWebRTCDataChannel * channel,
       gst_webrtc_data_channel_signals[SIGNAL_ON_MESSAGE_DATA], 0, data);
 }
 
+/**
+ * gst_webrtc_data_channel_on_message_data_list:
+ * @channel: a #GstWebRTCDataChannel
+ * @data: a #GPtrArray of #GBytes or %NULL entries
+ *
+ * Signal that the data channel received the data messages in @data.
+ * Should only be used by subclasses.
+ *
+ * If nothing is connected to #GstWebRTCDataChannel::on-message-data-list,
+ * #GstWebRTCDataChannel::on-message-data is emitted for each message instead.
+ *
+ * Since: 1.18
+ */
+void
+gst_webrtc_data_channel_on_message_data_list (GstWebRTCDataChannel * channel,
+    GPtrArray * data)
+{
+  guint i;
+
+  g_return_if_fail (GST_IS_WEBRTC_DATA_CHANNEL (channel));
+  g_return_if_fail (data != NULL);
+
+  if (data->len == 0)
+    return;
+
+  if (g_signal_has_handler_pending (channel,
+          gst_webrtc_data_channel_signals[SIGNAL_ON_MESSAGE_DATA_LIST], 0,
+          FALSE)) {
+    GST_LOG_OBJECT (channel, "Have %u data messages", data->len);
+    g_signal_emit (channel,
+        gst_webrtc_data_channel_signals[SIGNAL_ON_MESSAGE_DATA_LIST], 0, data);
+    return;
+  }
+
+  for (i = 0; i < data->len; i++)
+    gst_webrtc_data_channel_on_message_data (channel,
+        g_ptr_array_index (data, i));
+}
+
 /**
  * gst_webrtc_data_channel_on_message_string:
  * @channel: a #GstWebRTCDataChannel
@@ -520,6 +593,38 @@ gst_webrtc_data_channel_send_data (GstWebRTCDataChannel * channel,
   klass->send_data (channel, data);
 }
 
+/**
+ * gst_webrtc_data_channel_send_data_list:
+ * @channel: a #GstWebRTCDataChannel
+ * @data: a #GPtrArray of #GBytes or %NULL entries
+ *
+ * Send each entry of @data as a separate data message over @channel. This
+ * is equivalent to calling gst_webrtc_data_channel_send_data() for each
+ * entry but allows the implementation to hand all messages to the
+ * transport at once.
+ *
+ * Since: 1.18
+ */
+void
+gst_webrtc_data_channel_send_data_list (GstWebRTCDataChannel * channel,
+    GPtrArray * data)
+{
+  GstWebRTCDataChannelClass *klass;
+  guint i;
+
+  g_return_if_fail (GST_IS_WEBRTC_DATA_CHANNEL (channel));
+  g_return_if_fail (data != NULL);
+
+  klass = GST_WEBRTC_DATA_CHANNEL_GET_CLASS (channel);
+  if (klass->send_data_list) {
+    klass->send_data_list (channel, data);
+    return;
+  }
+
+  for (i = 0; i < data->len; i++)
+    klass->send_data (channel, g_ptr_array_index (data, i));
+}
+
 /**
  * gst_webrtc_data_channel_send_string:
  * @channel: a #GstWebRTCDataChannel
@@ -48,6 +48,8 @@ enum
   PROP_STRICT_BUFFER_SIZE,
   PROP_GAPLESS,
   PROP_MAX_SILENCE_TIME,
+  PROP_ZERO_COPY,
+  PROP_OUTPUT_BUFFER_LIST,
   LAST_PROP
 };
 
@@ -58,6 +60,8 @@ enum
 #define DEFAULT_STRICT_BUFFER_SIZE (FALSE)
 #define DEFAULT_GAPLESS (FALSE)
 #define DEFAULT_MAX_SILENCE_TIME (0)
+#define DEFAULT_ZERO_COPY (FALSE)
+#define DEFAULT_OUTPUT_BUFFER_LIST (FALSE)
 
 #define parent_class gst_audio_buffer_split_parent_class
 G_DEFINE_TYPE (GstAudioBufferSplit, gst_audio_buffer_split, GST_TYPE_ELEMENT);
@@ -134,6 +138,38 @@ gst_audio_buffer_split_class_init (GstAudioBufferSplitClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  /**
+   * GstAudioBufferSplit:zero-copy:
+   *
+   * Output buffers that span several input buffers are made of the memories
+   * of those input buffers instead of being merged into newly allocated
+   * memory.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_ZERO_COPY,
+      g_param_spec_boolean ("zero-copy", "Zero Copy",
+          "Output buffers referencing the memory of the input buffers "
+          "instead of copying when they span several input buffers",
+          DEFAULT_ZERO_COPY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstAudioBufferSplit:output-buffer-list:
+   *
+   * Push all output buffers produced from one input buffer downstream
+   * together as a #GstBufferList.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_BUFFER_LIST,
+      g_param_spec_boolean ("output-buffer-list", "Output Buffer List",
+          "Push the output buffers produced from one input buffer as a "
+          "buffer list", DEFAULT_OUTPUT_BUFFER_LIST,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "Audio Buffer Split", "Audio/Filter",
       "Splits raw audio buffers into equal sized chunks",
@@ -169,6 +205,8 @@ gst_audio_buffer_split_init (GstAudioBufferSplit * self)
   self->output_buffer_duration_d = DEFAULT_OUTPUT_BUFFER_DURATION_D;
   self->strict_buffer_size = DEFAULT_STRICT_BUFFER_SIZE;
   self->gapless = DEFAULT_GAPLESS;
+  self->zero_copy = DEFAULT_ZERO_COPY;
+  self->output_buffer_list = DEFAULT_OUTPUT_BUFFER_LIST;
 
   self->adapter = gst_adapter_new ();
 
@@ -267,6 +305,12 @@ gst_audio_buffer_split_set_property (GObject * object, guint property_id,
     case PROP_MAX_SILENCE_TIME:
       self->max_silence_time = g_value_get_uint64 (value);
       break;
+    case PROP_ZERO_COPY:
+      self->zero_copy = g_value_get_boolean (value);
+      break;
+    case PROP_OUTPUT_BUFFER_LIST:
+      self->output_buffer_list = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -305,6 +349,12 @@ gst_audio_buffer_split_get_property (GObject * object, guint property_id,
     case PROP_MAX_SILENCE_TIME:
       g_value_set_uint64 (value, self->max_silence_time);
       break;
+    case PROP_ZERO_COPY:
+      g_value_set_boolean (value, self->zero_copy);
+      break;
+    case PROP_OUTPUT_BUFFER_LIST:
+      g_value_set_boolean (value, self->output_buffer_list);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -355,15 +405,90 @@ gst_audio_buffer_split_change_state (GstElement * element,
   return state_ret;
 }
 
+/* Timestamps @buffer, which holds the next @size bytes of the stream, and
+ * either adds it to @list or pushes it downstream */
+static GstFlowReturn
+gst_audio_buffer_split_finish_buffer (GstAudioBufferSplit * self,
+    GstBuffer * buffer, gint size, gint rate, gint bpf, GstBufferList * list)
+{
+  GstClockTime resync_pts = self->resync_pts;
+  GstClockTime resync_time_diff;
+
+  /* After a reset we have to set the discont flag */
+  if (self->current_offset == 0)
+    GST_BUFFER_FLAG_SET (buffer,
+        GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC);
+  else
+    GST_BUFFER_FLAG_UNSET (buffer,
+        GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC);
+
+  resync_time_diff =
+      gst_util_uint64_scale (self->current_offset, GST_SECOND, rate);
+  if (self->out_segment.rate < 0.0) {
+    if (resync_pts > resync_time_diff)
+      GST_BUFFER_PTS (buffer) = resync_pts - resync_time_diff;
+    else
+      GST_BUFFER_PTS (buffer) = 0;
+    GST_BUFFER_DURATION (buffer) =
+        gst_util_uint64_scale (size / bpf, GST_SECOND, rate);
+
+    self->current_offset += size / bpf;
+  } else {
+    GST_BUFFER_PTS (buffer) = resync_pts + resync_time_diff;
+    self->current_offset += size / bpf;
+    resync_time_diff =
+        gst_util_uint64_scale (self->current_offset, GST_SECOND, rate);
+    GST_BUFFER_DURATION (buffer) =
+        resync_time_diff - (GST_BUFFER_PTS (buffer) - resync_pts);
+  }
+
+  GST_BUFFER_OFFSET (buffer) = GST_BUFFER_OFFSET_NONE;
+  GST_BUFFER_OFFSET_END (buffer) = GST_BUFFER_OFFSET_NONE;
+
+  self->accumulated_error =
+      (self->accumulated_error +
+      self->error_per_buffer) % self->output_buffer_duration_d;
+
+  GST_LOG_OBJECT (self,
+      "Outputting buffer at running time %" GST_TIME_FORMAT
+      " with timestamp %" GST_TIME_FORMAT " with duration %" GST_TIME_FORMAT
+      " (%u samples)",
+      GST_TIME_ARGS (gst_segment_to_running_time (&self->out_segment,
+              GST_FORMAT_TIME, GST_BUFFER_PTS (buffer))),
+      GST_TIME_ARGS (GST_BUFFER_PTS (buffer)),
+      GST_TIME_ARGS (GST_BUFFER_DURATION (buffer)), size / bpf);
+
+  if (list) {
+    gst_buffer_list_add (list, buffer);
+    return GST_FLOW_OK;
+  }
+
+  return gst_pad_push (self->srcpad, buffer);
+}
+
+static GstFlowReturn
+gst_audio_buffer_split_push_list (GstAudioBufferSplit * self,
+    GstBufferList * list)
+{
+  if (!list)
+    return GST_FLOW_OK;
+
+  if (gst_buffer_list_length (list) == 0) {
+    gst_buffer_list_unref (list);
+    return GST_FLOW_OK;
+  }
+
+  return gst_pad_push_list (self->srcpad, list);
+}
+
 static GstFlowReturn
 gst_audio_buffer_split_output (GstAudioBufferSplit * self, gboolean force,
     gint rate, gint bpf, guint samples_per_buffer)
 {
   gint size, avail;
   GstFlowReturn ret = GST_FLOW_OK;
-  GstClockTime resync_pts;
+  GstBufferList *list = NULL;
 
-  resync_pts = self->resync_pts;
   size = samples_per_buffer * bpf;
 
   /* If we accumulated enough error for one sample, include one
@@ -372,60 +497,25 @@ gst_audio_buffer_split_output (GstAudioBufferSplit * self, gboolean force,
       self->output_buffer_duration_d)
     size += bpf;
 
+  if (self->output_buffer_list)
+    list = gst_buffer_list_new ();
+
   while ((avail = gst_adapter_available (self->adapter)) >= size || (force
           && avail > 0)) {
     GstBuffer *buffer;
-    GstClockTime resync_time_diff;
 
     size = MIN (size, avail);
-    buffer = gst_adapter_take_buffer (self->adapter, size);
-    buffer = gst_buffer_make_writable (buffer);
-
-    /* After a reset we have to set the discont flag */
-    if (self->current_offset == 0)
-      GST_BUFFER_FLAG_SET (buffer,
-          GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC);
+    /* Unlike gst_adapter_take_buffer() this does not merge the memories of
+     * the input buffers if the output spans several of them */
+    if (self->zero_copy)
+      buffer = gst_adapter_take_buffer_fast (self->adapter, size);
     else
-      GST_BUFFER_FLAG_UNSET (buffer,
-          GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC);
-
-    resync_time_diff =
-        gst_util_uint64_scale (self->current_offset, GST_SECOND, rate);
-    if (self->out_segment.rate < 0.0) {
-      if (resync_pts > resync_time_diff)
-        GST_BUFFER_PTS (buffer) = resync_pts - resync_time_diff;
-      else
-        GST_BUFFER_PTS (buffer) = 0;
-      GST_BUFFER_DURATION (buffer) =
-          gst_util_uint64_scale (size / bpf, GST_SECOND, rate);
-
-      self->current_offset += size / bpf;
-    } else {
-      GST_BUFFER_PTS (buffer) = resync_pts + resync_time_diff;
-      self->current_offset += size / bpf;
-      resync_time_diff =
-          gst_util_uint64_scale (self->current_offset, GST_SECOND, rate);
-      GST_BUFFER_DURATION (buffer) =
-          resync_time_diff - (GST_BUFFER_PTS (buffer) - resync_pts);
-    }
-
-    GST_BUFFER_OFFSET (buffer) = GST_BUFFER_OFFSET_NONE;
-    GST_BUFFER_OFFSET_END (buffer) = GST_BUFFER_OFFSET_NONE;
-
-    self->accumulated_error =
-        (self->accumulated_error +
-        self->error_per_buffer) % self->output_buffer_duration_d;
-
-    GST_LOG_OBJECT (self,
-        "Outputting buffer at running time %" GST_TIME_FORMAT
-        " with timestamp %" GST_TIME_FORMAT " with duration %" GST_TIME_FORMAT
-        " (%u samples)",
-        GST_TIME_ARGS (gst_segment_to_running_time (&self->out_segment,
-                GST_FORMAT_TIME, GST_BUFFER_PTS (buffer))),
-        GST_TIME_ARGS (GST_BUFFER_PTS (buffer)),
-        GST_TIME_ARGS (GST_BUFFER_DURATION (buffer)), size / bpf);
+      buffer = gst_adapter_take_buffer (self->adapter, size);
+    buffer = gst_buffer_make_writable (buffer);
 
-    ret = gst_pad_push (self->srcpad, buffer);
+    ret =
+        gst_audio_buffer_split_finish_buffer (self, buffer, size, rate, bpf,
+        list);
     if (ret != GST_FLOW_OK)
       break;
 
@@ -437,6 +527,52 @@ gst_audio_buffer_split_output (GstAudioBufferSplit * self, gboolean force,
       size += bpf;
   }
 
+  if (list)
+    ret = gst_audio_buffer_split_push_list (self, list);
+
+  return ret;
+}
+
+/* Splits @buffer, whose size is a multiple of the output buffer size, into
+ * sub-buffers sharing its memory without going through the adapter. Only
+ * valid while the adapter is empty and every output buffer has the same
+ * number of samples */
+static GstFlowReturn
+gst_audio_buffer_split_output_direct (GstAudioBufferSplit * self,
+    GstBuffer * buffer, gint rate, gint bpf, guint samples_per_buffer)
+{
+  gsize input_size = gst_buffer_get_size (buffer);
+  gint size = samples_per_buffer * bpf;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBufferList *list = NULL;
+  gsize offset;
+
+  if (input_size == size && !self->output_buffer_list) {
+    buffer = gst_buffer_make_writable (buffer);
+    return gst_audio_buffer_split_finish_buffer (self, buffer, size, rate, bpf,
+        NULL);
+  }
+
+  if (self->output_buffer_list)
+    list = gst_buffer_list_new_sized (input_size / size);
+
+  for (offset = 0; offset < input_size; offset += size) {
+    GstBuffer *outbuf;
+
+    outbuf = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_ALL, offset, size);
+
+    ret =
+        gst_audio_buffer_split_finish_buffer (self, outbuf, size, rate, bpf,
+        list);
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+
+  gst_buffer_unref (buffer);
+
+  if (list)
+    ret = gst_audio_buffer_split_push_list (self, list);
+
   return ret;
 }
 
@@ -720,6 +856,15 @@ gst_audio_buffer_split_sink_chain (GstPad * pad, GstObject * parent,
   if (!buffer)
     return GST_FLOW_OK;
 
+  /* Fast path: nothing is pending and the input splits into whole output
+   * buffers without a remainder */
+  if (gst_adapter_available (self->adapter) == 0
+      && self->error_per_buffer == 0
+      && gst_buffer_get_size (buffer) % (samples_per_buffer * bpf) == 0) {
+    return gst_audio_buffer_split_output_direct (self, buffer, rate, bpf,
+        samples_per_buffer);
+  }
+
   gst_adapter_push (self->adapter, buffer);
 
   return gst_audio_buffer_split_output (self, FALSE, rate, bpf,
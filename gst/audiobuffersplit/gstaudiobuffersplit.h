@@ -66,6 +66,8 @@ struct _GstAudioBufferSplit {
   gboolean strict_buffer_size;
   gboolean gapless;
   GstClockTime max_silence_time;
+  gboolean zero_copy;
+  gboolean output_buffer_list;
 };
 
 struct _GstAudioBufferSplitClass {
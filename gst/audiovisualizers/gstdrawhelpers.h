@@ -21,6 +21,24 @@
  
 /* FIXME: add versions that don't ignore alpha */
  
+/* Adds the components of _c to the ones of _p, saturating at 255. The four
+ * bytes are added at once inside the word, the carries out of each byte
+ * select the saturated ones */
+static inline guint32
+add_pixel_sat (guint32 _p, guint32 _c)
+{
+  guint32 _lo = (_p & 0x7f7f7f7f) + (_c & 0x7f7f7f7f);
+  guint32 _carry = ((_p & _c) | ((_p ^ _c) & _lo)) & 0x80808080;
+
+  return (_lo ^ ((_p ^ _c) & 0x80808080)) | ((_carry >> 7) * 0xff);
+}
+
+static inline void
+add_pixel (guint32 * _p, guint32 _c)
+{
+  *_p = add_pixel_sat (*_p, _c);
+}
+
 #define draw_dot(_vd, _x, _y, _st, _c) G_STMT_START {                          \
   _vd[(_y * _st) + _x] = _c;                                                   \
 } G_STMT_END
@@ -85,3 +103,73 @@
   }                                                                            \
 } G_STMT_END
 
+
+#define draw_dot_add(_vd, _x, _y, _st, _c) G_STMT_START {                      \
+  add_pixel (&_vd[((_y) * (_st)) + (_x)], _c);                                 \
+} G_STMT_END
+
+/* the spans below include _x1/_y1 and exclude _x2/_y2 */
+
+#define draw_hline(_vd, _x1, _x2, _y, _st, _c) G_STMT_START {                  \
+  guint32 *_p = &_vd[(_y) * (_st)];                                            \
+  gint _i;                                                                     \
+                                                                               \
+  for (_i = (_x1); _i < (_x2); _i++)                                           \
+    _p[_i] = _c;                                                               \
+} G_STMT_END
+
+#define draw_hline_add(_vd, _x1, _x2, _y, _st, _c) G_STMT_START {              \
+  guint32 *_p = &_vd[(_y) * (_st)];                                            \
+  gint _i;                                                                     \
+                                                                               \
+  for (_i = (_x1); _i < (_x2); _i++)                                           \
+    _p[_i] = add_pixel_sat (_p[_i], _c);                                       \
+} G_STMT_END
+
+#define draw_vline(_vd, _x, _y1, _y2, _st, _c) G_STMT_START {                  \
+  gint _i;                                                                     \
+                                                                               \
+  for (_i = (_y1); _i < (_y2); _i++)                                           \
+    _vd[(_i * (_st)) + (_x)] = _c;                                             \
+} G_STMT_END
+
+#define draw_vline_add(_vd, _x, _y1, _y2, _st, _c) G_STMT_START {              \
+  gint _i;                                                                     \
+                                                                               \
+  for (_i = (_y1); _i < (_y2); _i++)                                           \
+    add_pixel (&_vd[(_i * (_st)) + (_x)], _c);                                 \
+} G_STMT_END
+
+/* filled rectangle, drawn row by row */
+#define draw_box(_vd, _x1, _x2, _y1, _y2, _st, _c) G_STMT_START {              \
+  gint _j;                                                                     \
+                                                                               \
+  for (_j = (_y1); _j < (_y2); _j++)                                           \
+    draw_hline (_vd, _x1, _x2, _j, _st, _c);                                   \
+} G_STMT_END
+
+#define draw_box_add(_vd, _x1, _x2, _y1, _y2, _st, _c) G_STMT_START {          \
+  gint _j;                                                                     \
+                                                                               \
+  for (_j = (_y1); _j < (_y2); _j++)                                           \
+    draw_hline_add (_vd, _x1, _x2, _j, _st, _c);                               \
+} G_STMT_END
+
+/* vertical bars from the rows in _top down to the bottom row _y2, drawn row
+ * by row from _y1, the smallest of the _top rows. The top pixel of a bar is
+ * set to _c and _cf is added to the ones below, which writes the frame in
+ * memory order */
+#define draw_bars(_vd, _top, _w, _y1, _y2, _st, _c, _cf) G_STMT_START {        \
+  guint32 *_r, _p;                                                             \
+  gint _i, _j;                                                                 \
+                                                                               \
+  for (_j = (_y1); _j <= (gint) (_y2); _j++) {                                 \
+    _r = &_vd[_j * (_st)];                                                     \
+    for (_i = 0; _i < (gint) (_w); _i++) {                                     \
+      _p = _r[_i];                                                             \
+      _p = _j == (gint) (_top)[_i] ? (_c) : _p;                                \
+      _p = _j > (gint) (_top)[_i] ? add_pixel_sat (_p, _cf) : _p;              \
+      _r[_i] = _p;                                                             \
+    }                                                                          \
+  }                                                                            \
+} G_STMT_END
@@ -0,0 +1,133 @@
+/* GStreamer
+ *
+ * gstscopefft.c: float FFT plans shared between scopes
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* All scope instances that need a FFT of the same length share one plan.
+ * The plan holds the precomputed window and a pool of FFT contexts: a
+ * context has scratch memory and can only be used by one thread at a time,
+ * so there are as many of them as scopes of that size rendering in
+ * parallel, instead of one per instance. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+
+#include "gstscopefft.h"
+
+struct _GstScopeFFT
+{
+  gint len;
+  gint ref_count;               /* protected by the plans lock */
+
+  gfloat *window;
+
+  GMutex lock;
+  GSList *idle;                 /* contexts not in use */
+};
+
+G_LOCK_DEFINE_STATIC (plans);
+static GHashTable *plans = NULL;
+
+/* Returns the plan for real FFTs of @len samples, @len must be even */
+GstScopeFFT *
+gst_scope_fft_get (gint len)
+{
+  GstScopeFFT *fft;
+  gint i;
+
+  g_return_val_if_fail (len > 0 && len % 2 == 0, NULL);
+
+  G_LOCK (plans);
+  if (!plans)
+    plans = g_hash_table_new (NULL, NULL);
+
+  fft = g_hash_table_lookup (plans, GINT_TO_POINTER (len));
+  if (fft) {
+    fft->ref_count++;
+  } else {
+    fft = g_new0 (GstScopeFFT, 1);
+    fft->len = len;
+    fft->ref_count = 1;
+    fft->window = g_new (gfloat, len);
+    for (i = 0; i < len; i++)
+      fft->window[i] = 0.53836 - 0.46164 * cos (2.0 * G_PI * i / len);
+    g_mutex_init (&fft->lock);
+    g_hash_table_insert (plans, GINT_TO_POINTER (len), fft);
+  }
+  G_UNLOCK (plans);
+
+  return fft;
+}
+
+void
+gst_scope_fft_unref (GstScopeFFT * fft)
+{
+  g_return_if_fail (fft != NULL);
+
+  G_LOCK (plans);
+  if (--fft->ref_count > 0) {
+    G_UNLOCK (plans);
+    return;
+  }
+  g_hash_table_remove (plans, GINT_TO_POINTER (fft->len));
+  G_UNLOCK (plans);
+
+  g_slist_free_full (fft->idle, (GDestroyNotify) gst_fft_f32_free);
+  g_free (fft->window);
+  g_mutex_clear (&fft->lock);
+  g_free (fft);
+}
+
+/* Same as gst_fft_f32_window() with GST_FFT_WINDOW_HAMMING, but without
+ * computing the window every time */
+void
+gst_scope_fft_window_hamming (GstScopeFFT * fft, gfloat * timedata)
+{
+  const gfloat *window = fft->window;
+  gint i;
+
+  for (i = 0; i < fft->len; i++)
+    timedata[i] *= window[i];
+}
+
+/* Unlike the integer FFTs, the output is not scaled by 1 / len */
+void
+gst_scope_fft_fft (GstScopeFFT * fft, const gfloat * timedata,
+    GstFFTF32Complex * freqdata)
+{
+  GstFFTF32 *ctx = NULL;
+
+  g_mutex_lock (&fft->lock);
+  if (fft->idle) {
+    ctx = fft->idle->data;
+    fft->idle = g_slist_delete_link (fft->idle, fft->idle);
+  }
+  g_mutex_unlock (&fft->lock);
+
+  if (!ctx)
+    ctx = gst_fft_f32_new (fft->len, FALSE);
+
+  gst_fft_f32_fft (ctx, timedata, freqdata);
+
+  g_mutex_lock (&fft->lock);
+  fft->idle = g_slist_prepend (fft->idle, ctx);
+  g_mutex_unlock (&fft->lock);
+}
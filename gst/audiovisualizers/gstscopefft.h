@@ -0,0 +1,39 @@
+/* GStreamer
+ *
+ * gstscopefft.h: float FFT plans shared between scopes
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_SCOPE_FFT_H__
+#define __GST_SCOPE_FFT_H__
+
+#include <gst/gst.h>
+#include <gst/fft/gstfftf32.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstScopeFFT GstScopeFFT;
+
+GstScopeFFT * gst_scope_fft_get (gint len);
+void gst_scope_fft_unref (GstScopeFFT * fft);
+
+void gst_scope_fft_window_hamming (GstScopeFFT * fft, gfloat * timedata);
+void gst_scope_fft_fft (GstScopeFFT * fft, const gfloat * timedata,
+    GstFFTF32Complex * freqdata);
+
+G_END_DECLS
+#endif /* __GST_SCOPE_FFT_H__ */
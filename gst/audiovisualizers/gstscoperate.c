@@ -0,0 +1,161 @@
+/* GStreamer
+ *
+ * gstscoperate.c: rendering scopes below the video framerate
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Scopes can render at a lower rate than the video framerate, the frames in
+ * between repeat the last rendered picture. Only the picture is kept, so the
+ * repeated frames cost a copy instead of the analysis and drawing. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstscoperate.h"
+
+/* Starts counting the render periods from the next frame on, which is
+ * always rendered. Called with the object lock */
+static void
+gst_scope_render_rate_restart (GstScopeRenderRate * rate)
+{
+  rate->n_frames = 0;
+  rate->last_slot = G_MAXUINT64;
+  rate->last_pts = GST_CLOCK_TIME_NONE;
+}
+
+void
+gst_scope_render_rate_init (GstScopeRenderRate * rate, GstObject * object)
+{
+  rate->object = object;
+  rate->rate_n = 0;
+  rate->rate_d = 1;
+  rate->last_frame = NULL;
+  rate->last_frame_size = 0;
+  gst_scope_render_rate_restart (rate);
+}
+
+/* Drops the last picture, to be called when the video format changes and
+ * on finalize */
+void
+gst_scope_render_rate_reset (GstScopeRenderRate * rate)
+{
+  GST_OBJECT_LOCK (rate->object);
+  gst_scope_render_rate_restart (rate);
+  GST_OBJECT_UNLOCK (rate->object);
+
+  g_free (rate->last_frame);
+  rate->last_frame = NULL;
+  rate->last_frame_size = 0;
+}
+
+void
+gst_scope_render_rate_set_property (GstScopeRenderRate * rate,
+    const GValue * value)
+{
+  GST_OBJECT_LOCK (rate->object);
+  rate->rate_n = gst_value_get_fraction_numerator (value);
+  rate->rate_d = gst_value_get_fraction_denominator (value);
+  gst_scope_render_rate_restart (rate);
+  GST_OBJECT_UNLOCK (rate->object);
+}
+
+void
+gst_scope_render_rate_get_property (GstScopeRenderRate * rate, GValue * value)
+{
+  GST_OBJECT_LOCK (rate->object);
+  gst_value_set_fraction (value, rate->rate_n, rate->rate_d);
+  GST_OBJECT_UNLOCK (rate->object);
+}
+
+/* Returns TRUE if @video got the last rendered picture and must not be
+ * rendered */
+gboolean
+gst_scope_render_rate_repeat (GstScopeRenderRate * rate, GstVideoFrame * video)
+{
+  gint fps_n = GST_VIDEO_INFO_FPS_N (&video->info);
+  gint fps_d = GST_VIDEO_INFO_FPS_D (&video->info);
+  GstClockTime pts = GST_BUFFER_PTS (video->buffer);
+  GstClockTime frame_duration;
+  gboolean repeat;
+  guint64 slot;
+  gsize size;
+
+  if (fps_n == 0)
+    return FALSE;
+
+  GST_OBJECT_LOCK (rate->object);
+  /* not below the framerate, every frame is rendered anyway */
+  if (rate->rate_n == 0 ||
+      (guint64) rate->rate_n * fps_d >= (guint64) fps_n * rate->rate_d) {
+    GST_OBJECT_UNLOCK (rate->object);
+    return FALSE;
+  }
+
+  /* flushes and segments are handled by the base class, but a seek shows
+   * up as the timestamps going backwards or jumping ahead */
+  if (GST_CLOCK_TIME_IS_VALID (pts)) {
+    frame_duration = gst_util_uint64_scale_int (GST_SECOND, fps_d, fps_n);
+    if (GST_CLOCK_TIME_IS_VALID (rate->last_pts) && (pts < rate->last_pts
+            || pts - rate->last_pts > 2 * frame_duration))
+      gst_scope_render_rate_restart (rate);
+    rate->last_pts = pts;
+  }
+
+  /* the render period the frame falls into */
+  slot = gst_util_uint64_scale (rate->n_frames++,
+      (guint64) rate->rate_n * fps_d, (guint64) rate->rate_d * fps_n);
+
+  size = GST_VIDEO_FRAME_PLANE_STRIDE (video, 0) *
+      GST_VIDEO_FRAME_HEIGHT (video);
+  repeat = slot == rate->last_slot && rate->last_frame
+      && rate->last_frame_size == size;
+  rate->last_slot = slot;
+  GST_OBJECT_UNLOCK (rate->object);
+
+  /* the last picture is only touched from the streaming thread */
+  if (repeat)
+    memcpy (GST_VIDEO_FRAME_PLANE_DATA (video, 0), rate->last_frame, size);
+
+  return repeat;
+}
+
+/* Keeps the picture of the rendered frame @video for the repeated ones */
+void
+gst_scope_render_rate_store (GstScopeRenderRate * rate, GstVideoFrame * video)
+{
+  gboolean enabled;
+  gsize size;
+
+  GST_OBJECT_LOCK (rate->object);
+  enabled = rate->rate_n != 0;
+  GST_OBJECT_UNLOCK (rate->object);
+
+  if (!enabled)
+    return;
+
+  size = GST_VIDEO_FRAME_PLANE_STRIDE (video, 0) *
+      GST_VIDEO_FRAME_HEIGHT (video);
+  if (rate->last_frame_size != size) {
+    g_free (rate->last_frame);
+    rate->last_frame = g_malloc (size);
+    rate->last_frame_size = size;
+  }
+  memcpy (rate->last_frame, GST_VIDEO_FRAME_PLANE_DATA (video, 0), size);
+}
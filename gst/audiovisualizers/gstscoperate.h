@@ -0,0 +1,60 @@
+/* GStreamer
+ *
+ * gstscoperate.h: rendering scopes below the video framerate
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_SCOPE_RATE_H__
+#define __GST_SCOPE_RATE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstScopeRenderRate
+{
+  /* the scope, its object lock protects the fields below */
+  GstObject *object;
+
+  /* 0/1 renders every frame */
+  gint rate_n, rate_d;
+
+  /* < private > */
+  guint64 n_frames;
+  guint64 last_slot;
+  GstClockTime last_pts;
+  guint8 *last_frame;
+  gsize last_frame_size;
+};
+
+void gst_scope_render_rate_init (GstScopeRenderRate * rate,
+    GstObject * object);
+void gst_scope_render_rate_reset (GstScopeRenderRate * rate);
+
+void gst_scope_render_rate_set_property (GstScopeRenderRate * rate,
+    const GValue * value);
+void gst_scope_render_rate_get_property (GstScopeRenderRate * rate,
+    GValue * value);
+
+gboolean gst_scope_render_rate_repeat (GstScopeRenderRate * rate,
+    GstVideoFrame * video);
+void gst_scope_render_rate_store (GstScopeRenderRate * rate,
+    GstVideoFrame * video);
+
+G_END_DECLS
+#endif /* __GST_SCOPE_RATE_H__ */
@@ -70,7 +70,8 @@ GST_DEBUG_CATEGORY_STATIC (space_scope_debug);
 enum
 {
   PROP_0,
-  PROP_STYLE
+  PROP_STYLE,
+  PROP_RENDER_RATE
 };
 
 enum
@@ -116,6 +117,9 @@ static void render_color_dots (GstAudioVisualizer * base, guint32 * vdata,
 static void render_color_lines (GstAudioVisualizer * base, guint32 * vdata,
     gint16 * adata, guint num_samples);
 
+static void gst_space_scope_finalize (GObject * object);
+
+static gboolean gst_space_scope_setup (GstAudioVisualizer * scope);
 static gboolean gst_space_scope_render (GstAudioVisualizer * scope,
     GstBuffer * audio, GstVideoFrame * video);
 
@@ -140,7 +144,9 @@ gst_space_scope_class_init (GstSpaceScopeClass * g_class)
 
   gobject_class->set_property = gst_space_scope_set_property;
   gobject_class->get_property = gst_space_scope_get_property;
+  gobject_class->finalize = gst_space_scope_finalize;
 
+  scope_class->setup = GST_DEBUG_FUNCPTR (gst_space_scope_setup);
   scope_class->render = GST_DEBUG_FUNCPTR (gst_space_scope_render);
 
   g_object_class_install_property (gobject_class, PROP_STYLE,
@@ -149,13 +155,48 @@ gst_space_scope_class_init (GstSpaceScopeClass * g_class)
           GST_TYPE_SPACE_SCOPE_STYLE, STYLE_DOTS,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstSpaceScope:render-rate:
+   *
+   * Maximum rate at which the points are rendered, the frames in between
+   * repeat the last rendered one. 0/1 renders every frame.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_RENDER_RATE,
+      gst_param_spec_fraction ("render-rate", "Render rate",
+          "Maximum rate at which frames are rendered, the frames in between "
+          "repeat the last rendered one (0/1 = every frame)",
+          0, 1, G_MAXINT, 1, 0, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_type_mark_as_plugin_api (GST_TYPE_SPACE_SCOPE_STYLE, 0);
 }
 
 static void
 gst_space_scope_init (GstSpaceScope * scope)
 {
-  /* do nothing */
+  gst_scope_render_rate_init (&scope->render_rate, GST_OBJECT (scope));
+}
+
+static void
+gst_space_scope_finalize (GObject * object)
+{
+  GstSpaceScope *scope = GST_SPACE_SCOPE (object);
+
+  gst_scope_render_rate_reset (&scope->render_rate);
+
+  G_OBJECT_CLASS (gst_space_scope_parent_class)->finalize (object);
+}
+
+static gboolean
+gst_space_scope_setup (GstAudioVisualizer * bscope)
+{
+  GstSpaceScope *scope = GST_SPACE_SCOPE (bscope);
+
+  gst_scope_render_rate_reset (&scope->render_rate);
+
+  return TRUE;
 }
 
 static void
@@ -182,6 +223,9 @@ gst_space_scope_set_property (GObject * object, guint prop_id,
           break;
       }
       break;
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_set_property (&scope->render_rate, value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -198,6 +242,9 @@ gst_space_scope_get_property (GObject * object, guint prop_id,
     case PROP_STYLE:
       g_value_set_enum (value, scope->style);
       break;
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_get_property (&scope->render_rate, value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -436,6 +483,9 @@ gst_space_scope_render (GstAudioVisualizer * base, GstBuffer * audio,
   GstMapInfo amap;
   guint num_samples;
 
+  if (gst_scope_render_rate_repeat (&scope->render_rate, video))
+    return TRUE;
+
   gst_buffer_map (audio, &amap, GST_MAP_READ);
 
   num_samples =
@@ -443,6 +493,9 @@ gst_space_scope_render (GstAudioVisualizer * base, GstBuffer * audio,
   scope->process (base, (guint32 *) GST_VIDEO_FRAME_PLANE_DATA (video, 0),
       (gint16 *) amap.data, num_samples);
   gst_buffer_unmap (audio, &amap);
+
+  gst_scope_render_rate_store (&scope->render_rate, video);
+
   return TRUE;
 }
 
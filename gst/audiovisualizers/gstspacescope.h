@@ -23,6 +23,7 @@
 #define __GST_SPACE_SCOPE_H__
 
 #include "gst/pbutils/gstaudiovisualizer.h"
+#include "gstscoperate.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_SPACE_SCOPE            (gst_space_scope_get_type())
@@ -43,6 +44,8 @@ struct _GstSpaceScope
   GstSpaceScopeProcessFunc process;
   gint style;
 
+  GstScopeRenderRate render_rate;
+
   /* filter specific data */
   gdouble f1l_l, f1l_m, f1l_h;
   gdouble f1r_l, f1r_m, f1r_h;
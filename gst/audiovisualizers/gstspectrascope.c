@@ -27,6 +27,11 @@
  * Spectrascope is a simple spectrum visualisation element. It renders the
  * frequency spectrum as a series of bars.
  *
+ * The spectrum is computed with a float FFT whose plan is shared between all
+ * scopes of the same width. With #GstSpectraScope:render-rate the spectrum
+ * can be rendered less often than the video framerate, which is useful when
+ * a lot of scopes are shown at once.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 audiotestsrc ! audioconvert ! spectrascope ! ximagesink
@@ -37,8 +42,10 @@
 #include "config.h"
 #endif
 #include <stdlib.h>
+#include <math.h>
 
 #include "gstspectrascope.h"
+#include "gstdrawhelpers.h"
 
 #if G_BYTE_ORDER == G_BIG_ENDIAN
 #define RGB_ORDER "xRGB"
@@ -58,7 +65,8 @@ GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
+        "format = (string) { " GST_AUDIO_NE (S16) ", " GST_AUDIO_NE (F32)
+        " }, "
         "layout = (string) interleaved, "
         "rate = (int) [ 8000, 96000 ], "
         "channels = (int) 2, " "channel-mask = (bitmask) 0x3")
@@ -68,6 +76,16 @@ GST_STATIC_PAD_TEMPLATE ("sink",
 GST_DEBUG_CATEGORY_STATIC (spectra_scope_debug);
 #define GST_CAT_DEFAULT spectra_scope_debug
 
+enum
+{
+  PROP_0,
+  PROP_RENDER_RATE
+};
+
+static void gst_spectra_scope_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_spectra_scope_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 static void gst_spectra_scope_finalize (GObject * object);
 
 static gboolean gst_spectra_scope_setup (GstAudioVisualizer * scope);
@@ -84,6 +102,8 @@ gst_spectra_scope_class_init (GstSpectraScopeClass * g_class)
   GstElementClass *element_class = (GstElementClass *) g_class;
   GstAudioVisualizerClass *scope_class = (GstAudioVisualizerClass *) g_class;
 
+  gobject_class->set_property = gst_spectra_scope_set_property;
+  gobject_class->get_property = gst_spectra_scope_get_property;
   gobject_class->finalize = gst_spectra_scope_finalize;
 
   gst_element_class_set_static_metadata (element_class,
@@ -97,27 +117,77 @@ gst_spectra_scope_class_init (GstSpectraScopeClass * g_class)
 
   scope_class->setup = GST_DEBUG_FUNCPTR (gst_spectra_scope_setup);
   scope_class->render = GST_DEBUG_FUNCPTR (gst_spectra_scope_render);
+
+  /**
+   * GstSpectraScope:render-rate:
+   *
+   * Maximum rate at which the spectrum is rendered, the frames in between
+   * repeat the last rendered one. 0/1 renders every frame.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_RENDER_RATE,
+      gst_param_spec_fraction ("render-rate", "Render rate",
+          "Maximum rate at which frames are rendered, the frames in between "
+          "repeat the last rendered one (0/1 = every frame)",
+          0, 1, G_MAXINT, 1, 0, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 gst_spectra_scope_init (GstSpectraScope * scope)
 {
-  /* do nothing */
+  gst_scope_render_rate_init (&scope->render_rate, GST_OBJECT (scope));
 }
 
 static void
-gst_spectra_scope_finalize (GObject * object)
+gst_spectra_scope_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstSpectraScope *scope = GST_SPECTRA_SCOPE (object);
+
+  switch (prop_id) {
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_set_property (&scope->render_rate, value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_spectra_scope_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
 {
   GstSpectraScope *scope = GST_SPECTRA_SCOPE (object);
 
-  if (scope->fft_ctx) {
-    gst_fft_s16_free (scope->fft_ctx);
-    scope->fft_ctx = NULL;
+  switch (prop_id) {
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_get_property (&scope->render_rate, value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
   }
-  if (scope->freq_data) {
-    g_free (scope->freq_data);
-    scope->freq_data = NULL;
+}
+
+static void
+gst_spectra_scope_finalize (GObject * object)
+{
+  GstSpectraScope *scope = GST_SPECTRA_SCOPE (object);
+
+  if (scope->fft) {
+    gst_scope_fft_unref (scope->fft);
+    scope->fft = NULL;
   }
+  g_free (scope->freq_data);
+  scope->freq_data = NULL;
+  g_free (scope->adata);
+  scope->adata = NULL;
+  g_free (scope->top);
+  scope->top = NULL;
+  gst_scope_render_rate_reset (&scope->render_rate);
 
   G_OBJECT_CLASS (gst_spectra_scope_parent_class)->finalize (object);
 }
@@ -128,40 +198,22 @@ gst_spectra_scope_setup (GstAudioVisualizer * bscope)
   GstSpectraScope *scope = GST_SPECTRA_SCOPE (bscope);
   guint num_freq = GST_VIDEO_INFO_WIDTH (&bscope->vinfo) + 1;
 
-  if (scope->fft_ctx)
-    gst_fft_s16_free (scope->fft_ctx);
+  if (scope->fft)
+    gst_scope_fft_unref (scope->fft);
   g_free (scope->freq_data);
+  g_free (scope->adata);
+  g_free (scope->top);
 
   /* we'd need this amount of samples per render() call */
   bscope->req_spf = num_freq * 2 - 2;
-  scope->fft_ctx = gst_fft_s16_new (bscope->req_spf, FALSE);
-  scope->freq_data = g_new (GstFFTS16Complex, num_freq);
+  scope->fft = gst_scope_fft_get (bscope->req_spf);
+  scope->freq_data = g_new (GstFFTF32Complex, num_freq);
+  scope->adata = g_new0 (gfloat, bscope->req_spf);
+  scope->top = g_new (guint, num_freq - 1);
 
-  return TRUE;
-}
+  gst_scope_render_rate_reset (&scope->render_rate);
 
-static inline void
-add_pixel (guint32 * _p, guint32 _c)
-{
-  guint8 *p = (guint8 *) _p;
-  guint8 *c = (guint8 *) & _c;
-
-  if (p[0] < 255 - c[0])
-    p[0] += c[0];
-  else
-    p[0] = 255;
-  if (p[1] < 255 - c[1])
-    p[1] += c[1];
-  else
-    p[1] = 255;
-  if (p[2] < 255 - c[2])
-    p[2] += c[2];
-  else
-    p[2] = 255;
-  if (p[3] < 255 - c[3])
-    p[3] += c[3];
-  else
-    p[3] = 255;
+  return TRUE;
 }
 
 static gboolean
@@ -169,63 +221,78 @@ gst_spectra_scope_render (GstAudioVisualizer * bscope, GstBuffer * audio,
     GstVideoFrame * video)
 {
   GstSpectraScope *scope = GST_SPECTRA_SCOPE (bscope);
-  gint16 *mono_adata;
-  GstFFTS16Complex *fdata = scope->freq_data;
-  guint x, y, off, l;
+  gfloat *mono_adata = scope->adata;
+  GstFFTF32Complex *fdata = scope->freq_data;
+  guint *top = scope->top;
+  guint x, y, min_y;
   guint w = GST_VIDEO_INFO_WIDTH (&bscope->vinfo);
   guint h = GST_VIDEO_INFO_HEIGHT (&bscope->vinfo) - 1;
-  gfloat fr, fi;
+  gfloat fr, fi, mag, scale;
   GstMapInfo amap;
   guint32 *vdata;
-  gint channels;
+  guint ch, num_samples, i, c, s;
+
+  if (gst_scope_render_rate_repeat (&scope->render_rate, video))
+    return TRUE;
 
   gst_buffer_map (audio, &amap, GST_MAP_READ);
   vdata = (guint32 *) GST_VIDEO_FRAME_PLANE_DATA (video, 0);
 
-  channels = GST_AUDIO_INFO_CHANNELS (&bscope->ainfo);
+  ch = GST_AUDIO_INFO_CHANNELS (&bscope->ainfo);
+  num_samples = amap.size / GST_AUDIO_INFO_BPF (&bscope->ainfo);
+  num_samples = MIN (num_samples, bscope->req_spf);
 
-  mono_adata = (gint16 *) g_memdup (amap.data, amap.size);
+  /* deinterleave and mixdown adata, float samples are scaled to the range
+   * of the integer ones */
+  s = 0;
+  if (GST_AUDIO_INFO_FORMAT (&bscope->ainfo) == GST_AUDIO_FORMAT_F32) {
+    const gfloat *adata = (const gfloat *) amap.data;
+    gfloat norm = 32768.0 / ch;
 
-  if (channels > 1) {
-    guint ch = channels;
-    guint num_samples = amap.size / (ch * sizeof (gint16));
-    guint i, c, v, s = 0;
+    for (i = 0; i < num_samples; i++) {
+      gfloat v = 0.0;
+      for (c = 0; c < ch; c++)
+        v += adata[s++];
+      mono_adata[i] = v * norm;
+    }
+  } else {
+    const gint16 *adata = (const gint16 *) amap.data;
+    gfloat norm = 1.0 / ch;
 
-    /* deinterleave and mixdown adata */
     for (i = 0; i < num_samples; i++) {
-      v = 0;
-      for (c = 0; c < ch; c++) {
-        v += mono_adata[s++];
-      }
-      mono_adata[i] = v / ch;
+      gint v = 0;
+      for (c = 0; c < ch; c++)
+        v += adata[s++];
+      mono_adata[i] = v * norm;
     }
   }
+  gst_buffer_unmap (audio, &amap);
 
   /* run fft */
-  gst_fft_s16_window (scope->fft_ctx, mono_adata, GST_FFT_WINDOW_HAMMING);
-  gst_fft_s16_fft (scope->fft_ctx, mono_adata, fdata);
-  g_free (mono_adata);
+  gst_scope_fft_window_hamming (scope->fft, mono_adata);
+  gst_scope_fft_fft (scope->fft, mono_adata, fdata);
 
-  /* draw lines */
+  /* bar heights, the float fft is not normalized by the length like the
+   * integer one we used to have */
+  scale = 1.0 / (512.0 * bscope->req_spf);
+  min_y = h;
   for (x = 0; x < w; x++) {
     /* figure out the range so that we don't need to clip,
      * or even better do a log mapping? */
-    fr = (gfloat) fdata[1 + x].r / 512.0;
-    fi = (gfloat) fdata[1 + x].i / 512.0;
-    y = (guint) (h * sqrt (fr * fr + fi * fi));
-    if (y > h)
-      y = h;
-    y = h - y;
-    off = (y * w) + x;
-    vdata[off] = 0x00FFFFFF;
-    for (l = y; l < h; l++) {
-      off += w;
-      add_pixel (&vdata[off], 0x007F7F7F);
-    }
-    /* ensure bottom line is full bright (especially in move-up mode) */
-    add_pixel (&vdata[off], 0x007F7F7F);
+    fr = fdata[1 + x].r * scale;
+    fi = fdata[1 + x].i * scale;
+    mag = h * sqrtf (fr * fr + fi * fi);
+    y = (guint) MIN (mag, (gfloat) h);
+    top[x] = h - y;
+    min_y = MIN (min_y, top[x]);
   }
-  gst_buffer_unmap (audio, &amap);
+
+  draw_bars (vdata, top, w, min_y, h, w, 0x00FFFFFF, 0x007F7F7F);
+  /* ensure bottom line is full bright (especially in move-up mode) */
+  draw_hline_add (vdata, 0, w, h, w, 0x007F7F7F);
+
+  gst_scope_render_rate_store (&scope->render_rate, video);
+
   return TRUE;
 }
 
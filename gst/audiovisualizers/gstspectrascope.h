@@ -23,7 +23,8 @@
 #define __GST_SPECTRA_SCOPE_H__
 
 #include "gst/pbutils/gstaudiovisualizer.h"
-#include <gst/fft/gstffts16.h>
+#include "gstscopefft.h"
+#include "gstscoperate.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_SPECTRA_SCOPE            (gst_spectra_scope_get_type())
@@ -38,8 +39,12 @@ struct _GstSpectraScope
 {
   GstAudioVisualizer parent;
 
-  GstFFTS16 *fft_ctx;
-  GstFFTS16Complex *freq_data;
+  GstScopeFFT *fft;
+  GstFFTF32Complex *freq_data;
+  gfloat *adata;
+  guint *top;
+
+  GstScopeRenderRate render_rate;
 };
 
 struct _GstSpectraScopeClass
@@ -26,6 +26,10 @@
  * Synaescope is an audio visualisation element. It analyzes frequencies and
  * out-of phase properties of audio and draws this as clouds of stars.
  *
+ * The FFT plans are shared between all scopes of the same height and
+ * #GstSynaeScope:render-rate allows to render less often than the video
+ * framerate.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 audiotestsrc ! audioconvert ! synaescope ! ximagesink
@@ -37,6 +41,7 @@
 #endif
 
 #include "gstsynaescope.h"
+#include "gstdrawhelpers.h"
 
 #if G_BYTE_ORDER == G_BIG_ENDIAN
 #define RGB_ORDER "xRGB"
@@ -56,7 +61,8 @@ GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
+        "format = (string) { " GST_AUDIO_NE (S16) ", " GST_AUDIO_NE (F32)
+        " }, "
         "layout = (string) interleaved, "
         "rate = (int) [ 8000, 96000 ], "
         "channels = (int) 2, " "channel-mask = (bitmask) 0x3")
@@ -66,6 +72,16 @@ GST_STATIC_PAD_TEMPLATE ("sink",
 GST_DEBUG_CATEGORY_STATIC (synae_scope_debug);
 #define GST_CAT_DEFAULT synae_scope_debug
 
+enum
+{
+  PROP_0,
+  PROP_RENDER_RATE
+};
+
+static void gst_synae_scope_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_synae_scope_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 static void gst_synae_scope_finalize (GObject * object);
 
 static gboolean gst_synae_scope_setup (GstAudioVisualizer * scope);
@@ -82,6 +98,8 @@ gst_synae_scope_class_init (GstSynaeScopeClass * g_class)
   GstElementClass *element_class = (GstElementClass *) g_class;
   GstAudioVisualizerClass *scope_class = (GstAudioVisualizerClass *) g_class;
 
+  gobject_class->set_property = gst_synae_scope_set_property;
+  gobject_class->get_property = gst_synae_scope_get_property;
   gobject_class->finalize = gst_synae_scope_finalize;
 
   gst_element_class_set_static_metadata (element_class, "Synaescope",
@@ -96,6 +114,21 @@ gst_synae_scope_class_init (GstSynaeScopeClass * g_class)
 
   scope_class->setup = GST_DEBUG_FUNCPTR (gst_synae_scope_setup);
   scope_class->render = GST_DEBUG_FUNCPTR (gst_synae_scope_render);
+
+  /**
+   * GstSynaeScope:render-rate:
+   *
+   * Maximum rate at which the stars are rendered, the frames in between
+   * repeat the last rendered one. 0/1 renders every frame.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_RENDER_RATE,
+      gst_param_spec_fraction ("render-rate", "Render rate",
+          "Maximum rate at which frames are rendered, the frames in between "
+          "repeat the last rendered one (0/1 = every frame)",
+          0, 1, G_MAXINT, 1, 0, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -120,6 +153,40 @@ gst_synae_scope_init (GstSynaeScope * scope)
 
   for (i = 0; i < 256; i++)
     shade[i] = i * 200 >> 8;
+
+  gst_scope_render_rate_init (&scope->render_rate, GST_OBJECT (scope));
+}
+
+static void
+gst_synae_scope_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstSynaeScope *scope = GST_SYNAE_SCOPE (object);
+
+  switch (prop_id) {
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_set_property (&scope->render_rate, value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_synae_scope_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstSynaeScope *scope = GST_SYNAE_SCOPE (object);
+
+  switch (prop_id) {
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_get_property (&scope->render_rate, value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 static void
@@ -127,9 +194,9 @@ gst_synae_scope_finalize (GObject * object)
 {
   GstSynaeScope *scope = GST_SYNAE_SCOPE (object);
 
-  if (scope->fft_ctx) {
-    gst_fft_s16_free (scope->fft_ctx);
-    scope->fft_ctx = NULL;
+  if (scope->fft) {
+    gst_scope_fft_unref (scope->fft);
+    scope->fft = NULL;
   }
   if (scope->freq_data_l) {
     g_free (scope->freq_data_l);
@@ -147,6 +214,7 @@ gst_synae_scope_finalize (GObject * object)
     g_free (scope->adata_r);
     scope->adata_r = NULL;
   }
+  gst_scope_render_rate_reset (&scope->render_rate);
 
   G_OBJECT_CLASS (gst_synae_scope_parent_class)->finalize (object);
 }
@@ -157,8 +225,8 @@ gst_synae_scope_setup (GstAudioVisualizer * bscope)
   GstSynaeScope *scope = GST_SYNAE_SCOPE (bscope);
   guint num_freq = GST_VIDEO_INFO_HEIGHT (&bscope->vinfo) + 1;
 
-  if (scope->fft_ctx)
-    gst_fft_s16_free (scope->fft_ctx);
+  if (scope->fft)
+    gst_scope_fft_unref (scope->fft);
   g_free (scope->freq_data_l);
   g_free (scope->freq_data_r);
   g_free (scope->adata_l);
@@ -168,38 +236,16 @@ gst_synae_scope_setup (GstAudioVisualizer * bscope)
 
   /* we'd need this amount of samples per render() call */
   bscope->req_spf = num_freq * 2 - 2;
-  scope->fft_ctx = gst_fft_s16_new (bscope->req_spf, FALSE);
-  scope->freq_data_l = g_new (GstFFTS16Complex, num_freq);
-  scope->freq_data_r = g_new (GstFFTS16Complex, num_freq);
+  scope->fft = gst_scope_fft_get (bscope->req_spf);
+  scope->freq_data_l = g_new (GstFFTF32Complex, num_freq);
+  scope->freq_data_r = g_new (GstFFTF32Complex, num_freq);
 
-  scope->adata_l = g_new (gint16, bscope->req_spf);
-  scope->adata_r = g_new (gint16, bscope->req_spf);
+  scope->adata_l = g_new0 (gfloat, bscope->req_spf);
+  scope->adata_r = g_new0 (gfloat, bscope->req_spf);
 
-  return TRUE;
-}
+  gst_scope_render_rate_reset (&scope->render_rate);
 
-static inline void
-add_pixel (guint32 * _p, guint32 _c)
-{
-  guint8 *p = (guint8 *) _p;
-  guint8 *c = (guint8 *) & _c;
-
-  if (p[0] < 255 - c[0])
-    p[0] += c[0];
-  else
-    p[0] = 255;
-  if (p[1] < 255 - c[1])
-    p[1] += c[1];
-  else
-    p[1] = 255;
-  if (p[2] < 255 - c[2])
-    p[2] += c[2];
-  else
-    p[2] = 255;
-  if (p[3] < 255 - c[3])
-    p[3] += c[3];
-  else
-    p[3] = 255;
+  return TRUE;
 }
 
 static gboolean
@@ -209,11 +255,10 @@ gst_synae_scope_render (GstAudioVisualizer * bscope, GstBuffer * audio,
   GstSynaeScope *scope = GST_SYNAE_SCOPE (bscope);
   GstMapInfo amap;
   guint32 *vdata;
-  gint16 *adata;
-  gint16 *adata_l = scope->adata_l;
-  gint16 *adata_r = scope->adata_r;
-  GstFFTS16Complex *fdata_l = scope->freq_data_l;
-  GstFFTS16Complex *fdata_r = scope->freq_data_r;
+  gfloat *adata_l = scope->adata_l;
+  gfloat *adata_r = scope->adata_r;
+  GstFFTF32Complex *fdata_l = scope->freq_data_l;
+  GstFFTF32Complex *fdata_r = scope->freq_data_r;
   gint x, y;
   guint off;
   guint w = GST_VIDEO_INFO_WIDTH (&bscope->vinfo);
@@ -227,35 +272,55 @@ gst_synae_scope_render (GstAudioVisualizer * bscope, GstBuffer * audio,
   gint br, br1, br2;
   gint clarity;
   gdouble fc, r, l, rr, ll;
-  gdouble frl, fil, frr, fir;
+  gdouble frl, fil, frr, fir, norm;
   const guint sl = 30;
 
+  if (gst_scope_render_rate_repeat (&scope->render_rate, video))
+    return TRUE;
+
   gst_buffer_map (audio, &amap, GST_MAP_READ);
 
   vdata = (guint32 *) GST_VIDEO_FRAME_PLANE_DATA (video, 0);
-  adata = (gint16 *) amap.data;
 
-  num_samples = amap.size / (ch * sizeof (gint16));
+  num_samples = amap.size / GST_AUDIO_INFO_BPF (&bscope->ainfo);
+  num_samples = MIN (num_samples, bscope->req_spf);
+
+  /* deinterleave, float samples are scaled to the range of the integer
+   * ones */
+  if (GST_AUDIO_INFO_FORMAT (&bscope->ainfo) == GST_AUDIO_FORMAT_F32) {
+    const gfloat *adata = (const gfloat *) amap.data;
 
-  /* deinterleave */
-  for (i = 0, j = 0; i < num_samples; i++) {
-    adata_l[i] = adata[j++];
-    adata_r[i] = adata[j++];
+    for (i = 0, j = 0; i < num_samples; i++, j += ch) {
+      adata_l[i] = adata[j] * 32768.0f;
+      adata_r[i] = adata[j + 1] * 32768.0f;
+    }
+  } else {
+    const gint16 *adata = (const gint16 *) amap.data;
+
+    for (i = 0, j = 0; i < num_samples; i++, j += ch) {
+      adata_l[i] = adata[j];
+      adata_r[i] = adata[j + 1];
+    }
   }
+  gst_buffer_unmap (audio, &amap);
 
   /* run fft */
-  /*gst_fft_s16_window (scope->fft_ctx, adata_l, GST_FFT_WINDOW_HAMMING); */
-  gst_fft_s16_fft (scope->fft_ctx, adata_l, fdata_l);
-  /*gst_fft_s16_window (scope->fft_ctx, adata_r, GST_FFT_WINDOW_HAMMING); */
-  gst_fft_s16_fft (scope->fft_ctx, adata_r, fdata_r);
+  /*gst_scope_fft_window_hamming (scope->fft, adata_l); */
+  gst_scope_fft_fft (scope->fft, adata_l, fdata_l);
+  /*gst_scope_fft_window_hamming (scope->fft, adata_r); */
+  gst_scope_fft_fft (scope->fft, adata_r, fdata_r);
+
+  /* the float fft is not normalized by the length like the integer one we
+   * used to have */
+  norm = 1.0 / bscope->req_spf;
 
   /* draw stars */
   for (y = 0; y < h; y++) {
     b = h - y;
-    frl = (gdouble) fdata_l[b].r;
-    fil = (gdouble) fdata_l[b].i;
-    frr = (gdouble) fdata_r[b].r;
-    fir = (gdouble) fdata_r[b].i;
+    frl = fdata_l[b].r * norm;
+    fil = fdata_l[b].i * norm;
+    frr = fdata_r[b].r * norm;
+    fir = fdata_r[b].i * norm;
 
     ll = (frl + fil) * (frl + fil) + (frr - fir) * (frr - fir);
     l = sqrt (ll);
@@ -305,7 +370,8 @@ gst_synae_scope_render (GstAudioVisualizer * bscope, GstBuffer * audio,
       }
     }
   }
-  gst_buffer_unmap (audio, &amap);
+
+  gst_scope_render_rate_store (&scope->render_rate, video);
 
   return TRUE;
 }
@@ -70,7 +70,8 @@ GST_DEBUG_CATEGORY_STATIC (wave_scope_debug);
 enum
 {
   PROP_0,
-  PROP_STYLE
+  PROP_STYLE,
+  PROP_RENDER_RATE
 };
 
 enum
@@ -144,6 +145,21 @@ gst_wave_scope_class_init (GstWaveScopeClass * g_class)
           GST_TYPE_WAVE_SCOPE_STYLE, STYLE_DOTS,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstWaveScope:render-rate:
+   *
+   * Maximum rate at which the waveforms are rendered, the frames in between
+   * repeat the last rendered one. 0/1 renders every frame.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_RENDER_RATE,
+      gst_param_spec_fraction ("render-rate", "Render rate",
+          "Maximum rate at which frames are rendered, the frames in between "
+          "repeat the last rendered one (0/1 = every frame)",
+          0, 1, G_MAXINT, 1, 0, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "Waveform oscilloscope", "Visualization", "Simple waveform oscilloscope",
       "Stefan Kost <ensonic@users.sf.net>");
@@ -159,7 +175,7 @@ gst_wave_scope_class_init (GstWaveScopeClass * g_class)
 static void
 gst_wave_scope_init (GstWaveScope * scope)
 {
-  /* do nothing */
+  gst_scope_render_rate_init (&scope->render_rate, GST_OBJECT (scope));
 }
 
 static void
@@ -171,6 +187,7 @@ gst_wave_scope_finalize (GObject * object)
     g_free (scope->flt);
     scope->flt = NULL;
   }
+  gst_scope_render_rate_reset (&scope->render_rate);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -184,6 +201,8 @@ gst_wave_scope_setup (GstAudioVisualizer * bscope)
 
   scope->flt = g_new0 (gdouble, 6 * GST_AUDIO_INFO_CHANNELS (&bscope->ainfo));
 
+  gst_scope_render_rate_reset (&scope->render_rate);
+
   return TRUE;
 }
 
@@ -211,6 +230,9 @@ gst_wave_scope_set_property (GObject * object, guint prop_id,
           break;
       }
       break;
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_set_property (&scope->render_rate, value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -227,6 +249,9 @@ gst_wave_scope_get_property (GObject * object, guint prop_id,
     case PROP_STYLE:
       g_value_set_enum (value, scope->style);
       break;
+    case PROP_RENDER_RATE:
+      gst_scope_render_rate_get_property (&scope->render_rate, value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -412,6 +437,9 @@ gst_wave_scope_render (GstAudioVisualizer * base, GstBuffer * audio,
   guint num_samples;
   gint channels = GST_AUDIO_INFO_CHANNELS (&base->ainfo);
 
+  if (gst_scope_render_rate_repeat (&scope->render_rate, video))
+    return TRUE;
+
   gst_buffer_map (audio, &amap, GST_MAP_READ);
 
   num_samples = amap.size / (channels * sizeof (gint16));
@@ -420,6 +448,8 @@ gst_wave_scope_render (GstAudioVisualizer * base, GstBuffer * audio,
 
   gst_buffer_unmap (audio, &amap);
 
+  gst_scope_render_rate_store (&scope->render_rate, video);
+
   return TRUE;
 }
 
@@ -23,6 +23,7 @@
 #define __GST_WAVE_SCOPE_H__
 
 #include "gst/pbutils/gstaudiovisualizer.h"
+#include "gstscoperate.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_WAVE_SCOPE            (gst_wave_scope_get_type())
@@ -43,6 +44,8 @@ struct _GstWaveScope
   GstWaveScopeProcessFunc process;
   gint style;
 
+  GstScopeRenderRate render_rate;
+
   /* filter specific data */
   gdouble *flt;
 };
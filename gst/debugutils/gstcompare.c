@@ -91,7 +91,9 @@ enum
   PROP_OFFSET_TS,
   PROP_METHOD,
   PROP_THRESHOLD,
-  PROP_UPPER
+  PROP_UPPER,
+  PROP_N_THREADS,
+  PROP_SUMMARY_INTERVAL
 };
 
 #define DEFAULT_META             GST_BUFFER_COPY_ALL
@@ -99,6 +101,8 @@ enum
 #define DEFAULT_METHOD           GST_COMPARE_METHOD_MEM
 #define DEFAULT_THRESHOLD        0
 #define DEFAULT_UPPER            TRUE
+#define DEFAULT_N_THREADS        1
+#define DEFAULT_SUMMARY_INTERVAL 0
 
 static void gst_compare_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
@@ -125,6 +129,8 @@ gst_compare_finalize (GObject * object)
 
   gst_object_unref (comp->cpads);
 
+  gst_slice_runner_free (comp->runner);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -168,6 +174,42 @@ gst_compare_class_init (GstCompareClass * klass)
       g_param_spec_boolean ("upper", "Threshold Upper Bound",
           "Whether threshold value is upper bound or lower bound for difference measure",
           DEFAULT_UPPER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCompare:n-threads:
+   *
+   * Number of threads the SSIM of a buffer is computed with, 0 uses as many
+   * threads as there are processors.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads to use for the ssim method "
+          "(0 = number of processors)", 0, G_MAXINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCompare:summary-interval:
+   *
+   * When non-zero, no "delta" message is posted for mismatching buffers.
+   * Instead a "summary" message with the statistics of the buffers compared
+   * since the previous one is posted every summary-interval buffers and on
+   * EOS. It contains the following fields:
+   *
+   * * "count" (G_TYPE_UINT): number of compared buffers
+   * * "content" (G_TYPE_UINT): number of buffers failing the content match
+   * * "meta" (G_TYPE_UINT): number of buffers failing the metadata match
+   * * "missing" (G_TYPE_UINT): number of buffers without a counterpart
+   * * "min", "max", "mean" (G_TYPE_DOUBLE): statistics of the content
+   *   difference measure
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_SUMMARY_INTERVAL,
+      g_param_spec_uint ("summary-interval", "Summary Interval",
+          "Number of buffers between summary messages, replacing the "
+          "per-buffer messages (0 = disabled)", 0, G_MAXUINT,
+          DEFAULT_SUMMARY_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_static_pad_template (gstelement_class, &src_factory);
   gst_element_class_add_static_pad_template (gstelement_class, &sink_factory);
@@ -212,13 +254,56 @@ gst_compare_init (GstCompare * comp)
   comp->method = DEFAULT_METHOD;
   comp->threshold = DEFAULT_THRESHOLD;
   comp->upper = DEFAULT_UPPER;
+  comp->n_threads = DEFAULT_N_THREADS;
+  comp->summary_interval = DEFAULT_SUMMARY_INTERVAL;
 
   gst_compare_reset (comp);
 }
 
+static void
+gst_compare_summary_reset (GstCompare * comp)
+{
+  comp->summary_count = 0;
+  comp->summary_content_mismatches = 0;
+  comp->summary_meta_mismatches = 0;
+  comp->summary_missing = 0;
+  comp->summary_min = G_MAXDOUBLE;
+  comp->summary_max = -G_MAXDOUBLE;
+  comp->summary_sum = 0;
+}
+
 static void
 gst_compare_reset (GstCompare * comp)
 {
+  gst_compare_summary_reset (comp);
+}
+
+static void
+gst_compare_post_summary (GstCompare * comp)
+{
+  GstStructure *s;
+  guint compared;
+
+  if (comp->summary_count == 0)
+    return;
+
+  compared = comp->summary_count - comp->summary_missing;
+  s = gst_structure_new ("summary",
+      "count", G_TYPE_UINT, comp->summary_count,
+      "content", G_TYPE_UINT, comp->summary_content_mismatches,
+      "meta", G_TYPE_UINT, comp->summary_meta_mismatches,
+      "missing", G_TYPE_UINT, comp->summary_missing, NULL);
+  if (compared > 0) {
+    gst_structure_set (s,
+        "min", G_TYPE_DOUBLE, comp->summary_min,
+        "max", G_TYPE_DOUBLE, comp->summary_max,
+        "mean", G_TYPE_DOUBLE, comp->summary_sum / compared, NULL);
+  }
+
+  gst_element_post_message (GST_ELEMENT (comp),
+      gst_message_new_element (GST_OBJECT (comp), s));
+
+  gst_compare_summary_reset (comp);
 }
 
 static gboolean
@@ -233,7 +318,7 @@ gst_compare_query (GstPad * pad, GstObject * parent, GstQuery * query)
   return gst_pad_peer_query (otherpad, query);
 }
 
-static void
+static gint
 gst_compare_meta (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     GstBuffer * buf2, GstCaps * caps2)
 {
@@ -292,10 +377,13 @@ gst_compare_meta (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     GST_WARNING_OBJECT (comp, "buffers %p and %p failed metadata match %d",
         buf1, buf2, flags);
 
-    gst_element_post_message (GST_ELEMENT (comp),
-        gst_message_new_element (GST_OBJECT (comp),
-            gst_structure_new ("delta", "meta", G_TYPE_INT, flags, NULL)));
+    if (!comp->summary_interval)
+      gst_element_post_message (GST_ELEMENT (comp),
+          gst_message_new_element (GST_OBJECT (comp),
+              gst_structure_new ("delta", "meta", G_TYPE_INT, flags, NULL)));
   }
+
+  return flags;
 }
 
 /* when comparing contents, it is already ensured sizes are equal */
@@ -348,50 +436,161 @@ gst_compare_max (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
   return delta;
 }
 
-static double
-gst_compare_ssim_window (GstCompare * comp, guint8 * data1, guint8 * data2,
-    gint width, gint height, gint step, gint stride)
+/* SSIM is computed on 16x16 windows moving by 8 pixels, clipped at the
+ * right and bottom edges. Each window is made of 2x2 blocks of 8x8 pixels,
+ * so the sums of every block are computed once and shared by the four
+ * windows overlapping it. */
+#define SSIM_BLOCK 8
+
+typedef struct
 {
-  gint count = 0, i, j;
-  gint sum1 = 0, sum2 = 0, ssum1 = 0, ssum2 = 0, acov = 0;
-  gdouble avg1, avg2, var1, var2, cov;
+  guint32 sum1, sum2;
+  guint32 ssum1, ssum2;
+  guint32 acov;
+  guint32 count;
+} GstCompareSsimBlock;
 
+typedef struct
+{
+  GstCompare *comp;
+  const guint8 *data1;
+  const guint8 *data2;
+  gint width;
+  gint height;
+  gint step;
+  gint stride;
+  gint row_start;
+  gint row_end;
+  gdouble ssim_sum;
+  gint count;
+} GstCompareSsimSlice;
+
+/* Sums of the row of blocks starting at @data1 and @data2 */
+static void
+gst_compare_ssim_block_row (const guint8 * data1, const guint8 * data2,
+    gint width, gint height, gint step, gint stride,
+    GstCompareSsimBlock * blocks)
+{
+  gint n_blocks = (width + SSIM_BLOCK - 1) / SSIM_BLOCK;
+  gint i, j, x;
+
+  memset (blocks, 0, n_blocks * sizeof (GstCompareSsimBlock));
+
+  for (j = 0; j < height; j++) {
+    const guint8 *row1 = data1 + j * stride;
+    const guint8 *row2 = data2 + j * stride;
+
+    for (x = 0; x < n_blocks; x++) {
+      const guint8 *p1 = row1 + x * SSIM_BLOCK * step;
+      const guint8 *p2 = row2 + x * SSIM_BLOCK * step;
+      gint bw = MIN (SSIM_BLOCK, width - x * SSIM_BLOCK);
+      guint32 sum1 = 0, sum2 = 0, ssum1 = 0, ssum2 = 0, acov = 0;
+
+      /* without subsampling the samples are indexed directly */
+      if (step == 1) {
+        for (i = 0; i < bw; i++) {
+          sum1 += p1[i];
+          sum2 += p2[i];
+          ssum1 += p1[i] * p1[i];
+          ssum2 += p2[i] * p2[i];
+          acov += p1[i] * p2[i];
+        }
+      } else {
+        for (i = 0; i < bw; i++) {
+          guint32 v1 = p1[i * step], v2 = p2[i * step];
+
+          sum1 += v1;
+          sum2 += v2;
+          ssum1 += v1 * v1;
+          ssum2 += v2 * v2;
+          acov += v1 * v2;
+        }
+      }
+
+      blocks[x].sum1 += sum1;
+      blocks[x].sum2 += sum2;
+      blocks[x].ssum1 += ssum1;
+      blocks[x].ssum2 += ssum2;
+      blocks[x].acov += acov;
+      blocks[x].count += bw;
+    }
+  }
+}
+
+static gdouble
+gst_compare_ssim_window (const GstCompareSsimBlock * top,
+    const GstCompareSsimBlock * bottom)
+{
   const gdouble k1 = 0.01;
   const gdouble k2 = 0.03;
   const gdouble L = 255.0;
   const gdouble c1 = (k1 * L) * (k1 * L);
   const gdouble c2 = (k2 * L) * (k2 * L);
+  gdouble count, avg1, avg2, var1, var2, cov;
+
+  count = top[0].count + top[1].count + bottom[0].count + bottom[1].count;
+  avg1 = (top[0].sum1 + top[1].sum1 + bottom[0].sum1 + bottom[1].sum1) /
+      count;
+  avg2 = (top[0].sum2 + top[1].sum2 + bottom[0].sum2 + bottom[1].sum2) /
+      count;
+  var1 = (top[0].ssum1 + top[1].ssum1 + bottom[0].ssum1 + bottom[1].ssum1) /
+      count - avg1 * avg1;
+  var2 = (top[0].ssum2 + top[1].ssum2 + bottom[0].ssum2 + bottom[1].ssum2) /
+      count - avg2 * avg2;
+  cov = (top[0].acov + top[1].acov + bottom[0].acov + bottom[1].acov) /
+      count - avg1 * avg2;
 
-  /* For empty images, return maximum similarity */
-  if (height <= 0 || width <= 0)
-    return 1.0;
+  return (2 * avg1 * avg2 + c1) * (2 * cov + c2) /
+      ((avg1 * avg1 + avg2 * avg2 + c1) * (var1 + var2 + c2));
+}
+
+/* Sums the SSIM of the windows of the window rows row_start to row_end */
+static void
+gst_compare_ssim_slice (GstCompareSsimSlice * slice)
+{
+  GstCompareSsimBlock *top, *bottom, *tmp;
+  gint n_blocks = (slice->width + SSIM_BLOCK - 1) / SSIM_BLOCK;
+  gint row, x;
+
+  slice->ssim_sum = 0;
+  slice->count = 0;
+
+  if (slice->row_start >= slice->row_end)
+    return;
+
+  top = g_new (GstCompareSsimBlock, n_blocks);
+  bottom = g_new (GstCompareSsimBlock, n_blocks);
+
+  gst_compare_ssim_block_row (slice->data1 + slice->row_start * SSIM_BLOCK *
+      slice->stride, slice->data2 + slice->row_start * SSIM_BLOCK *
+      slice->stride, slice->width, SSIM_BLOCK, slice->step, slice->stride,
+      top);
 
-  /* plain and simple; no fancy optimizations */
-  for (i = 0; i < height; i++) {
-    for (j = 0; j < width; j++) {
-      sum1 += *data1;
-      sum2 += *data2;
-      ssum1 += *data1 * *data1;
-      ssum2 += *data2 * *data2;
-      acov += *data1 * *data2;
-      count++;
-      data1 += step;
-      data2 += step;
+  for (row = slice->row_start; row < slice->row_end; row++) {
+    gint y = (row + 1) * SSIM_BLOCK;
+
+    gst_compare_ssim_block_row (slice->data1 + y * slice->stride,
+        slice->data2 + y * slice->stride, slice->width,
+        MIN (SSIM_BLOCK, slice->height - y), slice->step, slice->stride,
+        bottom);
+
+    for (x = 0; x < n_blocks - 1; x++) {
+      gdouble ssim = gst_compare_ssim_window (&top[x], &bottom[x]);
+
+      GST_LOG_OBJECT (slice->comp, "ssim for %dx%d at (%d, %d) = %f",
+          2 * SSIM_BLOCK, 2 * SSIM_BLOCK, x * SSIM_BLOCK, row * SSIM_BLOCK,
+          ssim);
+      slice->ssim_sum += ssim;
+      slice->count++;
     }
-    data1 -= j * step;
-    data2 -= j * step;
-    data1 += stride;
-    data2 += stride;
-  }
 
-  avg1 = sum1 / count;
-  avg2 = sum2 / count;
-  var1 = ssum1 / count - avg1 * avg1;
-  var2 = ssum2 / count - avg2 * avg2;
-  cov = acov / count - avg1 * avg2;
+    tmp = top;
+    top = bottom;
+    bottom = tmp;
+  }
 
-  return (2 * avg1 * avg2 + c1) * (2 * cov + c2) /
-      ((avg1 * avg1 + avg2 * avg2 + c1) * (var1 + var2 + c2));
+  g_free (top);
+  g_free (bottom);
 }
 
 /* @width etc are for the particular component */
@@ -399,22 +598,44 @@ static gdouble
 gst_compare_ssim_component (GstCompare * comp, guint8 * data1, guint8 * data2,
     gint width, gint height, gint step, gint stride)
 {
-  const gint window = 16;
+  GstCompareSsimSlice *slices;
   gdouble ssim_sum = 0;
-  gint count = 0, i, j;
-
-  for (j = 0; j + (window / 2) < height; j += (window / 2)) {
-    for (i = 0; i + (window / 2) < width; i += (window / 2)) {
-      gdouble ssim;
-
-      ssim = gst_compare_ssim_window (comp, data1 + step * i + j * stride,
-          data2 + step * i + j * stride,
-          MIN (window, width - i), MIN (window, height - j), step, stride);
-      GST_LOG_OBJECT (comp, "ssim for %dx%d at (%d, %d) = %f", window, window,
-          i, j, ssim);
-      ssim_sum += ssim;
-      count++;
-    }
+  gint count = 0, rows;
+  guint i, n_slices, n_threads;
+
+  /* a window row starts at every block row but the last one */
+  rows = (height + SSIM_BLOCK - 1) / SSIM_BLOCK - 1;
+
+  /* For empty images, return maximum similarity */
+  if (rows <= 0 || width <= SSIM_BLOCK)
+    return 1.0;
+
+  GST_OBJECT_LOCK (comp);
+  n_threads = comp->n_threads;
+  GST_OBJECT_UNLOCK (comp);
+
+  comp->runner = gst_slice_runner_update (comp->runner, n_threads);
+  n_slices = MIN (gst_slice_runner_get_n_threads (comp->runner), (guint) rows);
+
+  slices = g_newa (GstCompareSsimSlice, n_slices);
+  for (i = 0; i < n_slices; i++) {
+    slices[i].comp = comp;
+    slices[i].data1 = data1;
+    slices[i].data2 = data2;
+    slices[i].width = width;
+    slices[i].height = height;
+    slices[i].step = step;
+    slices[i].stride = stride;
+    slices[i].row_start = rows * i / n_slices;
+    slices[i].row_end = rows * (i + 1) / n_slices;
+  }
+
+  gst_slice_runner_run (comp->runner, (GstSliceFunc) gst_compare_ssim_slice,
+      slices, sizeof (GstCompareSsimSlice), n_slices);
+
+  for (i = 0; i < n_slices; i++) {
+    ssim_sum += slices[i].ssim_sum;
+    count += slices[i].count;
   }
 
   /* For empty images, return maximum similarity */
@@ -424,14 +645,15 @@ gst_compare_ssim_component (GstCompare * comp, guint8 * data1, guint8 * data2,
   return (ssim_sum / count);
 }
 
+/* The SSIM of each component is returned in @cssim */
 static gdouble
 gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
-    GstBuffer * buf2, GstCaps * caps2)
+    GstBuffer * buf2, GstCaps * caps2, gdouble cssim[4], gint * n_comps)
 {
   GstVideoInfo info1, info2;
   GstVideoFrame frame1, frame2;
   gint i, comps;
-  gdouble cssim[4], ssim, c[4] = { 1.0, 0.0, 0.0, 0.0 };
+  gdouble ssim, c[4] = { 1.0, 0.0, 0.0, 0.0 };
 
   if (!caps1)
     goto invalid_input;
@@ -451,6 +673,7 @@ gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     return comp->threshold + 1;
 
   comps = GST_VIDEO_INFO_N_COMPONENTS (&info1);
+  *n_comps = comps;
   /* note that some are reported both yuv and gray */
   for (i = 0; i < comps; ++i)
     c[i] = 1.0;
@@ -514,10 +737,14 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     GstBuffer * buf2, GstCaps * caps2)
 {
   gdouble delta = 0;
+  gdouble cssim[4] = { 1.0, 1.0, 1.0, 1.0 };
+  gint i, n_comps = 0;
   gsize size1, size2;
+  gboolean failed;
 
   /* first check metadata */
-  gst_compare_meta (comp, buf1, caps1, buf2, caps2);
+  if (gst_compare_meta (comp, buf1, caps1, buf2, caps2))
+    comp->summary_meta_mismatches++;
 
   size1 = gst_buffer_get_size (buf1);
   size2 = gst_buffer_get_size (buf1);
@@ -527,14 +754,19 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
   if (size1 != size2) {
     delta = comp->threshold + 1;
   } else {
-    GstMapInfo map1, map2;
-
-    gst_buffer_map (buf1, &map1, GST_MAP_READ);
-    gst_buffer_map (buf2, &map2, GST_MAP_READ);
-    GST_MEMDUMP_OBJECT (comp, "buffer 1", map1.data, map2.size);
-    GST_MEMDUMP_OBJECT (comp, "buffer 2", map2.data, map2.size);
-    gst_buffer_unmap (buf1, &map1);
-    gst_buffer_unmap (buf2, &map2);
+#ifndef GST_DISABLE_GST_DEBUG
+    if (gst_debug_category_get_threshold (GST_CAT_DEFAULT) >=
+        GST_LEVEL_MEMDUMP) {
+      GstMapInfo map1, map2;
+
+      gst_buffer_map (buf1, &map1, GST_MAP_READ);
+      gst_buffer_map (buf2, &map2, GST_MAP_READ);
+      GST_MEMDUMP_OBJECT (comp, "buffer 1", map1.data, map2.size);
+      GST_MEMDUMP_OBJECT (comp, "buffer 2", map2.data, map2.size);
+      gst_buffer_unmap (buf1, &map1);
+      gst_buffer_unmap (buf2, &map2);
+    }
+#endif
     switch (comp->method) {
       case GST_COMPARE_METHOD_MEM:
         delta = gst_compare_mem (comp, buf1, caps1, buf2, caps2);
@@ -543,7 +775,8 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
         delta = gst_compare_max (comp, buf1, caps1, buf2, caps2);
         break;
       case GST_COMPARE_METHOD_SSIM:
-        delta = gst_compare_ssim (comp, buf1, caps1, buf2, caps2);
+        delta = gst_compare_ssim (comp, buf1, caps1, buf2, caps2, cssim,
+            &n_comps);
         break;
       default:
         g_assert_not_reached ();
@@ -551,15 +784,41 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     }
   }
 
-  if ((comp->upper && delta > comp->threshold) ||
-      (!comp->upper && delta < comp->threshold)) {
+  failed = (comp->upper && delta > comp->threshold) ||
+      (!comp->upper && delta < comp->threshold);
+
+  comp->summary_min = MIN (comp->summary_min, delta);
+  comp->summary_max = MAX (comp->summary_max, delta);
+  comp->summary_sum += delta;
+  if (failed)
+    comp->summary_content_mismatches++;
+
+  if (failed) {
     GST_WARNING_OBJECT (comp, "buffers %p and %p failed content match %f",
         buf1, buf2, delta);
 
-    gst_element_post_message (GST_ELEMENT (comp),
-        gst_message_new_element (GST_OBJECT (comp),
-            gst_structure_new ("delta", "content", G_TYPE_DOUBLE, delta,
-                NULL)));
+    if (!comp->summary_interval) {
+      GstStructure *s;
+
+      s = gst_structure_new ("delta", "content", G_TYPE_DOUBLE, delta, NULL);
+
+      /* per component similarity, to tell which plane is off */
+      if (n_comps > 0) {
+        GValue arr = G_VALUE_INIT, val = G_VALUE_INIT;
+
+        g_value_init (&arr, GST_TYPE_ARRAY);
+        g_value_init (&val, G_TYPE_DOUBLE);
+        for (i = 0; i < n_comps; i++) {
+          g_value_set_double (&val, cssim[i]);
+          gst_value_array_append_value (&arr, &val);
+        }
+        g_value_unset (&val);
+        gst_structure_take_value (s, "components", &arr);
+      }
+
+      gst_element_post_message (GST_ELEMENT (comp),
+          gst_message_new_element (GST_OBJECT (comp), s));
+    }
   }
 }
 
@@ -578,6 +837,8 @@ gst_compare_collect_pads (GstCollectPads * cpads, GstCompare * comp)
   caps2 = gst_pad_get_current_caps (comp->checkpad);
 
   if (!buf1 && !buf2) {
+    if (comp->summary_interval)
+      gst_compare_post_summary (comp);
     gst_pad_push_event (comp->srcpad, gst_event_new_eos ());
     return GST_FLOW_EOS;
   } else if (buf1 && buf2) {
@@ -586,12 +847,19 @@ gst_compare_collect_pads (GstCollectPads * cpads, GstCompare * comp)
     GST_WARNING_OBJECT (comp, "buffer %p != NULL", buf1 ? buf1 : buf2);
 
     comp->count++;
-    gst_element_post_message (GST_ELEMENT (comp),
-        gst_message_new_element (GST_OBJECT (comp),
-            gst_structure_new ("delta", "count", G_TYPE_INT, comp->count,
-                NULL)));
+    comp->summary_missing++;
+    if (!comp->summary_interval)
+      gst_element_post_message (GST_ELEMENT (comp),
+          gst_message_new_element (GST_OBJECT (comp),
+              gst_structure_new ("delta", "count", G_TYPE_INT, comp->count,
+                  NULL)));
   }
 
+  comp->summary_count++;
+  if (comp->summary_interval &&
+      comp->summary_count >= comp->summary_interval)
+    gst_compare_post_summary (comp);
+
   if (buf1)
     gst_pad_push (comp->srcpad, buf1);
 
@@ -629,6 +897,14 @@ gst_compare_set_property (GObject * object, guint prop_id,
     case PROP_UPPER:
       comp->upper = g_value_get_boolean (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (comp);
+      comp->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (comp);
+      break;
+    case PROP_SUMMARY_INTERVAL:
+      comp->summary_interval = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -657,6 +933,14 @@ gst_compare_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_UPPER:
       g_value_set_boolean (value, comp->upper);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (comp);
+      g_value_set_uint (value, comp->n_threads);
+      GST_OBJECT_UNLOCK (comp);
+      break;
+    case PROP_SUMMARY_INTERVAL:
+      g_value_set_uint (value, comp->summary_interval);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -26,6 +26,7 @@
 
 
 #include <gst/gst.h>
+#include <gst/slicerunner/gstslicerunner.h>
 
 G_BEGIN_DECLS
 
@@ -62,6 +63,20 @@ struct _GstCompare {
   gint method;
   gdouble threshold;
   gboolean upper;
+  guint n_threads;
+  guint summary_interval;
+
+  /* ssim slices */
+  GstSliceRunner *runner;
+
+  /* summary statistics */
+  guint summary_count;
+  guint summary_content_mismatches;
+  guint summary_meta_mismatches;
+  guint summary_missing;
+  gdouble summary_min;
+  gdouble summary_max;
+  gdouble summary_sum;
 };
 
 struct _GstCompareClass {
@@ -82,6 +82,8 @@ GST_DEBUG_CATEGORY_STATIC (gst_field_analysis_debug);
 #define DEFAULT_BLOCK_HEIGHT 16
 #define DEFAULT_BLOCK_THRESH 80
 #define DEFAULT_IGNORED_LINES 2
+#define DEFAULT_N_THREADS 1
+#define DEFAULT_FAST FALSE
 
 enum
 {
@@ -96,7 +98,9 @@ enum
   PROP_BLOCK_WIDTH,
   PROP_BLOCK_HEIGHT,
   PROP_BLOCK_THRESH,
-  PROP_IGNORED_LINES
+  PROP_IGNORED_LINES,
+  PROP_N_THREADS,
+  PROP_FAST
 };
 
 static GstStaticPadTemplate sink_factory =
@@ -274,6 +278,33 @@ gst_field_analysis_class_init (GstFieldAnalysisClass * klass)
           "Ignore this many lines from the top and bottom for windowed comb detection",
           2, G_MAXUINT64, DEFAULT_IGNORED_LINES,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstFieldAnalysis:n-threads:
+   *
+   * Number of threads the field and frame metrics are computed with, 0 uses
+   * as many threads as there are processors.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Maximum number of threads to use (0 = number of processors)",
+          0, G_MAXINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstFieldAnalysis:fast:
+   *
+   * Only analyse every fourth line of the fields for the field and 5-tap
+   * frame metrics and every second row of blocks for windowed comb
+   * detection. The field and 5-tap scores are extrapolated to the whole
+   * picture so the thresholds keep their meaning.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_FAST,
+      g_param_spec_boolean ("fast", "Fast",
+          "Analyse a subset of the lines to trade accuracy for speed",
+          DEFAULT_FAST, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_field_analysis_change_state);
@@ -300,12 +331,12 @@ static gfloat same_parity_3_tap (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
 static gfloat opposite_parity_5_tap (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
-static guint64 block_score_for_row_32detect (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
-static guint64 block_score_for_row_iscombed (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
-static guint64 block_score_for_row_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
+static void comb_mask_for_line_32detect (guint8 ** lines, gint incr,
+    gint width, gint spatial_thresh, guint8 * comb_mask);
+static void comb_mask_for_line_iscombed (guint8 ** lines, gint incr,
+    gint width, gint spatial_thresh, guint8 * comb_mask);
+static void comb_mask_for_line_5_tap (guint8 ** lines, gint incr,
+    gint width, gint spatial_thresh, guint8 * comb_mask);
 static gfloat opposite_parity_windowed_comb (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
 
@@ -328,10 +359,8 @@ gst_field_analysis_reset (GstFieldAnalysis * filter)
   filter->is_telecine = FALSE;
   filter->first_buffer = TRUE;
   gst_video_info_init (&filter->vinfo);
-  g_free (filter->comb_mask);
-  filter->comb_mask = NULL;
-  g_free (filter->block_scores);
-  filter->block_scores = NULL;
+  gst_slice_runner_free (filter->runner);
+  filter->runner = NULL;
 }
 
 static void
@@ -355,12 +384,14 @@ gst_field_analysis_init (GstFieldAnalysis * filter)
   filter->same_frame = &opposite_parity_5_tap;
   filter->frame_thresh = DEFAULT_FRAME_THRESH;
   filter->noise_floor = DEFAULT_NOISE_FLOOR;
-  filter->block_score_for_row = &block_score_for_row_5_tap;
+  filter->comb_mask_for_line = &comb_mask_for_line_5_tap;
   filter->spatial_thresh = DEFAULT_SPATIAL_THRESH;
   filter->block_width = DEFAULT_BLOCK_WIDTH;
   filter->block_height = DEFAULT_BLOCK_HEIGHT;
   filter->block_thresh = DEFAULT_BLOCK_THRESH;
   filter->ignored_lines = DEFAULT_IGNORED_LINES;
+  filter->n_threads = DEFAULT_N_THREADS;
+  filter->fast = DEFAULT_FAST;
 }
 
 static void
@@ -409,13 +440,13 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
     case PROP_COMB_METHOD:
       switch (g_value_get_enum (value)) {
         case METHOD_32DETECT:
-          filter->block_score_for_row = &block_score_for_row_32detect;
+          filter->comb_mask_for_line = &comb_mask_for_line_32detect;
           break;
         case METHOD_IS_COMBED:
-          filter->block_score_for_row = &block_score_for_row_iscombed;
+          filter->comb_mask_for_line = &comb_mask_for_line_iscombed;
           break;
         case METHOD_5_TAP:
-          filter->block_score_for_row = &block_score_for_row_5_tap;
+          filter->comb_mask_for_line = &comb_mask_for_line_5_tap;
           break;
         default:
           break;
@@ -426,18 +457,6 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
       break;
     case PROP_BLOCK_WIDTH:
       filter->block_width = g_value_get_uint64 (value);
-      if (GST_VIDEO_FRAME_WIDTH (&filter->frames[0].frame)) {
-        const gint frame_width =
-            GST_VIDEO_FRAME_WIDTH (&filter->frames[0].frame);
-        if (filter->block_scores) {
-          gsize nbytes = (frame_width / filter->block_width) * sizeof (guint);
-          filter->block_scores = g_realloc (filter->block_scores, nbytes);
-          memset (filter->block_scores, 0, nbytes);
-        } else {
-          filter->block_scores =
-              g_malloc0 ((frame_width / filter->block_width) * sizeof (guint));
-        }
-      }
       break;
     case PROP_BLOCK_HEIGHT:
       filter->block_height = g_value_get_uint64 (value);
@@ -448,6 +467,14 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
     case PROP_IGNORED_LINES:
       filter->ignored_lines = g_value_get_uint64 (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (filter);
+      filter->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (filter);
+      break;
+    case PROP_FAST:
+      filter->fast = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -497,11 +524,11 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
     case PROP_COMB_METHOD:
     {
       FieldAnalysisCombMethod method = DEFAULT_COMB_METHOD;
-      if (filter->block_score_for_row == &block_score_for_row_32detect) {
+      if (filter->comb_mask_for_line == &comb_mask_for_line_32detect) {
         method = METHOD_32DETECT;
-      } else if (filter->block_score_for_row == &block_score_for_row_iscombed) {
+      } else if (filter->comb_mask_for_line == &comb_mask_for_line_iscombed) {
         method = METHOD_IS_COMBED;
-      } else if (filter->block_score_for_row == &block_score_for_row_5_tap) {
+      } else if (filter->comb_mask_for_line == &comb_mask_for_line_5_tap) {
         method = METHOD_5_TAP;
       }
       g_value_set_enum (value, method);
@@ -522,6 +549,12 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
     case PROP_IGNORED_LINES:
       g_value_set_uint64 (value, filter->ignored_lines);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filter->n_threads);
+      break;
+    case PROP_FAST:
+      g_value_set_boolean (value, filter->fast);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -531,7 +564,6 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
 static void
 gst_field_analysis_update_format (GstFieldAnalysis * filter, GstCaps * caps)
 {
-  gint width;
   GQueue *outbufs;
   GstVideoInfo vinfo;
 
@@ -568,22 +600,6 @@ gst_field_analysis_update_format (GstFieldAnalysis * filter, GstCaps * caps)
   filter->flushing = FALSE;
 
   filter->vinfo = vinfo;
-  width = GST_VIDEO_INFO_WIDTH (&filter->vinfo);
-
-  /* update allocations for metric scores */
-  if (filter->comb_mask) {
-    filter->comb_mask = g_realloc (filter->comb_mask, width);
-  } else {
-    filter->comb_mask = g_malloc (width);
-  }
-  if (filter->block_scores) {
-    gsize nbytes = (width / filter->block_width) * sizeof (guint);
-    filter->block_scores = g_realloc (filter->block_scores, nbytes);
-    memset (filter->block_scores, 0, nbytes);
-  } else {
-    filter->block_scores =
-        g_malloc0 ((width / filter->block_width) * sizeof (guint));
-  }
 
   GST_OBJECT_UNLOCK (filter);
   return;
@@ -805,121 +821,193 @@ gst_field_analysis_sink_event (GstPad * pad, GstObject * parent,
 }
 
 
+/* every n-th line of each field is analysed in fast mode, and every n-th row
+ * of blocks for windowed comb detection, whose block scores are absolute */
+#define FAST_ROW_STEP 4
+#define FAST_BLOCK_ROW_STEP 2
+
+typedef struct _FieldAnalysisSlice FieldAnalysisSlice;
+
+struct _FieldAnalysisSlice
+{
+  GstFieldAnalysis *filter;
+  FieldAnalysisFields (*history)[2];
+  gint start;
+  gint end;
+  gint step;
+
+  guint64 sum;
+  /* windowed comb: 0 - not combed; 1 - slightly combed; 2 - combed */
+  gint comb;
+};
+
+/* must be called with the object lock held */
+static guint
+gst_field_analysis_get_n_slices (GstFieldAnalysis * filter, gint n_rows)
+{
+  filter->runner = gst_slice_runner_update (filter->runner, filter->n_threads);
+
+  return MIN (gst_slice_runner_get_n_threads (filter->runner),
+      (guint) MAX (n_rows, 1));
+}
+
+/* Splits the rows 0 to n_rows into n_slices slices and runs @func on each of
+ * them. Must be called with the object lock held. */
+static void
+gst_field_analysis_run_slices (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], void (*func) (FieldAnalysisSlice *),
+    gint n_rows, gint step, FieldAnalysisSlice * slices, guint n_slices)
+{
+  guint i;
+
+  for (i = 0; i < n_slices; i++) {
+    slices[i].filter = filter;
+    slices[i].history = history;
+    slices[i].start = n_rows * i / n_slices;
+    slices[i].end = n_rows * (i + 1) / n_slices;
+    slices[i].step = step;
+    slices[i].sum = 0;
+    slices[i].comb = 0;
+  }
+
+  gst_slice_runner_run (filter->runner, (GstSliceFunc) func, slices,
+      sizeof (FieldAnalysisSlice), n_slices);
+}
+
+/* Sum of @func over the n_rows lines of a field, extrapolated from the
+ * analysed lines in fast mode */
 static gfloat
-same_parity_sad (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+gst_field_analysis_sum_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], void (*func) (FieldAnalysisSlice *),
+    gint n_rows)
 {
-  gint j;
-  gfloat sum;
-  guint8 *f1j, *f2j;
+  FieldAnalysisSlice *slices;
+  guint i, n_slices;
+  gint step, n_analysed;
+  guint64 sum = 0;
+
+  if (n_rows <= 0)
+    return 0.0f;
+
+  step = filter->fast ? FAST_ROW_STEP : 1;
+  n_slices = gst_field_analysis_get_n_slices (filter, n_rows);
+  slices = g_newa (FieldAnalysisSlice, n_slices);
+
+  gst_field_analysis_run_slices (filter, history, func, n_rows, step, slices,
+      n_slices);
+
+  for (i = 0; i < n_slices; i++)
+    sum += slices[i].sum;
+
+  n_analysed = (n_rows + step - 1) / step;
+
+  return (gfloat) sum *n_rows / n_analysed;
+}
+
+/* first row of a slice that is a multiple of the step */
+#define SLICE_FIRST_ROW(slice) \
+    ((slice)->start + ((slice)->step - (slice)->start % (slice)->step) % \
+        (slice)->step)
+
+static inline guint8 *
+frame_line (GstVideoFrame * frame, gint line)
+{
+  return GST_VIDEO_FRAME_COMP_DATA (frame, 0) +
+      GST_VIDEO_FRAME_COMP_OFFSET (frame, 0) +
+      line * GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
+}
+
+/* line @line of the field with the parity of @fields */
+static inline guint8 *
+field_line (FieldAnalysisFields * fields, gint line)
+{
+  return frame_line (&fields->frame, fields->parity + 2 * line);
+}
 
+static void
+same_parity_sad_slice (FieldAnalysisSlice * slice)
+{
+  FieldAnalysisFields (*history)[2] = slice->history;
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
-  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
-  const guint32 noise_floor = filter->noise_floor;
-
-  f1j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-      0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
-      0);
-
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  const guint32 noise_floor = slice->filter->noise_floor;
+  guint64 sum = 0;
+  gint j;
+
+  for (j = SLICE_FIRST_ROW (slice); j < slice->end; j += slice->step) {
     guint32 tempsum = 0;
-    fieldanalysis_orc_same_parity_sad_planar_yuv (&tempsum, f1j, f2j,
+    fieldanalysis_orc_same_parity_sad_planar_yuv (&tempsum,
+        field_line (&(*history)[0], j), field_line (&(*history)[1], j),
         noise_floor, width);
     sum += tempsum;
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
-  return sum / (0.5f * width * height);
+  slice->sum = sum;
 }
 
 static gfloat
-same_parity_ssd (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+same_parity_sad (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
 {
-  gint j;
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
   gfloat sum;
-  guint8 *f1j, *f2j;
 
+  sum = gst_field_analysis_sum_rows (filter, history, same_parity_sad_slice,
+      height >> 1);
+
+  return sum / (0.5f * width * height);
+}
+
+static void
+same_parity_ssd_slice (FieldAnalysisSlice * slice)
+{
+  FieldAnalysisFields (*history)[2] = slice->history;
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
-  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
   /* noise floor needs to be squared for SSD */
-  const guint32 noise_floor = filter->noise_floor * filter->noise_floor;
-
-  f1j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-      0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
-      0);
-
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  const guint32 noise_floor =
+      slice->filter->noise_floor * slice->filter->noise_floor;
+  guint64 sum = 0;
+  gint j;
+
+  for (j = SLICE_FIRST_ROW (slice); j < slice->end; j += slice->step) {
     guint32 tempsum = 0;
-    fieldanalysis_orc_same_parity_ssd_planar_yuv (&tempsum, f1j, f2j,
+    fieldanalysis_orc_same_parity_ssd_planar_yuv (&tempsum,
+        field_line (&(*history)[0], j), field_line (&(*history)[1], j),
         noise_floor, width);
     sum += tempsum;
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
-  return sum / (0.5f * width * height); /* field is half height */
+  slice->sum = sum;
 }
 
-/* horizontal [1,4,1] diff between fields - is this a good idea or should the
- * current sample be emphasised more or less? */
 static gfloat
-same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+same_parity_ssd (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
 {
-  gint i, j;
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
   gfloat sum;
-  guint8 *f1j, *f2j;
 
+  sum = gst_field_analysis_sum_rows (filter, history, same_parity_ssd_slice,
+      height >> 1);
+
+  return sum / (0.5f * width * height); /* field is half height */
+}
+
+/* horizontal [1,4,1] diff between fields - is this a good idea or should the
+ * current sample be emphasised more or less? */
+static void
+same_parity_3_tap_slice (FieldAnalysisSlice * slice)
+{
+  FieldAnalysisFields (*history)[2] = slice->history;
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
-  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
   const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
   /* noise floor needs to be *6 for [1,4,1] */
-  const guint32 noise_floor = filter->noise_floor * 6;
-
-  f1j = GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame, 0) +
-      GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
-      0);
-
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  const guint32 noise_floor = slice->filter->noise_floor * 6;
+  guint64 sum = 0;
+  gint i, j;
+
+  for (j = SLICE_FIRST_ROW (slice); j < slice->end; j += slice->step) {
+    guint8 *f1j = field_line (&(*history)[0], j);
+    guint8 *f2j = field_line (&(*history)[1], j);
     guint32 tempsum = 0;
     guint32 diff;
 
@@ -940,36 +1028,39 @@ same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
         - ((f2j[i - incr] << 1) + (f2j[i] << 2)));
     if (diff > noise_floor)
       sum += diff;
-
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
+  slice->sum = sum;
+}
+
+static gfloat
+same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+{
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
+  gfloat sum;
+
+  sum = gst_field_analysis_sum_rows (filter, history, same_parity_3_tap_slice,
+      height >> 1);
+
   return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 = 6; field is half height */
 }
 
 /* vertical [1,-3,4,-3,1] - same as is used in FieldDiff from TIVTC,
  * tritical's AVISynth IVTC filter */
 /* 0th field's parity defines operation */
-static gfloat
-opposite_parity_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2])
+static void
+opposite_parity_5_tap_slice (FieldAnalysisSlice * slice)
 {
-  gint j;
-  gfloat sum;
-  guint8 *fjm2, *fjm1, *fj, *fjp1, *fjp2;
-  guint32 tempsum;
-
+  FieldAnalysisFields (*history)[2] = slice->history;
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
+  const gint last = (height >> 1) - 1;
   /* noise floor needs to be *6 for [1,-3,4,-3,1] */
-  const guint32 noise_floor = filter->noise_floor * 6;
-
-  sum = 0.0f;
+  const guint32 noise_floor = slice->filter->noise_floor * 6;
+  GstVideoFrame *top, *bottom;
+  guint64 sum = 0;
+  gint j;
 
   /* fj is line j of the combined frame made from the top field even lines of
    *   field 0 and the bottom field odd lines from field 1
@@ -978,347 +1069,280 @@ opposite_parity_5_tap (GstFieldAnalysis * filter,
    * fj with j == 0 is the 0th line of the top field
    * fj with j == 1 is the 0th line of the bottom field or the 1st field of
    *   the frame*/
-
-  /* unroll first line as it is a special case */
   if ((*history)[0].parity == TOP_FIELD) {
-    fj = GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0);
-    fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0);
-    fjp2 = fj + stride0x2;
+    top = &(*history)[0].frame;
+    bottom = &(*history)[1].frame;
   } else {
-    fj = GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame, 0);
-    fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
-    fjp2 = fj + stride1x2;
+    top = &(*history)[1].frame;
+    bottom = &(*history)[0].frame;
   }
 
-  tempsum = 0;
-  fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjp2, fjp1, fj,
-      fjp1, fjp2, noise_floor, width);
-  sum += tempsum;
-
-  for (j = 1; j < (height >> 1) - 1; j++) {
-    /* shift everything down a line in the field of interest (means += stridex2) */
-    fjm2 = fj;
-    fjm1 = fjp1;
-    fj = fjp2;
-    if ((*history)[0].parity == TOP_FIELD) {
-      fjp1 += stride1x2;
-      fjp2 += stride0x2;
+  for (j = SLICE_FIRST_ROW (slice); j < slice->end; j += slice->step) {
+    guint8 *fj = frame_line (top, 2 * j);
+    guint8 *fjp1 = frame_line (bottom, 2 * j + 1);
+    guint32 tempsum = 0;
+
+    if (j == 0) {
+      /* the first line is mirrored as it is a special case */
+      guint8 *fjp2 = frame_line (top, 2 * j + 2);
+
+      fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjp2, fjp1,
+          fj, fjp1, fjp2, noise_floor, width);
+    } else if (j == last) {
+      /* as is the last line */
+      guint8 *fjm2 = frame_line (top, 2 * j - 2);
+      guint8 *fjm1 = frame_line (bottom, 2 * j - 1);
+
+      fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1,
+          fj, fjm1, fjm2, noise_floor, width);
     } else {
-      fjp1 += stride0x2;
-      fjp2 += stride1x2;
-    }
+      guint8 *fjm2 = frame_line (top, 2 * j - 2);
+      guint8 *fjm1 = frame_line (bottom, 2 * j - 1);
+      guint8 *fjp2 = frame_line (top, 2 * j + 2);
 
-    tempsum = 0;
-    fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1,
-        fj, fjp1, fjp2, noise_floor, width);
+      fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1,
+          fj, fjp1, fjp2, noise_floor, width);
+    }
     sum += tempsum;
   }
 
-  /* unroll the last line as it is a special case */
-  /* shift everything down a line in the field of interest (means += stridex2) */
-  fjm2 = fj;
-  fjm1 = fjp1;
-  fj = fjp2;
+  slice->sum = sum;
+}
+
+static gfloat
+opposite_parity_5_tap (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2])
+{
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
+  gfloat sum;
+
+  /* the first and last lines need lines above and below them */
+  if ((height >> 1) < 2)
+    return 0.0f;
 
-  tempsum = 0;
-  fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1, fj,
-      fjm1, fjm2, noise_floor, width);
-  sum += tempsum;
+  sum = gst_field_analysis_sum_rows (filter, history,
+      opposite_parity_5_tap_slice, height >> 1);
 
   return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 == 3 + 3 == 6; field is half height */
 }
 
-/* this metric was sourced from HandBrake but originally from transcode
- * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_32detect (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+/* The comb masks flag the samples of line fj that differ from both the line
+ * above and below in the same direction. lines[] holds the lines fjm2, fjm1,
+ * fj, fjp1 and fjp2 of the combined frame. Planar lines go through the ORC
+ * versions, the packed formats interleave chroma and use the C loops. */
+
+/* this metric was sourced from HandBrake but originally from transcode */
+static void
+comb_mask_for_line_32detect (guint8 ** lines, gint incr, gint width,
+    gint spatial_thresh, guint8 * comb_mask)
 {
-  guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm2, *fjm1, *fj, *fjp1;
-  const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
-  const gint stridex2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const guint64 block_width = filter->block_width;
-  const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint width =
-      GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
-      (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
+  const guint8 *fjm2 = lines[0], *fjm1 = lines[1], *fj = lines[2];
+  const guint8 *fjp1 = lines[3];
+  gint i;
 
-  fjm2 = base_fj - stridex2;
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
+  if (incr == 1) {
+    fieldanalysis_orc_comb_mask_32detect (comb_mask, fjm2, fjm1, fj, fjp1,
+        spatial_thresh, width);
+    return;
+  }
 
-  for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
+  for (i = 0; i < width; i++) {
+    const gint idx = i * incr;
+    const gint diff1 = fj[idx] - fjm1[idx];
+    const gint diff2 = fj[idx] - fjp1[idx];
 
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
     /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] = abs (fj[0] - fjm2[0]) < 10 && abs (fj[0] - fjm1[0]) > 15;
-    } else {
-      comb_mask[0] = FALSE;
-    }
+    comb_mask[i] = (((diff1 > spatial_thresh) & (diff2 > spatial_thresh)) |
+        ((diff1 < -spatial_thresh) & (diff2 < -spatial_thresh))) &
+        (abs (fj[idx] - fjm2[idx]) < 10) & (abs (diff1) > 15);
+  }
+}
 
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
+/* this metric was sourced from HandBrake but originally from
+ * tritical's isCombedT Avisynth function. isCombedT also requires
+ * diff1 * diff2 > spatial_thresh^2, which always holds for two differences
+ * beyond the (non-negative) threshold in the same direction */
+static void
+comb_mask_for_line_iscombed (guint8 ** lines, gint incr, gint width,
+    gint spatial_thresh, guint8 * comb_mask)
+{
+  const guint8 *fjm1 = lines[1], *fj = lines[2], *fjp1 = lines[3];
+  gint i;
 
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] = abs (fj[idx] - fjm2[idx]) < 10
-            && abs (fj[idx] - fjm1[idx]) > 15;
-      } else {
-        comb_mask[i] = FALSE;
-      }
+  if (incr == 1) {
+    fieldanalysis_orc_comb_mask_iscombed (comb_mask, fjm1, fj, fjp1,
+        spatial_thresh, width);
+    return;
+  }
 
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
-    }
-    /* advance down a line */
-    fjm2 = fjm1;
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjm1 + stridex2;
+  for (i = 0; i < width; i++) {
+    const gint idx = i * incr;
+    const gint diff1 = fj[idx] - fjm1[idx];
+    const gint diff2 = fj[idx] - fjp1[idx];
+
+    comb_mask[i] = ((diff1 > spatial_thresh) & (diff2 > spatial_thresh)) |
+        ((diff1 < -spatial_thresh) & (diff2 < -spatial_thresh));
   }
+}
 
-  block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
+/* this metric was sourced from HandBrake but originally from
+ * tritical's isCombedT Avisynth function */
+static void
+comb_mask_for_line_5_tap (guint8 ** lines, gint incr, gint width,
+    gint spatial_thresh, guint8 * comb_mask)
+{
+  const guint8 *fjm2 = lines[0], *fjm1 = lines[1], *fj = lines[2];
+  const guint8 *fjp1 = lines[3], *fjp2 = lines[4];
+  const gint spatial_threshx6 = 6 * spatial_thresh;
+  gint i;
+
+  if (incr == 1) {
+    fieldanalysis_orc_comb_mask_5_tap (comb_mask, fjm2, fjm1, fj, fjp1, fjp2,
+        spatial_thresh, spatial_threshx6, width);
+    return;
   }
 
-  g_free (block_scores);
-  g_free (comb_mask);
-  return block_score;
+  for (i = 0; i < width; i++) {
+    const gint idx = i * incr;
+    const gint diff1 = fj[idx] - fjm1[idx];
+    const gint diff2 = fj[idx] - fjp1[idx];
+
+    /* motion detection that needs previous and next frames
+       this isn't really necessary, but acts as an optimisation if the
+       additional delay isn't a problem
+       if (motion_detection) {
+       if (abs(fpj[idx] - fj[idx]               ) > motion_thresh &&
+       abs(           fjm1[idx] - fnjm1[idx]) > motion_thresh &&
+       abs(           fjp1[idx] - fnjp1[idx]) > motion_thresh)
+       motion++;
+       if (abs(             fj[idx]   - fnj[idx]) > motion_thresh &&
+       abs(fpjm1[idx] - fjm1[idx]           ) > motion_thresh &&
+       abs(fpjp1[idx] - fjp1[idx]           ) > motion_thresh)
+       motion++;
+       } else {
+       motion = 1;
+       }
+     */
+    comb_mask[i] = (((diff1 > spatial_thresh) & (diff2 > spatial_thresh)) |
+        ((diff1 < -spatial_thresh) & (diff2 < -spatial_thresh))) &
+        (abs (fjm2[idx] + (fj[idx] << 2) + fjp2[idx] - 3 * (fjm1[idx] +
+                fjp1[idx])) > spatial_threshx6);
+  }
 }
 
-/* this metric was sourced from HandBrake but originally from
- * tritical's isCombedT Avisynth function
+/* line k of the combined frame, even lines come from the field of base_fj and
+ * odd lines from the field of base_fjp1 */
+static inline guint8 *
+comb_line (guint8 * base_fj, guint8 * base_fjp1, gint stridex2, gint k)
+{
+  if (k & 1)
+    return base_fjp1 + ((k - 1) / 2) * stridex2;
+  return base_fj + (k / 2) * stridex2;
+}
+
+/* a sample contributes to the score of its block if it and the samples to
+ * its left and right are combed. samples outside of the picture count as
+ * combed so that two combed samples are enough at the edges.
  * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_iscombed (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+static guint64
+block_score_for_row (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1,
+    guint8 * comb_mask, guint * block_scores)
 {
-  guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm1, *fj, *fjp1;
   const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
   const gint stridex2 =
       GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
   const guint64 block_width = filter->block_width;
   const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint64 spatial_thresh_squared = spatial_thresh * spatial_thresh;
+  /* the metrics compare with differences of samples so this is exact */
+  const gint spatial_thresh = MIN (filter->spatial_thresh, 255);
   const gint width =
       GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
       (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
+  const gint n_blocks = width / block_width;
+  guint8 *mask = comb_mask + 1;
+  guint64 block_score;
+  guint64 i, j;
+  gint b;
 
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
+  memset (block_scores, 0, n_blocks * sizeof (guint));
+  mask[-1] = mask[width] = TRUE;
 
   for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
+    guint8 *lines[5];
+    gint k;
 
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
-    /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] =
-          (fjm1[0] - fj[0]) * (fjp1[0] - fj[0]) > spatial_thresh_squared;
-    } else {
-      comb_mask[0] = FALSE;
-    }
+    for (k = 0; k < 5; k++)
+      lines[k] = comb_line (base_fj, base_fjp1, stridex2, (gint) j + k - 2);
 
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
-
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] =
-            (fjm1[idx] - fj[idx]) * (fjp1[idx] - fj[idx]) >
-            spatial_thresh_squared;
-      } else {
-        comb_mask[i] = FALSE;
-      }
+    filter->comb_mask_for_line (lines, incr, width, spatial_thresh, mask);
 
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
+    for (b = 0; b < n_blocks; b++) {
+      const guint8 *m = mask + b * block_width;
+      guint score = 0;
+
+      for (i = 0; i < block_width; i++)
+        score += m[i - 1] & m[i] & m[i + 1];
+      block_scores[b] += score;
     }
-    /* advance down a line */
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjm1 + stridex2;
   }
 
   block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
+  for (b = 0; b < n_blocks; b++) {
+    if (block_scores[b] > block_score)
+      block_score = block_scores[b];
   }
 
-  g_free (block_scores);
-  g_free (comb_mask);
   return block_score;
 }
 
-/* this metric was sourced from HandBrake but originally from
- * tritical's isCombedT Avisynth function
- * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+static void
+opposite_parity_windowed_comb_slice (FieldAnalysisSlice * slice)
 {
-  guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm2, *fjm1, *fj, *fjp1, *fjp2;
-  const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
-  const gint stridex2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const guint64 block_width = filter->block_width;
+  GstFieldAnalysis *filter = slice->filter;
+  FieldAnalysisFields (*history)[2] = slice->history;
+  const gint stride = GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
+  const gint frame_width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const guint64 block_thresh = filter->block_thresh;
   const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint64 spatial_threshx6 = 6 * spatial_thresh;
-  const gint width =
-      GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
-      (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
-
+  const gint width = frame_width - (frame_width % filter->block_width);
+  guint8 *base_fj, *base_fjp1;
+  guint8 *comb_mask;
+  guint *block_scores;
+  gint j;
 
-  fjm2 = base_fj - stridex2;
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
-  fjp2 = fj + stridex2;
+  if ((*history)[0].parity == TOP_FIELD) {
+    base_fj = frame_line (&(*history)[0].frame, 0);
+    base_fjp1 = frame_line (&(*history)[1].frame, 1);
+  } else {
+    base_fj = frame_line (&(*history)[1].frame, 0);
+    base_fjp1 = frame_line (&(*history)[0].frame, 1);
+  }
 
-  for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
+  /* one more sample on either side for the edges */
+  comb_mask = g_malloc (width + 2);
+  block_scores = g_new (guint, MAX (width / filter->block_width, 1));
 
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
-    /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] =
-          abs (fjm2[0] + (fj[0] << 2) + fjp2[0] - 3 * (fjm1[0] + fjp1[0])) >
-          spatial_threshx6;
-
-      /* motion detection that needs previous and next frames
-         this isn't really necessary, but acts as an optimisation if the
-         additional delay isn't a problem
-         if (motion_detection) {
-         if (abs(fpj[idx] - fj[idx]               ) > motion_thresh &&
-         abs(           fjm1[idx] - fnjm1[idx]) > motion_thresh &&
-         abs(           fjp1[idx] - fnjp1[idx]) > motion_thresh)
-         motion++;
-         if (abs(             fj[idx]   - fnj[idx]) > motion_thresh &&
-         abs(fpjm1[idx] - fjm1[idx]           ) > motion_thresh &&
-         abs(fpjp1[idx] - fjp1[idx]           ) > motion_thresh)
-         motion++;
-         } else {
-         motion = 1;
-         }
-       */
-    } else {
-      comb_mask[0] = FALSE;
-    }
-
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
-
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] =
-            abs (fjm2[idx] + (fj[idx] << 2) + fjp2[idx] - 3 * (fjm1[idx] +
-                fjp1[idx])) > spatial_threshx6;
-      } else {
-        comb_mask[i] = FALSE;
-      }
+  /* we operate on a row of blocks of height block_height through each iteration */
+  for (j = SLICE_FIRST_ROW (slice); j < slice->end; j += slice->step) {
+    guint64 line_offset = (filter->ignored_lines + j * block_height) * stride;
+    guint64 block_score = block_score_for_row (filter, history,
+        base_fj + line_offset, base_fjp1 + line_offset, comb_mask,
+        block_scores);
 
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
+    if (block_score > (block_thresh >> 1)
+        && block_score <= block_thresh) {
+      /* blend if nothing more combed comes along */
+      slice->comb = 1;
+    } else if (block_score > block_thresh) {
+      slice->comb = 2;
+      break;
     }
-    /* advance down a line */
-    fjm2 = fjm1;
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjp2;
-    fjp2 = fj + stridex2;
-  }
-
-  block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
   }
 
-  g_free (block_scores);
   g_free (comb_mask);
-  return block_score;
+  g_free (block_scores);
 }
 
 /* a pass is made over the field using one of three comb-detection metrics
@@ -1328,63 +1352,47 @@ block_score_for_row_5_tap (GstFieldAnalysis * filter,
    score is between half the threshold and the threshold, the block is
    slightly combed. if when analysis is complete, slight combing is detected
    that is returned. if any results are observed that are above the threshold,
-   the function returns immediately */
+   a slice stops analysing its rows of blocks */
 /* 0th field's parity defines operation */
 static gfloat
 opposite_parity_windowed_comb (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2])
 {
-  gint j;
-  gboolean slightly_combed;
-
   const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride = GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
-  const guint64 block_thresh = filter->block_thresh;
   const guint64 block_height = filter->block_height;
-  guint8 *base_fj, *base_fjp1;
-
-  if ((*history)[0].parity == TOP_FIELD) {
-    base_fj =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0);
-    base_fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0);
-  } else {
-    base_fj =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame, 0);
-    base_fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
-  }
-
-  /* we operate on a row of blocks of height block_height through each iteration */
-  slightly_combed = FALSE;
-  for (j = 0; j <= height - filter->ignored_lines - block_height;
-      j += block_height) {
-    guint64 line_offset = (filter->ignored_lines + j) * stride;
-    guint block_score =
-        filter->block_score_for_row (filter, history, base_fj + line_offset,
-        base_fjp1 + line_offset);
-
-    if (block_score > (block_thresh >> 1)
-        && block_score <= block_thresh) {
-      /* blend if nothing more combed comes along */
-      slightly_combed = TRUE;
-    } else if (block_score > block_thresh) {
-      if (GST_VIDEO_INFO_INTERLACE_MODE (&(*history)[0].frame.info) ==
-          GST_VIDEO_INTERLACE_MODE_INTERLEAVED) {
-        return 1.0f;            /* blend */
-      } else {
-        return 2.0f;            /* deinterlace */
-      }
+  FieldAnalysisSlice *slices;
+  guint i, n_slices;
+  gint64 available;
+  gint n_rows, comb = 0;
+
+  if (block_height == 0)
+    return 0.0f;
+
+  available = (gint64) height - (gint64) filter->ignored_lines -
+      (gint64) block_height;
+  if (available < 0)
+    return 0.0f;
+  n_rows = available / block_height + 1;
+
+  n_slices = gst_field_analysis_get_n_slices (filter, n_rows);
+  slices = g_newa (FieldAnalysisSlice, n_slices);
+  gst_field_analysis_run_slices (filter, history,
+      opposite_parity_windowed_comb_slice, n_rows,
+      filter->fast ? FAST_BLOCK_ROW_STEP : 1, slices, n_slices);
+
+  for (i = 0; i < n_slices; i++)
+    comb = MAX (comb, slices[i].comb);
+
+  if (comb == 2) {
+    if (GST_VIDEO_INFO_INTERLACE_MODE (&(*history)[0].frame.info) ==
+        GST_VIDEO_INTERLACE_MODE_INTERLEAVED) {
+      return 1.0f;              /* blend */
+    } else {
+      return 2.0f;              /* deinterlace */
     }
   }
 
-  return (gfloat) slightly_combed;      /* TRUE means blend, else don't */
+  return (gfloat) comb;         /* 1 means blend, else don't */
 }
 
 /* this is where the magic happens
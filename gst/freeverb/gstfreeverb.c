@@ -56,6 +56,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstbasetransform.h>
+#include <gst/slicerunner/gstslicerunner.h>
 
 #include "gstfreeverb.h"
 
@@ -68,9 +69,12 @@ enum
   PROP_ROOM_SIZE,
   PROP_DAMPING,
   PROP_PAN_WIDTH,
-  PROP_LEVEL
+  PROP_LEVEL,
+  PROP_N_THREADS
 };
 
+#define DEFAULT_N_THREADS 1
+
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
@@ -160,6 +164,7 @@ typedef struct _freeverb_allpass
 static void
 freeverb_allpass_setbuffer (freeverb_allpass * allpass, gint size)
 {
+  size = MAX (size, 1);
   allpass->bufidx = 0;
   allpass->buffer = g_new (gfloat, size);
   allpass->bufsize = size;
@@ -195,17 +200,34 @@ freeverb_allpass_getfeedback(freeverb_allpass* allpass)
   return allpass->feedback;
 }*/
 
-#define freeverb_allpass_process(_allpass, _input_1) \
-{ \
-  gfloat output; \
-  gfloat bufout; \
-  bufout = _allpass.buffer[_allpass.bufidx]; \
-  output = bufout-_input_1; \
-  _allpass.buffer[_allpass.bufidx] = _input_1 + (bufout * _allpass.feedback); \
-  if (++_allpass.bufidx >= _allpass.bufsize) { \
-    _allpass.bufidx = 0; \
-  } \
-  _input_1 = output; \
+/* Filters @n samples of @data in place. @n must not be larger than the
+ * buffer size, so every sample read from the delay line was written before
+ * this block and the loop has no dependency between samples */
+static void
+freeverb_allpass_process_block (freeverb_allpass * allpass, gfloat * data,
+    gint n)
+{
+  const gfloat feedback = allpass->feedback;
+  gint i = 0;
+
+  while (i < n) {
+    gint j, len = MIN (n - i, allpass->bufsize - allpass->bufidx);
+    gfloat *buf = allpass->buffer + allpass->bufidx;
+    gfloat *x = data + i;
+
+    for (j = 0; j < len; j++) {
+      gfloat bufout = buf[j];
+      gfloat input = x[j];
+
+      buf[j] = input + (bufout * feedback);
+      x[j] = bufout - input;
+    }
+
+    i += len;
+    allpass->bufidx += len;
+    if (allpass->bufidx >= allpass->bufsize)
+      allpass->bufidx = 0;
+  }
 }
 
 /* comb filter */
@@ -224,6 +246,7 @@ typedef struct _freeverb_comb
 static void
 freeverb_comb_setbuffer (freeverb_comb * comb, gint size)
 {
+  size = MAX (size, 1);
   comb->filterstore = 0;
   comb->bufidx = 0;
   comb->buffer = g_new (gfloat, size);
@@ -274,17 +297,6 @@ freeverb_comb_getfeedback(freeverb_comb* comb)
   return comb->feedback;
 }*/
 
-#define freeverb_comb_process(_comb, _input_1, _output) \
-{ \
-  gfloat _tmp = _comb.buffer[_comb.bufidx]; \
-  _comb.filterstore = (_tmp * _comb.damp2) + (_comb.filterstore * _comb.damp1); \
-  _comb.buffer[_comb.bufidx] = _input_1 + (_comb.filterstore * _comb.feedback); \
-  if (++_comb.bufidx >= _comb.bufsize) { \
-    _comb.bufidx = 0; \
-  } \
-  _output += _tmp; \
-}
-
 #define numcombs 8
 #define numallpasses 4
 #define	fixedgain 0.015f
@@ -324,6 +336,10 @@ freeverb_comb_getfeedback(freeverb_comb* comb)
 #define allpasstuningL4 225
 #define allpasstuningR4 (225 + stereospread)
 
+/* Samples are processed in blocks of at most this size, limited to the
+ * shortest delay line */
+#define FREEVERB_BLOCK_SIZE 64
+
 struct _GstFreeverbPrivate
 {
   gfloat roomsize;
@@ -342,8 +358,116 @@ struct _GstFreeverbPrivate
   /* Allpass filters */
   freeverb_allpass allpassL[numallpasses];
   freeverb_allpass allpassR[numallpasses];
+
+  gint block_size;
+
+  /* dry and wet signal of both channels */
+  gfloat *scratch;
+  guint scratch_len;
+
+  /* processes the two channels in parallel when threaded */
+  GstSliceRunner *runner;
 };
 
+typedef struct
+{
+  GstFreeverb *filter;
+  freeverb_comb *combs;
+  freeverb_allpass *allpasses;
+  const gfloat *dry;
+  gfloat *wet;
+  gfloat input_scale;
+  guint num_samples;
+} GstFreeverbChannelJob;
+
+/* Runs the combs of one channel in parallel over @n samples, @n must not be
+ * larger than the shortest comb buffer. The block is split where one of the
+ * delay lines wraps around, in between the inner loop is the same operation
+ * on all combs with their state kept in registers. The filter store is a
+ * recurrence over the samples, so unlike the allpasses this does not
+ * vectorize and only gains from avoiding the per sample function calls */
+static void
+freeverb_combs_process_block (freeverb_comb * combs, const gfloat * input,
+    gfloat * output, gint n)
+{
+  gfloat *buf[numcombs];
+  gfloat filterstore[numcombs], damp1[numcombs], damp2[numcombs];
+  gfloat feedback[numcombs];
+  gint c, i, k, len;
+
+  for (c = 0; c < numcombs; c++) {
+    filterstore[c] = combs[c].filterstore;
+    damp1[c] = combs[c].damp1;
+    damp2[c] = combs[c].damp2;
+    feedback[c] = combs[c].feedback;
+  }
+
+  for (i = 0; i < n; i += len) {
+    len = n - i;
+    for (c = 0; c < numcombs; c++) {
+      len = MIN (len, combs[c].bufsize - combs[c].bufidx);
+      buf[c] = combs[c].buffer + combs[c].bufidx;
+    }
+
+    for (k = 0; k < len; k++) {
+      const gfloat x = input[i + k];
+      gfloat sum = 0.0f;
+
+      for (c = 0; c < numcombs; c++) {
+        gfloat tmp = buf[c][k];
+
+        filterstore[c] = (tmp * damp2[c]) + (filterstore[c] * damp1[c]);
+        buf[c][k] = x + (filterstore[c] * feedback[c]);
+        sum += tmp;
+      }
+      output[i + k] = sum;
+    }
+
+    for (c = 0; c < numcombs; c++) {
+      combs[c].bufidx += len;
+      if (combs[c].bufidx >= combs[c].bufsize)
+        combs[c].bufidx = 0;
+    }
+  }
+
+  for (c = 0; c < numcombs; c++)
+    combs[c].filterstore = filterstore[c];
+}
+
+/* Computes the wet signal of one channel from its dry signal */
+static void
+freeverb_process_channel (GstFreeverbChannelJob * job)
+{
+  GstFreeverbPrivate *priv = job->filter->priv;
+  const gint block_size = priv->block_size;
+  const gfloat scale = job->input_scale * priv->gain;
+  const gfloat offset = (gfloat) DC_OFFSET * priv->gain;
+  gfloat input[FREEVERB_BLOCK_SIZE];
+  guint i;
+  gint a, k, n;
+
+  for (i = 0; i < job->num_samples; i += n) {
+    const gfloat *dry = job->dry + i;
+    gfloat *wet = job->wet + i;
+
+    n = MIN (block_size, job->num_samples - i);
+
+    for (k = 0; k < n; k++)
+      input[k] = dry[k] * scale + offset;
+
+    /* Accumulate comb filters in parallel */
+    freeverb_combs_process_block (job->combs, input, wet, n);
+
+    /* Feed through allpasses in series */
+    for (a = 0; a < numallpasses; a++)
+      freeverb_allpass_process_block (&job->allpasses[a], wet, n);
+
+    /* Remove the DC offset */
+    for (k = 0; k < n; k++)
+      wet[k] -= (gfloat) DC_OFFSET;
+  }
+}
+
 G_DEFINE_TYPE_WITH_CODE (GstFreeverb, gst_freeverb, GST_TYPE_BASE_TRANSFORM,
     G_ADD_PRIVATE (GstFreeverb)
     G_IMPLEMENT_INTERFACE (GST_TYPE_PRESET, NULL));
@@ -418,6 +542,20 @@ gst_freeverb_class_init (GstFreeverbClass * klass)
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE |
           G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstFreeverb:n-threads:
+   *
+   * Number of threads the left and right reverb channels are processed
+   * with, 0 uses two threads if more than one processor is available.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads to process the channels with (0 = automatic)",
+          0, 2, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "Reverberation/room effect", "Filter/Effect/Audio",
       "Add reverberation to audio streams",
@@ -440,6 +578,7 @@ static void
 gst_freeverb_init (GstFreeverb * filter)
 {
   filter->priv = gst_freeverb_get_instance_private (filter);
+  filter->n_threads = DEFAULT_N_THREADS;
 
   gst_audio_info_init (&filter->info);
   filter->process = NULL;
@@ -456,6 +595,9 @@ gst_freeverb_finalize (GObject * object)
 
   freeverb_revmodel_free (filter);
 
+  gst_slice_runner_free (filter->priv->runner);
+  g_free (filter->priv->scratch);
+
   G_OBJECT_CLASS (gst_freeverb_parent_class)->finalize (object);
 }
 
@@ -483,6 +625,7 @@ gst_freeverb_init_rev_model (GstFreeverb * filter)
 {
   gfloat srfactor = GST_AUDIO_INFO_RATE (&filter->info) / 44100.0f;
   GstFreeverbPrivate *priv = filter->priv;
+  gint i;
 
   freeverb_revmodel_free (filter);
 
@@ -516,6 +659,16 @@ gst_freeverb_init_rev_model (GstFreeverb * filter)
   /* clear buffers */
   freeverb_revmodel_init (filter);
 
+  priv->block_size = FREEVERB_BLOCK_SIZE;
+  for (i = 0; i < numcombs; i++) {
+    priv->block_size = MIN (priv->block_size, priv->combL[i].bufsize);
+    priv->block_size = MIN (priv->block_size, priv->combR[i].bufsize);
+  }
+  for (i = 0; i < numallpasses; i++) {
+    priv->block_size = MIN (priv->block_size, priv->allpassL[i].bufsize);
+    priv->block_size = MIN (priv->block_size, priv->allpassR[i].bufsize);
+  }
+
   /* set default values */
   freeverb_allpass_setfeedback (&priv->allpassL[0], 0.5f);
   freeverb_allpass_setfeedback (&priv->allpassR[0], 0.5f);
@@ -565,6 +718,11 @@ gst_freeverb_set_property (GObject * object, guint prop_id,
       priv->wet1 = priv->wet * (priv->width / 2.0f + 0.5f);
       priv->wet2 = priv->wet * ((1.0f - priv->width) / 2.0f);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (filter);
+      filter->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (filter);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -590,6 +748,9 @@ gst_freeverb_get_property (GObject * object, guint prop_id,
     case PROP_LEVEL:
       g_value_set_float (value, filter->level);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filter->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -685,192 +846,200 @@ no_format:
   }
 }
 
-static gboolean
-gst_freeverb_transform_m2s_int (GstFreeverb * filter,
-    gint16 * idata, gint16 * odata, guint num_samples)
+/* Computes the wet signals of both channels. The channels are independent
+ * until they are mixed, so the right channel is processed in another thread
+ * if enabled */
+static void
+gst_freeverb_process_reverb (GstFreeverb * filter, const gfloat * dry_l,
+    const gfloat * dry_r, gfloat input_scale, gfloat * wet_l, gfloat * wet_r,
+    guint num_samples)
 {
   GstFreeverbPrivate *priv = filter->priv;
-  gint i, k;
-  gfloat out_l1, out_r1, input_1;
-  gfloat out_l2, out_r2, input_2;
-  gboolean drained = TRUE;
+  GstFreeverbChannelJob jobs[2] = {
+    {filter, priv->combL, priv->allpassL, dry_l, wet_l, input_scale,
+        num_samples},
+    {filter, priv->combR, priv->allpassR, dry_r, wet_r, input_scale,
+        num_samples},
+  };
+  guint n_threads;
+
+  GST_OBJECT_LOCK (filter);
+  n_threads = filter->n_threads;
+  GST_OBJECT_UNLOCK (filter);
+
+  /* there are only two channels to run in parallel */
+  if (n_threads == 0)
+    n_threads = g_get_num_processors () > 1 ? 2 : 1;
+
+  /* not worth the synchronisation for tiny buffers */
+  if (n_threads > 1 && num_samples >= FREEVERB_BLOCK_SIZE) {
+    priv->runner = gst_slice_runner_update (priv->runner, 2);
+    gst_slice_runner_run (priv->runner, (GstSliceFunc) freeverb_process_channel,
+        jobs, sizeof (GstFreeverbChannelJob), 2);
+  } else {
+    freeverb_process_channel (&jobs[0]);
+    freeverb_process_channel (&jobs[1]);
+  }
+}
 
-  for (k = 0; k < num_samples; k++) {
-    out_l1 = out_r1 = 0.0;
+static void
+gst_freeverb_ensure_scratch (GstFreeverb * filter, guint num_samples)
+{
+  GstFreeverbPrivate *priv = filter->priv;
 
-    /* The original Freeverb code expects a stereo signal and 'input_1'
-     * is set to the sum of the left and right input_1 sample. Since
-     * this code works on a mono signal, 'input_1' is set to twice the
-     * input_1 sample. */
-    input_2 = (gfloat) * idata++;
-    input_1 = (2.0f * input_2 + DC_OFFSET) * priv->gain;
+  if (num_samples > priv->scratch_len) {
+    g_free (priv->scratch);
+    priv->scratch = g_new (gfloat, 4 * num_samples);
+    priv->scratch_len = num_samples;
+  }
+}
 
-    /* Accumulate comb filters in parallel */
-    for (i = 0; i < numcombs; i++) {
-      freeverb_comb_process (priv->combL[i], input_1, out_l1);
-      freeverb_comb_process (priv->combR[i], input_1, out_r1);
-    }
-    /* Feed through allpasses in series */
-    for (i = 0; i < numallpasses; i++) {
-      freeverb_allpass_process (priv->allpassL[i], out_l1);
-      freeverb_allpass_process (priv->allpassR[i], out_r1);
-    }
+/* Mixes the dry and wet signals into the interleaved output. Interleaved
+ * samples are indexed with a gsize: with a guint 2 * k could wrap around and
+ * GCC does not vectorize the loop, here and when deinterleaving the input */
+static gboolean
+gst_freeverb_mix_int (GstFreeverb * filter, const gfloat * dry_l,
+    const gfloat * dry_r, const gfloat * wet_l, const gfloat * wet_r,
+    gint16 * odata, guint num_samples)
+{
+  GstFreeverbPrivate *priv = filter->priv;
+  const gfloat wet1 = priv->wet1, wet2 = priv->wet2, dry = priv->dry;
+  gint nonzero = 0;
+  gsize k;
 
-    /* Remove the DC offset */
-    out_l1 -= (gfloat) DC_OFFSET;
-    out_r1 -= (gfloat) DC_OFFSET;
+  for (k = 0; k < num_samples; k++) {
+    gfloat out_l2, out_r2;
 
     /* Calculate output */
-    out_l2 = out_l1 * priv->wet1 + out_r1 * priv->wet2 + input_2 * priv->dry;
-    out_r2 = out_r1 * priv->wet1 + out_l1 * priv->wet2 + input_2 * priv->dry;
+    out_l2 = wet_l[k] * wet1 + wet_r[k] * wet2 + dry_l[k] * dry;
+    out_r2 = wet_r[k] * wet1 + wet_l[k] * wet2 + dry_r[k] * dry;
     out_l2 = CLAMP (out_l2, G_MININT16, G_MAXINT16);
     out_r2 = CLAMP (out_r2, G_MININT16, G_MAXINT16);
-    *odata++ = (gint16) out_l2;
-    *odata++ = (gint16) out_r2;
+    odata[2 * k] = (gint16) out_l2;
+    odata[2 * k + 1] = (gint16) out_r2;
 
-    if (abs ((gint16) out_l2) > 0 || abs ((gint16) out_r2) > 0)
-      drained = FALSE;
+    nonzero |= odata[2 * k] | odata[2 * k + 1];
   }
-  return drained;
+
+  return nonzero == 0;
 }
 
 static gboolean
-gst_freeverb_transform_s2s_int (GstFreeverb * filter,
-    gint16 * idata, gint16 * odata, guint num_samples)
+gst_freeverb_mix_float (GstFreeverb * filter, const gfloat * dry_l,
+    const gfloat * dry_r, const gfloat * wet_l, const gfloat * wet_r,
+    gfloat * odata, guint num_samples)
 {
   GstFreeverbPrivate *priv = filter->priv;
-  gint i, k;
-  gfloat out_l1, out_r1, input_1l, input_1r;
-  gfloat out_l2, out_r2, input_2l, input_2r;
-  gboolean drained = TRUE;
+  const gfloat wet1 = priv->wet1, wet2 = priv->wet2, dry = priv->dry;
+  gint nonzero = 0;
+  gsize k;
 
   for (k = 0; k < num_samples; k++) {
-    out_l1 = out_r1 = 0.0;
-
-    input_2l = (gfloat) * idata++;
-    input_2r = (gfloat) * idata++;
-    input_1l = (input_2l + DC_OFFSET) * priv->gain;
-    input_1r = (input_2r + DC_OFFSET) * priv->gain;
-
-    /* Accumulate comb filters in parallel */
-    for (i = 0; i < numcombs; i++) {
-      freeverb_comb_process (priv->combL[i], input_1l, out_l1);
-      freeverb_comb_process (priv->combR[i], input_1r, out_r1);
-    }
-    /* Feed through allpasses in series */
-    for (i = 0; i < numallpasses; i++) {
-      freeverb_allpass_process (priv->allpassL[i], out_l1);
-      freeverb_allpass_process (priv->allpassR[i], out_r1);
-    }
-
-    /* Remove the DC offset */
-    out_l1 -= (gfloat) DC_OFFSET;
-    out_r1 -= (gfloat) DC_OFFSET;
+    gfloat out_l2, out_r2;
 
     /* Calculate output */
-    out_l2 = out_l1 * priv->wet1 + out_r1 * priv->wet2 + input_2l * priv->dry;
-    out_r2 = out_r1 * priv->wet1 + out_l1 * priv->wet2 + input_2r * priv->dry;
-    out_l2 = CLAMP (out_l2, G_MININT16, G_MAXINT16);
-    out_r2 = CLAMP (out_r2, G_MININT16, G_MAXINT16);
-    *odata++ = (gint16) out_l2;
-    *odata++ = (gint16) out_r2;
+    out_l2 = wet_l[k] * wet1 + wet_r[k] * wet2 + dry_l[k] * dry;
+    out_r2 = wet_r[k] * wet1 + wet_l[k] * wet2 + dry_r[k] * dry;
+    odata[2 * k] = out_l2;
+    odata[2 * k + 1] = out_r2;
 
-    if (abs ((gint16) out_l2) > 0 || abs ((gint16) out_r2) > 0)
-      drained = FALSE;
+    nonzero |= (out_l2 != 0.0f) | (out_r2 != 0.0f);
   }
-  return drained;
+
+  return nonzero == 0;
 }
 
+/* The original Freeverb code expects a stereo signal and 'input_1' is set to
+ * the sum of the left and right input_1 sample. Since the mono functions
+ * work on a mono signal, the reverb input is scaled by two. */
+
 static gboolean
-gst_freeverb_transform_m2s_float (GstFreeverb * filter,
-    gfloat * idata, gfloat * odata, guint num_samples)
+gst_freeverb_transform_m2s_int (GstFreeverb * filter,
+    gint16 * idata, gint16 * odata, guint num_samples)
 {
-  GstFreeverbPrivate *priv = filter->priv;
-  gint i, k;
-  gfloat out_l1, out_r1, input_1;
-  gfloat out_l2, out_r2, input_2;
-  gboolean drained = TRUE;
+  gfloat *dry, *wet_l, *wet_r;
+  guint k;
 
-  for (k = 0; k < num_samples; k++) {
-    out_l1 = out_r1 = 0.0;
+  gst_freeverb_ensure_scratch (filter, num_samples);
+  dry = filter->priv->scratch;
+  wet_l = dry + 2 * num_samples;
+  wet_r = wet_l + num_samples;
 
-    /* The original Freeverb code expects a stereo signal and 'input_1'
-     * is set to the sum of the left and right input_1 sample. Since
-     * this code works on a mono signal, 'input_1' is set to twice the
-     * input_1 sample. */
-    input_2 = *idata++;
-    input_1 = (2.0f * input_2 + DC_OFFSET) * priv->gain;
+  for (k = 0; k < num_samples; k++)
+    dry[k] = (gfloat) idata[k];
 
-    /* Accumulate comb filters in parallel */
-    for (i = 0; i < numcombs; i++) {
-      freeverb_comb_process (priv->combL[i], input_1, out_l1);
-      freeverb_comb_process (priv->combR[i], input_1, out_r1);
-    }
-    /* Feed through allpasses in series */
-    for (i = 0; i < numallpasses; i++) {
-      freeverb_allpass_process (priv->allpassL[i], out_l1);
-      freeverb_allpass_process (priv->allpassR[i], out_r1);
-    }
+  gst_freeverb_process_reverb (filter, dry, dry, 2.0f, wet_l, wet_r,
+      num_samples);
 
-    /* Remove the DC offset */
-    out_l1 -= (gfloat) DC_OFFSET;
-    out_r1 -= (gfloat) DC_OFFSET;
+  return gst_freeverb_mix_int (filter, dry, dry, wet_l, wet_r, odata,
+      num_samples);
+}
 
-    /* Calculate output */
-    out_l2 = out_l1 * priv->wet1 + out_r1 * priv->wet2 + input_2 * priv->dry;
-    out_r2 = out_r1 * priv->wet1 + out_l1 * priv->wet2 + input_2 * priv->dry;
-    *odata++ = out_l2;
-    *odata++ = out_r2;
+static gboolean
+gst_freeverb_transform_s2s_int (GstFreeverb * filter,
+    gint16 * idata, gint16 * odata, guint num_samples)
+{
+  gfloat *dry_l, *dry_r, *wet_l, *wet_r;
+  gsize k;
 
-    if (fabs (out_l2) > 0 || fabs (out_r2) > 0)
-      drained = FALSE;
+  gst_freeverb_ensure_scratch (filter, num_samples);
+  dry_l = filter->priv->scratch;
+  dry_r = dry_l + num_samples;
+  wet_l = dry_r + num_samples;
+  wet_r = wet_l + num_samples;
+
+  for (k = 0; k < num_samples; k++) {
+    dry_l[k] = (gfloat) idata[2 * k];
+    dry_r[k] = (gfloat) idata[2 * k + 1];
   }
-  return drained;
+
+  gst_freeverb_process_reverb (filter, dry_l, dry_r, 1.0f, wet_l, wet_r,
+      num_samples);
+
+  return gst_freeverb_mix_int (filter, dry_l, dry_r, wet_l, wet_r, odata,
+      num_samples);
 }
 
 static gboolean
-gst_freeverb_transform_s2s_float (GstFreeverb * filter,
+gst_freeverb_transform_m2s_float (GstFreeverb * filter,
     gfloat * idata, gfloat * odata, guint num_samples)
 {
-  GstFreeverbPrivate *priv = filter->priv;
-  gint i, k;
-  gfloat out_l1, out_r1, input_1l, input_1r;
-  gfloat out_l2, out_r2, input_2l, input_2r;
-  gboolean drained = TRUE;
+  gfloat *wet_l, *wet_r;
 
-  for (k = 0; k < num_samples; k++) {
-    out_l1 = out_r1 = 0.0;
+  gst_freeverb_ensure_scratch (filter, num_samples);
+  wet_l = filter->priv->scratch + 2 * num_samples;
+  wet_r = wet_l + num_samples;
 
-    input_2l = *idata++;
-    input_2r = *idata++;
-    input_1l = (input_2l + DC_OFFSET) * priv->gain;
-    input_1r = (input_2r + DC_OFFSET) * priv->gain;
+  gst_freeverb_process_reverb (filter, idata, idata, 2.0f, wet_l, wet_r,
+      num_samples);
 
-    /* Accumulate comb filters in parallel */
-    for (i = 0; i < numcombs; i++) {
-      freeverb_comb_process (priv->combL[i], input_1l, out_l1);
-      freeverb_comb_process (priv->combR[i], input_1r, out_r1);
-    }
-    /* Feed through allpasses in series */
-    for (i = 0; i < numallpasses; i++) {
-      freeverb_allpass_process (priv->allpassL[i], out_l1);
-      freeverb_allpass_process (priv->allpassR[i], out_r1);
-    }
+  return gst_freeverb_mix_float (filter, idata, idata, wet_l, wet_r, odata,
+      num_samples);
+}
 
-    /* Remove the DC offset */
-    out_l1 -= (gfloat) DC_OFFSET;
-    out_r1 -= (gfloat) DC_OFFSET;
+static gboolean
+gst_freeverb_transform_s2s_float (GstFreeverb * filter,
+    gfloat * idata, gfloat * odata, guint num_samples)
+{
+  gfloat *dry_l, *dry_r, *wet_l, *wet_r;
+  gsize k;
 
-    /* Calculate output */
-    out_l2 = out_l1 * priv->wet1 + out_r1 * priv->wet2 + input_2l * priv->dry;
-    out_r2 = out_r1 * priv->wet1 + out_l1 * priv->wet2 + input_2r * priv->dry;
-    *odata++ = out_l2;
-    *odata++ = out_r2;
+  gst_freeverb_ensure_scratch (filter, num_samples);
+  dry_l = filter->priv->scratch;
+  dry_r = dry_l + num_samples;
+  wet_l = dry_r + num_samples;
+  wet_r = wet_l + num_samples;
 
-    if (fabs (out_l2) > 0 || fabs (out_r2) > 0)
-      drained = FALSE;
+  for (k = 0; k < num_samples; k++) {
+    dry_l[k] = idata[2 * k];
+    dry_r[k] = idata[2 * k + 1];
   }
-  return drained;
+
+  gst_freeverb_process_reverb (filter, dry_l, dry_r, 1.0f, wet_l, wet_r,
+      num_samples);
+
+  return gst_freeverb_mix_float (filter, dry_l, dry_r, wet_l, wet_r, odata,
+      num_samples);
 }
 
 /* this function does the actual processing
@@ -48,6 +48,7 @@ struct _GstFreeverb {
   gfloat damping;
   gfloat pan_width;
   gfloat level;
+  guint n_threads;
 
   GstFreeverbProcessFunc process;
   GstAudioInfo info;
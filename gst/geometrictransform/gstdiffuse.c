@@ -165,16 +165,45 @@ diffuse_prepare (GstGeometricTransform * trans)
   return TRUE;
 }
 
+static void
+diffuse_before_transform (GstBaseTransform * trans, GstBuffer * outbuf)
+{
+  GstDiffuse *diffuse = GST_DIFFUSE_CAST (trans);
+
+  diffuse->seed++;
+
+  GST_BASE_TRANSFORM_CLASS (parent_class)->before_transform (trans, outbuf);
+}
+
+/* The map is called from several threads at once, so instead of sharing the
+ * global random number generator the displacement of a pixel is a hash of its
+ * position and of the frame */
+static inline guint32
+diffuse_hash (guint32 x, guint32 y, guint32 seed)
+{
+  guint32 h = seed ^ (x * 0x9e3779b1) ^ (y * 0x85ebca77);
+
+  h ^= h >> 16;
+  h *= 0x7feb352d;
+  h ^= h >> 15;
+  h *= 0x846ca68b;
+  h ^= h >> 16;
+
+  return h;
+}
+
 static gboolean
 diffuse_map (GstGeometricTransform * gt, gint x, gint y, gdouble * in_x,
     gdouble * in_y)
 {
   GstDiffuse *diffuse = GST_DIFFUSE_CAST (gt);
+  guint32 h;
   gint angle;
   gdouble distance;
 
-  angle = g_random_int_range (0, 256);
-  distance = g_random_double ();
+  h = diffuse_hash (x, y, diffuse->seed);
+  angle = h & 0xff;
+  distance = (h >> 8) / 16777216.0;
 
   *in_x = x + distance * diffuse->sin_table[angle];
   *in_y = y + distance * diffuse->cos_table[angle];
@@ -190,10 +219,12 @@ gst_diffuse_class_init (GstDiffuseClass * klass)
 {
   GObjectClass *gobject_class;
   GstElementClass *gstelement_class;
+  GstBaseTransformClass *trans_class;
   GstGeometricTransformClass *gstgt_class;
 
   gobject_class = (GObjectClass *) klass;
   gstelement_class = (GstElementClass *) klass;
+  trans_class = (GstBaseTransformClass *) klass;
   gstgt_class = (GstGeometricTransformClass *) klass;
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -212,6 +243,9 @@ gst_diffuse_class_init (GstDiffuseClass * klass)
           1, G_MAXDOUBLE, DEFAULT_SCALE,
           GST_PARAM_CONTROLLABLE | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  trans_class->before_transform =
+      GST_DEBUG_FUNCPTR (diffuse_before_transform);
+
   gstgt_class->prepare_func = diffuse_prepare;
   gstgt_class->map_func = diffuse_map;
 }
@@ -74,6 +74,9 @@ struct _GstDiffuse
 
   gdouble *sin_table;
   gdouble *cos_table;
+
+  /* changes the displacements from one frame to the next */
+  guint32 seed;
 };
 
 struct _GstDiffuseClass
@@ -49,7 +49,9 @@ static GstVideoFilterClass *parent_class = NULL;
 enum
 {
   PROP_0,
-  PROP_OFF_EDGE_PIXELS
+  PROP_OFF_EDGE_PIXELS,
+  PROP_INTERPOLATION,
+  PROP_N_THREADS
 };
 
 #define GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE ( \
@@ -74,17 +76,164 @@ gst_geometric_transform_off_edges_pixels_method_get_type (void)
   return method_type;
 }
 
+#define GST_GT_INTERPOLATION_METHOD_TYPE ( \
+    gst_geometric_transform_interpolation_method_get_type())
+static GType
+gst_geometric_transform_interpolation_method_get_type (void)
+{
+  static GType method_type = 0;
+
+  static const GEnumValue method_types[] = {
+    {GST_GT_INTERPOLATION_NEAREST, "Nearest neighbour", "nearest"},
+    {GST_GT_INTERPOLATION_BILINEAR, "Bilinear", "bilinear"},
+    {0, NULL, NULL}
+  };
+
+  if (!method_type) {
+    method_type =
+        g_enum_register_static ("GstGeometricTransformInterpolationMethod",
+        method_types);
+  }
+  return method_type;
+}
+
 #define DEFAULT_OFF_EDGE_PIXELS GST_GT_OFF_EDGES_PIXELS_IGNORE
+#define DEFAULT_INTERPOLATION GST_GT_INTERPOLATION_NEAREST
+#define DEFAULT_N_THREADS 1
+
+typedef struct _GstGeometricTransformSlice GstGeometricTransformSlice;
+
+struct _GstGeometricTransformSlice
+{
+  GstGeometricTransform *gt;
+
+  gint y_start, y_end;
+
+  const guint8 *in_data;
+  gint in_stride;
+  guint8 *out_data;
+  gint out_stride;
+
+  gboolean failed;
+};
+
+/* Splits the rows of the frame into slices and runs @func on each of them.
+ * Returns FALSE if any slice failed.
+ * Must be called with the object lock */
+static gboolean
+gst_geometric_transform_run_slices (GstGeometricTransform * gt,
+    void (*func) (GstGeometricTransformSlice * slice),
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame)
+{
+  GstGeometricTransformSlice *slices;
+  guint i, n_slices;
+  gboolean ret = TRUE;
+
+  gt->runner = gst_slice_runner_update (gt->runner, gt->n_threads);
+  n_slices = MIN (gst_slice_runner_get_n_threads (gt->runner),
+      (guint) MAX (gt->height, 1));
+  slices = g_newa (GstGeometricTransformSlice, n_slices);
+
+  for (i = 0; i < n_slices; i++) {
+    slices[i].gt = gt;
+    slices[i].y_start = gt->height * i / n_slices;
+    slices[i].y_end = gt->height * (i + 1) / n_slices;
+    slices[i].in_data =
+        in_frame ? GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0) : NULL;
+    slices[i].in_stride =
+        in_frame ? GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0) : 0;
+    slices[i].out_data =
+        out_frame ? GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0) : NULL;
+    slices[i].out_stride =
+        out_frame ? GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0) : 0;
+    slices[i].failed = FALSE;
+  }
+
+  gst_slice_runner_run (gt->runner, (GstSliceFunc) func, slices,
+      sizeof (GstGeometricTransformSlice), n_slices);
+
+  for (i = 0; i < n_slices; i++)
+    ret &= !slices[i].failed;
+
+  return ret;
+}
+
+/* Applies the off edge handling to the input position and converts it to
+ * fixed point. Returns FALSE if the output pixel should stay black */
+static inline gboolean
+gst_geometric_transform_to_fixed (GstGeometricTransform * gt, gdouble in_x,
+    gdouble in_y, gint32 * fixed_x, gint32 * fixed_y)
+{
+  gint trunc_x, trunc_y;
+
+  switch (gt->off_edge_pixels) {
+    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
+      in_x = CLAMP (in_x, 0, gt->width - 1);
+      in_y = CLAMP (in_y, 0, gt->height - 1);
+      break;
+
+    case GST_GT_OFF_EDGES_PIXELS_WRAP:
+      in_x = gst_gm_mod_float (in_x, gt->width);
+      in_y = gst_gm_mod_float (in_y, gt->height);
+      if (in_x < 0)
+        in_x += gt->width;
+      if (in_y < 0)
+        in_y += gt->height;
+      break;
+
+    default:
+      break;
+  }
+
+  /* only map pixels whose nearest neighbour is valid */
+  trunc_x = (gint) in_x;
+  trunc_y = (gint) in_y;
+  if (trunc_x < 0 || trunc_x >= gt->width || trunc_y < 0
+      || trunc_y >= gt->height)
+    return FALSE;
+
+  in_x = CLAMP (in_x, 0, gt->width - 1);
+  in_y = CLAMP (in_y, 0, gt->height - 1);
+  *fixed_x = (gint32) (in_x * GST_GT_MAP_ONE);
+  *fixed_y = (gint32) (in_y * GST_GT_MAP_ONE);
+
+  return TRUE;
+}
+
+static void
+gst_geometric_transform_generate_map_slice (GstGeometricTransformSlice * slice)
+{
+  GstGeometricTransform *gt = slice->gt;
+  GstGeometricTransformClass *klass = GST_GEOMETRIC_TRANSFORM_GET_CLASS (gt);
+  gint32 *ptr;
+  gint x, y;
+
+  ptr = gt->map + (gsize) slice->y_start * gt->width * 2;
+
+  for (y = slice->y_start; y < slice->y_end; y++) {
+    for (x = 0; x < gt->width; x++) {
+      gdouble in_x, in_y;
+
+      if (!klass->map_func (gt, x, y, &in_x, &in_y)) {
+        /* child should have warned */
+        slice->failed = TRUE;
+        return;
+      }
+
+      if (!gst_geometric_transform_to_fixed (gt, in_x, in_y, &ptr[0],
+              &ptr[1]))
+        ptr[0] = GST_GT_MAP_INVALID;
+      ptr += 2;
+    }
+  }
+}
 
 /* must be called with the object lock */
 static gboolean
 gst_geometric_transform_generate_map (GstGeometricTransform * gt)
 {
-  gint x, y;
-  gdouble in_x, in_y;
-  gboolean ret = TRUE;
   GstGeometricTransformClass *klass;
-  gdouble *ptr;
+  gboolean ret;
 
   GST_INFO_OBJECT (gt, "Generating new transform map");
 
@@ -100,24 +249,11 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
   /*
    * (x,y) pairs of the inverse mapping
    */
-  gt->map = g_malloc0 (sizeof (gdouble) * gt->width * gt->height * 2);
-  ptr = gt->map;
+  gt->map = g_malloc (sizeof (gint32) * gt->width * gt->height * 2);
 
-  for (y = 0; y < gt->height; y++) {
-    for (x = 0; x < gt->width; x++) {
-      if (!klass->map_func (gt, x, y, &in_x, &in_y)) {
-        /* child should have warned */
-        ret = FALSE;
-        goto end;
-      }
+  ret = gst_geometric_transform_run_slices (gt,
+      gst_geometric_transform_generate_map_slice, NULL, NULL);
 
-      ptr[0] = in_x;
-      ptr[1] = in_y;
-      ptr += 2;
-    }
-  }
-
-end:
   if (!ret) {
     GST_WARNING_OBJECT (gt, "Generating transform map failed");
     g_free (gt->map);
@@ -145,9 +281,18 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
 
   gt->width = in_info->width;
   gt->height = in_info->height;
+  gt->format = GST_VIDEO_INFO_FORMAT (in_info);
   gt->row_stride = in_info->stride[0];
   gt->pixel_stride = GST_VIDEO_INFO_COMP_PSTRIDE (in_info, 0);
 
+  /* in AYUV black is not just all zeros:
+   * 0x10 is black for Y,
+   * 0x80 is black for Cr and Cb */
+  if (gt->format == GST_VIDEO_FORMAT_AYUV)
+    GST_WRITE_UINT32_BE (gt->black, 0xff108080);
+  else
+    memset (gt->black, 0, sizeof (gt->black));
+
   /* regenerate the map */
   GST_OBJECT_LOCK (gt);
   if (gt->map == NULL || old_width == 0 || old_height == 0
@@ -164,44 +309,155 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
   return ret;
 }
 
+static inline guint
+gst_geometric_transform_read_16 (GstGeometricTransform * gt, const guint8 * p)
+{
+  if (gt->format == GST_VIDEO_FORMAT_GRAY16_BE)
+    return GST_READ_UINT16_BE (p);
+  return GST_READ_UINT16_LE (p);
+}
+
+/* Writes the output pixel at @out from the input position @fixed_x,
+ * @fixed_y */
+static inline void
+gst_geometric_transform_sample (GstGeometricTransform * gt,
+    const guint8 * in_data, gint in_stride, guint8 * out, gint32 fixed_x,
+    gint32 fixed_y)
+{
+  gint pixel_stride = gt->pixel_stride;
+  gint x0, y0, x1, y1;
+  guint wx, wy;
+  const guint8 *p00, *p01, *p10, *p11;
+  gint c;
+
+  x0 = fixed_x >> GST_GT_MAP_FRAC_BITS;
+  y0 = fixed_y >> GST_GT_MAP_FRAC_BITS;
+
+  if (gt->interpolation == GST_GT_INTERPOLATION_NEAREST) {
+    const guint8 *in = in_data + y0 * in_stride + x0 * pixel_stride;
+
+    /* constant sizes so the copies become plain loads and stores */
+    switch (pixel_stride) {
+      case 4:
+        memcpy (out, in, 4);
+        break;
+      case 3:
+        memcpy (out, in, 3);
+        break;
+      case 2:
+        memcpy (out, in, 2);
+        break;
+      default:
+        memcpy (out, in, pixel_stride);
+        break;
+    }
+    return;
+  }
+
+  wx = fixed_x & (GST_GT_MAP_ONE - 1);
+  wy = fixed_y & (GST_GT_MAP_ONE - 1);
+
+  /* the neighbours of the last row and column are outside the picture */
+  x1 = x0 + 1;
+  if (x1 >= gt->width)
+    x1 = gt->off_edge_pixels == GST_GT_OFF_EDGES_PIXELS_WRAP ? 0 : x0;
+  y1 = y0 + 1;
+  if (y1 >= gt->height)
+    y1 = gt->off_edge_pixels == GST_GT_OFF_EDGES_PIXELS_WRAP ? 0 : y0;
+
+  p00 = in_data + y0 * in_stride + x0 * pixel_stride;
+  p01 = in_data + y0 * in_stride + x1 * pixel_stride;
+  p10 = in_data + y1 * in_stride + x0 * pixel_stride;
+  p11 = in_data + y1 * in_stride + x1 * pixel_stride;
+
+  if (gt->format == GST_VIDEO_FORMAT_GRAY16_LE
+      || gt->format == GST_VIDEO_FORMAT_GRAY16_BE) {
+    guint32 top, bottom, v;
+
+    top = gst_geometric_transform_read_16 (gt, p00) * (GST_GT_MAP_ONE - wx) +
+        gst_geometric_transform_read_16 (gt, p01) * wx;
+    bottom = gst_geometric_transform_read_16 (gt, p10) * (GST_GT_MAP_ONE - wx) +
+        gst_geometric_transform_read_16 (gt, p11) * wx;
+    v = (top * (GST_GT_MAP_ONE - wy) + bottom * wy +
+        (1 << (2 * GST_GT_MAP_FRAC_BITS - 1))) >> (2 * GST_GT_MAP_FRAC_BITS);
+
+    if (gt->format == GST_VIDEO_FORMAT_GRAY16_BE)
+      GST_WRITE_UINT16_BE (out, v);
+    else
+      GST_WRITE_UINT16_LE (out, v);
+    return;
+  }
+
+  for (c = 0; c < pixel_stride; c++) {
+    guint top, bottom;
+
+    top = p00[c] * (GST_GT_MAP_ONE - wx) + p01[c] * wx;
+    bottom = p10[c] * (GST_GT_MAP_ONE - wx) + p11[c] * wx;
+    out[c] = (top * (GST_GT_MAP_ONE - wy) + bottom * wy +
+        (1 << (2 * GST_GT_MAP_FRAC_BITS - 1))) >> (2 * GST_GT_MAP_FRAC_BITS);
+  }
+}
+
+static inline void
+gst_geometric_transform_write_black (GstGeometricTransform * gt, guint8 * out)
+{
+  memcpy (out, gt->black, gt->pixel_stride);
+}
+
 static void
-gst_geometric_transform_do_map (GstGeometricTransform * gt, guint8 * in_data,
-    guint8 * out_data, gint x, gint y, gdouble in_x, gdouble in_y)
+gst_geometric_transform_remap_slice (GstGeometricTransformSlice * slice)
 {
-  gint in_offset;
-  gint out_offset;
+  GstGeometricTransform *gt = slice->gt;
+  const gint32 *ptr;
+  gint x, y;
 
-  out_offset = y * gt->row_stride + x * gt->pixel_stride;
+  ptr = gt->map + (gsize) slice->y_start * gt->width * 2;
 
-  /* operate on out of edge pixels */
-  switch (gt->off_edge_pixels) {
-    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
-      in_x = CLAMP (in_x, 0, gt->width - 1);
-      in_y = CLAMP (in_y, 0, gt->height - 1);
-      break;
+  for (y = slice->y_start; y < slice->y_end; y++) {
+    guint8 *out = slice->out_data + y * slice->out_stride;
 
-    case GST_GT_OFF_EDGES_PIXELS_WRAP:
-      in_x = gst_gm_mod_float (in_x, gt->width);
-      in_y = gst_gm_mod_float (in_y, gt->height);
-      if (in_x < 0)
-        in_x += gt->width;
-      if (in_y < 0)
-        in_y += gt->height;
-      break;
+    for (x = 0; x < gt->width; x++) {
+      if (ptr[0] != GST_GT_MAP_INVALID)
+        gst_geometric_transform_sample (gt, slice->in_data, slice->in_stride,
+            out, ptr[0], ptr[1]);
+      else
+        gst_geometric_transform_write_black (gt, out);
 
-    default:
-      break;
+      out += gt->pixel_stride;
+      ptr += 2;
+    }
   }
+}
 
-  {
-    gint trunc_x = (gint) in_x;
-    gint trunc_y = (gint) in_y;
-    /* only set the values if the values are valid */
-    if (trunc_x >= 0 && trunc_x < gt->width && trunc_y >= 0 &&
-        trunc_y < gt->height) {
-      in_offset = trunc_y * gt->row_stride + trunc_x * gt->pixel_stride;
+/* for subclasses that can't use a precalculated map */
+static void
+gst_geometric_transform_map_slice (GstGeometricTransformSlice * slice)
+{
+  GstGeometricTransform *gt = slice->gt;
+  GstGeometricTransformClass *klass = GST_GEOMETRIC_TRANSFORM_GET_CLASS (gt);
+  gint x, y;
+
+  for (y = slice->y_start; y < slice->y_end; y++) {
+    guint8 *out = slice->out_data + y * slice->out_stride;
+
+    for (x = 0; x < gt->width; x++) {
+      gdouble in_x, in_y;
+      gint32 fixed_x, fixed_y;
 
-      memcpy (out_data + out_offset, in_data + in_offset, gt->pixel_stride);
+      if (!klass->map_func (gt, x, y, &in_x, &in_y)) {
+        GST_WARNING_OBJECT (gt, "Failed to do mapping for %d %d", x, y);
+        slice->failed = TRUE;
+        return;
+      }
+
+      if (gst_geometric_transform_to_fixed (gt, in_x, in_y, &fixed_x,
+              &fixed_y))
+        gst_geometric_transform_sample (gt, slice->in_data, slice->in_stride,
+            out, fixed_x, fixed_y);
+      else
+        gst_geometric_transform_write_black (gt, out);
+
+      out += gt->pixel_stride;
     }
   }
 }
@@ -229,28 +485,11 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
 {
   GstGeometricTransform *gt;
   GstGeometricTransformClass *klass;
-  gint x, y, i;
   GstFlowReturn ret = GST_FLOW_OK;
-  gdouble *ptr;
-  guint8 *in_data;
-  guint8 *out_data;
 
   gt = GST_GEOMETRIC_TRANSFORM_CAST (vfilter);
   klass = GST_GEOMETRIC_TRANSFORM_GET_CLASS (gt);
 
-  in_data = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
-  out_data = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
-
-  if (GST_VIDEO_FRAME_FORMAT (out_frame) == GST_VIDEO_FORMAT_AYUV) {
-    /* in AYUV black is not just all zeros:
-     * 0x10 is black for Y,
-     * 0x80 is black for Cr and Cb */
-    for (i = 0; i < out_frame->map[0].size; i += 4)
-      GST_WRITE_UINT32_BE (out_data + i, 0xff108080);
-  } else {
-    memset (out_data, 0, out_frame->map[0].size);
-  }
-
   GST_OBJECT_LOCK (gt);
   if (gt->precalc_map) {
     if (gt->needs_remap) {
@@ -261,31 +500,16 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
         }
       gst_geometric_transform_generate_map (gt);
     }
-    g_return_val_if_fail (gt->map, GST_FLOW_ERROR);
-    ptr = gt->map;
-    for (y = 0; y < gt->height; y++) {
-      for (x = 0; x < gt->width; x++) {
-        /* do the mapping */
-        gst_geometric_transform_do_map (gt, in_data, out_data, x, y, ptr[0],
-            ptr[1]);
-        ptr += 2;
-      }
+    if (!gt->map) {
+      GST_OBJECT_UNLOCK (gt);
+      g_return_val_if_reached (GST_FLOW_ERROR);
     }
+    gst_geometric_transform_run_slices (gt,
+        gst_geometric_transform_remap_slice, in_frame, out_frame);
   } else {
-    for (y = 0; y < gt->height; y++) {
-      for (x = 0; x < gt->width; x++) {
-        gdouble in_x, in_y;
-
-        if (klass->map_func (gt, x, y, &in_x, &in_y)) {
-          gst_geometric_transform_do_map (gt, in_data, out_data, x, y, in_x,
-              in_y);
-        } else {
-          GST_WARNING_OBJECT (gt, "Failed to do mapping for %d %d", x, y);
-          ret = GST_FLOW_ERROR;
-          goto end;
-        }
-      }
-    }
+    if (!gst_geometric_transform_run_slices (gt,
+            gst_geometric_transform_map_slice, in_frame, out_frame))
+      ret = GST_FLOW_ERROR;
   }
 end:
   GST_OBJECT_UNLOCK (gt);
@@ -304,6 +528,18 @@ gst_geometric_transform_set_property (GObject * object, guint prop_id,
     case PROP_OFF_EDGE_PIXELS:
       GST_OBJECT_LOCK (gt);
       gt->off_edge_pixels = g_value_get_enum (value);
+      /* the off edge handling is part of the map */
+      gst_geometric_transform_set_need_remap (gt);
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    case PROP_INTERPOLATION:
+      GST_OBJECT_LOCK (gt);
+      gt->interpolation = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (gt);
+      gt->n_threads = g_value_get_uint (value);
       GST_OBJECT_UNLOCK (gt);
       break;
     default:
@@ -324,6 +560,12 @@ gst_geometric_transform_get_property (GObject * object, guint prop_id,
     case PROP_OFF_EDGE_PIXELS:
       g_value_set_enum (value, gt->off_edge_pixels);
       break;
+    case PROP_INTERPOLATION:
+      g_value_set_enum (value, gt->interpolation);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, gt->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -344,9 +586,22 @@ gst_geometric_transform_stop (GstBaseTransform * trans)
   g_free (gt->map);
   gt->map = NULL;
 
+  gst_slice_runner_free (gt->runner);
+  gt->runner = NULL;
+
   return TRUE;
 }
 
+static void
+gst_geometric_transform_finalize (GObject * object)
+{
+  GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (object);
+
+  gst_slice_runner_free (gt->runner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_geometric_transform_base_init (gpointer g_class)
 {
@@ -373,6 +628,7 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
 
   obj_class->set_property = gst_geometric_transform_set_property;
   obj_class->get_property = gst_geometric_transform_get_property;
+  obj_class->finalize = gst_geometric_transform_finalize;
 
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_geometric_transform_stop);
   trans_class->before_transform =
@@ -389,7 +645,34 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
           GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE, DEFAULT_OFF_EDGE_PIXELS,
           GST_PARAM_CONTROLLABLE | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstGeometricTransform:interpolation:
+   *
+   * How to calculate output pixels that map in between input pixels.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (obj_class, PROP_INTERPOLATION,
+      g_param_spec_enum ("interpolation", "Interpolation",
+          "Interpolation method to use for sampling the input",
+          GST_GT_INTERPOLATION_METHOD_TYPE, DEFAULT_INTERPOLATION,
+          GST_PARAM_CONTROLLABLE | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstGeometricTransform:n-threads:
+   *
+   * Number of threads the rows of the frame and of the transform map are
+   * split across.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (obj_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of CPUs)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_type_mark_as_plugin_api (GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE, 0);
+  gst_type_mark_as_plugin_api (GST_GT_INTERPOLATION_METHOD_TYPE, 0);
 }
 
 static void
@@ -398,6 +681,8 @@ gst_geometric_transform_init (GTypeInstance * instance, gpointer g_class)
   GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (instance);
 
   gt->off_edge_pixels = DEFAULT_OFF_EDGE_PIXELS;
+  gt->interpolation = DEFAULT_INTERPOLATION;
+  gt->n_threads = DEFAULT_N_THREADS;
   gt->precalc_map = TRUE;
   gt->needs_remap = TRUE;
 }
@@ -22,6 +22,7 @@
 
 #include <gst/video/gstvideofilter.h>
 #include <gst/video/video.h>
+#include <gst/slicerunner/gstslicerunner.h>
 
 G_BEGIN_DECLS
 
@@ -46,6 +47,20 @@ enum
   GST_GT_OFF_EDGES_PIXELS_WRAP
 };
 
+enum
+{
+  GST_GT_INTERPOLATION_NEAREST = 0,
+  GST_GT_INTERPOLATION_BILINEAR
+};
+
+/* The precalculated map stores the input position of every output pixel as
+ * two fixed point numbers with GST_GT_MAP_FRAC_BITS of fractional part, off
+ * edge handling is already applied. Pixels that are left black are marked
+ * with GST_GT_MAP_INVALID in x */
+#define GST_GT_MAP_FRAC_BITS 8
+#define GST_GT_MAP_ONE (1 << GST_GT_MAP_FRAC_BITS)
+#define GST_GT_MAP_INVALID G_MININT32
+
 typedef struct _GstGeometricTransform GstGeometricTransform;
 typedef struct _GstGeometricTransformClass GstGeometricTransformClass;
 
@@ -99,8 +114,15 @@ struct _GstGeometricTransform {
 
   /* properties */
   gint off_edge_pixels;
+  gint interpolation;
+  guint n_threads;
+
+  gint32 *map;
+
+  guint8 black[4];
 
-  gdouble *map;
+  /* slice threading */
+  GstSliceRunner *runner;
 };
 
 struct _GstGeometricTransformClass {
@@ -213,6 +213,7 @@ gst_comb_detect_transform_frame (GstVideoFilter * filter,
   {
     int j;
     int thisline[MAX_WIDTH];
+    guint8 combed[MAX_WIDTH];
     int score = 0;
 
     height = GST_VIDEO_FRAME_COMP_HEIGHT (outframe, 0);
@@ -234,10 +235,24 @@ gst_comb_detect_transform_frame (GstVideoFilter * filter,
         guint8 *src1 = GET_LINE (inframe, 0, j - 1);
         guint8 *src2 = GET_LINE (inframe, 0, j);
         guint8 *src3 = GET_LINE (inframe, 0, j + 1);
+        int ncombed = 0;
 
+        /* flag the combed samples first, most lines have none and can
+         * be copied as is */
         for (i = 0; i < width; i++) {
-          if (src2[i] < MIN (src1[i], src3[i]) - 5 ||
-              src2[i] > MAX (src1[i], src3[i]) + 5) {
+          combed[i] = (src2[i] < MIN (src1[i], src3[i]) - 5) |
+              (src2[i] > MAX (src1[i], src3[i]) + 5);
+          ncombed += combed[i];
+        }
+
+        if (ncombed == 0) {
+          memset (thisline, 0, width * sizeof (int));
+          memcpy (dest, src2, width);
+          continue;
+        }
+
+        for (i = 0; i < width; i++) {
+          if (combed[i]) {
             if (i > 0) {
               thisline[i] += thisline[i - 1];
             }
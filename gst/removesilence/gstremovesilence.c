@@ -31,7 +31,11 @@
  * - #guint64 "silence_detected": the PTS for the first silent buffer after a non silence period.
  *    
  * - #guint64 "silence_finished": the PTS for the first non silent buffer after a silence period.
- *   
+ *
+ * Multichannel streams are either downmixed before voice activity detection
+ * or, with #GstRemoveSilence:channel-mode set to independent, every channel
+ * is analysed on its own and a buffer is silent if all of its channels are.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 -v -m filesrc location="audiofile" ! decodebin ! removesilence remove=true ! wavenc ! filesink location=without_audio.wav
@@ -60,6 +64,7 @@ GST_DEBUG_CATEGORY_STATIC (gst_remove_silence_debug);
 #define MINIMUM_SILENCE_TIME_MAX  10000000000
 #define MINIMUM_SILENCE_TIME_DEF  0
 #define DEFAULT_VAD_THRESHOLD -60
+#define DEFAULT_CHANNEL_MODE GST_REMOVE_SILENCE_CHANNEL_MODE_DOWNMIX
 
 /* Filter signals and args */
 enum
@@ -77,25 +82,50 @@ enum
   PROP_SQUASH,
   PROP_SILENT,
   PROP_MINIMUM_SILENCE_BUFFERS,
-  PROP_MINIMUM_SILENCE_TIME
+  PROP_MINIMUM_SILENCE_TIME,
+  PROP_CHANNEL_MODE
 };
 
 
+#define ALLOWED_CAPS \
+    "audio/x-raw, " \
+    "format = (string) { " GST_AUDIO_NE (S16) ", " GST_AUDIO_NE (S32) ", " \
+        GST_AUDIO_NE (F32) " }, " \
+    "layout = (string) interleaved, " \
+    "rate = (int) [ 1, MAX ], " "channels = (int) [ 1, MAX ]"
+
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
-        "layout = (string) interleaved, "
-        "rate = (int) [ 1, MAX ], " "channels = (int) 1"));
+    GST_STATIC_CAPS (ALLOWED_CAPS));
 
 static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS ("audio/x-raw, "
-        "format = (string) " GST_AUDIO_NE (S16) ", "
-        "layout = (string) interleaved, "
-        "rate = (int) [ 1, MAX ], " "channels = (int) 1"));
+    GST_STATIC_CAPS (ALLOWED_CAPS));
+
+#define GST_TYPE_REMOVE_SILENCE_CHANNEL_MODE (gst_remove_silence_channel_mode_get_type ())
+static GType
+gst_remove_silence_channel_mode_get_type (void)
+{
+  static GType channel_mode_type = 0;
+
+  if (!channel_mode_type) {
+    static const GEnumValue channel_modes[] = {
+      {GST_REMOVE_SILENCE_CHANNEL_MODE_DOWNMIX,
+          "Detect voice on the downmix of all channels", "downmix"},
+      {GST_REMOVE_SILENCE_CHANNEL_MODE_INDEPENDENT,
+            "Detect voice on every channel, silent if all channels are silent",
+          "independent"},
+      {0, NULL, NULL},
+    };
+
+    channel_mode_type =
+        g_enum_register_static ("GstRemoveSilenceChannelMode", channel_modes);
+  }
+
+  return channel_mode_type;
+}
 
 
 #define DEBUG_INIT(bla) \
@@ -111,6 +141,8 @@ static void gst_remove_silence_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
 static gboolean gst_remove_silence_start (GstBaseTransform * trans);
+static gboolean gst_remove_silence_set_caps (GstBaseTransform * trans,
+    GstCaps * incaps, GstCaps * outcaps);
 static gboolean gst_remove_silence_sink_event (GstBaseTransform * trans,
     GstEvent * event);
 static GstFlowReturn gst_remove_silence_transform_ip (GstBaseTransform * base,
@@ -177,6 +209,19 @@ gst_remove_silence_class_init (GstRemoveSilenceClass * klass)
           MINIMUM_SILENCE_TIME_MIN, MINIMUM_SILENCE_TIME_MAX,
           MINIMUM_SILENCE_TIME_DEF, G_PARAM_READWRITE));
 
+  /**
+   * GstRemoveSilence:channel-mode:
+   *
+   * How voice activity is detected on multichannel streams.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_CHANNEL_MODE,
+      g_param_spec_enum ("channel-mode", "Channel mode",
+          "How voice activity is detected on multichannel streams",
+          GST_TYPE_REMOVE_SILENCE_CHANNEL_MODE, DEFAULT_CHANNEL_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "RemoveSilence",
       "Filter/Effect/Audio",
@@ -189,10 +234,14 @@ gst_remove_silence_class_init (GstRemoveSilenceClass * klass)
   gst_element_class_add_static_pad_template (gstelement_class, &sink_template);
 
   base_transform_class->start = GST_DEBUG_FUNCPTR (gst_remove_silence_start);
+  base_transform_class->set_caps =
+      GST_DEBUG_FUNCPTR (gst_remove_silence_set_caps);
   base_transform_class->sink_event =
       GST_DEBUG_FUNCPTR (gst_remove_silence_sink_event);
   base_transform_class->transform_ip =
       GST_DEBUG_FUNCPTR (gst_remove_silence_transform_ip);
+
+  gst_type_mark_as_plugin_api (GST_TYPE_REMOVE_SILENCE_CHANNEL_MODE, 0);
 }
 
 static void
@@ -218,6 +267,8 @@ gst_remove_silence_init (GstRemoveSilence * filter)
   filter->silent = TRUE;
   filter->minimum_silence_buffers = MINIMUM_SILENCE_BUFFERS_DEF;
   filter->minimum_silence_time = MINIMUM_SILENCE_TIME_DEF;
+  filter->channel_mode = DEFAULT_CHANNEL_MODE;
+  gst_audio_info_init (&filter->info);
 
   gst_remove_silence_reset (filter);
 
@@ -238,6 +289,38 @@ gst_remove_silence_start (GstBaseTransform * trans)
   return TRUE;
 }
 
+static void
+gst_remove_silence_free_channel_vads (GstRemoveSilence * filter)
+{
+  gint i;
+
+  for (i = 0; i < filter->n_channel_vads; i++)
+    vad_destroy (filter->channel_vads[i]);
+  g_free (filter->channel_vads);
+  filter->channel_vads = NULL;
+  filter->n_channel_vads = 0;
+}
+
+static gboolean
+gst_remove_silence_set_caps (GstBaseTransform * trans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstRemoveSilence *filter = GST_REMOVE_SILENCE (trans);
+  GstAudioInfo info;
+
+  if (!gst_audio_info_from_caps (&info, incaps)) {
+    GST_ERROR_OBJECT (filter, "invalid caps %" GST_PTR_FORMAT, incaps);
+    return FALSE;
+  }
+
+  if (GST_AUDIO_INFO_CHANNELS (&info) != GST_AUDIO_INFO_CHANNELS (&filter->info))
+    gst_remove_silence_free_channel_vads (filter);
+
+  filter->info = info;
+
+  return TRUE;
+}
+
 static gboolean
 gst_remove_silence_sink_event (GstBaseTransform * trans, GstEvent * event)
 {
@@ -260,6 +343,9 @@ gst_remove_silence_finalize (GObject * obj)
   GST_DEBUG ("Destroying VAD");
   vad_destroy (filter->vad);
   filter->vad = NULL;
+  gst_remove_silence_free_channel_vads (filter);
+  g_free (filter->samples);
+  filter->samples = NULL;
   GST_DEBUG ("VAD Destroyed");
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
@@ -274,12 +360,23 @@ gst_remove_silence_set_property (GObject * object, guint prop_id,
     case PROP_REMOVE:
       filter->remove = g_value_get_boolean (value);
       break;
-    case PROP_HYSTERESIS:
+    case PROP_HYSTERESIS:{
+      gint i;
+
       vad_set_hysteresis (filter->vad, g_value_get_uint64 (value));
+      for (i = 0; i < filter->n_channel_vads; i++)
+        vad_set_hysteresis (filter->channel_vads[i],
+            g_value_get_uint64 (value));
       break;
-    case PROP_THRESHOLD:
+    }
+    case PROP_THRESHOLD:{
+      gint i;
+
       vad_set_threshold (filter->vad, g_value_get_int (value));
+      for (i = 0; i < filter->n_channel_vads; i++)
+        vad_set_threshold (filter->channel_vads[i], g_value_get_int (value));
       break;
+    }
     case PROP_SQUASH:
       filter->squash = g_value_get_boolean (value);
       break;
@@ -292,6 +389,9 @@ gst_remove_silence_set_property (GObject * object, guint prop_id,
     case PROP_MINIMUM_SILENCE_TIME:
       filter->minimum_silence_time = g_value_get_uint64 (value);
       break;
+    case PROP_CHANNEL_MODE:
+      filter->channel_mode = g_value_get_enum (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -326,12 +426,116 @@ gst_remove_silence_get_property (GObject * object, guint prop_id,
     case PROP_MINIMUM_SILENCE_TIME:
       g_value_set_uint64 (value, filter->minimum_silence_time);
       break;
+    case PROP_CHANNEL_MODE:
+      g_value_set_enum (value, filter->channel_mode);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* The VAD works on samples normalized to [-1.0, 1.0]. The channels of a
+ * frame are averaged while converting */
+#define DEFINE_CONVERT(name, type, scale)                                    \
+static void                                                                  \
+downmix_##name (const guint8 * data, gint channels, gint n_frames,           \
+    gfloat * out)                                                            \
+{                                                                            \
+  const type *in = (const type *) data;                                      \
+  const gfloat s = (scale) / channels;                                       \
+  gint i, c;                                                                 \
+                                                                             \
+  if (channels == 1) {                                                       \
+    for (i = 0; i < n_frames; i++)                                           \
+      out[i] = in[i] * (gfloat) (scale);                                     \
+    return;                                                                  \
+  }                                                                          \
+                                                                             \
+  for (i = 0; i < n_frames; i++) {                                           \
+    gfloat sum = 0.0f;                                                       \
+                                                                             \
+    for (c = 0; c < channels; c++)                                           \
+      sum += in[i * channels + c];                                           \
+    out[i] = sum * s;                                                        \
+  }                                                                          \
+}                                                                            \
+                                                                             \
+static void                                                                  \
+deinterleave_##name (const guint8 * data, gint channels, gint channel,      \
+    gint n_frames, gfloat * out)                                             \
+{                                                                            \
+  const type *in = (const type *) data + channel;                            \
+  gint i;                                                                    \
+                                                                             \
+  for (i = 0; i < n_frames; i++)                                             \
+    out[i] = in[i * channels] * (gfloat) (scale);                            \
+}
+
+DEFINE_CONVERT (s16, gint16, 1.0 / 32768.0)
+DEFINE_CONVERT (s32, gint32, 1.0 / 2147483648.0)
+DEFINE_CONVERT (f32, gfloat, 1.0)
+
+static gint
+gst_remove_silence_update_vad (GstRemoveSilence * filter, const guint8 * data,
+    gint n_frames)
+{
+  const gint channels = GST_AUDIO_INFO_CHANNELS (&filter->info);
+  void (*downmix) (const guint8 *, gint, gint, gfloat *);
+  void (*deinterleave) (const guint8 *, gint, gint, gint, gfloat *);
+  gint frame_type = VAD_SILENCE;
+  gint c;
+
+  switch (GST_AUDIO_INFO_FORMAT (&filter->info)) {
+    case GST_AUDIO_FORMAT_S16:
+      downmix = downmix_s16;
+      deinterleave = deinterleave_s16;
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      downmix = downmix_s32;
+      deinterleave = deinterleave_s32;
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      downmix = downmix_f32;
+      deinterleave = deinterleave_f32;
+      break;
+    default:
+      g_assert_not_reached ();
+      return VAD_VOICE;
+  }
+
+  if (n_frames > filter->samples_len) {
+    filter->samples = g_renew (gfloat, filter->samples, n_frames);
+    filter->samples_len = n_frames;
+  }
+
+  if (channels == 1
+      || filter->channel_mode == GST_REMOVE_SILENCE_CHANNEL_MODE_DOWNMIX) {
+    downmix (data, channels, n_frames, filter->samples);
+    return vad_update (filter->vad, filter->samples, n_frames);
+  }
+
+  if (filter->n_channel_vads != channels) {
+    gst_remove_silence_free_channel_vads (filter);
+    filter->channel_vads = g_new (VADFilter *, channels);
+    for (c = 0; c < channels; c++) {
+      filter->channel_vads[c] = vad_new (vad_get_hysteresis (filter->vad),
+          vad_get_threshold_as_db (filter->vad));
+    }
+    filter->n_channel_vads = channels;
+  }
+
+  /* every VAD sees every buffer to keep its history up to date */
+  for (c = 0; c < channels; c++) {
+    deinterleave (data, channels, c, n_frames, filter->samples);
+    if (vad_update (filter->channel_vads[c], filter->samples,
+            n_frames) == VAD_VOICE)
+      frame_type = VAD_VOICE;
+  }
+
+  return frame_type;
+}
+
 static GstFlowReturn
 gst_remove_silence_transform_ip (GstBaseTransform * trans, GstBuffer * inbuf)
 {
@@ -344,7 +548,8 @@ gst_remove_silence_transform_ip (GstBaseTransform * trans, GstBuffer * inbuf)
 
   gst_buffer_map (inbuf, &map, GST_MAP_READ);
   frame_type =
-      vad_update (filter->vad, (gint16 *) map.data, map.size / sizeof (gint16));
+      gst_remove_silence_update_vad (filter, map.data,
+      map.size / GST_AUDIO_INFO_BPF (&filter->info));
   gst_buffer_unmap (inbuf, &map);
 
   if (frame_type == VAD_SILENCE) {
@@ -25,6 +25,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstbasetransform.h>
+#include <gst/audio/audio.h>
 #include "vad_private.h"
 
 G_BEGIN_DECLS
@@ -40,9 +41,21 @@ G_BEGIN_DECLS
 #define GST_IS_REMOVESILENCE_CLASS(klass) \
   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_REMOVE_SILENCE))
 
+typedef enum {
+  GST_REMOVE_SILENCE_CHANNEL_MODE_DOWNMIX,
+  GST_REMOVE_SILENCE_CHANNEL_MODE_INDEPENDENT
+} GstRemoveSilenceChannelMode;
+
 typedef struct _GstRemoveSilence {
   GstBaseTransform parent;
   VADFilter* vad;
+  /* one VAD per channel in independent channel mode */
+  VADFilter** channel_vads;
+  gint n_channel_vads;
+  GstRemoveSilenceChannelMode channel_mode;
+  GstAudioInfo info;
+  gfloat *samples;
+  gint samples_len;
   gboolean remove;
   gboolean squash;
   gboolean silent;
@@ -26,41 +26,30 @@
 #include <glib.h>
 #include "vad_private.h"
 
-#define VAD_POWER_ALPHA     0x0800      /* Q16 */
+#define VAD_POWER_ALPHA     (0x0800 / 65536.0f)
 #define VAD_ZCR_THRESHOLD   0
 #define VAD_BUFFER_SIZE     256
-
-
-union pgen
-{
-  guint64 a;
-  gpointer v;
-  guint64 *l;
-  guchar *b;
-  guint16 *w;
-  gint16 *s;
-};
-
-struct _cqueue_s
-{
-  union pgen base;
-  union pgen tail;
-  union pgen head;
-  gint size;
-};
-
-typedef struct _cqueue_s cqueue_t;
+/* the zero crossing rate is taken over the last VAD_HISTORY_SIZE samples */
+#define VAD_HISTORY_SIZE    (VAD_BUFFER_SIZE - 1)
+/* the energy is averaged over blocks of samples of this size */
+#define VAD_BLOCK_SIZE      64
+/* partial sums to break the dependency chain of the energy accumulation */
+#define VAD_LANES           8
 
 struct _vad_s
 {
-  gint16 vad_buffer[VAD_BUFFER_SIZE];
-  cqueue_t cqueue;
+  gfloat history[VAD_HISTORY_SIZE];
+  gint history_len;
   gint vad_state;
   guint64 hysteresis;
   guint64 vad_samples;
-  guint64 vad_power;
-  guint64 threshold;
+  gfloat vad_power;
+  gfloat threshold;
   long vad_zcr;
+  /* weights[i] = alpha * (1 - alpha)^(VAD_BLOCK_SIZE - 1 - i) */
+  gfloat weights[VAD_BLOCK_SIZE];
+  /* decay[n] = (1 - alpha)^n */
+  gfloat decay[VAD_BLOCK_SIZE + 1];
 };
 
 VADFilter *
@@ -76,11 +65,16 @@ vad_new (guint64 hysteresis, gint threshold)
 void
 vad_reset (VADFilter * vad)
 {
+  gint i;
+
   memset (vad, 0, sizeof (*vad));
-  vad->cqueue.base.s = vad->vad_buffer;
-  vad->cqueue.tail.a = vad->cqueue.head.a = 0;
-  vad->cqueue.size = VAD_BUFFER_SIZE;
   vad->vad_state = VAD_SILENCE;
+
+  vad->decay[0] = 1.0f;
+  for (i = 1; i <= VAD_BLOCK_SIZE; i++)
+    vad->decay[i] = vad->decay[i - 1] * (1.0f - VAD_POWER_ALPHA);
+  for (i = 0; i < VAD_BLOCK_SIZE; i++)
+    vad->weights[i] = VAD_POWER_ALPHA * vad->decay[VAD_BLOCK_SIZE - 1 - i];
 }
 
 void
@@ -105,44 +99,79 @@ void
 vad_set_threshold (struct _vad_s *p, gint threshold_db)
 {
   gint power = (gint) (threshold_db / 10.0);
-  p->threshold = (guint64) (pow (10, (power)) * 4294967295UL);
+  p->threshold = pow (10, power);
 }
 
 gint
 vad_get_threshold_as_db (struct _vad_s *p)
 {
-  return (gint) (10 * log10 (p->threshold / 4294967295.0));
+  return (gint) floor (10 * log10 (p->threshold) + 0.5);
+}
+
+/* Exponential moving average of the sample energy. Over a block of n samples
+ * the average decays by (1 - alpha)^n and gains the weighted sum of the
+ * energies of the block, which has no dependency between samples */
+static void
+vad_update_power (struct _vad_s *p, const gfloat * data, gint len)
+{
+  gint i, j, k, n;
+
+  for (i = 0; i < len; i += n) {
+    const gfloat *w, *x;
+    gfloat acc[VAD_LANES] = { 0.0f, };
+    gfloat sum = 0.0f;
+
+    n = MIN (len - i, VAD_BLOCK_SIZE);
+    w = p->weights + VAD_BLOCK_SIZE - n;
+    x = data + i;
+
+    for (j = 0; j + VAD_LANES <= n; j += VAD_LANES) {
+      for (k = 0; k < VAD_LANES; k++)
+        acc[k] += w[j + k] * x[j + k] * x[j + k];
+    }
+    for (; j < n; j++)
+      sum += w[j] * x[j] * x[j];
+    for (k = 0; k < VAD_LANES; k++)
+      sum += acc[k];
+
+    p->vad_power = p->decay[n] * p->vad_power + sum;
+  }
+}
+
+/* Keeps the last VAD_HISTORY_SIZE samples for the zero crossing rate */
+static void
+vad_update_history (struct _vad_s *p, const gfloat * data, gint len)
+{
+  gint keep;
+
+  if (len >= VAD_HISTORY_SIZE) {
+    memcpy (p->history, data + len - VAD_HISTORY_SIZE,
+        VAD_HISTORY_SIZE * sizeof (gfloat));
+    p->history_len = VAD_HISTORY_SIZE;
+    return;
+  }
+
+  keep = MIN (p->history_len, VAD_HISTORY_SIZE - len);
+  memmove (p->history, p->history + p->history_len - keep,
+      keep * sizeof (gfloat));
+  memcpy (p->history + keep, data, len * sizeof (gfloat));
+  p->history_len = keep + len;
 }
 
 gint
-vad_update (struct _vad_s * p, gint16 * data, gint len)
+vad_update (struct _vad_s * p, const gfloat * data, gint len)
 {
-  guint64 tail;
   gint frame_type;
-  gint16 sample;
+  gint crossings = 0;
   gint i;
 
-  for (i = 0; i < len; i++) {
-    p->vad_power = VAD_POWER_ALPHA * ((data[i] * data[i] >> 14) & 0xFFFF) +
-        (0xFFFF - VAD_POWER_ALPHA) * (p->vad_power >> 16) +
-        ((0xFFFF - VAD_POWER_ALPHA) * (p->vad_power & 0xFFFF) >> 16);
-    /* Update VAD buffer */
-    p->cqueue.base.s[p->cqueue.head.a] = data[i];
-    p->cqueue.head.a = (p->cqueue.head.a + 1) & (p->cqueue.size - 1);
-    if (p->cqueue.head.a == p->cqueue.tail.a)
-      p->cqueue.tail.a = (p->cqueue.tail.a + 1) & (p->cqueue.size - 1);
-  }
+  vad_update_power (p, data, len);
+  vad_update_history (p, data, len);
 
-  tail = p->cqueue.tail.a;
-  p->vad_zcr = 0;
-  for (;;) {
-    sample = p->cqueue.base.s[tail];
-    tail = (tail + 1) & (p->cqueue.size - 1);
-    if (tail == p->cqueue.head.a)
-      break;
-    p->vad_zcr +=
-        ((sample & 0x8000) != (p->cqueue.base.s[tail] & 0x8000)) ? 1 : -1;
-  }
+  /* +1 for every pair of samples with a sign change, -1 for the others */
+  for (i = 1; i < p->history_len; i++)
+    crossings += (p->history[i - 1] < 0.0f) != (p->history[i] < 0.0f);
+  p->vad_zcr = 2 * crossings - MAX (p->history_len - 1, 0);
 
   frame_type = (p->vad_power > p->threshold
       && p->vad_zcr < VAD_ZCR_THRESHOLD) ? VAD_VOICE : VAD_SILENCE;
@@ -29,7 +29,7 @@
 
 typedef struct _vad_s VADFilter;
 
-gint vad_update(VADFilter *p, gint16 *data, gint len);
+gint vad_update(VADFilter *p, const gfloat *data, gint len);
 
 void vad_set_hysteresis(VADFilter *p, guint64 hysteresis);
 
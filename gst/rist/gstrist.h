@@ -72,6 +72,23 @@ typedef struct {
 } GstRistRtpDeextClass;
 GType gst_rist_rtp_deext_get_type (void);
 
+#define GST_TYPE_RIST_DISPATCHER      (gst_rist_dispatcher_get_type())
+#define GST_RIST_DISPATCHER(obj)      (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_RIST_DISPATCHER,GstRistDispatcher))
+#define GST_IS_RIST_DISPATCHER(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_RIST_DISPATCHER))
+typedef struct _GstRistDispatcher GstRistDispatcher;
+typedef struct {
+  GstElementClass parent;
+} GstRistDispatcherClass;
+GType gst_rist_dispatcher_get_type (void);
+
+#define GST_TYPE_RIST_DISPATCHER_PAD  (gst_rist_dispatcher_pad_get_type())
+#define GST_RIST_DISPATCHER_PAD(obj)  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_RIST_DISPATCHER_PAD,GstRistDispatcherPad))
+typedef struct _GstRistDispatcherPad GstRistDispatcherPad;
+typedef struct {
+  GstPadClass parent;
+} GstRistDispatcherPadClass;
+GType gst_rist_dispatcher_pad_get_type (void);
+
 guint32 gst_rist_rtp_ext_seq (guint32 * extseqnum, guint16 seqnum);
 
 void gst_rist_rtx_send_set_extseqnum (GstRistRtxSend *self, guint32 ssrc,
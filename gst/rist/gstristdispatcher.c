@@ -0,0 +1,285 @@
+/* GStreamer RIST plugin
+ * Copyright (C) 2026 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-ristdispatcher
+ * @title: ristdispatcher
+ * @see_also: ristsink, roundrobin
+ *
+ * This element distributes incoming buffers over multiple src pads
+ * proportionally to the "weight" property of each src pad. It uses a smooth
+ * weighted round robin, so that buffers sent to the same pad are spread
+ * evenly over time instead of being sent in bursts. With all weights equal,
+ * this behaves exactly like the roundrobin element. A pad with a weight of 0
+ * does not receive any buffer.
+ *
+ * This element is used by ristsink when "bonding-method" is set to
+ * "weighted", in which case ristsink updates the weights from the RTCP
+ * receiver reports of each link.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstrist.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_rist_dispatcher_debug);
+#define GST_CAT_DEFAULT gst_rist_dispatcher_debug
+
+#define DEFAULT_WEIGHT 1.0
+
+enum
+{
+  PROP_PAD_0,
+  PROP_PAD_WEIGHT,
+  PROP_PAD_BUFFERS,
+  PROP_PAD_BYTES
+};
+
+static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("ANY"));
+
+static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS ("ANY"));
+
+struct _GstRistDispatcherPad
+{
+  GstPad parent;
+
+  /* protected by the element object lock */
+  gdouble weight;
+  gdouble current_weight;
+  guint64 buffers;
+  guint64 bytes;
+};
+
+struct _GstRistDispatcher
+{
+  GstElement parent;
+};
+
+G_DEFINE_TYPE (GstRistDispatcherPad, gst_rist_dispatcher_pad, GST_TYPE_PAD);
+
+G_DEFINE_TYPE_WITH_CODE (GstRistDispatcher, gst_rist_dispatcher,
+    GST_TYPE_ELEMENT, GST_DEBUG_CATEGORY_INIT (gst_rist_dispatcher_debug,
+        "ristdispatcher", 0, "RIST Weighted Dispatcher"));
+
+static void
+gst_rist_dispatcher_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstRistDispatcherPad *pad = GST_RIST_DISPATCHER_PAD (object);
+  GstObject *parent = gst_object_get_parent (GST_OBJECT (pad));
+
+  if (parent)
+    GST_OBJECT_LOCK (parent);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      g_value_set_double (value, pad->weight);
+      break;
+    case PROP_PAD_BUFFERS:
+      g_value_set_uint64 (value, pad->buffers);
+      break;
+    case PROP_PAD_BYTES:
+      g_value_set_uint64 (value, pad->bytes);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+
+  if (parent) {
+    GST_OBJECT_UNLOCK (parent);
+    gst_object_unref (parent);
+  }
+}
+
+static void
+gst_rist_dispatcher_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstRistDispatcherPad *pad = GST_RIST_DISPATCHER_PAD (object);
+  GstObject *parent = gst_object_get_parent (GST_OBJECT (pad));
+
+  if (parent)
+    GST_OBJECT_LOCK (parent);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      pad->weight = g_value_get_double (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+
+  if (parent) {
+    GST_OBJECT_UNLOCK (parent);
+    gst_object_unref (parent);
+  }
+}
+
+static void
+gst_rist_dispatcher_pad_class_init (GstRistDispatcherPadClass * klass)
+{
+  GObjectClass *object_class = (GObjectClass *) klass;
+
+  object_class->get_property = gst_rist_dispatcher_pad_get_property;
+  object_class->set_property = gst_rist_dispatcher_pad_set_property;
+
+  g_object_class_install_property (object_class, PROP_PAD_WEIGHT,
+      g_param_spec_double ("weight", "Weight",
+          "Relative share of the buffers sent through this pad", 0.0,
+          G_MAXDOUBLE, DEFAULT_WEIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (object_class, PROP_PAD_BUFFERS,
+      g_param_spec_uint64 ("buffers", "Buffers",
+          "Number of buffers sent through this pad", 0, G_MAXUINT64, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (object_class, PROP_PAD_BYTES,
+      g_param_spec_uint64 ("bytes", "Bytes",
+          "Number of bytes sent through this pad", 0, G_MAXUINT64, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+gst_rist_dispatcher_pad_init (GstRistDispatcherPad * pad)
+{
+  pad->weight = DEFAULT_WEIGHT;
+}
+
+/* Smooth weighted round robin: every pad accumulates its weight, the pad
+ * with the highest accumulated value is picked and is then penalized by the
+ * sum of all weights. Called with the object lock. */
+static GstRistDispatcherPad *
+gst_rist_dispatcher_pick_pad (GstRistDispatcher * disp)
+{
+  GstRistDispatcherPad *best = NULL;
+  gdouble total = 0.0;
+  GList *l;
+
+  for (l = GST_ELEMENT (disp)->srcpads; l; l = l->next) {
+    GstRistDispatcherPad *pad = l->data;
+
+    if (pad->weight <= 0.0)
+      continue;
+
+    pad->current_weight += pad->weight;
+    total += pad->weight;
+
+    if (!best || pad->current_weight > best->current_weight)
+      best = pad;
+  }
+
+  if (best)
+    best->current_weight -= total;
+
+  return best;
+}
+
+static GstFlowReturn
+gst_rist_dispatcher_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstRistDispatcher *disp = GST_RIST_DISPATCHER (parent);
+  GstRistDispatcherPad *src_pad;
+  GstFlowReturn ret;
+
+  GST_OBJECT_LOCK (disp);
+  src_pad = gst_rist_dispatcher_pick_pad (disp);
+  if (src_pad) {
+    gst_object_ref (src_pad);
+    src_pad->buffers++;
+    src_pad->bytes += gst_buffer_get_size (buffer);
+  }
+  GST_OBJECT_UNLOCK (disp);
+
+  if (!src_pad) {
+    /* no pad, or all weights are 0, that's fine */
+    gst_buffer_unref (buffer);
+    return GST_FLOW_OK;
+  }
+
+  ret = gst_pad_push (GST_PAD (src_pad), buffer);
+  gst_object_unref (src_pad);
+
+  return ret;
+}
+
+static GstPad *
+gst_rist_dispatcher_request_pad (GstElement * element, GstPadTemplate * templ,
+    const gchar * name, const GstCaps * caps)
+{
+  GstPad *pad;
+
+  pad = gst_element_get_static_pad (element, name);
+  if (pad) {
+    gst_object_unref (pad);
+    return NULL;
+  }
+
+  pad = g_object_new (GST_TYPE_RIST_DISPATCHER_PAD, "name", name,
+      "direction", templ->direction, "template", templ, NULL);
+  gst_element_add_pad (element, pad);
+
+  return pad;
+}
+
+static void
+gst_rist_dispatcher_init (GstRistDispatcher * disp)
+{
+  GstPad *pad;
+
+  gst_element_create_all_pads (GST_ELEMENT (disp));
+  pad = GST_PAD (GST_ELEMENT (disp)->sinkpads->data);
+
+  GST_PAD_SET_PROXY_CAPS (pad);
+  GST_PAD_SET_PROXY_SCHEDULING (pad);
+  /* do not proxy allocation, it requires special handling like tee does */
+
+  gst_pad_set_chain_function (pad,
+      GST_DEBUG_FUNCPTR (gst_rist_dispatcher_chain));
+}
+
+static void
+gst_rist_dispatcher_class_init (GstRistDispatcherClass * klass)
+{
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  gst_element_class_set_metadata (element_class,
+      "RIST Weighted Dispatcher", "Source/Network",
+      "A weighted round robin dispatcher element.",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  gst_element_class_add_static_pad_template_with_gtype (element_class,
+      &src_templ, GST_TYPE_RIST_DISPATCHER_PAD);
+  gst_element_class_add_static_pad_template (element_class, &sink_templ);
+
+  element_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_rist_dispatcher_request_pad);
+
+  gst_type_mark_as_plugin_api (GST_TYPE_RIST_DISPATCHER_PAD, 0);
+}
@@ -90,12 +90,13 @@ bit_count (guint8 value)
   return count;
 }
 
+/* Takes ownership of @buffer. On success, @outbuf is set to the buffer to
+ * push downstream, or NULL if the packet had to be dropped. */
 static GstFlowReturn
-gst_rist_rtp_deext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+gst_rist_rtp_deext_process_buffer (GstRistRtpDeext * self, GstBuffer * buffer,
+    GstBuffer ** outbuf)
 {
-  GstRistRtpDeext *self = GST_RIST_RTP_DEEXT (parent);
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
-  GstBuffer *outbuf;
   gboolean has_seqnum_ext;
   gboolean has_drop_null;
   gboolean ts_packet_size;
@@ -115,6 +116,7 @@ gst_rist_rtp_deext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   guint orig_payload_offset;
   guint hdrlen;
 
+  *outbuf = NULL;
 
   if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp)) {
     GST_ELEMENT_ERROR (self, STREAM, MUX, (NULL), ("Could not map RTP buffer"));
@@ -124,21 +126,24 @@ gst_rist_rtp_deext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   if (!gst_rtp_buffer_get_extension_data (&rtp, &bits, &extdata, &extlen)) {
     /* Has no extension, let's push out without modifying */
     gst_rtp_buffer_unmap (&rtp);
-    return gst_pad_push (self->srcpad, buffer);
+    *outbuf = buffer;
+    return GST_FLOW_OK;
   }
 
   if (bits != ('R' << 8 | 'I')) {
     gst_rtp_buffer_unmap (&rtp);
     GST_LOG_OBJECT (self, "Buffer %" GST_PTR_FORMAT
         " has an extension that's not the RIST one, ignoring", buffer);
-    return gst_pad_push (self->srcpad, buffer);
+    *outbuf = buffer;
+    return GST_FLOW_OK;
   }
 
   if (extlen != 1) {
     gst_rtp_buffer_unmap (&rtp);
     GST_LOG_OBJECT (self, "Buffer %" GST_PTR_FORMAT
         " has a RIST extension that's not of length 1, ignoring", buffer);
-    return gst_pad_push (self->srcpad, buffer);
+    *outbuf = buffer;
+    return GST_FLOW_OK;
   }
 
   data = extdata;
@@ -251,30 +256,83 @@ no_restore:
   gst_rtp_buffer_unmap (&rtp);
 
   /* Create a new buffer without the header extension */
-  outbuf = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_ALL, 0, hdrlen);
+  *outbuf = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_ALL, 0, hdrlen);
 
   /* Unset extension flag, can't use the GstRTPBuffer function as they will
    * try to look for the extension itself which isn't there if the flag is set.
    */
-  gst_buffer_map (outbuf, &map, GST_MAP_READWRITE);
+  gst_buffer_map (*outbuf, &map, GST_MAP_READWRITE);
   map.data[0] &= ~0x10;
-  gst_buffer_unmap (outbuf, &map);
+  gst_buffer_unmap (*outbuf, &map);
 
   if (mem)
-    gst_buffer_append_memory (outbuf, mem);
+    gst_buffer_append_memory (*outbuf, mem);
   else
-    gst_buffer_copy_into (outbuf, buffer, GST_BUFFER_COPY_MEMORY,
+    gst_buffer_copy_into (*outbuf, buffer, GST_BUFFER_COPY_MEMORY,
         orig_payload_offset, -1);
 
   gst_buffer_unref (buffer);
 
-  return gst_pad_push (self->srcpad, outbuf);
+  return GST_FLOW_OK;
 
 mapping_error:
   gst_buffer_unref (buffer);
   return GST_FLOW_ERROR;
 }
 
+static GstFlowReturn
+gst_rist_rtp_deext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstRistRtpDeext *self = GST_RIST_RTP_DEEXT (parent);
+  GstBuffer *outbuf = NULL;
+  GstFlowReturn ret;
+
+  ret = gst_rist_rtp_deext_process_buffer (self, buffer, &outbuf);
+  if (ret != GST_FLOW_OK || outbuf == NULL)
+    return ret;
+
+  return gst_pad_push (self->srcpad, outbuf);
+}
+
+typedef struct
+{
+  GstRistRtpDeext *self;
+  GstFlowReturn ret;
+} DeextListData;
+
+static gboolean
+gst_rist_rtp_deext_process_list_item (GstBuffer ** buffer, guint idx,
+    gpointer user_data)
+{
+  DeextListData *data = user_data;
+  GstBuffer *outbuf = NULL;
+
+  data->ret = gst_rist_rtp_deext_process_buffer (data->self, *buffer, &outbuf);
+  *buffer = outbuf;
+
+  return data->ret == GST_FLOW_OK;
+}
+
+/* Process the whole list in place so that batched reception is preserved
+ * all the way to the jitterbuffer. */
+static GstFlowReturn
+gst_rist_rtp_deext_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRistRtpDeext *self = GST_RIST_RTP_DEEXT (parent);
+  DeextListData data = { self, GST_FLOW_OK };
+
+  list = gst_buffer_list_make_writable (list);
+  gst_buffer_list_foreach (list, gst_rist_rtp_deext_process_list_item, &data);
+
+  if (data.ret != GST_FLOW_OK || gst_buffer_list_length (list) == 0) {
+    gst_buffer_list_unref (list);
+    return data.ret;
+  }
+
+  return gst_pad_push_list (self->srcpad, list);
+}
+
 static void
 gst_rist_rtp_deext_init (GstRistRtpDeext * self)
 {
@@ -286,6 +344,8 @@ gst_rist_rtp_deext_init (GstRistRtpDeext * self)
   GST_PAD_SET_PROXY_ALLOCATION (self->sinkpad);
   GST_PAD_SET_PROXY_CAPS (self->sinkpad);
   gst_pad_set_chain_function (self->sinkpad, gst_rist_rtp_deext_chain);
+  gst_pad_set_chain_list_function (self->sinkpad,
+      gst_rist_rtp_deext_chain_list);
 
   gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
   gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
@@ -83,6 +83,8 @@ static gboolean gst_rist_rtx_receive_src_event (GstPad * pad,
     GstObject * parent, GstEvent * event);
 static GstFlowReturn gst_rist_rtx_receive_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buffer);
+static GstFlowReturn gst_rist_rtx_receive_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static GstStateChangeReturn gst_rist_rtx_receive_change_state (GstElement *
     element, GstStateChange transition);
 static void gst_rist_rtx_receive_get_property (GObject * object, guint prop_id,
@@ -155,6 +157,8 @@ gst_rist_rtx_receive_init (GstRistRtxReceive * rtx)
   GST_PAD_SET_PROXY_ALLOCATION (rtx->sinkpad);
   gst_pad_set_chain_function (rtx->sinkpad,
       GST_DEBUG_FUNCPTR (gst_rist_rtx_receive_chain));
+  gst_pad_set_chain_list_function (rtx->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_rist_rtx_receive_chain_list));
   gst_element_add_pad (GST_ELEMENT (rtx), rtx->sinkpad);
 }
 
@@ -202,15 +206,15 @@ gst_rist_rtx_receive_src_event (GstPad * pad, GstObject * parent,
   return gst_pad_event_default (pad, parent, event);
 }
 
-static GstFlowReturn
-gst_rist_rtx_receive_chain (GstPad * pad, GstObject * parent,
-    GstBuffer * buffer)
+/* Restores the original SSRC of RIST RTX packets and flags them as
+ * retransmissions. Returns NULL if the buffer was dropped. */
+static GstBuffer *
+gst_rist_rtx_receive_process_buffer (GstRistRtxReceive * rtx,
+    GstBuffer * buffer, gboolean * is_rtx)
 {
-  GstRistRtxReceive *rtx = GST_RIST_RTX_RECEIVE (parent);
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   guint32 ssrc = 0;
   guint16 seqnum = 0;
-  gboolean is_rtx;
 
   /* map current rtp packet to parse its header */
   if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp))
@@ -219,21 +223,11 @@ gst_rist_rtx_receive_chain (GstPad * pad, GstObject * parent,
   ssrc = gst_rtp_buffer_get_ssrc (&rtp);
   seqnum = gst_rtp_buffer_get_seq (&rtp);
 
-  /* check if we have a retransmission packet (this information comes from SDP) */
-  GST_OBJECT_LOCK (rtx);
-
   /* RIST sets SSRC LSB to 1 to indicate an RTC packet */
-  is_rtx = ssrc & 0x1;
-  rtx->last_time = GST_BUFFER_PTS (buffer);
-
-  if (is_rtx)
-    /* increase our statistic */
-    ++rtx->num_rtx_packets;
-
-  GST_OBJECT_UNLOCK (rtx);
+  *is_rtx = ssrc & 0x1;
 
   /* create the retransmission packet */
-  if (is_rtx) {
+  if (*is_rtx) {
     GST_DEBUG_OBJECT (rtx,
         "Recovered packet from RIST RTX seqnum:%u ssrc: %u",
         gst_rtp_buffer_get_seq (&rtp), gst_rtp_buffer_get_ssrc (&rtp));
@@ -245,15 +239,88 @@ gst_rist_rtx_receive_chain (GstPad * pad, GstObject * parent,
 
   GST_TRACE_OBJECT (rtx, "pushing packet seqnum:%u from master stream "
       "ssrc: %X", seqnum, ssrc);
-  return gst_pad_push (rtx->srcpad, buffer);
+
+  return buffer;
 
 invalid_buffer:
   {
     GST_ELEMENT_WARNING (rtx, STREAM, DECODE, (NULL),
         ("Received invalid RTP payload, dropping"));
     gst_buffer_unref (buffer);
+    return NULL;
+  }
+}
+
+static GstFlowReturn
+gst_rist_rtx_receive_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer)
+{
+  GstRistRtxReceive *rtx = GST_RIST_RTX_RECEIVE (parent);
+  gboolean is_rtx = FALSE;
+
+  buffer = gst_rist_rtx_receive_process_buffer (rtx, buffer, &is_rtx);
+  if (!buffer)
+    return GST_FLOW_OK;
+
+  GST_OBJECT_LOCK (rtx);
+  rtx->last_time = GST_BUFFER_PTS (buffer);
+
+  if (is_rtx)
+    /* increase our statistic */
+    ++rtx->num_rtx_packets;
+  GST_OBJECT_UNLOCK (rtx);
+
+  return gst_pad_push (rtx->srcpad, buffer);
+}
+
+typedef struct
+{
+  GstRistRtxReceive *rtx;
+  guint num_rtx_packets;
+  GstClockTime last_time;
+} RtxReceiveListData;
+
+static gboolean
+gst_rist_rtx_receive_process_list_item (GstBuffer ** buffer, guint idx,
+    gpointer user_data)
+{
+  RtxReceiveListData *data = user_data;
+  gboolean is_rtx = FALSE;
+
+  *buffer = gst_rist_rtx_receive_process_buffer (data->rtx, *buffer, &is_rtx);
+  if (*buffer) {
+    data->last_time = GST_BUFFER_PTS (*buffer);
+    if (is_rtx)
+      data->num_rtx_packets++;
+  }
+
+  return TRUE;
+}
+
+/* Lists coming from a batched receive are processed in place and pushed
+ * downstream as a list, the statistics being updated once per list. */
+static GstFlowReturn
+gst_rist_rtx_receive_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRistRtxReceive *rtx = GST_RIST_RTX_RECEIVE (parent);
+  RtxReceiveListData data = { rtx, 0, GST_CLOCK_TIME_NONE };
+
+  list = gst_buffer_list_make_writable (list);
+  gst_buffer_list_foreach (list, gst_rist_rtx_receive_process_list_item,
+      &data);
+
+  if (gst_buffer_list_length (list) == 0) {
+    gst_buffer_list_unref (list);
     return GST_FLOW_OK;
   }
+
+  GST_OBJECT_LOCK (rtx);
+  rtx->last_time = data.last_time;
+  rtx->num_rtx_packets += data.num_rtx_packets;
+  GST_OBJECT_UNLOCK (rtx);
+
+  return gst_pad_push_list (rtx->srcpad, list);
 }
 
 static void
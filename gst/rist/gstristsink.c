@@ -51,13 +51,19 @@
  * mapped to its own RTP session. RTX request are only replied to on the
  * link the NACK was received from.
  *
- * There are currently two bonding methods in place: "broadcast" and "round-robin".
- * In "broadcast" mode, all the packets are duplicated over all sessions.
- * While in "round-robin" mode, packets are evenly distributed over the links. One
- * can also implement its own dispatcher element and configure it using the
- * "dispatcher" property. As a reference, "broadcast" mode is implemented with
- * the "tee" element, while "round-robin" mode is implemented with the
- * "round-robin" element.
+ * There are currently three bonding methods in place: "broadcast",
+ * "round-robin" and "weighted". In "broadcast" mode, all the packets are
+ * duplicated over all sessions. While in "round-robin" mode, packets are evenly
+ * distributed over the links. In "weighted" mode, packets are distributed
+ * according to a per link weight, which is adjusted every time a receiver
+ * report is received on that link: the weight of a link is reduced
+ * proportionally to its packet loss and slowly increased again while the link
+ * is loss free, and links with a higher round trip time than the fastest one
+ * get a proportionally smaller share. One can also implement its own
+ * dispatcher element and configure it using the "dispatcher" property. As a
+ * reference, "broadcast" mode is implemented with the "tee" element,
+ * "round-robin" mode is implemented with the "round-robin" element and
+ * "weighted" mode with the "ristdispatcher" element.
  *
  * ## Example gst-launch line for bonding
  * |[
@@ -108,8 +114,19 @@ typedef enum
 {
   GST_RIST_BONDING_METHOD_BROADCAST,
   GST_RIST_BONDING_METHOD_ROUND_ROBIN,
+  GST_RIST_BONDING_METHOD_WEIGHTED,
 } GstRistBondingMethod;
 
+/* Loss ratio above which the weight of a link is reduced */
+#define WEIGHTED_LOSS_THRESHOLD 0.02
+/* Growth factor applied to the weight of a loss-free link on each report,
+ * up to the full share of 1.0 */
+#define WEIGHTED_INCREASE 1.05
+/* Links are never completely disabled, so that they can recover */
+#define WEIGHTED_MIN_WEIGHT 0.01
+/* Lowest share a link can get due to its round trip time alone */
+#define WEIGHTED_MIN_RTT_FACTOR 0.25
+
 static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
@@ -127,6 +144,19 @@ typedef struct
   GstElement *rtx_send;
   GstElement *rtx_queue;
   guint32 rtcp_ssrc;
+
+  /* For the weighted bonding method, protected by bonds_lock */
+  gboolean have_report;
+  guint32 last_exthighestseq;
+  gint32 last_packets_lost;
+  guint64 last_packets_sent;
+  guint64 last_octets_sent;
+  gint64 last_report_time;
+  gdouble capacity;
+  gdouble weight;
+  gdouble link_loss;
+  guint64 link_throughput;
+  GstClockTime link_rtt;
 } RistSenderBond;
 
 struct _GstRistSink
@@ -175,6 +205,8 @@ gst_rist_bonding_method_get_type (void)
         "GST_RIST_BONDING_METHOD_BROADCAST", "broadcast"},
     {GST_RIST_BONDING_METHOD_ROUND_ROBIN,
         "GST_RIST_BONDING_METHOD_ROUND_ROBIN", "round-robin"},
+    {GST_RIST_BONDING_METHOD_WEIGHTED,
+        "GST_RIST_BONDING_METHOD_WEIGHTED", "weighted"},
     {0, NULL, NULL}
   };
 
@@ -200,6 +232,8 @@ gst_rist_sink_add_bond (GstRistSink * sink)
 
   bond->session = sink->bonds->len;
   bond->address = g_strdup ("localhost");
+  bond->capacity = 1.0;
+  bond->weight = 1.0;
 
   g_snprintf (name, 32, "rist_rtp_udpsink%u", bond->session);
   bond->rtp_sink = gst_element_factory_make ("udpsink", name);
@@ -361,6 +395,178 @@ on_receiving_rtcp (GObject * session, GstBuffer * buffer, GstRistSink * sink)
   }
 }
 
+/* called with bonds lock */
+static void
+gst_rist_sink_apply_weights (GstRistSink * sink)
+{
+  GstClockTime min_rtt = GST_CLOCK_TIME_NONE;
+  gdouble max_capacity = 0.0;
+  gint i;
+
+  for (i = 0; i < sink->bonds->len; i++) {
+    RistSenderBond *bond = g_ptr_array_index (sink->bonds, i);
+
+    max_capacity = MAX (max_capacity, bond->capacity);
+    if (bond->link_rtt > 0)
+      min_rtt = MIN (min_rtt, bond->link_rtt);
+  }
+
+  for (i = 0; i < sink->bonds->len; i++) {
+    RistSenderBond *bond = g_ptr_array_index (sink->bonds, i);
+    gdouble rtt_factor = 1.0;
+    GstPad *pad;
+    gchar name[32];
+
+    /* Keep the best link at 1.0 so the weights don't drift */
+    bond->capacity /= max_capacity;
+
+    if (bond->link_rtt > 0 && GST_CLOCK_TIME_IS_VALID (min_rtt))
+      rtt_factor = MAX ((gdouble) min_rtt / bond->link_rtt,
+          WEIGHTED_MIN_RTT_FACTOR);
+
+    bond->weight = bond->capacity * rtt_factor;
+
+    g_snprintf (name, 32, "src_%u", bond->session);
+    pad = gst_element_get_static_pad (sink->dispatcher, name);
+    if (pad) {
+      g_object_set (pad, "weight", bond->weight, NULL);
+      gst_object_unref (pad);
+    }
+  }
+}
+
+/* called with bonds lock */
+static void
+gst_rist_sink_update_bond_weight (GstRistSink * sink, RistSenderBond * bond,
+    GObject * session, guint32 rr_ssrc, guint32 exthighestseq,
+    gint32 packets_lost)
+{
+  GObject *source = NULL;
+  GstStructure *sstats;
+  guint64 packets_sent = 0, octets_sent = 0;
+  gint64 now = g_get_monotonic_time ();
+  guint rb_rtt = 0;
+
+  g_signal_emit_by_name (session, "get-source-by-ssrc", sink->rtp_ssrc,
+      &source);
+  if (!source)
+    return;
+
+  g_object_get (source, "stats", &sstats, NULL);
+  gst_structure_get_uint64 (sstats, "packets-sent", &packets_sent);
+  gst_structure_get_uint64 (sstats, "octets-sent", &octets_sent);
+  gst_structure_free (sstats);
+  g_object_unref (source);
+
+  /* The RTT is computed by the session from the previous report */
+  g_signal_emit_by_name (session, "get-source-by-ssrc", rr_ssrc, &source);
+  if (source) {
+    g_object_get (source, "stats", &sstats, NULL);
+    gst_structure_get_uint (sstats, "rb-round-trip", &rb_rtt);
+    gst_structure_free (sstats);
+    g_object_unref (source);
+
+    /* rb_rtt is in Q16 in NTP time */
+    if (rb_rtt)
+      bond->link_rtt = gst_util_uint64_scale (rb_rtt, GST_SECOND, 65536);
+  }
+
+  if (bond->have_report && packets_sent > bond->last_packets_sent) {
+    guint64 sent = packets_sent - bond->last_packets_sent;
+    guint64 octets = octets_sent - bond->last_octets_sent;
+    gint64 expected = (gint32) (exthighestseq - bond->last_exthighestseq);
+    gint64 received = expected - (packets_lost - bond->last_packets_lost);
+
+    /* Each link only carries part of the sequence numbers, so the loss
+     * reported by the receiver is meaningless. Instead compare how many
+     * packets were received over that link to how many we sent on it. */
+    received = CLAMP (received, 0, sent);
+    bond->link_loss = 1.0 - (gdouble) received / sent;
+
+    if (now > bond->last_report_time)
+      bond->link_throughput = gst_util_uint64_scale (received * octets * 8,
+          G_USEC_PER_SEC, sent * (now - bond->last_report_time));
+
+    if (bond->link_loss > WEIGHTED_LOSS_THRESHOLD)
+      bond->capacity *= 1.0 - bond->link_loss;
+    else
+      bond->capacity = MIN (bond->capacity * WEIGHTED_INCREASE, 1.0);
+    bond->capacity = MAX (bond->capacity, WEIGHTED_MIN_WEIGHT);
+
+    GST_LOG_OBJECT (sink, "Link %u: sent %" G_GUINT64_FORMAT " received %"
+        G_GINT64_FORMAT " loss %f rtt %" GST_TIME_FORMAT " capacity %f",
+        bond->session, sent, received, bond->link_loss,
+        GST_TIME_ARGS (bond->link_rtt), bond->capacity);
+  }
+
+  bond->have_report = TRUE;
+  bond->last_exthighestseq = exthighestseq;
+  bond->last_packets_lost = packets_lost;
+  bond->last_packets_sent = packets_sent;
+  bond->last_octets_sent = octets_sent;
+  bond->last_report_time = now;
+
+  gst_rist_sink_apply_weights (sink);
+}
+
+static void
+on_receiving_rtcp_weighted (GObject * session, GstBuffer * buffer,
+    GstRistSink * sink)
+{
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  RistSenderBond *bond;
+  guint session_id =
+      GPOINTER_TO_UINT (g_object_get_qdata (session, session_id_quark));
+
+  if (!gst_rtcp_buffer_map (buffer, GST_MAP_READ, &rtcp))
+    return;
+
+  g_mutex_lock (&sink->bonds_lock);
+
+  if (session_id >= sink->bonds->len)
+    goto done;
+  bond = g_ptr_array_index (sink->bonds, session_id);
+
+  if (!gst_rtcp_buffer_get_first_packet (&rtcp, &packet))
+    goto done;
+
+  do {
+    guint32 rr_ssrc;
+    guint i, count;
+
+    switch (gst_rtcp_packet_get_type (&packet)) {
+      case GST_RTCP_TYPE_SR:
+        gst_rtcp_packet_sr_get_sender_info (&packet, &rr_ssrc, NULL, NULL,
+            NULL, NULL);
+        break;
+      case GST_RTCP_TYPE_RR:
+        rr_ssrc = gst_rtcp_packet_rr_get_ssrc (&packet);
+        break;
+      default:
+        continue;
+    }
+
+    count = gst_rtcp_packet_get_rb_count (&packet);
+    for (i = 0; i < count; i++) {
+      guint32 ssrc, exthighestseq, jitter, lsr, dlsr;
+      guint8 fractionlost;
+      gint32 packetslost;
+
+      gst_rtcp_packet_get_rb (&packet, i, &ssrc, &fractionlost, &packetslost,
+          &exthighestseq, &jitter, &lsr, &dlsr);
+
+      if (ssrc == sink->rtp_ssrc)
+        gst_rist_sink_update_bond_weight (sink, bond, session, rr_ssrc,
+            exthighestseq, packetslost);
+    }
+  } while (gst_rtcp_packet_move_to_next (&packet));
+
+done:
+  g_mutex_unlock (&sink->bonds_lock);
+  gst_rtcp_buffer_unmap (&rtcp);
+}
+
 static void
 on_app_rtcp (GObject * session, guint32 subtype, guint32 ssrc,
     const gchar * name, GstBuffer * data, GstRistSink * sink)
@@ -433,6 +639,19 @@ on_app_rtcp (GObject * session, guint32 subtype, guint32 ssrc,
   }
 }
 
+/* Sessions see a new sender SSRC for every RTP and RTX stream, only connect
+ * the weighted dispatcher handler the first time */
+static void
+gst_rist_sink_connect_weighted (GstRistSink * sink, GObject * session)
+{
+  if (g_signal_handler_find (session, G_SIGNAL_MATCH_FUNC | G_SIGNAL_MATCH_DATA,
+          0, 0, NULL, on_receiving_rtcp_weighted, sink))
+    return;
+
+  g_signal_connect (session, "on-receiving-rtcp",
+      (GCallback) on_receiving_rtcp_weighted, sink);
+}
+
 static void
 gst_rist_sink_on_new_sender_ssrc (GstRistSink * sink, guint session_id,
     guint ssrc, GstElement * rtpbin)
@@ -441,8 +660,19 @@ gst_rist_sink_on_new_sender_ssrc (GstRistSink * sink, guint session_id,
   GObject *session = NULL;
   GObject *source = NULL;
 
-  if (session_id != 0)
+  if (session_id != 0) {
+    /* The weighted dispatcher needs the receiver reports of every link */
+    if (sink->bonding_method == GST_RIST_BONDING_METHOD_WEIGHTED &&
+        GST_IS_RIST_DISPATCHER (sink->dispatcher) && (ssrc & 1) == 0) {
+      g_signal_emit_by_name (rtpbin, "get-internal-session", session_id,
+          &session);
+      g_object_set_qdata (session, session_id_quark,
+          GUINT_TO_POINTER (session_id));
+      gst_rist_sink_connect_weighted (sink, session);
+      g_object_unref (session);
+    }
     return;
+  }
 
   g_signal_emit_by_name (rtpbin, "get-session", session_id, &gstsession);
   g_signal_emit_by_name (rtpbin, "get-internal-session", session_id, &session);
@@ -455,6 +685,9 @@ gst_rist_sink_on_new_sender_ssrc (GstRistSink * sink, guint session_id,
     g_signal_connect (session, "on-app-rtcp", (GCallback) on_app_rtcp, sink);
     g_signal_connect (session, "on-receiving-rtcp",
         (GCallback) on_receiving_rtcp, sink);
+    if (sink->bonding_method == GST_RIST_BONDING_METHOD_WEIGHTED &&
+        GST_IS_RIST_DISPATCHER (sink->dispatcher))
+      gst_rist_sink_connect_weighted (sink, session);
   }
 
   g_object_unref (source);
@@ -729,6 +962,11 @@ gst_rist_sink_start (GstRistSink * sink)
             "rist_dispatcher");
         g_assert (sink->dispatcher);
         break;
+      case GST_RIST_BONDING_METHOD_WEIGHTED:
+        sink->dispatcher = gst_element_factory_make ("ristdispatcher",
+            "rist_dispatcher");
+        g_assert (sink->dispatcher);
+        break;
     }
   }
 
@@ -827,6 +1065,11 @@ gst_rist_sink_create_stats (GstRistSink * sink)
         "sent-retransmitted-packets", G_TYPE_UINT64, rtx_sent,
         "round-trip-time", G_TYPE_UINT64, rtt, NULL);
 
+    if (sink->bonding_method == GST_RIST_BONDING_METHOD_WEIGHTED)
+      gst_structure_set (stats, "weight", G_TYPE_DOUBLE, bond->weight,
+          "link-loss", G_TYPE_DOUBLE, bond->link_loss,
+          "link-throughput", G_TYPE_UINT64, bond->link_throughput, NULL);
+
     g_value_init (&value, GST_TYPE_STRUCTURE);
     g_value_take_boxed (&value, stats);
     g_value_array_append (session_stats, &value);
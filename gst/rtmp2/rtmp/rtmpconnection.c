@@ -37,6 +37,9 @@ GST_DEBUG_CATEGORY_STATIC (gst_rtmp_connection_debug_category);
 
 #define READ_SIZE 8192
 
+/* Maximum number of queued messages coalesced into a single write */
+#define MAX_WRITE_MESSAGES 64
+
 typedef void (*GstRtmpConnectionCallback) (GstRtmpConnection * connection);
 
 struct _GstRtmpConnection
@@ -83,6 +86,7 @@ struct _GstRtmpConnection
   guint64 out_bytes_total;
   guint64 in_bytes_acked;
   guint64 out_bytes_acked;
+  guint64 out_writes;
 };
 
 
@@ -473,65 +477,97 @@ gst_rtmp_connection_input_ready (GInputStream * is, gpointer user_data)
   return G_SOURCE_CONTINUE;
 }
 
-static void
-gst_rtmp_connection_start_write (GstRtmpConnection * self)
+/* Serializes @message into @chunks. Sets @protocol_control if the message
+ * has to be the last one of the write. */
+static gboolean
+gst_rtmp_connection_serialize_message (GstRtmpConnection * self,
+    GstBuffer * message, GstBufferList * chunks, gboolean * protocol_control)
 {
-  GOutputStream *os;
-  GstBuffer *message, *chunks;
   GstRtmpMeta *meta;
   GstRtmpChunkStream *cstream;
 
-  if (self->writing) {
-    return;
-  }
-
-  message = g_async_queue_try_pop (self->output_queue);
-  if (!message) {
-    return;
-  }
-
   meta = gst_buffer_get_rtmp_meta (message);
   if (!meta) {
     GST_ERROR_OBJECT (self, "No RTMP meta on %" GST_PTR_FORMAT, message);
-    goto out;
+    return FALSE;
   }
 
   if (gst_rtmp_message_is_protocol_control (message)) {
     if (!gst_rtmp_connection_prepare_protocol_control (self, message)) {
       GST_ERROR_OBJECT (self,
           "Failed to prepare protocol control %" GST_PTR_FORMAT, message);
-      goto out;
+      return FALSE;
     }
+    *protocol_control = TRUE;
   }
 
   cstream = gst_rtmp_chunk_streams_get (self->output_streams, meta->cstream);
   if (!cstream) {
     GST_ERROR_OBJECT (self, "Failed to get chunk stream for %" GST_PTR_FORMAT,
         message);
-    goto out;
+    return FALSE;
   }
 
-  chunks = gst_rtmp_chunk_stream_serialize_all (cstream, message,
-      self->out_chunk_size);
-  if (!chunks) {
+  if (!gst_rtmp_chunk_stream_serialize_all (cstream, message,
+          self->out_chunk_size, chunks)) {
     GST_ERROR_OBJECT (self, "Failed to serialize %" GST_PTR_FORMAT, message);
-    goto out;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static void
+gst_rtmp_connection_start_write (GstRtmpConnection * self)
+{
+  GOutputStream *os;
+  GstBufferList *chunks;
+  GstBuffer *message;
+  gboolean protocol_control = FALSE;
+  guint n_messages = 0;
+
+  if (self->writing) {
+    return;
+  }
+
+  chunks = gst_buffer_list_new ();
+
+  /* Coalesce everything that is queued into a single vectored write. A
+   * protocol control message ends the write, since its effect, e.g. a new
+   * chunk size, only applies to the messages sent after it. */
+  while (!protocol_control && n_messages < MAX_WRITE_MESSAGES) {
+    message = g_async_queue_try_pop (self->output_queue);
+    if (!message) {
+      break;
+    }
+
+    if (gst_rtmp_connection_serialize_message (self, message, chunks,
+            &protocol_control)) {
+      n_messages++;
+    }
+
+    gst_buffer_unref (message);
   }
 
+  if (n_messages == 0) {
+    gst_buffer_list_unref (chunks);
+    return;
+  }
+
+  GST_TRACE_OBJECT (self, "writing %u messages in %u chunks", n_messages,
+      gst_buffer_list_length (chunks));
+
   self->writing = TRUE;
   if (self->output_handler) {
     self->output_handler (self, self->output_handler_user_data);
   }
 
   os = g_io_stream_get_output_stream (G_IO_STREAM (self->connection));
-  gst_rtmp_output_stream_write_all_buffer_async (os, chunks, G_PRIORITY_DEFAULT,
-      self->cancellable, gst_rtmp_connection_write_buffer_done,
-      g_object_ref (self));
-
-  gst_buffer_unref (chunks);
+  gst_rtmp_output_stream_write_all_buffers_async (os, chunks,
+      G_PRIORITY_DEFAULT, self->cancellable,
+      gst_rtmp_connection_write_buffer_done, g_object_ref (self));
 
-out:
-  gst_buffer_unref (message);
+  gst_buffer_list_unref (chunks);
 }
 
 static void
@@ -561,10 +597,11 @@ gst_rtmp_connection_write_buffer_done (GObject * obj,
 
   self->writing = FALSE;
 
-  res = gst_rtmp_output_stream_write_all_buffer_finish (os, result,
+  res = gst_rtmp_output_stream_write_all_buffers_finish (os, result,
       &bytes_written, &error);
 
   self->out_bytes_total += bytes_written;
+  self->out_writes++;
 
   if (!res) {
     if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
@@ -1240,7 +1277,10 @@ get_stats (GstRtmpConnection * self)
       "in-bytes-total", G_TYPE_UINT64, self ? self->in_bytes_total : 0,
       "out-bytes-total", G_TYPE_UINT64, self ? self->out_bytes_total : 0,
       "in-bytes-acked", G_TYPE_UINT64, self ? self->in_bytes_acked : 0,
-      "out-bytes-acked", G_TYPE_UINT64, self ? self->out_bytes_acked : 0, NULL);
+      "out-bytes-acked", G_TYPE_UINT64, self ? self->out_bytes_acked : 0,
+      "out-writes", G_TYPE_UINT64, self ? self->out_writes : 0,
+      "out-bytes-per-write", G_TYPE_UINT64, (self && self->out_writes) ?
+      self->out_bytes_total / self->out_writes : 0, NULL);
 }
 
 GstStructure *
@@ -30,7 +30,7 @@ static void read_all_bytes_done (GObject * source, GAsyncResult * result,
     gpointer user_data);
 static void write_all_bytes_done (GObject * source, GAsyncResult * result,
     gpointer user_data);
-static void write_all_buffer_done (GObject * source, GAsyncResult * result,
+static void write_all_buffers_done (GObject * source, GAsyncResult * result,
     gpointer user_data);
 
 void
@@ -158,76 +158,148 @@ gst_rtmp_output_stream_write_all_bytes_finish (GOutputStream * stream,
 
 typedef struct
 {
-  GstBuffer *buffer;
-  GstMapInfo map;
-  gboolean mapped;
+  GstBufferList *buffers;
+  GArray *maps;
+  GOutputVector *vectors;
+  gsize n_vectors;
+  guint8 *data;
   gsize bytes_written;
-} WriteAllBufferData;
+} WriteAllBuffersData;
 
-static WriteAllBufferData *
-write_all_buffer_data_new (GstBuffer * buffer)
+static WriteAllBuffersData *
+write_all_buffers_data_new (GstBufferList * buffers)
 {
-  WriteAllBufferData *data = g_slice_new0 (WriteAllBufferData);
-  data->buffer = gst_buffer_ref (buffer);
+  WriteAllBuffersData *data = g_slice_new0 (WriteAllBuffersData);
+  data->buffers = gst_buffer_list_ref (buffers);
+  data->maps = g_array_new (FALSE, FALSE, sizeof (GstMapInfo));
   return data;
 }
 
 static void
-write_all_buffer_data_free (gpointer ptr)
+write_all_buffers_data_unmap (WriteAllBuffersData * data)
 {
-  WriteAllBufferData *data = ptr;
-  if (data->mapped) {
-    gst_buffer_unmap (data->buffer, &data->map);
+  guint i;
+
+  for (i = 0; i < data->maps->len; i++) {
+    GstMapInfo *map = &g_array_index (data->maps, GstMapInfo, i);
+    gst_memory_unmap (map->memory, map);
   }
-  g_clear_pointer (&data->buffer, gst_buffer_unref);
-  g_slice_free (WriteAllBufferData, data);
+
+  g_array_set_size (data->maps, 0);
+}
+
+static void
+write_all_buffers_data_free (gpointer ptr)
+{
+  WriteAllBuffersData *data = ptr;
+  write_all_buffers_data_unmap (data);
+  g_array_unref (data->maps);
+  g_free (data->vectors);
+  g_free (data->data);
+  g_clear_pointer (&data->buffers, gst_buffer_list_unref);
+  g_slice_free (WriteAllBuffersData, data);
 }
 
+/* Writes all buffers of the list with a single vectored write, mapping the
+ * memories individually so that none of them is merged or copied. */
 void
-gst_rtmp_output_stream_write_all_buffer_async (GOutputStream * stream,
-    GstBuffer * buffer, int io_priority, GCancellable * cancellable,
+gst_rtmp_output_stream_write_all_buffers_async (GOutputStream * stream,
+    GstBufferList * buffers, int io_priority, GCancellable * cancellable,
     GAsyncReadyCallback callback, gpointer user_data)
 {
   GTask *task;
-  WriteAllBufferData *data;
+  WriteAllBuffersData *data;
+  guint i, j, n_buffers;
 
   g_return_if_fail (G_IS_OUTPUT_STREAM (stream));
-  g_return_if_fail (GST_IS_BUFFER (buffer));
+  g_return_if_fail (GST_IS_BUFFER_LIST (buffers));
 
   task = g_task_new (stream, cancellable, callback, user_data);
 
-  data = write_all_buffer_data_new (buffer);
-  g_task_set_task_data (task, data, write_all_buffer_data_free);
+  data = write_all_buffers_data_new (buffers);
+  g_task_set_task_data (task, data, write_all_buffers_data_free);
 
-  if (!gst_buffer_map (buffer, &data->map, GST_MAP_READ)) {
-    GST_ERROR ("Failed to map %" GST_PTR_FORMAT, buffer);
-    g_task_return_new_error (task, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_READ,
-        "Failed to map buffer for reading");
-    g_object_unref (task);
-    return;
+  n_buffers = gst_buffer_list_length (buffers);
+  for (i = 0; i < n_buffers; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (buffers, i);
+    guint n_memory = gst_buffer_n_memory (buffer);
+
+    for (j = 0; j < n_memory; j++) {
+      GstMemory *mem = gst_buffer_peek_memory (buffer, j);
+      GstMapInfo map;
+
+      if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+        GST_ERROR ("Failed to map memory of %" GST_PTR_FORMAT, buffer);
+        g_task_return_new_error (task, GST_RESOURCE_ERROR,
+            GST_RESOURCE_ERROR_READ, "Failed to map buffer for reading");
+        g_object_unref (task);
+        return;
+      }
+
+      if (map.size == 0) {
+        gst_memory_unmap (mem, &map);
+        continue;
+      }
+
+      g_array_append_val (data->maps, map);
+    }
+  }
+
+#if GLIB_CHECK_VERSION(2,60,0)
+  data->n_vectors = data->maps->len;
+  data->vectors = g_new (GOutputVector, data->n_vectors);
+
+  for (i = 0; i < data->n_vectors; i++) {
+    GstMapInfo *map = &g_array_index (data->maps, GstMapInfo, i);
+    data->vectors[i].buffer = map->data;
+    data->vectors[i].size = map->size;
   }
 
-  data->mapped = TRUE;
+  g_output_stream_writev_all_async (stream, data->vectors, data->n_vectors,
+      io_priority, cancellable, write_all_buffers_done, task);
+#else
+  {
+    gsize size = 0;
+
+    for (i = 0; i < data->maps->len; i++)
+      size += g_array_index (data->maps, GstMapInfo, i).size;
+
+    data->data = g_malloc (size);
+    size = 0;
+
+    for (i = 0; i < data->maps->len; i++) {
+      GstMapInfo *map = &g_array_index (data->maps, GstMapInfo, i);
+      memcpy (data->data + size, map->data, map->size);
+      size += map->size;
+    }
+
+    write_all_buffers_data_unmap (data);
 
-  g_output_stream_write_all_async (stream, data->map.data, data->map.size,
-      io_priority, cancellable, write_all_buffer_done, task);
+    g_output_stream_write_all_async (stream, data->data, size, io_priority,
+        cancellable, write_all_buffers_done, task);
+  }
+#endif
 }
 
 static void
-write_all_buffer_done (GObject * source, GAsyncResult * result,
+write_all_buffers_done (GObject * source, GAsyncResult * result,
     gpointer user_data)
 {
   GOutputStream *os = G_OUTPUT_STREAM (source);
   GTask *task = user_data;
-  WriteAllBufferData *data = g_task_get_task_data (task);
+  WriteAllBuffersData *data = g_task_get_task_data (task);
   GError *error = NULL;
   gboolean res;
 
+#if GLIB_CHECK_VERSION(2,60,0)
+  res = g_output_stream_writev_all_finish (os, result, &data->bytes_written,
+      &error);
+#else
   res = g_output_stream_write_all_finish (os, result, &data->bytes_written,
       &error);
+#endif
 
-  gst_buffer_unmap (data->buffer, &data->map);
-  data->mapped = FALSE;
+  write_all_buffers_data_unmap (data);
 
   if (!res) {
     g_task_return_error (task, error);
@@ -239,12 +311,11 @@ write_all_buffer_done (GObject * source, GAsyncResult * result,
   g_object_unref (task);
 }
 
-
 gboolean
-gst_rtmp_output_stream_write_all_buffer_finish (GOutputStream * stream,
+gst_rtmp_output_stream_write_all_buffers_finish (GOutputStream * stream,
     GAsyncResult * result, gsize * bytes_written, GError ** error)
 {
-  WriteAllBufferData *data;
+  WriteAllBuffersData *data;
   GTask *task;
 
   g_return_val_if_fail (g_task_is_valid (result, stream), FALSE);
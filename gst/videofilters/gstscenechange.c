@@ -33,6 +33,19 @@
  *
  * The scenechange element does not work with compressed video.
  *
+ * The picture difference can be computed on a subsampled picture with
+ * #GstSceneChange:subsample, trading detection accuracy for throughput,
+ * and split across several threads with #GstSceneChange:n-threads.  When
+ * #GstSceneChange:post-messages is enabled, an element message named
+ * "GstSceneChange" is posted for every frame with the following fields:
+ *
+ * * "timestamp" (G_TYPE_UINT64): the timestamp of the frame
+ * * "score" (G_TYPE_DOUBLE): the mean absolute luma difference to the
+ *   previous frame
+ * * "threshold" (G_TYPE_DOUBLE): the adaptive threshold the score was
+ *   compared against
+ * * "scene-change" (G_TYPE_BOOLEAN): whether a scene change was detected
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 -v filesrc location=some_file.ogv ! decodebin !
@@ -82,6 +95,7 @@
 #include <gst/video/gstvideofilter.h>
 #include <string.h>
 #include "gstscenechange.h"
+#include "gstvideofiltersbadorc.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_scene_change_debug_category);
 #define GST_CAT_DEFAULT gst_scene_change_debug_category
@@ -89,6 +103,12 @@ GST_DEBUG_CATEGORY_STATIC (gst_scene_change_debug_category);
 /* prototypes */
 
 
+static void gst_scene_change_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec);
+static void gst_scene_change_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec);
+static void gst_scene_change_finalize (GObject * object);
+static gboolean gst_scene_change_stop (GstBaseTransform * trans);
 static GstFlowReturn gst_scene_change_transform_frame_ip (GstVideoFilter *
     filter, GstVideoFrame * frame);
 
@@ -99,9 +119,16 @@ static gboolean is_shot_change (int frame_number);
 
 enum
 {
-  PROP_0
+  PROP_0,
+  PROP_SUBSAMPLE,
+  PROP_N_THREADS,
+  PROP_POST_MESSAGES
 };
 
+#define DEFAULT_SUBSAMPLE 1
+#define DEFAULT_N_THREADS 1
+#define DEFAULT_POST_MESSAGES FALSE
+
 #define VIDEO_CAPS \
     GST_VIDEO_CAPS_MAKE("{ I420, Y42B, Y41B, Y444 }")
 
@@ -115,8 +142,54 @@ G_DEFINE_TYPE_WITH_CODE (GstSceneChange, gst_scene_change,
 static void
 gst_scene_change_class_init (GstSceneChangeClass * klass)
 {
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBaseTransformClass *base_transform_class =
+      GST_BASE_TRANSFORM_CLASS (klass);
   GstVideoFilterClass *video_filter_class = GST_VIDEO_FILTER_CLASS (klass);
 
+  gobject_class->set_property = gst_scene_change_set_property;
+  gobject_class->get_property = gst_scene_change_get_property;
+  gobject_class->finalize = gst_scene_change_finalize;
+
+  /**
+   * GstSceneChange:subsample:
+   *
+   * Only compare every n-th pixel of every n-th row of the luma plane,
+   * e.g. 2 scores on a quarter and 4 on a sixteenth of the picture.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_SUBSAMPLE,
+      g_param_spec_uint ("subsample", "Subsample",
+          "Compute the picture difference on every n-th pixel and row", 1, 16,
+          DEFAULT_SUBSAMPLE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstSceneChange:n-threads:
+   *
+   * Number of threads to compute the picture difference with, 0 uses as
+   * many threads as there are processors.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads to use (0 = number of processors)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstSceneChange:post-messages:
+   *
+   * Post an element message with the score and threshold of every frame.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_POST_MESSAGES,
+      g_param_spec_boolean ("post-messages", "Post messages",
+          "Post an element message with the score of every frame",
+          DEFAULT_POST_MESSAGES, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
       gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
           gst_caps_from_string (VIDEO_CAPS)));
@@ -129,6 +202,7 @@ gst_scene_change_class_init (GstSceneChangeClass * klass)
       "Video/Filter", "Detects scene changes in video",
       "David Schleef <ds@entropywave.com>");
 
+  base_transform_class->stop = GST_DEBUG_FUNCPTR (gst_scene_change_stop);
   video_filter_class->transform_frame_ip =
       GST_DEBUG_FUNCPTR (gst_scene_change_transform_frame_ip);
 
@@ -137,31 +211,179 @@ gst_scene_change_class_init (GstSceneChangeClass * klass)
 static void
 gst_scene_change_init (GstSceneChange * scenechange)
 {
+  scenechange->subsample = DEFAULT_SUBSAMPLE;
+  scenechange->n_threads = DEFAULT_N_THREADS;
+  scenechange->post_messages = DEFAULT_POST_MESSAGES;
+}
+
+static void
+gst_scene_change_set_property (GObject * object, guint property_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstSceneChange *scenechange = GST_SCENE_CHANGE (object);
+
+  GST_OBJECT_LOCK (scenechange);
+  switch (property_id) {
+    case PROP_SUBSAMPLE:
+      scenechange->subsample = g_value_get_uint (value);
+      break;
+    case PROP_N_THREADS:
+      scenechange->n_threads = g_value_get_uint (value);
+      break;
+    case PROP_POST_MESSAGES:
+      scenechange->post_messages = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (scenechange);
+}
+
+static void
+gst_scene_change_get_property (GObject * object, guint property_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstSceneChange *scenechange = GST_SCENE_CHANGE (object);
+
+  GST_OBJECT_LOCK (scenechange);
+  switch (property_id) {
+    case PROP_SUBSAMPLE:
+      g_value_set_uint (value, scenechange->subsample);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, scenechange->n_threads);
+      break;
+    case PROP_POST_MESSAGES:
+      g_value_set_boolean (value, scenechange->post_messages);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (scenechange);
+}
+
+static void
+gst_scene_change_finalize (GObject * object)
+{
+  GstSceneChange *scenechange = GST_SCENE_CHANGE (object);
+
+  gst_slice_runner_free (scenechange->runner);
+  gst_buffer_replace (&scenechange->oldbuf, NULL);
+
+  G_OBJECT_CLASS (gst_scene_change_parent_class)->finalize (object);
 }
 
+static gboolean
+gst_scene_change_stop (GstBaseTransform * trans)
+{
+  GstSceneChange *scenechange = GST_SCENE_CHANGE (trans);
+
+  gst_buffer_replace (&scenechange->oldbuf, NULL);
+
+  gst_slice_runner_free (scenechange->runner);
+  scenechange->runner = NULL;
+
+  return TRUE;
+}
 
+typedef struct
+{
+  GstSceneChange *scenechange;
+  const guint8 *s1;
+  const guint8 *s2;
+  gint stride1;
+  gint stride2;
+  gint width;
+  gint y_start;
+  gint y_end;
+  guint step;
+  guint64 score;
+} GstSceneChangeSlice;
+
+static guint32
+get_line_sad_subsampled (const guint8 * s1, const guint8 * s2, gint width,
+    guint step)
+{
+  guint32 sad = 0;
+  gint i;
+
+  for (i = 0; i < width; i += step)
+    sad += ABS ((gint) s1[i] - (gint) s2[i]);
+
+  return sad;
+}
+
+static void
+get_slice_score (GstSceneChangeSlice * slice)
+{
+  guint64 score = 0;
+  gint j;
+
+  for (j = slice->y_start; j < slice->y_end; j += slice->step) {
+    const guint8 *s1 = slice->s1 + (gsize) slice->stride1 * j;
+    const guint8 *s2 = slice->s2 + (gsize) slice->stride2 * j;
+
+    if (slice->step == 1) {
+      guint32 sad;
+
+      videofilters_orc_sad_u8 (&sad, s1, s2, slice->width);
+      score += sad;
+    } else {
+      score += get_line_sad_subsampled (s1, s2, slice->width, slice->step);
+    }
+  }
+
+  slice->score = score;
+}
+
+/* Mean absolute difference of the luma planes, sampling every @step rows
+ * and columns */
 static double
-get_frame_score (GstVideoFrame * f1, GstVideoFrame * f2)
+get_frame_score (GstSceneChange * scenechange, GstVideoFrame * f1,
+    GstVideoFrame * f2, guint step, guint n_threads)
 {
-  int i;
-  int j;
-  int score = 0;
-  int width, height;
-  guint8 *s1;
-  guint8 *s2;
+  GstSceneChangeSlice *slices;
+  guint64 score = 0;
+  guint i, n_slices;
+  gint width, height, rows, n_pixels;
 
   width = f1->info.width;
   height = f1->info.height;
 
-  for (j = 0; j < height; j++) {
-    s1 = (guint8 *) f1->data[0] + f1->info.stride[0] * j;
-    s2 = (guint8 *) f2->data[0] + f2->info.stride[0] * j;
-    for (i = 0; i < width; i++) {
-      score += ABS (s1[i] - s2[i]);
-    }
+  rows = (height + step - 1) / step;
+  n_pixels = ((width + step - 1) / step) * rows;
+  if (n_pixels == 0)
+    return 0.0;
+
+  scenechange->runner = gst_slice_runner_update (scenechange->runner,
+      n_threads);
+  n_slices = MIN (gst_slice_runner_get_n_threads (scenechange->runner),
+      (guint) rows);
+  slices = g_newa (GstSceneChangeSlice, n_slices);
+
+  for (i = 0; i < n_slices; i++) {
+    slices[i].scenechange = scenechange;
+    slices[i].s1 = f1->data[0];
+    slices[i].s2 = f2->data[0];
+    slices[i].stride1 = f1->info.stride[0];
+    slices[i].stride2 = f2->info.stride[0];
+    slices[i].width = width;
+    /* slices start on a sampled row */
+    slices[i].y_start = rows * i / n_slices * step;
+    slices[i].y_end = MIN (rows * (i + 1) / n_slices * step, height);
+    slices[i].step = step;
+    slices[i].score = 0;
   }
 
-  return ((double) score) / (width * height);
+  gst_slice_runner_run (scenechange->runner, (GstSliceFunc) get_slice_score,
+      slices, sizeof (GstSceneChangeSlice), n_slices);
+
+  for (i = 0; i < n_slices; i++)
+    score += slices[i].score;
+
+  return ((double) score) / n_pixels;
 }
 
 static GstFlowReturn
@@ -175,6 +397,8 @@ gst_scene_change_transform_frame_ip (GstVideoFilter * filter,
   double threshold;
   double score;
   gboolean change;
+  gboolean post_messages;
+  guint subsample, n_threads;
   gboolean ret;
   int i;
 
@@ -196,7 +420,14 @@ gst_scene_change_transform_frame_ip (GstVideoFilter * filter,
     return GST_FLOW_ERROR;
   }
 
-  score = get_frame_score (&oldframe, frame);
+  GST_OBJECT_LOCK (scenechange);
+  subsample = scenechange->subsample;
+  n_threads = scenechange->n_threads;
+  post_messages = scenechange->post_messages;
+  GST_OBJECT_UNLOCK (scenechange);
+
+  score = get_frame_score (scenechange, &oldframe, frame, subsample,
+      n_threads);
 
   gst_video_frame_unmap (&oldframe);
 
@@ -237,6 +468,18 @@ gst_scene_change_transform_frame_ip (GstVideoFilter * filter,
     change = FALSE;
   }
 
+  if (post_messages) {
+    GstStructure *s;
+
+    s = gst_structure_new ("GstSceneChange",
+        "timestamp", G_TYPE_UINT64, GST_BUFFER_PTS (frame->buffer),
+        "score", G_TYPE_DOUBLE, score,
+        "threshold", G_TYPE_DOUBLE, threshold,
+        "scene-change", G_TYPE_BOOLEAN, change, NULL);
+    gst_element_post_message (GST_ELEMENT_CAST (scenechange),
+        gst_message_new_element (GST_OBJECT_CAST (scenechange), s));
+  }
+
   if (change == TRUE) {
     memset (scenechange->diffs, 0, sizeof (double) * SC_N_DIFFS);
     scenechange->n_diffs = 0;
@@ -22,6 +22,7 @@
 
 #include <gst/video/video.h>
 #include <gst/video/gstvideofilter.h>
+#include <gst/slicerunner/gstslicerunner.h>
 
 G_BEGIN_DECLS
 
@@ -45,6 +46,14 @@ struct _GstSceneChange
   GstBuffer *oldbuf;
   GstVideoInfo oldinfo;
   int count;
+
+  /* properties */
+  guint subsample;
+  guint n_threads;
+  gboolean post_messages;
+
+  /* row slices */
+  GstSliceRunner *runner;
 };
 
 struct _GstSceneChangeClass
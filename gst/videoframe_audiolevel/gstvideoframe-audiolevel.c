@@ -28,7 +28,15 @@
  *
  * This element acts like a synchronized audio/video "level". It gathers
  * all audio buffers sent between two video frames, and then sends a message
- * that contains the RMS value of all samples for these buffers.
+ * that contains the RMS and peak values of all samples for these buffers.
+ *
+ * The audio buffers are passed through untouched and are analyzed in place,
+ * they are never copied or merged, even when a video frame spans several of
+ * them.
+ *
+ * If #GstVideoFrameAudioLevel:loudness is enabled, the message also contains
+ * the EBU R128 momentary loudness (K-weighted, over the last 400ms) at the
+ * end of the video frame.
  *
  * ## Example launch line
  * |[
@@ -46,6 +54,7 @@
 
 #include "gstvideoframe-audiolevel.h"
 #include <math.h>
+#include <string.h>
 
 #define GST_CAT_DEFAULT gst_videoframe_audiolevel_debug
 #if G_BYTE_ORDER == G_LITTLE_ENDIAN
@@ -55,6 +64,14 @@
 #endif
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 
+#define DEFAULT_LOUDNESS FALSE
+
+enum
+{
+  PROP_0,
+  PROP_LOUDNESS,
+};
+
 static GstStaticPadTemplate audio_sink_template =
 GST_STATIC_PAD_TEMPLATE ("asink",
     GST_PAD_SINK,
@@ -99,6 +116,10 @@ static GstIterator *gst_videoframe_audiolevel_iterate_internal_links (GstPad *
     pad, GstObject * parent);
 
 static void gst_videoframe_audiolevel_finalize (GObject * gobject);
+static void gst_videoframe_audiolevel_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_videoframe_audiolevel_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
 
 static GstStateChangeReturn gst_videoframe_audiolevel_change_state (GstElement *
     element, GstStateChange transition);
@@ -120,6 +141,25 @@ gst_videoframe_audiolevel_class_init (GstVideoFrameAudioLevelClass * klass)
       "Vivia Nikolaidou <vivia@toolsonair.com>");
 
   gobject_class->finalize = gst_videoframe_audiolevel_finalize;
+  gobject_class->set_property = gst_videoframe_audiolevel_set_property;
+  gobject_class->get_property = gst_videoframe_audiolevel_get_property;
+
+  /**
+   * GstVideoFrameAudioLevel:loudness:
+   *
+   * Add the EBU R128 momentary loudness in LUFS to the messages, as
+   * "momentary-loudness". Until the first 100ms of audio were analyzed, and
+   * for digital silence, the value is -G_MAXDOUBLE.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_LOUDNESS,
+      g_param_spec_boolean ("loudness", "Loudness",
+          "Post the EBU R128 momentary loudness along with the levels",
+          DEFAULT_LOUDNESS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
   gstelement_class->change_state = gst_videoframe_audiolevel_change_state;
 
   gst_element_class_add_static_pad_template (gstelement_class,
@@ -195,10 +235,78 @@ gst_videoframe_audiolevel_init (GstVideoFrameAudioLevel * self)
   self->audio_flush_flag = FALSE;
   self->shutdown_flag = FALSE;
 
+  self->loudness = DEFAULT_LOUDNESS;
+
   g_mutex_init (&self->mutex);
   g_cond_init (&self->cond);
 }
 
+static void
+gst_videoframe_audiolevel_reset_loudness (GstVideoFrameAudioLevel * self)
+{
+  gint channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);
+
+  if (self->kstate)
+    memset (self->kstate, 0, 4 * channels * sizeof (gdouble));
+  if (self->KS)
+    memset (self->KS, 0, channels * sizeof (gdouble));
+  self->n_blocks = 0;
+  self->block_index = 0;
+  self->block_fill = 0;
+}
+
+static void
+gst_videoframe_audiolevel_free_channels (GstVideoFrameAudioLevel * self)
+{
+  g_free (self->CS);
+  self->CS = NULL;
+  g_free (self->peak);
+  self->peak = NULL;
+  g_free (self->kstate);
+  self->kstate = NULL;
+  g_free (self->KS);
+  self->KS = NULL;
+  g_free (self->weights);
+  self->weights = NULL;
+}
+
+static void
+gst_videoframe_audiolevel_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoFrameAudioLevel *self = GST_VIDEOFRAME_AUDIOLEVEL (object);
+
+  switch (prop_id) {
+    case PROP_LOUDNESS:
+      g_mutex_lock (&self->mutex);
+      self->loudness = g_value_get_boolean (value);
+      gst_videoframe_audiolevel_reset_loudness (self);
+      g_mutex_unlock (&self->mutex);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_videoframe_audiolevel_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoFrameAudioLevel *self = GST_VIDEOFRAME_AUDIOLEVEL (object);
+
+  switch (prop_id) {
+    case PROP_LOUDNESS:
+      g_mutex_lock (&self->mutex);
+      g_value_set_boolean (value, self->loudness);
+      g_mutex_unlock (&self->mutex);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 static GstStateChangeReturn
 gst_videoframe_audiolevel_change_state (GstElement * element,
     GstStateChange transition)
@@ -236,10 +344,7 @@ gst_videoframe_audiolevel_change_state (GstElement * element,
       gst_adapter_clear (self->adapter);
       g_queue_foreach (&self->vtimeq, (GFunc) g_free, NULL);
       g_queue_clear (&self->vtimeq);
-      if (self->CS) {
-        g_free (self->CS);
-        self->CS = NULL;
-      }
+      gst_videoframe_audiolevel_free_channels (self);
       g_mutex_unlock (&self->mutex);
       break;
     default:
@@ -262,10 +367,7 @@ gst_videoframe_audiolevel_finalize (GObject * object)
   g_queue_clear (&self->vtimeq);
   self->first_time = GST_CLOCK_TIME_NONE;
   self->total_frames = 0;
-  if (self->CS) {
-    g_free (self->CS);
-    self->CS = NULL;
-  }
+  gst_videoframe_audiolevel_free_channels (self);
 
   g_mutex_clear (&self->mutex);
   g_cond_clear (&self->cond);
@@ -273,54 +375,220 @@ gst_videoframe_audiolevel_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
-#define DEFINE_INT_LEVEL_CALCULATOR(TYPE, RESOLUTION)                         \
-static void inline                                                            \
-gst_videoframe_audiolevel_calculate_##TYPE (gpointer data, guint num, guint channels,        \
-                            gdouble *NCS)                                     \
+/* The levels of all channels are accumulated in a single pass over the
+ * interleaved samples instead of one strided pass per channel */
+#define DEFINE_LEVEL_CALCULATOR(TYPE)                                         \
+static void                                                                   \
+gst_videoframe_audiolevel_calculate_##TYPE (GstVideoFrameAudioLevel * self,   \
+    gconstpointer data, guint frames)                                         \
 {                                                                             \
-  TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  gdouble normalizer;                /* divisor to get a [-1.0, 1.0] range */ \
+  const TYPE *in = (const TYPE *) data;                                       \
+  guint channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);                    \
+  gdouble *CS = self->CS;                                                     \
+  gdouble *peak = self->peak;                                                 \
+  guint i, c;                                                                 \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
+  for (i = 0; i < frames; i++) {                                              \
+    for (c = 0; c < channels; c++) {                                          \
+      gdouble v = in[c];                                                      \
+      gdouble a = fabs (v);                                                   \
                                                                               \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    squaresum += square;                                                      \
+      CS[c] += v * v;                                                         \
+      peak[c] = peak[c] > a ? peak[c] : a;                                    \
+    }                                                                         \
+    in += channels;                                                           \
   }                                                                           \
-                                                                              \
-  normalizer = (gdouble) (G_GINT64_CONSTANT(1) << (RESOLUTION * 2));          \
-  *NCS = squaresum / normalizer;                                              \
 }
 
-DEFINE_INT_LEVEL_CALCULATOR (gint32, 31);
-DEFINE_INT_LEVEL_CALCULATOR (gint16, 15);
-DEFINE_INT_LEVEL_CALCULATOR (gint8, 7);
-
-#define DEFINE_FLOAT_LEVEL_CALCULATOR(TYPE)                                   \
-static void inline                                                            \
-gst_videoframe_audiolevel_calculate_##TYPE (gpointer data, guint num, guint channels,        \
-                            gdouble *NCS)                                     \
+/* Runs the samples through the two K-weighting biquads (transposed direct
+ * form II) and accumulates the square of the output, per channel */
+#define DEFINE_LOUDNESS_CALCULATOR(TYPE)                                      \
+static void                                                                   \
+gst_videoframe_audiolevel_calculate_loudness_##TYPE (                         \
+    GstVideoFrameAudioLevel * self, gconstpointer data, guint frames)         \
 {                                                                             \
-  TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
+  const TYPE *in = (const TYPE *) data;                                       \
+  guint channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);                    \
+  gdouble *z0 = self->kstate, *z1 = z0 + channels;                            \
+  gdouble *z2 = z1 + channels, *z3 = z2 + channels;                           \
+  gdouble *KS = self->KS;                                                     \
+  const gdouble scale = 1.0 / self->scale;                                    \
+  const gdouble b00 = self->kb[0][0], b01 = self->kb[0][1];                   \
+  const gdouble b02 = self->kb[0][2], a01 = self->ka[0][1];                   \
+  const gdouble a02 = self->ka[0][2];                                         \
+  const gdouble b10 = self->kb[1][0], b11 = self->kb[1][1];                   \
+  const gdouble b12 = self->kb[1][2], a11 = self->ka[1][1];                   \
+  const gdouble a12 = self->ka[1][2];                                         \
+  guint i, c;                                                                 \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
+  for (i = 0; i < frames; i++) {                                              \
+    for (c = 0; c < channels; c++) {                                          \
+      gdouble x = in[c] * scale;                                              \
+      gdouble y, w;                                                           \
                                                                               \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    squaresum += square;                                                      \
-  }                                                                           \
+      y = b00 * x + z0[c];                                                    \
+      z0[c] = b01 * x - a01 * y + z1[c];                                      \
+      z1[c] = b02 * x - a02 * y;                                              \
+                                                                              \
+      w = b10 * y + z2[c];                                                    \
+      z2[c] = b11 * y - a11 * w + z3[c];                                      \
+      z3[c] = b12 * y - a12 * w;                                              \
                                                                               \
-  *NCS = squaresum;                                                           \
+      KS[c] += w * w;                                                         \
+    }                                                                         \
+    in += channels;                                                           \
+  }                                                                           \
+}
+
+DEFINE_LEVEL_CALCULATOR (gint8);
+DEFINE_LEVEL_CALCULATOR (gint16);
+DEFINE_LEVEL_CALCULATOR (gint32);
+DEFINE_LEVEL_CALCULATOR (gfloat);
+DEFINE_LEVEL_CALCULATOR (gdouble);
+
+DEFINE_LOUDNESS_CALCULATOR (gint8);
+DEFINE_LOUDNESS_CALCULATOR (gint16);
+DEFINE_LOUDNESS_CALCULATOR (gint32);
+DEFINE_LOUDNESS_CALCULATOR (gfloat);
+DEFINE_LOUDNESS_CALCULATOR (gdouble);
+
+/* K-weighting filter of ITU-R BS.1770, the coefficients are derived from
+ * the analog prototypes so that any sample rate is supported */
+static void
+gst_videoframe_audiolevel_setup_kweighting (GstVideoFrameAudioLevel * self,
+    gint rate)
+{
+  gdouble f0, G, Q, K, Vh, Vb, a0;
+
+  /* high shelf pre-filter */
+  f0 = 1681.974450955533;
+  G = 3.999843853973347;
+  Q = 0.7071752369554196;
+  K = tan (G_PI * f0 / rate);
+  Vh = pow (10.0, G / 20.0);
+  Vb = pow (Vh, 0.4996667741545416);
+  a0 = 1.0 + K / Q + K * K;
+  self->kb[0][0] = (Vh + Vb * K / Q + K * K) / a0;
+  self->kb[0][1] = 2.0 * (K * K - Vh) / a0;
+  self->kb[0][2] = (Vh - Vb * K / Q + K * K) / a0;
+  self->ka[0][0] = 1.0;
+  self->ka[0][1] = 2.0 * (K * K - 1.0) / a0;
+  self->ka[0][2] = (1.0 - K / Q + K * K) / a0;
+
+  /* RLB high-pass */
+  f0 = 38.13547087602444;
+  Q = 0.5003270373238773;
+  K = tan (G_PI * f0 / rate);
+  a0 = 1.0 + K / Q + K * K;
+  self->kb[1][0] = 1.0;
+  self->kb[1][1] = -2.0;
+  self->kb[1][2] = 1.0;
+  self->ka[1][0] = 1.0;
+  self->ka[1][1] = 2.0 * (K * K - 1.0) / a0;
+  self->ka[1][2] = (1.0 - K / Q + K * K) / a0;
 }
 
-DEFINE_FLOAT_LEVEL_CALCULATOR (gfloat);
-DEFINE_FLOAT_LEVEL_CALCULATOR (gdouble);
+/* Channel weights of ITU-R BS.1770: the LFE channels are ignored and the
+ * surround channels get +1.5dB */
+static gdouble
+gst_videoframe_audiolevel_channel_weight (GstAudioChannelPosition position)
+{
+  switch (position) {
+    case GST_AUDIO_CHANNEL_POSITION_LFE1:
+    case GST_AUDIO_CHANNEL_POSITION_LFE2:
+      return 0.0;
+    case GST_AUDIO_CHANNEL_POSITION_REAR_LEFT:
+    case GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT:
+    case GST_AUDIO_CHANNEL_POSITION_SIDE_LEFT:
+    case GST_AUDIO_CHANNEL_POSITION_SIDE_RIGHT:
+      return 1.41;
+    default:
+      return 1.0;
+  }
+}
+
+static void
+gst_videoframe_audiolevel_finish_block (GstVideoFrameAudioLevel * self)
+{
+  gint channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);
+  gdouble sum = 0.0;
+  gint c;
+
+  for (c = 0; c < channels; c++) {
+    sum += self->weights[c] * self->KS[c];
+    self->KS[c] = 0.0;
+  }
+
+  self->blocks[self->block_index] = sum / self->block_frames;
+  self->block_index = (self->block_index + 1) % G_N_ELEMENTS (self->blocks);
+  if (self->n_blocks < G_N_ELEMENTS (self->blocks))
+    self->n_blocks++;
+  self->block_fill = 0;
+}
+
+/* Momentary loudness over the last four 100ms blocks, or over the blocks
+ * seen so far at the start of the stream. The loudness of silence is minus
+ * infinity, -G_MAXDOUBLE stands in for it so that the message structure
+ * stays serializable */
+static gdouble
+gst_videoframe_audiolevel_momentary_loudness (GstVideoFrameAudioLevel * self)
+{
+  gdouble sum = 0.0;
+  guint i;
+
+  for (i = 0; i < self->n_blocks; i++)
+    sum += self->blocks[i];
+
+  if (sum <= 0.0)
+    return -G_MAXDOUBLE;
+
+  return -0.691 + 10.0 * log10 (sum / self->n_blocks);
+}
+
+/* Analyzes the buffers of @list in place. The levels are only accumulated if
+ * @levels is TRUE, the loudness filter has to see all samples though */
+static void
+gst_videoframe_audiolevel_analyze (GstVideoFrameAudioLevel * self,
+    GstBufferList * list, gboolean levels)
+{
+  gint bpf = GST_AUDIO_INFO_BPF (&self->ainfo);
+  guint i, n;
+
+  n = gst_buffer_list_length (list);
+  for (i = 0; i < n; i++) {
+    GstBuffer *buf = gst_buffer_list_get (list, i);
+    GstMapInfo map;
+    const guint8 *data;
+    guint frames;
+
+    if (!gst_buffer_map (buf, &map, GST_MAP_READ)) {
+      GST_WARNING_OBJECT (self, "Failed to map buffer");
+      continue;
+    }
+
+    data = map.data;
+    frames = map.size / bpf;
+
+    if (levels) {
+      self->process (self, data, frames);
+      self->n_frames += frames;
+    }
+
+    while (self->loudness && frames > 0) {
+      guint block = MIN (frames, self->block_frames - self->block_fill);
+
+      self->process_loudness (self, data, block);
+      self->block_fill += block;
+      if (self->block_fill == self->block_frames)
+        gst_videoframe_audiolevel_finish_block (self);
+
+      data += block * bpf;
+      frames -= block;
+    }
+
+    gst_buffer_unmap (buf, &map);
+  }
+}
 
 static gboolean
 gst_videoframe_audiolevel_vsink_event (GstPad * pad, GstObject * parent,
@@ -375,6 +643,9 @@ gst_videoframe_audiolevel_asink_event (GstPad * pad, GstObject * parent,
       self->first_time = GST_CLOCK_TIME_NONE;
       self->total_frames = 0;
       gst_adapter_clear (self->adapter);
+      g_mutex_lock (&self->mutex);
+      gst_videoframe_audiolevel_reset_loudness (self);
+      g_mutex_unlock (&self->mutex);
       gst_event_copy_segment (event, &self->asegment);
       if (self->asegment.format != GST_FORMAT_TIME)
         return FALSE;
@@ -391,41 +662,76 @@ gst_videoframe_audiolevel_asink_event (GstPad * pad, GstObject * parent,
       self->first_time = GST_CLOCK_TIME_NONE;
       gst_adapter_clear (self->adapter);
       gst_segment_init (&self->asegment, GST_FORMAT_UNDEFINED);
+      g_mutex_lock (&self->mutex);
+      gst_videoframe_audiolevel_reset_loudness (self);
+      g_mutex_unlock (&self->mutex);
       break;
     case GST_EVENT_CAPS:{
       GstCaps *caps;
-      gint channels;
+      GstAudioInfo info;
+      gint channels, rate, c;
       gst_event_parse_caps (event, &caps);
       GST_DEBUG_OBJECT (self, "Got caps %" GST_PTR_FORMAT, caps);
-      if (!gst_audio_info_from_caps (&self->ainfo, caps))
+      if (!gst_audio_info_from_caps (&info, caps))
         return FALSE;
+      g_mutex_lock (&self->mutex);
+      self->ainfo = info;
       switch (GST_AUDIO_INFO_FORMAT (&self->ainfo)) {
         case GST_AUDIO_FORMAT_S8:
           self->process = gst_videoframe_audiolevel_calculate_gint8;
+          self->process_loudness =
+              gst_videoframe_audiolevel_calculate_loudness_gint8;
+          self->scale = 1 << 7;
           break;
         case GST_AUDIO_FORMAT_S16:
           self->process = gst_videoframe_audiolevel_calculate_gint16;
+          self->process_loudness =
+              gst_videoframe_audiolevel_calculate_loudness_gint16;
+          self->scale = 1 << 15;
           break;
         case GST_AUDIO_FORMAT_S32:
           self->process = gst_videoframe_audiolevel_calculate_gint32;
+          self->process_loudness =
+              gst_videoframe_audiolevel_calculate_loudness_gint32;
+          self->scale = (gdouble) (G_GINT64_CONSTANT (1) << 31);
           break;
         case GST_AUDIO_FORMAT_F32:
           self->process = gst_videoframe_audiolevel_calculate_gfloat;
+          self->process_loudness =
+              gst_videoframe_audiolevel_calculate_loudness_gfloat;
+          self->scale = 1.0;
           break;
         case GST_AUDIO_FORMAT_F64:
           self->process = gst_videoframe_audiolevel_calculate_gdouble;
+          self->process_loudness =
+              gst_videoframe_audiolevel_calculate_loudness_gdouble;
+          self->scale = 1.0;
           break;
         default:
           self->process = NULL;
+          self->process_loudness = NULL;
           break;
       }
       gst_adapter_clear (self->adapter);
       channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);
+      rate = GST_AUDIO_INFO_RATE (&self->ainfo);
       self->first_time = GST_CLOCK_TIME_NONE;
       self->total_frames = 0;
-      if (self->CS)
-        g_free (self->CS);
+      gst_videoframe_audiolevel_free_channels (self);
       self->CS = g_new0 (gdouble, channels);
+      self->peak = g_new0 (gdouble, channels);
+      self->n_frames = 0;
+      self->kstate = g_new0 (gdouble, 4 * channels);
+      self->KS = g_new0 (gdouble, channels);
+      self->weights = g_new (gdouble, channels);
+      for (c = 0; c < channels; c++)
+        self->weights[c] =
+            gst_videoframe_audiolevel_channel_weight (GST_AUDIO_INFO_POSITION
+            (&self->ainfo, c));
+      gst_videoframe_audiolevel_setup_kweighting (self, rate);
+      self->block_frames = MAX (rate / 10, 1);
+      gst_videoframe_audiolevel_reset_loudness (self);
+      g_mutex_unlock (&self->mutex);
       break;
     }
     default:
@@ -435,81 +741,75 @@ gst_videoframe_audiolevel_asink_event (GstPad * pad, GstObject * parent,
   return gst_pad_event_default (pad, parent, event);
 }
 
+/* Analyzes the audio of one video frame, @list may be %NULL if there is
+ * none */
 static GstMessage *
-update_rms_from_buffer (GstVideoFrameAudioLevel * self, GstBuffer * inbuf)
+update_rms_from_buffer_list (GstVideoFrameAudioLevel * self,
+    GstBufferList * list)
 {
-  GstMapInfo map;
-  guint8 *in_data;
-  gsize in_size;
-  gdouble CS;
   guint i;
-  guint num_frames, frames;
-  guint num_int_samples = 0;    /* number of interleaved samples
-                                 * ie. total count for all channels combined */
-  gint channels, rate, bps;
+  guint frames;
+  gint channels, rate;
   GValue v = G_VALUE_INIT;
   GValue va = G_VALUE_INIT;
-  GValueArray *a;
+  GValue vp = G_VALUE_INIT;
+  GValueArray *a, *p;
   GstStructure *s;
   GstMessage *msg;
   GstClockTime duration, running_time;
 
   channels = GST_AUDIO_INFO_CHANNELS (&self->ainfo);
-  bps = GST_AUDIO_INFO_BPS (&self->ainfo);
   rate = GST_AUDIO_INFO_RATE (&self->ainfo);
 
-  gst_buffer_map (inbuf, &map, GST_MAP_READ);
-  in_data = map.data;
-  in_size = map.size;
+  if (list)
+    gst_videoframe_audiolevel_analyze (self, list, TRUE);
 
-  num_int_samples = in_size / bps;
+  frames = self->n_frames;
+  self->n_frames = 0;
 
-  GST_LOG_OBJECT (self, "analyzing %u sample frames at ts %" GST_TIME_FORMAT,
-      num_int_samples, GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (inbuf)));
+  GST_LOG_OBJECT (self, "analyzed %u sample frames", frames);
 
-  g_return_val_if_fail (num_int_samples % channels == 0, NULL);
-
-  num_frames = num_int_samples / channels;
-  frames = num_frames;
   duration = GST_FRAMES_TO_CLOCK_TIME (frames, rate);
-  if (num_frames > 0) {
-    for (i = 0; i < channels; ++i) {
-      self->process (in_data + (bps * i), num_int_samples, channels, &CS);
-      GST_LOG_OBJECT (self,
-          "[%d]: cumulative squares %lf, over %d samples/%d channels",
-          i, CS, num_int_samples, channels);
-      self->CS[i] += CS;
-    }
-    in_data += num_frames * bps;
-
-    self->total_frames += num_frames;
-  }
+  self->total_frames += frames;
   running_time =
       self->first_time + gst_util_uint64_scale (self->total_frames, GST_SECOND,
       rate);
 
   a = g_value_array_new (channels);
+  p = g_value_array_new (channels);
   s = gst_structure_new ("videoframe-audiolevel", "running-time", G_TYPE_UINT64,
       running_time, "duration", G_TYPE_UINT64, duration, NULL);
 
   g_value_init (&v, G_TYPE_DOUBLE);
-  g_value_init (&va, G_TYPE_VALUE_ARRAY);
   for (i = 0; i < channels; i++) {
     gdouble rms;
     if (frames == 0 || self->CS[i] == 0) {
       rms = 0;                  /* empty buffer */
     } else {
-      rms = sqrt (self->CS[i] / frames);
+      rms = sqrt (self->CS[i] / frames) / self->scale;
     }
     self->CS[i] = 0.0;
     g_value_set_double (&v, rms);
     g_value_array_append (a, &v);
+
+    g_value_set_double (&v, self->peak[i] / self->scale);
+    self->peak[i] = 0.0;
+    g_value_array_append (p, &v);
   }
+
+  g_value_init (&va, G_TYPE_VALUE_ARRAY);
   g_value_take_boxed (&va, a);
   gst_structure_take_value (s, "rms", &va);
-  msg = gst_message_new_element (GST_OBJECT (self), s);
 
-  gst_buffer_unmap (inbuf, &map);
+  g_value_init (&vp, G_TYPE_VALUE_ARRAY);
+  g_value_take_boxed (&vp, p);
+  gst_structure_take_value (s, "peak", &vp);
+
+  if (self->loudness)
+    gst_structure_set (s, "momentary-loudness", G_TYPE_DOUBLE,
+        gst_videoframe_audiolevel_momentary_loudness (self), NULL);
+
+  msg = gst_message_new_element (GST_OBJECT (self), s);
 
   return msg;
 }
@@ -544,7 +844,7 @@ gst_videoframe_audiolevel_asink_chain (GstPad * pad, GstObject * parent,
 {
   GstClockTime timestamp, cur_time;
   GstVideoFrameAudioLevel *self = GST_VIDEOFRAME_AUDIOLEVEL (parent);
-  GstBuffer *buf;
+  GstBufferList *list;
   gsize inbuf_size;
   guint64 start_offset, end_offset;
   GstClockTime running_time;
@@ -606,10 +906,13 @@ gst_videoframe_audiolevel_asink_chain (GstPad * pad, GstObject * parent,
     self->total_frames = 0;
     self->first_time = running_time;
     self->next_offset = end_offset;
+    gst_videoframe_audiolevel_reset_loudness (self);
   } else {
     self->next_offset += inbuf_size / bpf;
   }
 
+  /* the adapter only keeps a reference, the audio is analyzed in place from
+   * buffer lists and never merged into a copy */
   gst_adapter_push (self->adapter, gst_buffer_ref (inbuf));
 
   GST_DEBUG_OBJECT (self, "Queue length %i",
@@ -642,15 +945,15 @@ gst_videoframe_audiolevel_asink_chain (GstPad * pad, GstObject * parent,
       } else if (self->vsegment.position == GST_CLOCK_TIME_NONE) {
         /* g_queue_get_length is surely >= 2 at this point
          * so the adapter isn't empty */
-        buf =
-            gst_adapter_take_buffer (self->adapter,
+        list =
+            gst_adapter_take_buffer_list (self->adapter,
             gst_adapter_available (self->adapter));
-        if (buf != NULL) {
+        if (list != NULL) {
           GstMessage *msg;
-          msg = update_rms_from_buffer (self, buf);
+          msg = update_rms_from_buffer_list (self, list);
           g_mutex_unlock (&self->mutex);
           gst_element_post_message (GST_ELEMENT (self), msg);
-          gst_buffer_unref (buf);
+          gst_buffer_list_unref (list);
           g_mutex_lock (&self->mutex);  /* we unlock again later */
         }
         break;
@@ -693,7 +996,16 @@ gst_videoframe_audiolevel_asink_chain (GstPad * pad, GstObject * parent,
         GST_DEBUG_OBJECT (self,
             "Flushed %" G_GSIZE_FORMAT " out of %" G_GSIZE_FORMAT " bytes",
             bytes, available_bytes);
-        gst_adapter_flush (self->adapter, MIN (bytes, available_bytes));
+        if (self->loudness) {
+          /* not part of any video frame, but the loudness filter and window
+           * still need the samples */
+          list = gst_adapter_take_buffer_list (self->adapter,
+              MIN (bytes, available_bytes));
+          gst_videoframe_audiolevel_analyze (self, list, FALSE);
+          gst_buffer_list_unref (list);
+        } else {
+          gst_adapter_flush (self->adapter, MIN (bytes, available_bytes));
+        }
         self->total_frames += num_frames;
         if (available_bytes <= bytes) {
           g_queue_push_head (&self->vtimeq, vt0);
@@ -722,18 +1034,19 @@ gst_videoframe_audiolevel_asink_chain (GstPad * pad, GstObject * parent,
     }
 
     if (bytes > 0) {
-      buf = gst_adapter_take_buffer (self->adapter, bytes);
-      g_assert (buf != NULL);
+      list = gst_adapter_take_buffer_list (self->adapter, bytes);
+      g_assert (list != NULL);
     } else {
-      /* Just an empty buffer */
-      buf = gst_buffer_new ();
+      /* No audio for this frame */
+      list = NULL;
     }
-    msg = update_rms_from_buffer (self, buf);
+    msg = update_rms_from_buffer_list (self, list);
     g_mutex_unlock (&self->mutex);
     gst_element_post_message (GST_ELEMENT (self), msg);
     g_mutex_lock (&self->mutex);
 
-    gst_buffer_unref (buf);
+    if (list)
+      gst_buffer_list_unref (list);
     g_free (vt0);
     if (available_bytes == bytes)
       break;
@@ -42,11 +42,25 @@ struct _GstVideoFrameAudioLevel
 
   GstAudioInfo ainfo;
 
-  gdouble *CS;                  /* normalized Cumulative Square */
+  gdouble *CS;                  /* Cumulative Square, per channel */
+  gdouble *peak;                /* absolute peak, per channel */
+  gdouble scale;                /* divisor to get a [-1.0, 1.0] range */
+  guint n_frames;               /* sample frames in CS and peak */
+
+  /* EBU R128 momentary loudness */
+  gboolean loudness;
+  gdouble kb[2][3], ka[2][3];   /* K-weighting biquad coefficients */
+  gdouble *kstate;              /* 4 filter states per channel */
+  gdouble *KS;                  /* K-weighted cumulative square */
+  gdouble *weights;             /* channel weights */
+  gdouble blocks[4];            /* mean square of the last 100ms blocks */
+  guint n_blocks, block_index;
+  guint block_frames, block_fill;
 
   GstSegment asegment, vsegment;
 
-  void (*process) (gpointer, guint, guint, gdouble *);
+  void (*process) (GstVideoFrameAudioLevel *, gconstpointer, guint);
+  void (*process_loudness) (GstVideoFrameAudioLevel *, gconstpointer, guint);
 
   GQueue vtimeq;
   GstAdapter *adapter;
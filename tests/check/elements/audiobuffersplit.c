@@ -0,0 +1,263 @@
+/* GStreamer unit tests for the audiobuffersplit element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+#define RATE 48000
+/* the default output-buffer-duration of 1/50 s */
+#define OUTPUT_SAMPLES 960
+
+#define CAPS_STR "audio/x-raw,format=S16LE,rate=48000,channels=1," \
+    "layout=interleaved"
+
+/* Creates a buffer with @n_samples samples starting at sample @offset, every
+ * sample holds its offset in the stream */
+static GstBuffer *
+create_buffer (guint offset, guint n_samples)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, n_samples * 2, NULL);
+  GstMapInfo map;
+  gint16 *samples;
+  guint i;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  samples = (gint16 *) map.data;
+  for (i = 0; i < n_samples; i++)
+    samples[i] = GINT16_TO_LE ((offset + i) & 0x7fff);
+  gst_buffer_unmap (buf, &map);
+
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale (offset, GST_SECOND, RATE);
+  GST_BUFFER_DURATION (buf) =
+      gst_util_uint64_scale (offset + n_samples, GST_SECOND, RATE) -
+      GST_BUFFER_PTS (buf);
+
+  return buf;
+}
+
+/* Pushes @n_inputs buffers of @input_samples each and returns the output
+ * buffers */
+static GList *
+run_split (GstHarness * h, guint input_samples, guint n_inputs)
+{
+  GList *outputs = NULL;
+  GstBuffer *buf;
+  guint i;
+
+  for (i = 0; i < n_inputs; i++)
+    fail_unless_equals_int (gst_harness_push (h,
+            create_buffer (i * input_samples, input_samples)), GST_FLOW_OK);
+
+  while ((buf = gst_harness_try_pull (h)))
+    outputs = g_list_append (outputs, buf);
+
+  return outputs;
+}
+
+/* Checks that the outputs are consecutive, full sized and contain the
+ * samples of the input in order */
+static void
+check_outputs (GList * outputs, guint n_outputs)
+{
+  GList *l;
+  guint offset = 0;
+
+  fail_unless_equals_int (g_list_length (outputs), n_outputs);
+
+  for (l = outputs; l; l = l->next) {
+    GstBuffer *buf = l->data;
+    GstMapInfo map;
+    const gint16 *samples;
+    guint i;
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buf),
+        gst_util_uint64_scale (offset, GST_SECOND, RATE));
+    fail_unless_equals_uint64 (GST_BUFFER_DURATION (buf),
+        gst_util_uint64_scale (offset + OUTPUT_SAMPLES, GST_SECOND, RATE) -
+        GST_BUFFER_PTS (buf));
+    fail_unless_equals_int (GST_BUFFER_FLAG_IS_SET (buf,
+            GST_BUFFER_FLAG_DISCONT), offset == 0);
+
+    fail_unless (gst_buffer_map (buf, &map, GST_MAP_READ));
+    fail_unless_equals_int (map.size, OUTPUT_SAMPLES * 2);
+    samples = (const gint16 *) map.data;
+    for (i = 0; i < OUTPUT_SAMPLES; i++)
+      fail_unless_equals_int (GINT16_FROM_LE (samples[i]),
+          (offset + i) & 0x7fff);
+    gst_buffer_unmap (buf, &map);
+
+    offset += OUTPUT_SAMPLES;
+  }
+}
+
+GST_START_TEST (test_zero_copy)
+{
+  GstHarness *h;
+  GList *outputs, *l;
+  guint n_spanning = 0;
+
+  /* 700 sample inputs, so that most outputs span two of them */
+  h = gst_harness_new_parse ("audiobuffersplit zero-copy=false");
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+  outputs = run_split (h, 700, 12);
+  check_outputs (outputs, 700 * 12 / OUTPUT_SAMPLES);
+  for (l = outputs; l; l = l->next)
+    fail_unless_equals_int (gst_buffer_n_memory (l->data), 1);
+  g_list_free_full (outputs, (GDestroyNotify) gst_buffer_unref);
+  gst_harness_teardown (h);
+
+  /* the outputs reference the memories of the inputs instead */
+  h = gst_harness_new_parse ("audiobuffersplit zero-copy=true");
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+  outputs = run_split (h, 700, 12);
+  check_outputs (outputs, 700 * 12 / OUTPUT_SAMPLES);
+  for (l = outputs; l; l = l->next) {
+    if (gst_buffer_n_memory (l->data) > 1)
+      n_spanning++;
+  }
+  fail_unless (n_spanning > 0);
+  g_list_free_full (outputs, (GDestroyNotify) gst_buffer_unref);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+typedef struct
+{
+  guint n_lists;
+  guint n_list_buffers;
+  guint n_single_buffers;
+  /* the list buffers the default chain_list still has to chain */
+  guint pending;
+} PushCounts;
+
+static GstPadProbeReturn
+count_pushes (GstPad * pad, GstPadProbeInfo * info, PushCounts * counts)
+{
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    guint len = gst_buffer_list_length (GST_PAD_PROBE_INFO_BUFFER_LIST (info));
+
+    counts->n_lists++;
+    counts->n_list_buffers += len;
+    counts->pending = len;
+  } else if (counts->pending > 0) {
+    counts->pending--;
+  } else {
+    counts->n_single_buffers++;
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (test_output_buffer_list)
+{
+  PushCounts counts = { 0, };
+  GstHarness *h;
+  GList *outputs;
+  GstBuffer *buf;
+  guint i;
+
+  h = gst_harness_new_parse ("audiobuffersplit output-buffer-list=true");
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+  gst_pad_add_probe (h->sinkpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) count_pushes, &counts, NULL);
+
+  /* through the adapter, each input completes one or two outputs */
+  outputs = run_split (h, 1440, 4);
+  check_outputs (outputs, 6);
+  g_list_free_full (outputs, (GDestroyNotify) gst_buffer_unref);
+  fail_unless_equals_int (counts.n_lists, 4);
+  fail_unless_equals_int (counts.n_list_buffers, 6);
+  fail_unless_equals_int (counts.n_single_buffers, 0);
+
+  /* directly split inputs, including one that is a single output */
+  memset (&counts, 0, sizeof (counts));
+  fail_unless_equals_int (gst_harness_push (h,
+          create_buffer (5760, 4 * OUTPUT_SAMPLES)), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_push (h,
+          create_buffer (5760 + 4 * OUTPUT_SAMPLES, OUTPUT_SAMPLES)),
+      GST_FLOW_OK);
+  for (i = 0; i < 5; i++) {
+    buf = gst_harness_pull (h);
+    fail_unless_equals_int (gst_buffer_get_size (buf), OUTPUT_SAMPLES * 2);
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buf),
+        gst_util_uint64_scale (5760 + i * OUTPUT_SAMPLES, GST_SECOND, RATE));
+    gst_buffer_unref (buf);
+  }
+  fail_unless_equals_int (counts.n_lists, 2);
+  fail_unless_equals_int (counts.n_list_buffers, 5);
+  fail_unless_equals_int (counts.n_single_buffers, 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_direct_split)
+{
+  GstHarness *h;
+  GList *direct, *adapter, *l, *m;
+
+  /* inputs of two output buffers each take the direct path, inputs of one
+   * and a half output buffers go through the adapter */
+  h = gst_harness_new ("audiobuffersplit");
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+  direct = run_split (h, 2 * OUTPUT_SAMPLES, 6);
+  gst_harness_teardown (h);
+
+  h = gst_harness_new ("audiobuffersplit");
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+  adapter = run_split (h, 3 * OUTPUT_SAMPLES / 2, 8);
+  gst_harness_teardown (h);
+
+  check_outputs (direct, 12);
+  check_outputs (adapter, 12);
+
+  for (l = direct, m = adapter; l && m; l = l->next, m = m->next) {
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (l->data),
+        GST_BUFFER_PTS (m->data));
+    fail_unless_equals_uint64 (GST_BUFFER_DURATION (l->data),
+        GST_BUFFER_DURATION (m->data));
+    fail_unless_equals_int (GST_BUFFER_FLAGS (l->data) &
+        (GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC),
+        GST_BUFFER_FLAGS (m->data) &
+        (GST_BUFFER_FLAG_DISCONT | GST_BUFFER_FLAG_RESYNC));
+  }
+
+  g_list_free_full (direct, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (adapter, (GDestroyNotify) gst_buffer_unref);
+}
+
+GST_END_TEST;
+
+static Suite *
+audiobuffersplit_suite (void)
+{
+  Suite *s = suite_create ("audiobuffersplit");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_zero_copy);
+  tcase_add_test (tc_chain, test_output_buffer_list);
+  tcase_add_test (tc_chain, test_direct_split);
+
+  return s;
+}
+
+GST_CHECK_MAIN (audiobuffersplit);
@@ -0,0 +1,305 @@
+/* GStreamer unit tests for the audiovisualizers elements
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+#include "../../../gst/audiovisualizers/gstdrawhelpers.h"
+
+#define RATE 44100
+#define FPS 30
+/* the audio of one video frame */
+#define SPF (RATE / FPS)
+
+#define AUDIO_CAPS_STR "audio/x-raw,format=S16LE,rate=44100,channels=2," \
+    "channel-mask=(bitmask)0x3,layout=interleaved"
+#define VIDEO_CAPS_STR "video/x-raw,width=64,height=48,framerate=30/1"
+
+/* frames 3n to 3n + 2 share a render period at 10/1 */
+#define RENDER_RATE "10/1"
+#define PERIOD 3
+
+static const gchar *scopes[] = {
+  "spectrascope", "synaescope", "wavescope", "spacescope"
+};
+
+typedef struct
+{
+  GstHarness *h;
+  GRand *rand;
+  /* in samples */
+  guint offset;
+} ScopeTest;
+
+static void
+setup_scope (ScopeTest * t, const gchar * scope, const gchar * render_rate)
+{
+  gchar *launch;
+
+  launch = g_strdup_printf ("%s shader=none render-rate=%s", scope,
+      render_rate);
+  t->h = gst_harness_new_parse (launch);
+  g_free (launch);
+
+  gst_harness_set_src_caps_str (t->h, AUDIO_CAPS_STR);
+  gst_harness_set_sink_caps_str (t->h, VIDEO_CAPS_STR);
+
+  t->rand = g_rand_new_with_seed (42);
+  t->offset = 0;
+}
+
+static void
+teardown_scope (ScopeTest * t)
+{
+  gst_harness_teardown (t->h);
+  g_rand_free (t->rand);
+}
+
+/* Pushes the noise for one more video frame */
+static void
+push_audio (ScopeTest * t)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, SPF * 4, NULL);
+  GstMapInfo map;
+  gint16 *samples;
+  guint i;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  samples = (gint16 *) map.data;
+  for (i = 0; i < SPF * 2; i++)
+    samples[i] = GINT16_TO_LE (g_rand_int_range (t->rand, -16384, 16384));
+  gst_buffer_unmap (buf, &map);
+
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale (t->offset, GST_SECOND, RATE);
+  GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (t->offset + SPF,
+      GST_SECOND, RATE) - GST_BUFFER_PTS (buf);
+  t->offset += SPF;
+
+  fail_unless_equals_int (gst_harness_push (t->h, buf), GST_FLOW_OK);
+}
+
+/* Returns the next video frame, pushing audio until there is one */
+static GstBuffer *
+pull_frame (ScopeTest * t)
+{
+  GstBuffer *buf;
+  guint i;
+
+  for (i = 0; i < 4; i++) {
+    if ((buf = gst_harness_try_pull (t->h)))
+      return buf;
+    push_audio (t);
+  }
+
+  fail ("no video frame");
+  return NULL;
+}
+
+static gboolean
+frames_equal (GstBuffer * a, GstBuffer * b)
+{
+  GstMapInfo map;
+  gboolean equal;
+
+  fail_unless (gst_buffer_map (a, &map, GST_MAP_READ));
+  equal = gst_buffer_get_size (b) == map.size &&
+      gst_buffer_memcmp (b, 0, map.data, map.size) == 0;
+  gst_buffer_unmap (a, &map);
+
+  return equal;
+}
+
+/* Pulls the next frame and checks that it repeats @prev or got rendered,
+ * returns the new frame */
+static GstBuffer *
+check_next_frame (ScopeTest * t, GstBuffer * prev, gboolean repeated,
+    const gchar * scope, guint n)
+{
+  GstBuffer *buf = pull_frame (t);
+
+  if (repeated)
+    fail_unless (frames_equal (prev, buf), "%s frame %u not repeated", scope,
+        n);
+  else
+    fail_if (frames_equal (prev, buf), "%s frame %u not rendered", scope, n);
+  gst_buffer_unref (prev);
+
+  return buf;
+}
+
+GST_START_TEST (test_render_rate)
+{
+  ScopeTest t;
+  GstBuffer *buf;
+  guint i, n;
+
+  for (i = 0; i < G_N_ELEMENTS (scopes); i++) {
+    /* every frame shows different noise */
+    setup_scope (&t, scopes[i], "0/1");
+    buf = pull_frame (&t);
+    for (n = 1; n < 4 * PERIOD; n++)
+      buf = check_next_frame (&t, buf, FALSE, scopes[i], n);
+    gst_buffer_unref (buf);
+    teardown_scope (&t);
+
+    /* unless it is in the render period of the frame before */
+    setup_scope (&t, scopes[i], RENDER_RATE);
+    buf = pull_frame (&t);
+    for (n = 1; n < 4 * PERIOD; n++)
+      buf = check_next_frame (&t, buf, n % PERIOD != 0, scopes[i], n);
+    gst_buffer_unref (buf);
+    teardown_scope (&t);
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_render_rate_restart)
+{
+  ScopeTest t;
+  GstSegment segment;
+  GstBuffer *buf;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (scopes); i++) {
+    setup_scope (&t, scopes[i], RENDER_RATE);
+
+    /* stop after the first frame of a render period, the next one would
+     * repeat it */
+    buf = pull_frame (&t);
+    buf = check_next_frame (&t, buf, TRUE, scopes[i], 1);
+    buf = check_next_frame (&t, buf, TRUE, scopes[i], 2);
+    buf = check_next_frame (&t, buf, FALSE, scopes[i], 3);
+
+    /* setting the property starts a new render period */
+    g_object_set (t.h->element, "render-rate", 10, 1, NULL);
+    buf = check_next_frame (&t, buf, FALSE, scopes[i], 4);
+    buf = check_next_frame (&t, buf, TRUE, scopes[i], 5);
+
+    /* as does a flushing seek back to the start */
+    fail_unless (gst_harness_push_event (t.h, gst_event_new_flush_start ()));
+    fail_unless (gst_harness_push_event (t.h,
+            gst_event_new_flush_stop (TRUE)));
+    gst_segment_init (&segment, GST_FORMAT_TIME);
+    fail_unless (gst_harness_push_event (t.h,
+            gst_event_new_segment (&segment)));
+    t.offset = 0;
+    buf = check_next_frame (&t, buf, FALSE, scopes[i], 6);
+    buf = check_next_frame (&t, buf, TRUE, scopes[i], 7);
+    buf = check_next_frame (&t, buf, TRUE, scopes[i], 8);
+    buf = check_next_frame (&t, buf, FALSE, scopes[i], 9);
+
+    gst_buffer_unref (buf);
+    teardown_scope (&t);
+  }
+}
+
+GST_END_TEST;
+
+#define DRAW_W 61
+#define DRAW_H 40
+
+/* the per byte saturating add spectrascope used before */
+static void
+add_pixel_ref (guint32 * _p, guint32 _c)
+{
+  guint8 *p = (guint8 *) _p;
+  guint8 *c = (guint8 *) & _c;
+  guint i;
+
+  for (i = 0; i < 4; i++) {
+    if (p[i] < 255 - c[i])
+      p[i] += c[i];
+    else
+      p[i] = 255;
+  }
+}
+
+/* the column by column bars spectrascope drew before */
+static void
+draw_bars_ref (guint32 * vdata, const guint * top, guint w, guint h)
+{
+  guint x, l, off;
+
+  for (x = 0; x < w; x++) {
+    off = (top[x] * w) + x;
+    vdata[off] = 0x00FFFFFF;
+    for (l = top[x]; l < h; l++) {
+      off += w;
+      add_pixel_ref (&vdata[off], 0x007F7F7F);
+    }
+  }
+}
+
+GST_START_TEST (test_draw_bars)
+{
+  guint32 *vdata, *ref;
+  guint top[DRAW_W], min_y;
+  guint h = DRAW_H - 1;
+  GRand *rand = g_rand_new_with_seed (42);
+  guint i, x;
+
+  vdata = g_new (guint32, DRAW_W * DRAW_H);
+  ref = g_new (guint32, DRAW_W * DRAW_H);
+
+  for (i = 0; i < 20; i++) {
+    /* random pictures below random bars, including empty and full ones */
+    for (x = 0; x < DRAW_W * DRAW_H; x++)
+      vdata[x] = ref[x] = g_rand_int (rand);
+    min_y = h;
+    for (x = 0; x < DRAW_W; x++) {
+      if (i == 0)
+        top[x] = h;
+      else if (i == 1)
+        top[x] = 0;
+      else
+        top[x] = g_rand_int_range (rand, 0, DRAW_H);
+      min_y = MIN (min_y, top[x]);
+    }
+
+    draw_bars (vdata, top, DRAW_W, min_y, h, DRAW_W, 0x00FFFFFF, 0x007F7F7F);
+    draw_bars_ref (ref, top, DRAW_W, h);
+
+    for (x = 0; x < DRAW_W * DRAW_H; x++)
+      fail_unless (vdata[x] == ref[x],
+          "picture %u differs at %u,%u: 0x%08x instead of 0x%08x", i,
+          x % DRAW_W, x / DRAW_W, vdata[x], ref[x]);
+  }
+
+  g_free (vdata);
+  g_free (ref);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+static Suite *
+audiovisualizers_suite (void)
+{
+  Suite *s = suite_create ("audiovisualizers");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_render_rate);
+  tcase_add_test (tc_chain, test_render_rate_restart);
+  tcase_add_test (tc_chain, test_draw_bars);
+
+  return s;
+}
+
+GST_CHECK_MAIN (audiovisualizers);
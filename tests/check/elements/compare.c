@@ -0,0 +1,210 @@
+/* GStreamer unit tests for the compare element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/app/gstappsrc.h>
+#include <math.h>
+
+#define WIDTH 64
+#define HEIGHT 64
+#define Y_SIZE (WIDTH * HEIGHT)
+#define UV_SIZE (WIDTH / 2 * HEIGHT / 2)
+
+static GstBuffer *
+create_i420_frame (guint i, guint8 y, guint8 u, guint8 v)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, Y_SIZE + 2 * UV_SIZE, NULL);
+
+  gst_buffer_memset (buf, 0, y, Y_SIZE);
+  gst_buffer_memset (buf, Y_SIZE, u, UV_SIZE);
+  gst_buffer_memset (buf, Y_SIZE + UV_SIZE, v, UV_SIZE);
+  GST_BUFFER_PTS (buf) = i * GST_SECOND / 30;
+  GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+
+  return buf;
+}
+
+/* Compares @n_frames frames filled with 128, except for the U plane of the
+ * checked frames listed in @mismatches that is set to 64, and returns the
+ * structures of the messages posted by compare */
+static GList *
+run_compare (const gchar * props, guint n_frames, const guint * mismatches,
+    guint n_mismatches)
+{
+  GstElement *pipeline, *src, *check;
+  GstBus *bus;
+  GstMessage *msg;
+  GList *structures = NULL;
+  gchar *desc;
+  guint i, j;
+
+  desc = g_strdup_printf ("appsrc name=src format=time caps=video/x-raw,"
+      "format=I420,width=%d,height=%d,framerate=30/1 ! compare name=c %s ! "
+      "fakesink appsrc name=check format=time caps=video/x-raw,format=I420,"
+      "width=%d,height=%d,framerate=30/1 ! c.check", WIDTH, HEIGHT, props,
+      WIDTH, HEIGHT);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  check = gst_bin_get_by_name (GST_BIN (pipeline), "check");
+  bus = gst_element_get_bus (pipeline);
+
+  fail_unless_equals_int (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING), GST_STATE_CHANGE_ASYNC);
+
+  for (i = 0; i < n_frames; i++) {
+    guint8 u = 128;
+
+    for (j = 0; j < n_mismatches; j++) {
+      if (mismatches[j] == i)
+        u = 64;
+    }
+
+    fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src),
+            create_i420_frame (i, 128, 128, 128)), GST_FLOW_OK);
+    fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (check),
+            create_i420_frame (i, 128, u, 128)), GST_FLOW_OK);
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (src));
+  gst_app_src_end_of_stream (GST_APP_SRC (check));
+
+  while ((msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+              GST_MESSAGE_ELEMENT | GST_MESSAGE_EOS | GST_MESSAGE_ERROR))) {
+    GstMessageType type = GST_MESSAGE_TYPE (msg);
+
+    fail_if (type == GST_MESSAGE_ERROR);
+    if (type == GST_MESSAGE_ELEMENT &&
+        g_strcmp0 (GST_MESSAGE_SRC_NAME (msg), "c") == 0)
+      structures = g_list_append (structures,
+          gst_structure_copy (gst_message_get_structure (msg)));
+    gst_message_unref (msg);
+
+    if (type == GST_MESSAGE_EOS)
+      break;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (bus);
+  gst_object_unref (check);
+  gst_object_unref (src);
+  gst_object_unref (pipeline);
+
+  return structures;
+}
+
+static void
+check_summary (const GstStructure * s, guint count, guint content)
+{
+  guint value;
+
+  fail_unless (gst_structure_has_name (s, "summary"));
+  fail_unless (gst_structure_get_uint (s, "count", &value));
+  fail_unless_equals_int (value, count);
+  fail_unless (gst_structure_get_uint (s, "content", &value));
+  fail_unless_equals_int (value, content);
+  fail_unless (gst_structure_get_uint (s, "meta", &value));
+  fail_unless_equals_int (value, 0);
+  fail_unless (gst_structure_get_uint (s, "missing", &value));
+  fail_unless_equals_int (value, 0);
+}
+
+GST_START_TEST (test_summary_interval)
+{
+  const guint mismatches[] = { 1, 2, 4 };
+  GList *structures;
+  gdouble mean;
+
+  structures = run_compare ("summary-interval=2", 5, mismatches,
+      G_N_ELEMENTS (mismatches));
+
+  /* no delta message, one summary every 2 buffers and one at EOS */
+  fail_unless_equals_int (g_list_length (structures), 3);
+  check_summary (g_list_nth_data (structures, 0), 2, 1);
+  check_summary (g_list_nth_data (structures, 1), 2, 1);
+  check_summary (g_list_nth_data (structures, 2), 1, 1);
+
+  fail_unless (gst_structure_get_double (g_list_nth_data (structures, 0),
+          "mean", &mean));
+  fail_unless_equals_float (mean, 0.5);
+
+  g_list_free_full (structures, (GDestroyNotify) gst_structure_free);
+}
+
+GST_END_TEST;
+
+static void
+check_components (const GstStructure * s)
+{
+  const GValue *components;
+  gdouble u_ssim;
+
+  fail_unless (gst_structure_has_name (s, "delta"));
+  components = gst_structure_get_value (s, "components");
+  fail_unless (components != NULL);
+  fail_unless_equals_int (gst_value_array_get_size (components), 3);
+
+  /* flat planes only differ by the luminance term of SSIM */
+  u_ssim = (2.0 * 128 * 64 + 6.5025) / (128.0 * 128 + 64 * 64 + 6.5025);
+  fail_unless_equals_float (g_value_get_double (gst_value_array_get_value
+          (components, 0)), 1.0);
+  fail_unless (fabs (g_value_get_double (gst_value_array_get_value
+              (components, 1)) - u_ssim) < 1e-9);
+  fail_unless_equals_float (g_value_get_double (gst_value_array_get_value
+          (components, 2)), 1.0);
+}
+
+GST_START_TEST (test_ssim_components)
+{
+  const guint mismatches[] = { 1 };
+  GList *structures;
+  guint n_threads;
+
+  for (n_threads = 1; n_threads <= 4; n_threads += 3) {
+    gchar *props = g_strdup_printf ("method=ssim upper=false threshold=0.99 "
+        "n-threads=%u", n_threads);
+
+    /* only the buffer with the modified U plane fails */
+    structures = run_compare (props, 3, mismatches,
+        G_N_ELEMENTS (mismatches));
+    fail_unless_equals_int (g_list_length (structures), 1);
+    check_components (structures->data);
+
+    g_list_free_full (structures, (GDestroyNotify) gst_structure_free);
+    g_free (props);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+compare_suite (void)
+{
+  Suite *s = suite_create ("compare");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_summary_interval);
+  tcase_add_test (tc, test_ssim_components);
+
+  return s;
+}
+
+GST_CHECK_MAIN (compare);
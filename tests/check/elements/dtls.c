@@ -31,6 +31,9 @@
 
 #include <gst/check/gstharness.h>
 
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
 GST_START_TEST (test_create_and_unref)
 {
   GstElement *e;
@@ -176,6 +179,207 @@ GST_START_TEST (test_data_transfer)
 
 GST_END_TEST;
 
+static gchar *
+_get_generated_pem (const gchar * key_type, guint rotation)
+{
+  GstElement *e;
+  gchar *pem;
+
+  e = gst_element_factory_make ("dtlsdec", NULL);
+  gst_util_set_object_arg (G_OBJECT (e), "key-type", key_type);
+  g_object_set (e, "certificate-rotation", rotation, NULL);
+  g_object_get (e, "pem", &pem, NULL);
+  gst_object_unref (e);
+
+  fail_unless (pem != NULL);
+  fail_unless (g_str_has_prefix (pem, "-----BEGIN CERTIFICATE-----"));
+
+  return pem;
+}
+
+static int
+_get_pem_key_type (const gchar * pem)
+{
+  BIO *bio;
+  X509 *x509;
+  EVP_PKEY *key;
+  int type;
+
+  bio = BIO_new_mem_buf ((gpointer) pem, -1);
+  fail_unless (bio != NULL);
+  x509 = PEM_read_bio_X509 (bio, NULL, NULL, NULL);
+  fail_unless (x509 != NULL);
+  key = X509_get_pubkey (x509);
+  fail_unless (key != NULL);
+
+  type = EVP_PKEY_base_id (key);
+
+  EVP_PKEY_free (key);
+  X509_free (x509);
+  BIO_free (bio);
+
+  return type;
+}
+
+GST_START_TEST (test_generated_certificate_pool)
+{
+  gchar *rsa, *ecdsa, *ecdsa2, *rotating;
+
+  /* generated certificates are shared per key type */
+  rsa = _get_generated_pem ("rsa", 0);
+  ecdsa = _get_generated_pem ("ecdsa", 0);
+  ecdsa2 = _get_generated_pem ("ecdsa", 0);
+  fail_unless_equals_string (ecdsa, ecdsa2);
+  fail_if (g_strcmp0 (rsa, ecdsa) == 0);
+
+  fail_unless_equals_int (_get_pem_key_type (rsa), EVP_PKEY_RSA);
+  fail_unless_equals_int (_get_pem_key_type (ecdsa), EVP_PKEY_EC);
+
+  /* a certificate younger than the rotation interval is still shared */
+  rotating = _get_generated_pem ("ecdsa", 3600);
+  fail_unless_equals_string (ecdsa, rotating);
+  fail_unless_equals_int (_get_pem_key_type (rotating), EVP_PKEY_EC);
+
+  g_free (rsa);
+  g_free (ecdsa);
+  g_free (ecdsa2);
+  g_free (rotating);
+}
+
+GST_END_TEST;
+
+typedef struct
+{
+  GstPad *pad;
+  GstBufferList *list;
+} PushedRun;
+
+static GstPadProbeReturn
+_record_run_probe (GstPad * pad, GstPadProbeInfo * info, GArray * runs)
+{
+  PushedRun run;
+
+  /* the demuxer only ever pushes lists when it got a list */
+  fail_unless (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST);
+
+  run.pad = pad;
+  run.list = gst_buffer_list_ref (GST_PAD_PROBE_INFO_BUFFER_LIST (info));
+  g_array_append_val (runs, run);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static GstBuffer *
+_make_packet (guint8 first_byte, guint8 index)
+{
+  guint8 data[] = { first_byte, index, 0, 0 };
+
+  return gst_buffer_new_wrapped (g_memdup (data, sizeof (data)),
+      sizeof (data));
+}
+
+static void
+_check_run (GArray * runs, guint run, GstPad * pad, const guint8 * indices,
+    guint n_indices)
+{
+  PushedRun *r;
+  guint i;
+
+  fail_unless (run < runs->len);
+  r = &g_array_index (runs, PushedRun, run);
+  fail_unless (r->pad == pad, "run %u pushed on %s:%s", run,
+      GST_DEBUG_PAD_NAME (r->pad));
+  fail_unless_equals_int (gst_buffer_list_length (r->list), n_indices);
+
+  for (i = 0; i < n_indices; i++) {
+    GstBuffer *buf = gst_buffer_list_get (r->list, i);
+    guint8 index;
+
+    fail_unless_equals_int (gst_buffer_extract (buf, 1, &index, 1), 1);
+    fail_unless_equals_int (index, indices[i]);
+  }
+}
+
+static void
+_check_pulled (GstHarness * h, const guint8 * indices, guint n_indices)
+{
+  guint i;
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), n_indices);
+
+  for (i = 0; i < n_indices; i++) {
+    GstBuffer *buf = gst_harness_pull (h);
+    guint8 index;
+
+    fail_unless_equals_int (gst_buffer_extract (buf, 1, &index, 1), 1);
+    fail_unless_equals_int (index, indices[i]);
+    gst_buffer_unref (buf);
+  }
+}
+
+GST_START_TEST (test_srtp_demux_buffer_list)
+{
+  /* DTLS records start with 20-63, RTP and RTCP packets with 128-191 */
+  static const guint8 packets[] = { 22, 23, 0x80, 0x80, 0x81, 22, 0x80, 0x00,
+    0x80
+  };
+  static const guint8 dtls_run_0[] = { 0, 1 };
+  static const guint8 rtp_run_0[] = { 2, 3, 4 };
+  static const guint8 dtls_run_1[] = { 5 };
+  static const guint8 rtp_run_1[] = { 6, 8 };
+  static const guint8 dtls_all[] = { 0, 1, 5 };
+  static const guint8 rtp_all[] = { 2, 3, 4, 6, 8 };
+  GstHarness *h, *h2;
+  GstBufferList *list;
+  GstPad *rtp_src, *dtls_src;
+  GArray *runs;
+  guint i;
+
+  h = gst_harness_new_with_padnames ("dtlssrtpdemux", "sink", "rtp_src");
+  h2 = gst_harness_new_with_element (h->element, NULL, "dtls_src");
+  gst_harness_set_src_caps_str (h, "application/x-srtp");
+
+  runs = g_array_new (FALSE, FALSE, sizeof (PushedRun));
+  rtp_src = gst_element_get_static_pad (h->element, "rtp_src");
+  dtls_src = gst_element_get_static_pad (h->element, "dtls_src");
+  gst_pad_add_probe (rtp_src, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) _record_run_probe, runs, NULL);
+  gst_pad_add_probe (dtls_src, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) _record_run_probe, runs, NULL);
+
+  /* the packet with an invalid first byte and the empty buffer are dropped
+   * without ending the RTP run they are in */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < G_N_ELEMENTS (packets); i++) {
+    gst_buffer_list_add (list, _make_packet (packets[i], i));
+    if (i == 7)
+      gst_buffer_list_add (list, gst_buffer_new ());
+  }
+  fail_unless_equals_int (gst_harness_push_list (h, list), GST_FLOW_OK);
+
+  /* consecutive packets of one kind are pushed together, in order */
+  fail_unless_equals_int (runs->len, 4);
+  _check_run (runs, 0, dtls_src, dtls_run_0, G_N_ELEMENTS (dtls_run_0));
+  _check_run (runs, 1, rtp_src, rtp_run_0, G_N_ELEMENTS (rtp_run_0));
+  _check_run (runs, 2, dtls_src, dtls_run_1, G_N_ELEMENTS (dtls_run_1));
+  _check_run (runs, 3, rtp_src, rtp_run_1, G_N_ELEMENTS (rtp_run_1));
+
+  _check_pulled (h, rtp_all, G_N_ELEMENTS (rtp_all));
+  _check_pulled (h2, dtls_all, G_N_ELEMENTS (dtls_all));
+
+  for (i = 0; i < runs->len; i++)
+    gst_buffer_list_unref (g_array_index (runs, PushedRun, i).list);
+  g_array_free (runs, TRUE);
+  gst_object_unref (rtp_src);
+  gst_object_unref (dtls_src);
+  gst_harness_teardown (h2);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 dtls_suite (void)
 {
@@ -185,6 +389,8 @@ dtls_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_create_and_unref);
   tcase_add_test (tc_chain, test_data_transfer);
+  tcase_add_test (tc_chain, test_generated_certificate_pool);
+  tcase_add_test (tc_chain, test_srtp_demux_buffer_list);
 
   return s;
 }
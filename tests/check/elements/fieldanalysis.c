@@ -0,0 +1,209 @@
+/* GStreamer unit tests for the fieldanalysis element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+
+#define WIDTH 320
+#define HEIGHT 240
+#define N_FRAMES 10
+
+#define CAPS_STR "video/x-raw,format=I420,width=320,height=240," \
+    "framerate=30/1,interlace-mode=mixed"
+
+#define OUTPUT_FLAGS (GST_VIDEO_BUFFER_FLAG_INTERLACED | \
+    GST_VIDEO_BUFFER_FLAG_TFF | GST_VIDEO_BUFFER_FLAG_RFF | \
+    GST_VIDEO_BUFFER_FLAG_ONEFIELD)
+
+static const gchar *metrics[] = {
+  "frame-metric=5-tap field-metric=sad",
+  "frame-metric=5-tap field-metric=ssd",
+  "frame-metric=5-tap field-metric=3-tap",
+  "frame-metric=windowed-comb comb-method=32-detect",
+  "frame-metric=windowed-comb comb-method=isCombed",
+  "frame-metric=windowed-comb comb-method=5-tap",
+};
+
+/* Vertical bars moving to the right. In the combed frames the odd lines
+ * are half a bar ahead of the even lines, the progressive frames have no
+ * vertical detail at all */
+static GstBuffer *
+create_frame (GstVideoInfo * info, guint i, gboolean combed)
+{
+  GstBuffer *buf;
+  GstVideoFrame frame;
+  guint8 *data;
+  gint x, y, stride;
+
+  buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info), NULL);
+  gst_buffer_memset (buf, 0, 128, GST_VIDEO_INFO_SIZE (info));
+
+  fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+  data = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0);
+  stride = GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0);
+  for (y = 0; y < HEIGHT; y++) {
+    gint shift = combed ? 16 * i + ((y & 1) ? 8 : 0) : 4 * i;
+
+    for (x = 0; x < WIDTH; x++)
+      data[y * stride + x] = (((x + shift) / 16) & 1) ? 235 : 16;
+  }
+  gst_video_frame_unmap (&frame);
+
+  GST_BUFFER_PTS (buf) = i * GST_SECOND / 30;
+  GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+
+  return buf;
+}
+
+/* Returns the output flags of the buffers fieldanalysis pushed for a
+ * stream of N_FRAMES progressive or combed frames */
+static GArray *
+run_fieldanalysis (const gchar * props, gboolean combed)
+{
+  GstHarness *h;
+  GstVideoInfo info;
+  GstBuffer *buf;
+  GArray *flags = g_array_new (FALSE, FALSE, sizeof (guint));
+  gchar *launch;
+  guint i;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, WIDTH, HEIGHT);
+
+  launch = g_strdup_printf ("fieldanalysis %s", props);
+  h = gst_harness_new_parse (launch);
+  g_free (launch);
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+
+  for (i = 0; i < N_FRAMES; i++)
+    fail_unless_equals_int (gst_harness_push (h, create_frame (&info, i,
+                combed)), GST_FLOW_OK);
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  while ((buf = gst_harness_try_pull (h))) {
+    guint f = GST_BUFFER_FLAGS (buf) & OUTPUT_FLAGS;
+
+    g_array_append_val (flags, f);
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+
+  fail_unless_equals_int (flags->len, N_FRAMES);
+
+  return flags;
+}
+
+static void
+check_same_flags (GArray * a, GArray * b, const gchar * props)
+{
+  guint i;
+
+  fail_unless_equals_int (a->len, b->len);
+  for (i = 0; i < a->len; i++)
+    fail_unless (g_array_index (a, guint, i) == g_array_index (b, guint, i),
+        "buffer %u with '%s': flags 0x%x instead of 0x%x", i, props,
+        g_array_index (b, guint, i), g_array_index (a, guint, i));
+}
+
+static void
+check_threads (const gchar * metric, gboolean fast, gboolean combed)
+{
+  gchar *single_props, *threaded_props;
+  GArray *single, *threaded;
+
+  single_props = g_strdup_printf ("%s fast=%d n-threads=1", metric, fast);
+  threaded_props = g_strdup_printf ("%s fast=%d n-threads=4", metric, fast);
+
+  single = run_fieldanalysis (single_props, combed);
+  threaded = run_fieldanalysis (threaded_props, combed);
+  check_same_flags (single, threaded, threaded_props);
+
+  g_array_unref (single);
+  g_array_unref (threaded);
+  g_free (single_props);
+  g_free (threaded_props);
+}
+
+GST_START_TEST (test_threads_match_single_thread)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (metrics); i++) {
+    check_threads (metrics[i], FALSE, FALSE);
+    check_threads (metrics[i], FALSE, TRUE);
+    check_threads (metrics[i], TRUE, FALSE);
+    check_threads (metrics[i], TRUE, TRUE);
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_fast_mode)
+{
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (metrics); i++) {
+    gchar *full_props = g_strdup_printf ("%s fast=false", metrics[i]);
+    gchar *fast_props = g_strdup_printf ("%s fast=true", metrics[i]);
+    GArray *full, *fast;
+
+    /* the progressive stream has no combing anywhere */
+    full = run_fieldanalysis (full_props, FALSE);
+    fast = run_fieldanalysis (fast_props, FALSE);
+    for (j = 0; j < fast->len; j++)
+      fail_if (g_array_index (fast, guint,
+              j) & GST_VIDEO_BUFFER_FLAG_INTERLACED,
+          "progressive buffer %u flagged interlaced with '%s'", j, fast_props);
+    check_same_flags (full, fast, fast_props);
+    g_array_unref (full);
+    g_array_unref (fast);
+
+    /* the combed stream is combed on every line, skipping lines and rows
+     * of blocks must not miss it */
+    full = run_fieldanalysis (full_props, TRUE);
+    fast = run_fieldanalysis (fast_props, TRUE);
+    for (j = 1; j < fast->len; j++)
+      fail_unless (g_array_index (fast, guint,
+              j) & GST_VIDEO_BUFFER_FLAG_INTERLACED,
+          "combed buffer %u not flagged interlaced with '%s'", j, fast_props);
+    check_same_flags (full, fast, fast_props);
+    g_array_unref (full);
+    g_array_unref (fast);
+
+    g_free (full_props);
+    g_free (fast_props);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+fieldanalysis_suite (void)
+{
+  Suite *s = suite_create ("fieldanalysis");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_threads_match_single_thread);
+  tcase_add_test (tc_chain, test_fast_mode);
+
+  return s;
+}
+
+GST_CHECK_MAIN (fieldanalysis);
@@ -0,0 +1,272 @@
+/* GStreamer unit tests for the freeverb element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/audio/audio.h>
+
+#include <math.h>
+#include <string.h>
+
+#define RATE 44100
+#define N_FRAMES (RATE / 2)
+
+#define CAPS_STR "audio/x-raw,format=" GST_AUDIO_NE (F32) ",rate=44100," \
+    "channels=2,layout=interleaved"
+
+#define ROOM_SIZE 0.5f
+#define DAMPING 0.2f
+#define WIDTH 0.8f
+#define LEVEL 0.5f
+
+/* the per sample algorithm of the original Freeverb code, with the tuning
+ * and scaling of the element */
+#define NUM_COMBS 8
+#define NUM_ALLPASSES 4
+#define STEREO_SPREAD 23
+#define FIXED_GAIN 0.015f
+#define DC_OFFSET 1e-8
+
+static const gint comb_tuning[NUM_COMBS] = {
+  1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617
+};
+
+static const gint allpass_tuning[NUM_ALLPASSES] = { 556, 441, 341, 225 };
+
+typedef struct
+{
+  gfloat feedback;
+  gfloat filterstore;
+  gfloat damp1;
+  gfloat damp2;
+  gfloat *buffer;
+  gint bufsize;
+  gint bufidx;
+} RefFilter;
+
+typedef struct
+{
+  RefFilter combs[NUM_COMBS];
+  RefFilter allpasses[NUM_ALLPASSES];
+} RefChannel;
+
+static void
+ref_filter_init (RefFilter * filter, gint size, gfloat feedback, gfloat damp)
+{
+  gint i;
+
+  memset (filter, 0, sizeof (RefFilter));
+  filter->feedback = feedback;
+  filter->damp1 = damp;
+  filter->damp2 = 1 - damp;
+  filter->buffer = g_new (gfloat, size);
+  filter->bufsize = size;
+  for (i = 0; i < size; i++)
+    filter->buffer[i] = (gfloat) DC_OFFSET;
+}
+
+static void
+ref_channel_init (RefChannel * channel, gint spread)
+{
+  gint i;
+
+  for (i = 0; i < NUM_COMBS; i++)
+    ref_filter_init (&channel->combs[i], comb_tuning[i] + spread,
+        ROOM_SIZE * 0.28f + 0.7f, DAMPING);
+  for (i = 0; i < NUM_ALLPASSES; i++)
+    ref_filter_init (&channel->allpasses[i], allpass_tuning[i] + spread, 0.5f,
+        0.0f);
+}
+
+static void
+ref_channel_clear (RefChannel * channel)
+{
+  gint i;
+
+  for (i = 0; i < NUM_COMBS; i++)
+    g_free (channel->combs[i].buffer);
+  for (i = 0; i < NUM_ALLPASSES; i++)
+    g_free (channel->allpasses[i].buffer);
+}
+
+static gfloat
+ref_channel_process (RefChannel * channel, gfloat dry)
+{
+  gfloat input = (dry + DC_OFFSET) * FIXED_GAIN;
+  gfloat output = 0.0f;
+  gint i;
+
+  for (i = 0; i < NUM_COMBS; i++) {
+    RefFilter *comb = &channel->combs[i];
+    gfloat tmp = comb->buffer[comb->bufidx];
+
+    comb->filterstore = (tmp * comb->damp2) + (comb->filterstore * comb->damp1);
+    comb->buffer[comb->bufidx] = input + (comb->filterstore * comb->feedback);
+    if (++comb->bufidx >= comb->bufsize)
+      comb->bufidx = 0;
+    output += tmp;
+  }
+
+  for (i = 0; i < NUM_ALLPASSES; i++) {
+    RefFilter *allpass = &channel->allpasses[i];
+    gfloat bufout = allpass->buffer[allpass->bufidx];
+
+    allpass->buffer[allpass->bufidx] = output + (bufout * allpass->feedback);
+    if (++allpass->bufidx >= allpass->bufsize)
+      allpass->bufidx = 0;
+    output = bufout - output;
+  }
+
+  return output - (gfloat) DC_OFFSET;
+}
+
+static gfloat *
+ref_freeverb (const gfloat * input)
+{
+  const gfloat wet = LEVEL, dry = 1.0f - LEVEL;
+  const gfloat wet1 = wet * (WIDTH / 2.0f + 0.5f);
+  const gfloat wet2 = wet * ((1.0f - WIDTH) / 2.0f);
+  gfloat *output = g_new (gfloat, 2 * N_FRAMES);
+  RefChannel left, right;
+  guint k;
+
+  ref_channel_init (&left, 0);
+  ref_channel_init (&right, STEREO_SPREAD);
+
+  for (k = 0; k < N_FRAMES; k++) {
+    gfloat dry_l = input[2 * k], dry_r = input[2 * k + 1];
+    gfloat wet_l = ref_channel_process (&left, dry_l);
+    gfloat wet_r = ref_channel_process (&right, dry_r);
+
+    output[2 * k] = wet_l * wet1 + wet_r * wet2 + dry_l * dry;
+    output[2 * k + 1] = wet_r * wet1 + wet_l * wet2 + dry_r * dry;
+  }
+
+  ref_channel_clear (&left);
+  ref_channel_clear (&right);
+
+  return output;
+}
+
+/* A short burst of noise followed by silence, so that the output is
+ * dominated by the reverb tail */
+static gfloat *
+create_input (void)
+{
+  gfloat *input = g_new0 (gfloat, 2 * N_FRAMES);
+  GRand *rand = g_rand_new_with_seed (42);
+  guint k;
+
+  for (k = 0; k < RATE / 20; k++) {
+    input[2 * k] = g_rand_double_range (rand, -0.5, 0.5);
+    input[2 * k + 1] = g_rand_double_range (rand, -0.5, 0.5);
+  }
+  g_rand_free (rand);
+
+  return input;
+}
+
+/* Runs @input through freeverb in buffers of varying size, some of them
+ * smaller than a processing block and than the shortest delay line */
+static gfloat *
+run_freeverb (const gfloat * input, guint n_threads)
+{
+  static const guint sizes[] = { 1024, 37, 4410, 1, 512, 63, 2000 };
+  gfloat *output = g_new (gfloat, 2 * N_FRAMES);
+  GstHarness *h;
+  guint offset, i;
+
+  h = gst_harness_new ("freeverb");
+  g_object_set (h->element, "room-size", ROOM_SIZE, "damping", DAMPING,
+      "width", WIDTH, "level", LEVEL, "n-threads", n_threads, NULL);
+  gst_harness_set_caps_str (h, CAPS_STR, CAPS_STR);
+
+  for (offset = 0, i = 0; offset < N_FRAMES; i++) {
+    guint n = MIN (sizes[i % G_N_ELEMENTS (sizes)], N_FRAMES - offset);
+    gsize size = 2 * n * sizeof (gfloat);
+    GstBuffer *buf;
+
+    buf = gst_buffer_new_allocate (NULL, size, NULL);
+    gst_buffer_fill (buf, 0, input + 2 * offset, size);
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+    buf = gst_harness_pull (h);
+    fail_unless_equals_int (gst_buffer_get_size (buf), size);
+    gst_buffer_extract (buf, 0, output + 2 * offset, size);
+    gst_buffer_unref (buf);
+
+    offset += n;
+  }
+
+  gst_harness_teardown (h);
+
+  return output;
+}
+
+GST_START_TEST (test_blocks_match_per_sample)
+{
+  gfloat *input = create_input ();
+  gfloat *expected = ref_freeverb (input);
+  guint n_threads, k;
+
+  for (n_threads = 1; n_threads <= 2; n_threads++) {
+    gfloat *output = run_freeverb (input, n_threads);
+
+    for (k = 0; k < 2 * N_FRAMES; k++)
+      fail_unless (fabs (output[k] - expected[k]) < 1e-5,
+          "sample %u with %u threads: %f instead of %f", k, n_threads,
+          output[k], expected[k]);
+
+    g_free (output);
+  }
+
+  g_free (expected);
+  g_free (input);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_threads_match_single_thread)
+{
+  gfloat *input = create_input ();
+  gfloat *single = run_freeverb (input, 1);
+  gfloat *threaded = run_freeverb (input, 2);
+
+  fail_unless (memcmp (single, threaded, 2 * N_FRAMES * sizeof (gfloat)) == 0);
+
+  g_free (threaded);
+  g_free (single);
+  g_free (input);
+}
+
+GST_END_TEST;
+
+static Suite *
+freeverb_suite (void)
+{
+  Suite *s = suite_create ("freeverb");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_blocks_match_per_sample);
+  tcase_add_test (tc_chain, test_threads_match_single_thread);
+
+  return s;
+}
+
+GST_CHECK_MAIN (freeverb);
@@ -0,0 +1,156 @@
+/* GStreamer unit tests for the geometrictransform elements
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+#define WIDTH 64
+#define HEIGHT 48
+#define N_FRAMES 3
+
+/* GRAY8 with a row stride equal to the width */
+#define CAPS_STR "video/x-raw,format=GRAY8,width=64,height=48,framerate=30/1"
+
+/* A gradient that changes by at most 3 between neighbouring pixels, so
+ * that sampling in between them stays close to the nearest neighbour */
+static GstBuffer *
+create_gradient (void)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, WIDTH * HEIGHT, NULL);
+  GstMapInfo map;
+  gint x, y;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++)
+      map.data[y * WIDTH + x] = 2 * x + y;
+  }
+  gst_buffer_unmap (buf, &map);
+
+  return buf;
+}
+
+/* Runs N_FRAMES gradient frames through @launch and returns the output
+ * frames, concatenated */
+static guint8 *
+run_transform (const gchar * launch)
+{
+  GstHarness *h;
+  guint8 *out = g_malloc (N_FRAMES * WIDTH * HEIGHT);
+  guint i;
+
+  h = gst_harness_new_parse (launch);
+  gst_harness_set_src_caps_str (h, CAPS_STR);
+
+  for (i = 0; i < N_FRAMES; i++) {
+    GstBuffer *buf = create_gradient ();
+
+    GST_BUFFER_PTS (buf) = i * GST_SECOND / 30;
+    GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+    buf = gst_harness_pull (h);
+    fail_unless (buf != NULL);
+    fail_unless_equals_int (gst_buffer_get_size (buf), WIDTH * HEIGHT);
+    gst_buffer_extract (buf, 0, out + i * WIDTH * HEIGHT, WIDTH * HEIGHT);
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+
+  return out;
+}
+
+static void
+check_output_equal (const gchar * reference, const gchar * launch)
+{
+  guint8 *ref = run_transform (reference);
+  guint8 *out = run_transform (launch);
+
+  fail_unless (memcmp (ref, out, N_FRAMES * WIDTH * HEIGHT) == 0,
+      "'%s' differs from '%s'", launch, reference);
+
+  g_free (ref);
+  g_free (out);
+}
+
+static void
+check_output_close (const gchar * reference, const gchar * launch,
+    gint tolerance)
+{
+  guint8 *ref = run_transform (reference);
+  guint8 *out = run_transform (launch);
+  guint i;
+
+  for (i = 0; i < N_FRAMES * WIDTH * HEIGHT; i++)
+    fail_unless (ABS ((gint) ref[i] - (gint) out[i]) <= tolerance,
+        "pixel %u of '%s' is %u instead of %u", i, launch, out[i], ref[i]);
+
+  g_free (ref);
+  g_free (out);
+}
+
+GST_START_TEST (test_rotate_threads)
+{
+  check_output_equal ("rotate angle=0.3 n-threads=1",
+      "rotate angle=0.3 n-threads=4");
+  check_output_equal ("rotate angle=0.3 interpolation=bilinear n-threads=1",
+      "rotate angle=0.3 interpolation=bilinear n-threads=4");
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rotate_bilinear)
+{
+  /* a sample in between two pixels is at most one gradient step away from
+   * the nearest one in each direction */
+  check_output_close ("rotate angle=0.3 n-threads=1",
+      "rotate angle=0.3 interpolation=bilinear n-threads=1", 3);
+  check_output_close ("rotate angle=0.3 off-edge-pixels=clamp n-threads=1",
+      "rotate angle=0.3 off-edge-pixels=clamp interpolation=bilinear "
+      "n-threads=4", 3);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_diffuse_threads)
+{
+  /* the displacements only depend on the pixel and the frame, not on the
+   * thread that computes them */
+  check_output_equal ("diffuse n-threads=1", "diffuse n-threads=4");
+  check_output_close ("diffuse n-threads=1",
+      "diffuse interpolation=bilinear n-threads=4", 3);
+}
+
+GST_END_TEST;
+
+static Suite *
+geometrictransform_suite (void)
+{
+  Suite *s = suite_create ("geometrictransform");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_rotate_threads);
+  tcase_add_test (tc_chain, test_rotate_bilinear);
+  tcase_add_test (tc_chain, test_diffuse_threads);
+
+  return s;
+}
+
+GST_CHECK_MAIN (geometrictransform);
@@ -0,0 +1,167 @@
+/* GStreamer unit tests for the iqa element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/app/gstappsrc.h>
+#include <math.h>
+
+#define WIDTH 64
+#define HEIGHT 48
+
+static GstBuffer *
+create_gray_frame (guint8 value)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, WIDTH * HEIGHT, NULL);
+
+  gst_buffer_memset (buf, 0, value, WIDTH * HEIGHT);
+  GST_BUFFER_PTS (buf) = 0;
+  GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+
+  return buf;
+}
+
+static void
+push_frame (GstElement * pipeline, const gchar * name, guint8 value)
+{
+  GstElement *src = gst_bin_get_by_name (GST_BIN (pipeline), name);
+
+  fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src),
+          create_gray_frame (value)), GST_FLOW_OK);
+  fail_unless_equals_int (gst_app_src_end_of_stream (GST_APP_SRC (src)),
+      GST_FLOW_OK);
+  gst_object_unref (src);
+}
+
+/* Compares a frame filled with @ref_value with one filled with @cmp_value
+ * and returns the IQA structure posted for them */
+static GstStructure *
+compare_gray_frames (guint8 ref_value, guint8 cmp_value, guint n_threads)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+  GstStructure *s = NULL;
+  gchar *desc;
+
+  desc = g_strdup_printf ("appsrc name=ref format=time caps=video/x-raw,"
+      "format=GRAY8,width=%d,height=%d,framerate=30/1 ! iqa name=iqa "
+      "do-psnr=true do-native-ssim=true n-threads=%u ! fakesink "
+      "appsrc name=cmp format=time caps=video/x-raw,format=GRAY8,"
+      "width=%d,height=%d,framerate=30/1 ! iqa.", WIDTH, HEIGHT, n_threads,
+      WIDTH, HEIGHT);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  bus = gst_element_get_bus (pipeline);
+  fail_unless_equals_int (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING), GST_STATE_CHANGE_ASYNC);
+
+  push_frame (pipeline, "ref", ref_value);
+  push_frame (pipeline, "cmp", cmp_value);
+
+  while ((msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+              GST_MESSAGE_ELEMENT | GST_MESSAGE_EOS | GST_MESSAGE_ERROR))) {
+    GstMessageType type = GST_MESSAGE_TYPE (msg);
+
+    fail_if (type == GST_MESSAGE_ERROR);
+    if (type == GST_MESSAGE_ELEMENT && !s &&
+        gst_message_has_name (msg, "IQA"))
+      s = gst_structure_copy (gst_message_get_structure (msg));
+    gst_message_unref (msg);
+
+    if (type == GST_MESSAGE_EOS)
+      break;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (bus);
+  gst_object_unref (pipeline);
+
+  fail_unless (s != NULL);
+
+  return s;
+}
+
+static gdouble
+get_metric (const GstStructure * s, const gchar * metric, const gchar * field)
+{
+  const GstStructure *m;
+  gdouble value;
+
+  m = gst_value_get_structure (gst_structure_get_value (s, metric));
+  fail_unless (m != NULL);
+  fail_unless (gst_structure_get_double (m, field, &value));
+
+  return value;
+}
+
+GST_START_TEST (test_identical_frames)
+{
+  GstStructure *s = compare_gray_frames (100, 100, 1);
+
+  fail_unless (isinf (get_metric (s, "psnr", "sink_1")));
+  fail_unless (isinf (get_metric (s, "psnr", "sink_1-y")));
+  fail_unless_equals_float (get_metric (s, "ssim", "sink_1"), 1.0);
+  fail_unless_equals_float (get_metric (s, "ssim", "sink_1-y"), 1.0);
+
+  gst_structure_free (s);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_known_distortion)
+{
+  GstStructure *s;
+  gdouble psnr, ssim;
+  guint n_threads;
+
+  for (n_threads = 1; n_threads <= 4; n_threads += 3) {
+    s = compare_gray_frames (100, 110, n_threads);
+
+    /* Every sample is off by 10: MSE = 100 */
+    psnr = get_metric (s, "psnr", "sink_1");
+    fail_unless (fabs (psnr - 10.0 * log10 (255.0 * 255.0 / 100.0)) < 1e-6);
+    fail_unless_equals_float (get_metric (s, "psnr", "sink_1-y"), psnr);
+
+    /* Flat pictures only differ by the luminance term of SSIM */
+    ssim = get_metric (s, "ssim", "sink_1");
+    fail_unless (fabs (ssim - (2.0 * 100 * 110 + 6.5025) /
+            (100.0 * 100 + 110.0 * 110 + 6.5025)) < 1e-6);
+
+    gst_structure_free (s);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+iqa_suite (void)
+{
+  Suite *s = suite_create ("iqa");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_identical_frames);
+  tcase_add_test (tc, test_known_distortion);
+
+  return s;
+}
+
+GST_CHECK_MAIN (iqa);
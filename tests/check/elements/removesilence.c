@@ -0,0 +1,179 @@
+/* GStreamer unit tests for the removesilence element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/audio/audio.h>
+
+#include <math.h>
+
+#define RATE 48000
+#define N_FRAMES 1024
+#define N_BUFFERS 4
+
+static GstHarness *
+setup_removesilence (const gchar * props, GstAudioFormat format)
+{
+  GstHarness *h;
+  gchar *launch, *caps;
+
+  launch = g_strdup_printf ("removesilence remove=true %s", props);
+  h = gst_harness_new_parse (launch);
+  g_free (launch);
+
+  caps = g_strdup_printf ("audio/x-raw,format=%s,rate=%d,channels=2,"
+      "layout=interleaved", gst_audio_format_to_string (format), RATE);
+  gst_harness_set_src_caps_str (h, caps);
+  g_free (caps);
+
+  return h;
+}
+
+/* Creates buffer @n of a stereo stream with a 440 Hz sine of @amplitude on
+ * the left channel, and the same sine multiplied by @right_gain on the
+ * right channel */
+static GstBuffer *
+create_buffer (GstAudioFormat format, guint n, gdouble amplitude,
+    gdouble right_gain)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  gsize bpf = 2 * GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8;
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, N_FRAMES * bpf, NULL);
+  GstMapInfo map;
+  guint i;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < N_FRAMES; i++) {
+    gdouble v = amplitude * sin (2 * G_PI * 440 * (n * N_FRAMES + i) / RATE);
+
+    if (format == GST_AUDIO_FORMAT_S16) {
+      ((gint16 *) map.data)[2 * i] = v * G_MAXINT16;
+      ((gint16 *) map.data)[2 * i + 1] = v * right_gain * G_MAXINT16;
+    } else if (format == GST_AUDIO_FORMAT_S32) {
+      ((gint32 *) map.data)[2 * i] = v * G_MAXINT32;
+      ((gint32 *) map.data)[2 * i + 1] = v * right_gain * G_MAXINT32;
+    } else {
+      ((gfloat *) map.data)[2 * i] = v;
+      ((gfloat *) map.data)[2 * i + 1] = v * right_gain;
+    }
+  }
+  gst_buffer_unmap (buf, &map);
+
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale (n * N_FRAMES, GST_SECOND, RATE);
+  GST_BUFFER_DURATION (buf) =
+      gst_util_uint64_scale (N_FRAMES, GST_SECOND, RATE);
+
+  return buf;
+}
+
+/* Pushes N_BUFFERS buffers and returns how many of them came out */
+static guint
+count_passed (GstHarness * h, GstAudioFormat format, gdouble amplitude,
+    gdouble right_gain)
+{
+  guint i;
+
+  for (i = 0; i < N_BUFFERS; i++)
+    fail_unless_equals_int (gst_harness_push (h, create_buffer (format, i,
+                amplitude, right_gain)), GST_FLOW_OK);
+
+  return gst_harness_buffers_received (h);
+}
+
+static void
+check_format (GstAudioFormat format)
+{
+  GstHarness *h;
+
+  /* silence on both channels is removed */
+  h = setup_removesilence ("", format);
+  fail_unless_equals_int (count_passed (h, format, 0.0, 1.0), 0);
+  gst_harness_teardown (h);
+
+  h = setup_removesilence ("channel-mode=independent", format);
+  fail_unless_equals_int (count_passed (h, format, 0.0, 1.0), 0);
+  gst_harness_teardown (h);
+
+  /* and a tone is kept */
+  h = setup_removesilence ("", format);
+  fail_unless_equals_int (count_passed (h, format, 0.5, 1.0), N_BUFFERS);
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_s16_stereo)
+{
+  check_format (GST_AUDIO_FORMAT_S16);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_s32_stereo)
+{
+  check_format (GST_AUDIO_FORMAT_S32);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_f32_stereo)
+{
+  check_format (GST_AUDIO_FORMAT_F32);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_channel_mode)
+{
+  GstHarness *h;
+
+  /* the channels are out of phase and cancel out in the downmix */
+  h = setup_removesilence ("channel-mode=downmix", GST_AUDIO_FORMAT_F32);
+  fail_unless_equals_int (count_passed (h, GST_AUDIO_FORMAT_F32, 0.5, -1.0),
+      0);
+  gst_harness_teardown (h);
+
+  /* each of them on its own is voiced */
+  h = setup_removesilence ("channel-mode=independent", GST_AUDIO_FORMAT_F32);
+  fail_unless_equals_int (count_passed (h, GST_AUDIO_FORMAT_F32, 0.5, -1.0),
+      N_BUFFERS);
+  gst_harness_teardown (h);
+
+  /* as is a single voiced channel next to a silent one */
+  h = setup_removesilence ("channel-mode=independent", GST_AUDIO_FORMAT_S32);
+  fail_unless_equals_int (count_passed (h, GST_AUDIO_FORMAT_S32, 0.5, 0.0),
+      N_BUFFERS);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+removesilence_suite (void)
+{
+  Suite *s = suite_create ("removesilence");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_s16_stereo);
+  tcase_add_test (tc_chain, test_s32_stereo);
+  tcase_add_test (tc_chain, test_f32_stereo);
+  tcase_add_test (tc_chain, test_channel_mode);
+
+  return s;
+}
+
+GST_CHECK_MAIN (removesilence);
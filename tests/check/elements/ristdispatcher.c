@@ -0,0 +1,140 @@
+/* GStreamer unit tests for the RIST weighted dispatcher
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gst/check/check.h>
+
+static void
+set_pad_weight (GstHarness * h, gdouble weight)
+{
+  GstPad *pad = gst_pad_get_peer (h->sinkpad);
+
+  g_object_set (pad, "weight", weight, NULL);
+  gst_object_unref (pad);
+}
+
+static guint64
+get_pad_buffers (GstHarness * h)
+{
+  GstPad *pad = gst_pad_get_peer (h->sinkpad);
+  guint64 buffers;
+
+  g_object_get (pad, "buffers", &buffers, NULL);
+  gst_object_unref (pad);
+
+  return buffers;
+}
+
+static void
+push_buffers (GstHarness * h, guint count)
+{
+  guint i;
+
+  for (i = 0; i < count; i++)
+    fail_unless_equals_int (gst_harness_push (h,
+            gst_buffer_new_allocate (NULL, 100, NULL)), GST_FLOW_OK);
+}
+
+GST_START_TEST (test_equal_weights)
+{
+  GstElement *disp = gst_element_factory_make ("ristdispatcher", NULL);
+  GstHarness *h0 = gst_harness_new_with_element (disp, "sink", "src_0");
+  GstHarness *h1 = gst_harness_new_with_element (disp, NULL, "src_1");
+
+  gst_harness_set_src_caps_str (h0, "application/x-rtp");
+  push_buffers (h0, 10);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h0), 5);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h1), 5);
+
+  gst_harness_teardown (h1);
+  gst_harness_teardown (h0);
+  gst_object_unref (disp);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_weighted)
+{
+  GstElement *disp = gst_element_factory_make ("ristdispatcher", NULL);
+  GstHarness *h0 = gst_harness_new_with_element (disp, "sink", "src_0");
+  GstHarness *h1 = gst_harness_new_with_element (disp, NULL, "src_1");
+  GstHarness *h2 = gst_harness_new_with_element (disp, NULL, "src_2");
+
+  set_pad_weight (h0, 10.0);
+  set_pad_weight (h1, 1.0);
+  set_pad_weight (h2, 0.0);
+
+  gst_harness_set_src_caps_str (h0, "application/x-rtp");
+  push_buffers (h0, 110);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h0), 100);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h1), 10);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h2), 0);
+
+  fail_unless_equals_int (get_pad_buffers (h0), 100);
+  fail_unless_equals_int (get_pad_buffers (h1), 10);
+  fail_unless_equals_int (get_pad_buffers (h2), 0);
+
+  gst_harness_teardown (h2);
+  gst_harness_teardown (h1);
+  gst_harness_teardown (h0);
+  gst_object_unref (disp);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_weighted_spread)
+{
+  GstElement *disp = gst_element_factory_make ("ristdispatcher", NULL);
+  GstHarness *h0 = gst_harness_new_with_element (disp, "sink", "src_0");
+  GstHarness *h1 = gst_harness_new_with_element (disp, NULL, "src_1");
+  guint i;
+
+  set_pad_weight (h0, 3.0);
+  set_pad_weight (h1, 1.0);
+
+  gst_harness_set_src_caps_str (h0, "application/x-rtp");
+
+  /* The lighter link must get its share regularly, not in one burst */
+  for (i = 0; i < 5; i++) {
+    push_buffers (h0, 4);
+    fail_unless_equals_int (gst_harness_buffers_in_queue (h0), 3 * (i + 1));
+    fail_unless_equals_int (gst_harness_buffers_in_queue (h1), i + 1);
+  }
+
+  gst_harness_teardown (h1);
+  gst_harness_teardown (h0);
+  gst_object_unref (disp);
+}
+
+GST_END_TEST;
+
+static Suite *
+ristdispatcher_suite (void)
+{
+  Suite *s = suite_create ("ristdispatcher");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_equal_weights);
+  tcase_add_test (tc, test_weighted);
+  tcase_add_test (tc, test_weighted_spread);
+
+  return s;
+}
+
+GST_CHECK_MAIN (ristdispatcher);
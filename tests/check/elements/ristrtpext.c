@@ -1056,6 +1056,79 @@ GST_START_TEST (test_deext_seq_drop)
 
 GST_END_TEST;
 
+GST_START_TEST (test_deext_list)
+{
+  GstHarness *h = gst_harness_new ("ristrtpdeext");
+  GstBufferList *list;
+  GstBuffer *obuf;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp, payload=33,"
+      "clock-rate=90000, encoding-name=MP2T");
+
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list,
+      alloc_ts_buffer_with_ext (7, FALSE, FALSE, 7, 188, 0, 0));
+  gst_buffer_list_add (list,
+      alloc_ts_buffer_with_ext (6, TRUE, FALSE, 7, 188, 1 << 3, 0));
+  gst_buffer_list_add (list, alloc_ts_buffer (3));
+
+  fail_unless_equals_int (gst_pad_push_list (h->srcpad, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 3);
+
+  obuf = gst_harness_pull (h);
+  gst_rtp_buffer_map (obuf, GST_MAP_READ, &rtp);
+  validate_ts_buffer_noext (&rtp, 7);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (obuf);
+
+  obuf = gst_harness_pull (h);
+  gst_rtp_buffer_map (obuf, GST_MAP_READ, &rtp);
+  validate_ts_buffer_noext (&rtp, 7);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (obuf);
+
+  obuf = gst_harness_pull (h);
+  gst_rtp_buffer_map (obuf, GST_MAP_READ, &rtp);
+  validate_ts_buffer_noext (&rtp, 3);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (obuf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_deext_list_seq_drop)
+{
+  GstHarness *h = gst_harness_new ("ristrtpdeext");
+  GstBufferList *list;
+  GstBuffer *obuf;
+  guint max_seqnum;
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp, payload=33,"
+      "clock-rate=90000, encoding-name=MP2T");
+
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list,
+      alloc_ts_buffer_with_ext (7, FALSE, TRUE, 7, 188, 0, 2));
+  gst_buffer_list_add (list,
+      alloc_ts_buffer_with_ext (7, FALSE, TRUE, 7, 188, 0, 0));
+
+  fail_unless_equals_int (gst_pad_push_list (h->srcpad, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+
+  obuf = gst_harness_pull (h);
+  gst_buffer_unref (obuf);
+
+  g_object_get (h->element, "max-ext-seqnum", &max_seqnum, NULL);
+  fail_unless_equals_int (max_seqnum, 65536 + 65536 + 44);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 ristrtpext_suite (void)
 {
@@ -1096,6 +1169,8 @@ ristrtpext_suite (void)
 
   tcase_add_test (tc, test_deext_seq_base);
   tcase_add_test (tc, test_deext_seq_drop);
+  tcase_add_test (tc, test_deext_list);
+  tcase_add_test (tc, test_deext_list_seq_drop);
 
   return s;
 }
@@ -0,0 +1,290 @@
+/* GStreamer unit tests for the RIST sink weighted bonding
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gst/check/check.h>
+#include <gst/rtp/rtp.h>
+
+#include <math.h>
+
+#define RTP_SSRC 0x12345678
+#define RECEIVER_SSRC 0xabcdef00
+#define N_LINKS 2
+#define PACKETS_PER_REPORT 200
+
+#define CAPS_STR "application/x-rtp,media=video,clock-rate=90000," \
+    "encoding-name=MP2T,payload=33,ssrc=(uint)305419896"
+
+typedef struct
+{
+  GstHarness *h;
+  GstElement *rtpbin;
+  GstElement *dispatcher;
+  guint16 seqnum;
+
+  /* what the simulated receiver reported on each link */
+  guint64 last_sent[N_LINKS];
+  guint32 exthighestseq[N_LINKS];
+  gint32 packets_lost[N_LINKS];
+} WeightedTest;
+
+static void
+setup_weighted (WeightedTest * t)
+{
+  memset (t, 0, sizeof (WeightedTest));
+
+  t->h = gst_harness_new_parse ("ristsink bonding-method=weighted "
+      "bonding-addresses=127.0.0.1:5004,127.0.0.1:5006");
+  gst_harness_set_src_caps_str (t->h, CAPS_STR);
+
+  t->rtpbin = gst_bin_get_by_name (GST_BIN (t->h->element),
+      "rist_send_rtpbin");
+  fail_unless (t->rtpbin != NULL);
+  g_object_get (t->h->element, "dispatcher", &t->dispatcher, NULL);
+  fail_unless (t->dispatcher != NULL);
+}
+
+static void
+teardown_weighted (WeightedTest * t)
+{
+  gst_object_unref (t->dispatcher);
+  gst_object_unref (t->rtpbin);
+  gst_harness_teardown (t->h);
+}
+
+static GObject *
+get_session (WeightedTest * t, guint link)
+{
+  GObject *session = NULL;
+
+  g_signal_emit_by_name (t->rtpbin, "get-internal-session", link, &session);
+  fail_unless (session != NULL);
+
+  return session;
+}
+
+static guint64
+get_packets_sent (WeightedTest * t, guint link)
+{
+  GObject *session = get_session (t, link);
+  GObject *source = NULL;
+  GstStructure *stats;
+  guint64 packets_sent = 0;
+
+  g_signal_emit_by_name (session, "get-source-by-ssrc", RTP_SSRC, &source);
+  if (source) {
+    g_object_get (source, "stats", &stats, NULL);
+    gst_structure_get_uint64 (stats, "packets-sent", &packets_sent);
+    gst_structure_free (stats);
+    g_object_unref (source);
+  }
+  g_object_unref (session);
+
+  return packets_sent;
+}
+
+static gdouble
+get_link_weight (WeightedTest * t, guint link)
+{
+  GstPad *pad;
+  gchar *name;
+  gdouble weight;
+
+  name = g_strdup_printf ("src_%u", link);
+  pad = gst_element_get_static_pad (t->dispatcher, name);
+  g_free (name);
+  fail_unless (pad != NULL);
+
+  g_object_get (pad, "weight", &weight, NULL);
+  gst_object_unref (pad);
+
+  return weight;
+}
+
+/* Pushes PACKETS_PER_REPORT packets and waits for the sessions to send all
+ * of them, the links have their own retransmission queue threads */
+static void
+push_packets (WeightedTest * t)
+{
+  guint64 expected = 0, sent = 0;
+  guint i;
+
+  for (i = 0; i < N_LINKS; i++)
+    expected += get_packets_sent (t, i);
+  expected += PACKETS_PER_REPORT;
+
+  for (i = 0; i < PACKETS_PER_REPORT; i++) {
+    GstBuffer *buf = gst_rtp_buffer_new_allocate (188, 0, 0);
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp));
+    gst_rtp_buffer_set_ssrc (&rtp, RTP_SSRC);
+    gst_rtp_buffer_set_payload_type (&rtp, 33);
+    gst_rtp_buffer_set_seq (&rtp, t->seqnum++);
+    gst_rtp_buffer_set_timestamp (&rtp, t->seqnum * 90);
+    gst_rtp_buffer_unmap (&rtp);
+
+    fail_unless_equals_int (gst_harness_push (t->h, buf), GST_FLOW_OK);
+  }
+
+  for (i = 0; i < 500 && sent < expected; i++) {
+    guint link;
+
+    g_usleep (G_USEC_PER_SEC / 100);
+    sent = 0;
+    for (link = 0; link < N_LINKS; link++)
+      sent += get_packets_sent (t, link);
+  }
+  fail_unless_equals_uint64 (sent, expected);
+}
+
+/* Makes the receiver report on @link that @loss of the packets sent over it
+ * since its last report got lost */
+static void
+receive_report (WeightedTest * t, guint link, gdouble loss)
+{
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  GObject *session;
+  GstBuffer *buf;
+  guint64 sent;
+  guint32 lost;
+
+  sent = get_packets_sent (t, link);
+  fail_unless (sent > t->last_sent[link], "nothing sent on link %u", link);
+  lost = (sent - t->last_sent[link]) * loss;
+  t->exthighestseq[link] += sent - t->last_sent[link];
+  t->packets_lost[link] += lost;
+  t->last_sent[link] = sent;
+
+  buf = gst_rtcp_buffer_new (1400);
+  fail_unless (gst_rtcp_buffer_map (buf, GST_MAP_READWRITE, &rtcp));
+  fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_RR, &packet));
+  gst_rtcp_packet_rr_set_ssrc (&packet, RECEIVER_SSRC);
+  fail_unless (gst_rtcp_packet_add_rb (&packet, RTP_SSRC, 0,
+          t->packets_lost[link], t->exthighestseq[link], 0, 0, 0));
+  gst_rtcp_buffer_unmap (&rtcp);
+
+  /* the throughput is measured between two reports */
+  g_usleep (1000);
+
+  session = get_session (t, link);
+  g_signal_emit_by_name (session, "on-receiving-rtcp", buf);
+  g_object_unref (session);
+  gst_buffer_unref (buf);
+}
+
+static void
+report_round (WeightedTest * t, gdouble loss_1)
+{
+  push_packets (t);
+  receive_report (t, 0, 0.0);
+  receive_report (t, 1, loss_1);
+}
+
+static const GstStructure *
+get_session_stats (const GstStructure * stats, guint link)
+{
+  const GValue *array = gst_structure_get_value (stats, "session-stats");
+  GValueArray *sessions = g_value_get_boxed (array);
+
+  fail_unless_equals_int (sessions->n_values, N_LINKS);
+
+  return gst_value_get_structure (g_value_array_get_nth (sessions, link));
+}
+
+static void
+check_session_stats (WeightedTest * t, guint link, gdouble loss)
+{
+  const GstStructure *sstats;
+  GstStructure *stats;
+  gdouble weight, link_loss;
+  guint64 throughput;
+
+  g_object_get (t->h->element, "stats", &stats, NULL);
+  sstats = get_session_stats (stats, link);
+
+  fail_unless (gst_structure_get_double (sstats, "weight", &weight));
+  fail_unless (gst_structure_get_double (sstats, "link-loss", &link_loss));
+  fail_unless (gst_structure_get_uint64 (sstats, "link-throughput",
+          &throughput));
+
+  assert_equals_float (weight, get_link_weight (t, link));
+  fail_unless (fabs (link_loss - loss) < 0.02,
+      "link %u loss %f instead of %f", link, link_loss, loss);
+  fail_unless (throughput > 0);
+
+  gst_structure_free (stats);
+}
+
+GST_START_TEST (test_weighted_adaptation)
+{
+  WeightedTest t;
+  gdouble weight, prev;
+  guint i;
+
+  setup_weighted (&t);
+
+  /* both links start with the same weight, the first reports only give the
+   * reference the next ones are compared to */
+  report_round (&t, 0.0);
+  assert_equals_float (get_link_weight (&t, 0), 1.0);
+  assert_equals_float (get_link_weight (&t, 1), 1.0);
+
+  /* link 1 loses 30% of its packets, its weight goes down with every
+   * report while link 0 keeps the full share */
+  prev = 1.0;
+  for (i = 0; i < 3; i++) {
+    report_round (&t, 0.3);
+    weight = get_link_weight (&t, 1);
+    fail_unless (weight < prev, "weight %f not below %f", weight, prev);
+    prev = weight;
+    assert_equals_float (get_link_weight (&t, 0), 1.0);
+  }
+  fail_unless (prev < 0.5);
+  check_session_stats (&t, 0, 0.0);
+  check_session_stats (&t, 1, 0.3);
+
+  /* once it is loss free again it slowly gets its share back */
+  for (i = 0; i < 5; i++) {
+    report_round (&t, 0.0);
+    weight = get_link_weight (&t, 1);
+    fail_unless (weight > prev, "weight %f not above %f", weight, prev);
+    prev = weight;
+  }
+  for (i = 0; i < 30; i++)
+    report_round (&t, 0.0);
+  assert_equals_float (get_link_weight (&t, 0), 1.0);
+  assert_equals_float (get_link_weight (&t, 1), 1.0);
+  check_session_stats (&t, 1, 0.0);
+
+  teardown_weighted (&t);
+}
+
+GST_END_TEST;
+
+static Suite *
+ristsink_suite (void)
+{
+  Suite *s = suite_create ("ristsink");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+  tcase_add_test (tc, test_weighted_adaptation);
+
+  return s;
+}
+
+GST_CHECK_MAIN (ristsink);
@@ -0,0 +1,221 @@
+/* GStreamer unit tests for the scenechange element
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/app/gstappsrc.h>
+#include <gst/video/video.h>
+
+/* odd sizes so that the rows and slices don't split evenly */
+#define WIDTH 97
+#define HEIGHT 61
+#define N_FRAMES 8
+
+/* Fills the luma plane of frame @i with a pattern that changes from frame to
+ * frame, the result only depends on @i */
+static GstBuffer *
+create_frame (GstVideoInfo * info, guint i)
+{
+  GstBuffer *buf;
+  GstVideoFrame frame;
+  GRand *rand;
+  guint8 *data;
+  gint x, y, stride;
+
+  buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info), NULL);
+  gst_buffer_memset (buf, 0, 128, GST_VIDEO_INFO_SIZE (info));
+
+  fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+  data = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0);
+  stride = GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0);
+  rand = g_rand_new_with_seed (i);
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++)
+      data[y * stride + x] = g_rand_int_range (rand, 0, 256);
+  }
+  g_rand_free (rand);
+  gst_video_frame_unmap (&frame);
+
+  GST_BUFFER_PTS (buf) = i * GST_SECOND / 30;
+  GST_BUFFER_DURATION (buf) = GST_SECOND / 30;
+
+  return buf;
+}
+
+/* Mean absolute luma difference of frames @i and @j */
+static gdouble
+get_reference_score (GstVideoInfo * info, guint i, guint j)
+{
+  GstBuffer *b1 = create_frame (info, i);
+  GstBuffer *b2 = create_frame (info, j);
+  GstVideoFrame f1, f2;
+  guint64 sum = 0;
+  gint x, y;
+
+  fail_unless (gst_video_frame_map (&f1, info, b1, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&f2, info, b2, GST_MAP_READ));
+  for (y = 0; y < HEIGHT; y++) {
+    const guint8 *s1 = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&f1, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&f1, 0);
+    const guint8 *s2 = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&f2, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&f2, 0);
+
+    for (x = 0; x < WIDTH; x++)
+      sum += ABS ((gint) s1[x] - (gint) s2[x]);
+  }
+  gst_video_frame_unmap (&f1);
+  gst_video_frame_unmap (&f2);
+  gst_buffer_unref (b1);
+  gst_buffer_unref (b2);
+
+  return (gdouble) sum / (WIDTH * HEIGHT);
+}
+
+/* Runs N_FRAMES frames through scenechange with @props and returns the
+ * scores of the posted messages */
+static GArray *
+run_scenechange (const gchar * props)
+{
+  GstElement *pipeline, *src;
+  GstVideoInfo info;
+  GstBus *bus;
+  GstMessage *msg;
+  GArray *scores = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  gchar *desc;
+  guint i;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, WIDTH, HEIGHT);
+
+  desc = g_strdup_printf ("appsrc name=src format=time caps=video/x-raw,"
+      "format=I420,width=%d,height=%d,framerate=30/1 ! scenechange "
+      "name=sc post-messages=true %s ! fakesink", WIDTH, HEIGHT, props);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  bus = gst_element_get_bus (pipeline);
+
+  fail_unless_equals_int (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING), GST_STATE_CHANGE_ASYNC);
+
+  for (i = 0; i < N_FRAMES; i++)
+    fail_unless_equals_int (gst_app_src_push_buffer (GST_APP_SRC (src),
+            create_frame (&info, i)), GST_FLOW_OK);
+  gst_app_src_end_of_stream (GST_APP_SRC (src));
+
+  while ((msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+              GST_MESSAGE_ELEMENT | GST_MESSAGE_EOS | GST_MESSAGE_ERROR))) {
+    GstMessageType type = GST_MESSAGE_TYPE (msg);
+    const GstStructure *s = gst_message_get_structure (msg);
+
+    fail_if (type == GST_MESSAGE_ERROR);
+    if (type == GST_MESSAGE_ELEMENT &&
+        gst_structure_has_name (s, "GstSceneChange")) {
+      gdouble score;
+
+      fail_unless (gst_structure_get_double (s, "score", &score));
+      g_array_append_val (scores, score);
+    }
+    gst_message_unref (msg);
+
+    if (type == GST_MESSAGE_EOS)
+      break;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (bus);
+  gst_object_unref (src);
+  gst_object_unref (pipeline);
+
+  return scores;
+}
+
+static void
+check_same_scores (GArray * a, GArray * b)
+{
+  guint i;
+
+  fail_unless_equals_int (a->len, b->len);
+  /* the sums are integers, splitting them differently gives the same value */
+  for (i = 0; i < a->len; i++)
+    fail_unless_equals_float (g_array_index (a, gdouble, i),
+        g_array_index (b, gdouble, i));
+}
+
+GST_START_TEST (test_full_resolution_score)
+{
+  GstVideoInfo info;
+  GArray *scores;
+  guint i;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, WIDTH, HEIGHT);
+
+  scores = run_scenechange ("n-threads=1");
+
+  /* no message for the first frame, there is nothing to compare it to */
+  fail_unless_equals_int (scores->len, N_FRAMES - 1);
+  for (i = 0; i < scores->len; i++)
+    fail_unless_equals_float (g_array_index (scores, gdouble, i),
+        get_reference_score (&info, i, i + 1));
+
+  g_array_unref (scores);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_threads_match_single_thread)
+{
+  const gchar *subsamples[] = { "subsample=1", "subsample=3" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (subsamples); i++) {
+    gchar *props;
+    GArray *single, *threaded;
+
+    props = g_strdup_printf ("%s n-threads=1", subsamples[i]);
+    single = run_scenechange (props);
+    g_free (props);
+
+    props = g_strdup_printf ("%s n-threads=4", subsamples[i]);
+    threaded = run_scenechange (props);
+    g_free (props);
+
+    fail_unless_equals_int (single->len, N_FRAMES - 1);
+    check_same_scores (single, threaded);
+
+    g_array_unref (single);
+    g_array_unref (threaded);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+scenechange_suite (void)
+{
+  Suite *s = suite_create ("scenechange");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_full_resolution_score);
+  tcase_add_test (tc_chain, test_threads_match_single_thread);
+
+  return s;
+}
+
+GST_CHECK_MAIN (scenechange);
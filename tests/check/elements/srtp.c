@@ -30,6 +30,7 @@
 #include <gst/check/gstcheck.h>
 
 #include <gst/check/gstharness.h>
+#include <gst/rtp/gstrtpbuffer.h>
 
 GST_START_TEST (test_create_and_unref)
 {
@@ -207,6 +208,125 @@ GST_START_TEST (test_roc)
 
 GST_END_TEST;
 
+#define LIST_TEST_SSRC 1356955624
+#define LIST_TEST_PAYLOAD_SIZE 160
+/* More than the room srtpenc needs for the authentication tag and MKI */
+#define LIST_TEST_TRAILER_ROOM 256
+#define LIST_TEST_CAPS_RTP "application/x-rtp, media=(string)audio, clock-rate=(int)8000, encoding-name=(string)PCMA, payload=(int)8, ssrc=(uint)1356955624"
+#define LIST_TEST_CAPS_SRTP "application/x-srtp, media=(string)audio, clock-rate=(int)8000, encoding-name=(string)PCMA, payload=(int)8, ssrc=(uint)1356955624, srtp-key=(buffer)012345678901234567890123456789012345678901234567890123456789, srtp-cipher=(string)aes-128-icm, srtp-auth=(string)hmac-sha1-80, srtcp-cipher=(string)aes-128-icm, srtcp-auth=(string)hmac-sha1-80"
+
+/* Creates an RTP packet, optionally with spare room after it so that
+ * srtpenc can protect it in place */
+static GstBuffer *
+create_rtp_buffer (guint16 seqnum, gsize spare)
+{
+  GstRTPBuffer rtpbuf = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf;
+  guint8 *payload;
+  gsize size = 12 + LIST_TEST_PAYLOAD_SIZE;
+  guint i;
+
+  buf = gst_buffer_new_allocate (NULL, size + spare, NULL);
+  gst_buffer_memset (buf, 0, 0, size + spare);
+  gst_buffer_memset (buf, 0, 0x80, 1);
+  gst_buffer_set_size (buf, size);
+
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtpbuf));
+  gst_rtp_buffer_set_payload_type (&rtpbuf, 8);
+  gst_rtp_buffer_set_ssrc (&rtpbuf, LIST_TEST_SSRC);
+  gst_rtp_buffer_set_seq (&rtpbuf, seqnum);
+  gst_rtp_buffer_set_timestamp (&rtpbuf, seqnum * LIST_TEST_PAYLOAD_SIZE);
+  payload = gst_rtp_buffer_get_payload (&rtpbuf);
+  for (i = 0; i < LIST_TEST_PAYLOAD_SIZE; i++)
+    payload[i] = (seqnum + i) & 0xff;
+  gst_rtp_buffer_unmap (&rtpbuf);
+
+  return buf;
+}
+
+static GstHarness *
+create_srtpenc_harness (void)
+{
+  GstHarness *h =
+      gst_harness_new_with_padnames ("srtpenc", "rtp_sink_0", "rtp_src_0");
+  GstCaps *caps = gst_caps_from_string (LIST_TEST_CAPS_SRTP);
+  const GValue *key =
+      gst_structure_get_value (gst_caps_get_structure (caps, 0), "srtp-key");
+
+  g_object_set (h->element, "key", gst_value_get_buffer (key), NULL);
+  gst_caps_unref (caps);
+  gst_harness_set_src_caps_str (h, LIST_TEST_CAPS_RTP);
+
+  return h;
+}
+
+GST_START_TEST (test_list_roundtrip)
+{
+  GstHarness *enc, *dec;
+  GstBufferList *list;
+  GstBuffer *originals[16];
+  GstMemory *memories[16];
+  guint i;
+
+  enc = create_srtpenc_harness ();
+  dec = gst_harness_new_with_padnames ("srtpdec", "rtp_sink", "rtp_src");
+  gst_harness_set_caps_str (dec, LIST_TEST_CAPS_SRTP, LIST_TEST_CAPS_RTP);
+
+  /* Mix packets that can be protected in place with ones that need a
+   * pooled output buffer */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < G_N_ELEMENTS (originals); i++) {
+    GstBuffer *buf =
+        create_rtp_buffer (i, (i % 2) ? LIST_TEST_TRAILER_ROOM : 0);
+
+    originals[i] = gst_buffer_copy_deep (buf);
+    memories[i] = gst_buffer_peek_memory (buf, 0);
+    gst_buffer_list_add (list, buf);
+  }
+  fail_unless_equals_int (gst_harness_push_list (enc, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (enc),
+      G_N_ELEMENTS (originals));
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < G_N_ELEMENTS (originals); i++) {
+    GstBuffer *buf = gst_harness_pull (enc);
+    GstMapInfo map;
+
+    gst_buffer_map (originals[i], &map, GST_MAP_READ);
+    fail_unless (gst_buffer_get_size (buf) > map.size);
+    fail_unless (gst_buffer_memcmp (buf, 12, map.data + 12,
+            LIST_TEST_PAYLOAD_SIZE) != 0);
+    gst_buffer_unmap (originals[i], &map);
+    /* packets with room for the trailer are protected in their own memory */
+    if (i % 2) {
+      fail_unless_equals_int (gst_buffer_n_memory (buf), 1);
+      fail_unless (gst_buffer_peek_memory (buf, 0) == memories[i]);
+    }
+    gst_buffer_list_add (list, buf);
+  }
+  fail_unless_equals_int (gst_harness_push_list (dec, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (dec),
+      G_N_ELEMENTS (originals));
+
+  for (i = 0; i < G_N_ELEMENTS (originals); i++) {
+    GstBuffer *buf = gst_harness_pull (dec);
+    GstMapInfo map;
+
+    gst_buffer_map (originals[i], &map, GST_MAP_READ);
+    fail_unless_equals_int (gst_buffer_get_size (buf), map.size);
+    fail_unless (gst_buffer_memcmp (buf, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (originals[i], &map);
+
+    gst_buffer_unref (buf);
+    gst_buffer_unref (originals[i]);
+  }
+
+  gst_harness_teardown (enc);
+  gst_harness_teardown (dec);
+}
+
+GST_END_TEST;
+
 #ifdef HAVE_SRTP2
 
 GST_START_TEST (test_simple_mki)
@@ -352,6 +472,7 @@ srtp_suite (void)
   tcase_add_test (tc_chain, test_create_and_unref);
   tcase_add_test (tc_chain, test_play);
   tcase_add_test (tc_chain, test_roc);
+  tcase_add_test (tc_chain, test_list_roundtrip);
 #ifdef HAVE_SRTP2
   tcase_add_test (tc_chain, test_simple_mki);
   tcase_add_test (tc_chain, test_srtpdec_multiple_mki);
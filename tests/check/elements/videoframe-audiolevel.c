@@ -29,6 +29,8 @@
 #include <gst/check/gstcheck.h>
 #include <gst/audio/audio.h>
 
+#include <math.h>
+
 static gboolean got_eos;
 static guint audio_buffer_count, video_buffer_count;
 static GstSegment current_audio_segment, current_video_segment;
@@ -42,6 +44,13 @@ static gboolean audiodelay, videodelay, per_channel, long_video;
 static gboolean early_video, late_video;
 static gboolean video_gaps, video_overlaps;
 static gboolean audio_nondiscont, audio_drift;
+static gboolean loudness;
+/* push a 997Hz sine at -20dBFS as F32 at 48kHz instead of constant S8 */
+static gboolean sine;
+
+#define SINE_RATE 48000
+#define SINE_FREQ 997
+#define SINE_AMPLITUDE (0.1 * G_SQRT2)
 
 static guint fill_value_per_channel[] = { 0, 1 };
 static gdouble expected_rms_per_channel[] = { 0, 0.0078125 };
@@ -64,6 +73,8 @@ set_default_params (void)
   audio_drift = FALSE;
   early_video = FALSE;
   late_video = FALSE;
+  loudness = FALSE;
+  sine = FALSE;
 };
 
 static GstFlowReturn
@@ -93,7 +104,10 @@ output_achain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 
   gst_buffer_extract (buffer, 0, &b, 1);
 
-  if (per_channel) {
+  if (sine) {
+    /* the sine starts at 0 in every buffer */
+    fail_unless_equals_int (b, 0);
+  } else if (per_channel) {
     fail_unless_equals_int (b, fill_value_per_channel[0]);
   } else {
     fail_unless_equals_int (b, fill_value);
@@ -189,7 +203,9 @@ push_abuffers (gpointer data)
   GstClockTime timestamp = 0;
   GstAudioInfo info;
   GstCaps *caps;
-  guint buf_size = 1000;
+  /* one second of audio per buffer */
+  guint buf_size = sine ? SINE_RATE : 1000;
+  GstAudioFormat format = sine ? GST_AUDIO_FORMAT_F32 : GST_AUDIO_FORMAT_S8;
 
   if (audiodelay)
     g_usleep (2000);
@@ -199,8 +215,7 @@ push_abuffers (gpointer data)
 
   gst_pad_send_event (pad, gst_event_new_stream_start ("test"));
 
-  gst_audio_info_set_format (&info, GST_AUDIO_FORMAT_S8, buf_size, channels,
-      NULL);
+  gst_audio_info_set_format (&info, format, buf_size, channels, NULL);
   caps = gst_audio_info_to_caps (&info);
   gst_pad_send_event (pad, gst_event_new_caps (caps));
   gst_caps_unref (caps);
@@ -209,9 +224,26 @@ push_abuffers (gpointer data)
   gst_pad_send_event (pad, gst_event_new_segment (&segment));
 
   for (i = 0; i < n_abuffers; i++) {
-    GstBuffer *buf = gst_buffer_new_and_alloc (channels * buf_size);
+    GstBuffer *buf =
+        gst_buffer_new_and_alloc (GST_AUDIO_INFO_BPF (&info) * buf_size);
 
-    if (per_channel) {
+    if (sine) {
+      GstMapInfo map;
+      gfloat *in_data;
+
+      gst_buffer_map (buf, &map, GST_MAP_WRITE);
+      in_data = (gfloat *) map.data;
+
+      /* a whole number of periods per buffer */
+      for (j = 0; j < buf_size; j++) {
+        for (k = 0; k < channels; k++) {
+          in_data[j * channels + k] =
+              SINE_AMPLITUDE * sin (2 * G_PI * SINE_FREQ * j / SINE_RATE);
+        }
+      }
+
+      gst_buffer_unmap (buf, &map);
+    } else if (per_channel) {
       GstMapInfo map;
       guint8 *in_data;
 
@@ -293,10 +325,10 @@ on_message (GstBus * bus, GstMessage * message, gpointer user_data)
 {
   const GstStructure *s = gst_message_get_structure (message);
   const gchar *name = gst_structure_get_name (s);
-  GValueArray *rms_arr;
+  GValueArray *rms_arr, *peak_arr;
   const GValue *array_val;
   const GValue *value;
-  gdouble rms;
+  gdouble rms, peak;
   gint channels2;
   guint i;
   GstClockTime *rtime;
@@ -320,18 +352,53 @@ on_message (GstBus * bus, GstMessage * message, gpointer user_data)
   channels2 = rms_arr->n_values;
   fail_unless_equals_int (channels2, channels);
 
+  array_val = gst_structure_get_value (s, "peak");
+  peak_arr = (GValueArray *) g_value_get_boxed (array_val);
+  fail_unless_equals_int (peak_arr->n_values, channels);
+
+  /* all samples of a channel have the same value, so the peak is the RMS */
   for (i = 0; i < channels; ++i) {
     value = g_value_array_get_nth (rms_arr, i);
     rms = g_value_get_double (value);
-    if (per_channel) {
+    value = g_value_array_get_nth (peak_arr, i);
+    peak = g_value_get_double (value);
+    if (sine) {
+      /* a video frame holds about 30 periods */
+      fail_unless (fabs (rms - 0.1) < 0.001, "rms %f", rms);
+      fail_unless (peak <= SINE_AMPLITUDE && peak > 0.99 * SINE_AMPLITUDE,
+          "peak %f", peak);
+    } else if (per_channel) {
       fail_unless_equals_float (rms, expected_rms_per_channel[i]);
+      fail_unless_equals_float (peak, expected_rms_per_channel[i]);
     } else if (early_video && *rtime <= 50 * GST_MSECOND) {
       fail_unless_equals_float (rms, 0);
+      fail_unless_equals_float (peak, 0);
     } else {
       fail_unless_equals_float (rms, expected_rms);
+      fail_unless_equals_float (peak, expected_rms);
     }
   }
 
+  if (loudness) {
+    gdouble momentary;
+
+    fail_unless (gst_structure_get_double (s, "momentary-loudness",
+            &momentary));
+    if (!sine) {
+      /* the K-weighting removes DC, only the initial step gets through */
+      fail_unless (momentary < -30.0);
+    } else if (*rtime < 100 * GST_MSECOND) {
+      /* no complete block yet */
+      fail_unless_equals_float (momentary, -G_MAXDOUBLE);
+    } else {
+      /* a 997Hz sine at -20dBFS in one channel is -20 LUFS, the K-weighting
+       * gain at that frequency is what the -0.691 offset compensates */
+      fail_unless (fabs (momentary + 20.0) < 0.1, "loudness %f", momentary);
+    }
+  } else {
+    fail_if (gst_structure_has_field (s, "momentary-loudness"));
+  }
+
 done:
   return GST_BUS_PASS;
 }
@@ -355,6 +422,7 @@ test_videoframe_audiolevel_generic (void)
 
   alevel = gst_element_factory_make ("videoframe-audiolevel", NULL);
   fail_unless (alevel != NULL);
+  g_object_set (alevel, "loudness", loudness, NULL);
 
   bus = gst_bus_new ();
   gst_element_set_bus (alevel, bus);
@@ -605,6 +673,26 @@ GST_START_TEST (test_videoframe_audiolevel_late_video)
 
 GST_END_TEST;
 
+GST_START_TEST (test_videoframe_audiolevel_loudness)
+{
+  set_default_params ();
+  loudness = TRUE;
+  test_videoframe_audiolevel_generic ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_videoframe_audiolevel_loudness_sine)
+{
+  set_default_params ();
+  loudness = TRUE;
+  sine = TRUE;
+  channels = 1;
+  test_videoframe_audiolevel_generic ();
+}
+
+GST_END_TEST;
+
 
 static Suite *
 videoframe_audiolevel_suite (void)
@@ -631,6 +719,8 @@ videoframe_audiolevel_suite (void)
   tcase_add_test (tc_chain, test_videoframe_audiolevel_audio_drift);
   tcase_add_test (tc_chain, test_videoframe_audiolevel_early_video);
   tcase_add_test (tc_chain, test_videoframe_audiolevel_late_video);
+  tcase_add_test (tc_chain, test_videoframe_audiolevel_loudness);
+  tcase_add_test (tc_chain, test_videoframe_audiolevel_loudness_sine);
   suite_add_tcase (s, tc_chain);
 
   return s;
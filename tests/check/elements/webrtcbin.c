@@ -28,6 +28,7 @@
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstharness.h>
+#include <gst/rtp/rtp.h>
 #include <gst/webrtc/webrtc.h>
 #include "../../../ext/webrtc/webrtcsdp.h"
 #include "../../../ext/webrtc/webrtcsdp.c"
@@ -868,6 +869,145 @@ GST_START_TEST (test_audio)
 
 GST_END_TEST;
 
+#define AUDIO_SSRC 3384078950
+
+struct ssrc_queue_data
+{
+  struct test_webrtc *t;
+  GstElement *demux;
+  GstElement *queue;
+  guint buffers;
+};
+
+static GstPadProbeReturn
+_ssrc_demux_src_probe (GstPad * pad, GstPadProbeInfo * info,
+    struct ssrc_queue_data *data)
+{
+  GstPad *peer = gst_pad_get_peer (pad);
+  GstElement *queue;
+
+  fail_unless (peer != NULL);
+  queue = gst_pad_get_parent_element (peer);
+  gst_object_unref (peer);
+  fail_unless (queue != NULL);
+  fail_unless_equals_string (GST_OBJECT_NAME (gst_element_get_factory
+          (queue)), "queue");
+
+  g_mutex_lock (&data->t->lock);
+  if (!data->queue)
+    data->queue = gst_object_ref (queue);
+  data->buffers++;
+  g_cond_broadcast (&data->t->cond);
+  g_mutex_unlock (&data->t->lock);
+
+  gst_object_unref (queue);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+_ssrc_demux_pad_added (GstElement * demux, GstPad * pad,
+    struct ssrc_queue_data *data)
+{
+  gchar *name = gst_pad_get_name (pad);
+
+  if (g_str_has_prefix (name, "src_"))
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+        (GstPadProbeCallback) _ssrc_demux_src_probe, data, NULL);
+  g_free (name);
+}
+
+static void
+_ssrc_demux_element_added (GstBin * bin, GstBin * sub_bin,
+    GstElement * element, struct ssrc_queue_data *data)
+{
+  GstElementFactory *factory = gst_element_get_factory (element);
+
+  if (data->demux || !factory ||
+      g_strcmp0 (GST_OBJECT_NAME (factory), "rtpssrcdemux") != 0)
+    return;
+
+  data->demux = gst_object_ref (element);
+  g_signal_connect (element, "pad-added",
+      G_CALLBACK (_ssrc_demux_pad_added), data);
+}
+
+static GstBuffer *
+_create_audio_rtp_buffer (guint16 seqnum)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf = gst_rtp_buffer_new_allocate (20, 0, 0);
+
+  gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+  gst_rtp_buffer_set_payload_type (&rtp, 96);
+  gst_rtp_buffer_set_ssrc (&rtp, AUDIO_SSRC);
+  gst_rtp_buffer_set_seq (&rtp, seqnum);
+  gst_rtp_buffer_set_timestamp (&rtp, seqnum * 960);
+  gst_rtp_buffer_unmap (&rtp);
+
+  GST_BUFFER_PTS (buf) = seqnum * 20 * GST_MSECOND;
+
+  return buf;
+}
+
+GST_START_TEST (test_audio_receive_stream_threads)
+{
+  struct test_webrtc *t = test_webrtc_new ();
+  struct ssrc_queue_data data = { t, };
+  VAL_SDP_INIT (offer, _count_num_sdp_media, GUINT_TO_POINTER (1), NULL);
+  VAL_SDP_INIT (answer, _count_num_sdp_media, GUINT_TO_POINTER (1), NULL);
+  GstHarness *h;
+  GstCaps *caps;
+  guint16 seqnum = 0;
+
+  t->on_negotiation_needed = NULL;
+  t->on_ice_candidate = NULL;
+  t->on_pad_added = _pad_added_fakesink;
+
+  /* check that media received with the per stream receive threads goes
+   * through the queue of its SSRC */
+  g_object_set (t->webrtc1, "receive-stream-threads", TRUE, NULL);
+  g_object_set (t->webrtc2, "receive-stream-threads", TRUE, NULL);
+  g_signal_connect (t->webrtc2, "deep-element-added",
+      G_CALLBACK (_ssrc_demux_element_added), &data);
+
+  h = gst_harness_new_with_element (t->webrtc1, "sink_0", NULL);
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (96));
+  gst_harness_set_src_caps (h, caps);
+  t->harnesses = g_list_prepend (t->harnesses, h);
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  test_validate_sdp_full (t, &offer, &answer, 0, FALSE);
+
+  /* packets are dropped until ICE and DTLS are connected */
+  g_mutex_lock (&t->lock);
+  while (data.buffers < 10) {
+    gint64 end_time = g_get_monotonic_time () + 10 * G_TIME_SPAN_MILLISECOND;
+
+    g_mutex_unlock (&t->lock);
+    gst_harness_push (h, _create_audio_rtp_buffer (seqnum++));
+    g_mutex_lock (&t->lock);
+    g_cond_wait_until (&t->cond, &t->lock, end_time);
+  }
+  g_mutex_unlock (&t->lock);
+
+  /* removing the SSRC releases its queue */
+  fail_unless (data.queue != NULL);
+  fail_unless (GST_OBJECT_PARENT (data.queue) != NULL);
+  g_signal_emit_by_name (data.demux, "clear-ssrc", AUDIO_SSRC);
+  fail_unless (GST_OBJECT_PARENT (data.queue) == NULL);
+
+  test_webrtc_free (t);
+  gst_object_unref (data.queue);
+  gst_object_unref (data.demux);
+}
+
+GST_END_TEST;
+
 static struct test_webrtc *
 create_audio_video_test (void)
 {
@@ -1381,6 +1521,341 @@ GST_START_TEST (test_session_stats)
 
 GST_END_TEST;
 
+static gboolean
+_stats_check_type (GQuark field_id, const GValue * value, gpointer user_data)
+{
+  GstWebRTCStatsType expected = GPOINTER_TO_UINT (user_data);
+  GstWebRTCStatsType type;
+
+  fail_unless (GST_VALUE_HOLDS_STRUCTURE (value));
+  gst_structure_get (gst_value_get_structure (value), "type",
+      GST_TYPE_WEBRTC_STATS_TYPE, &type, NULL);
+  fail_unless_equals_int (type, expected);
+
+  return TRUE;
+}
+
+static void
+_on_stats_by_type (GstPromise * promise, GstWebRTCStatsType type,
+    struct test_webrtc *t)
+{
+  const GstStructure *reply = gst_promise_get_reply (promise);
+  int i;
+
+  fail_unless (gst_structure_n_fields (reply) > 0);
+  gst_structure_foreach (reply, _stats_check_type, GUINT_TO_POINTER (type));
+  validate_stats (reply);
+
+  i = GPOINTER_TO_INT (t->user_data);
+  i++;
+  t->user_data = GINT_TO_POINTER (i);
+  if (i >= 2)
+    test_webrtc_signal_state (t, STATE_CUSTOM);
+
+  gst_promise_unref (promise);
+}
+
+static void
+_on_codec_stats (GstPromise * promise, gpointer user_data)
+{
+  _on_stats_by_type (promise, GST_WEBRTC_STATS_CODEC, user_data);
+}
+
+static void
+_on_peer_connection_stats (GstPromise * promise, gpointer user_data)
+{
+  _on_stats_by_type (promise, GST_WEBRTC_STATS_PEER_CONNECTION, user_data);
+}
+
+static gboolean
+_stats_check_pad (GQuark field_id, const GValue * value, gpointer user_data)
+{
+  const gchar *codec_id = user_data;
+  const GstStructure *s = gst_value_get_structure (value);
+  GstWebRTCStatsType type;
+  gchar *stream_codec_id;
+
+  gst_structure_get (s, "type", GST_TYPE_WEBRTC_STATS_TYPE, &type, NULL);
+  /* a sink pad only selects the statistics of what it sends */
+  fail_unless (type != GST_WEBRTC_STATS_PEER_CONNECTION);
+  fail_unless (type != GST_WEBRTC_STATS_INBOUND_RTP);
+  fail_unless (type != GST_WEBRTC_STATS_REMOTE_OUTBOUND_RTP);
+  if (type == GST_WEBRTC_STATS_CODEC)
+    fail_unless_equals_string (g_quark_to_string (field_id), codec_id);
+
+  if (type == GST_WEBRTC_STATS_OUTBOUND_RTP
+      || type == GST_WEBRTC_STATS_REMOTE_INBOUND_RTP) {
+    fail_unless (gst_structure_get (s, "codec-id", G_TYPE_STRING,
+            &stream_codec_id, NULL));
+    fail_unless_equals_string (stream_codec_id, codec_id);
+    g_free (stream_codec_id);
+  }
+
+  return TRUE;
+}
+
+static void
+_on_pad_stats (GstPromise * promise, gpointer user_data)
+{
+  struct test_webrtc *t = user_data;
+  const GstStructure *reply = gst_promise_get_reply (promise);
+
+  validate_stats (reply);
+  fail_unless (gst_structure_has_field (reply, "codec-stats-sink_0"));
+  fail_if (gst_structure_has_field (reply, "codec-stats-sink_1"));
+  gst_structure_foreach (reply, _stats_check_pad, "codec-stats-sink_0");
+
+  test_webrtc_signal_state (t, STATE_CUSTOM);
+  gst_promise_unref (promise);
+}
+
+GST_START_TEST (test_session_stats_by_type)
+{
+  struct test_webrtc *t = create_audio_video_test ();
+  GstPromise *p;
+  GstPad *pad;
+
+  /* test that a filtered query only returns the requested statistics */
+  g_object_set (t->webrtc1, "stats-update-interval", 1000, NULL);
+  test_validate_sdp (t, NULL, NULL);
+
+  pad = gst_element_get_static_pad (t->webrtc1, "sink_0");
+  fail_unless (pad != NULL);
+
+  p = gst_promise_new_with_change_func (_on_codec_stats, t, NULL);
+  g_signal_emit_by_name (t->webrtc1, "get-stats-by-type", pad,
+      GST_WEBRTC_STATS_CODEC, p);
+  p = gst_promise_new_with_change_func (_on_peer_connection_stats, t, NULL);
+  g_signal_emit_by_name (t->webrtc1, "get-stats-by-type", NULL,
+      GST_WEBRTC_STATS_PEER_CONNECTION, p);
+
+  test_webrtc_wait_for_state_mask (t, 1 << STATE_CUSTOM);
+
+  /* the statistics for a pad leave out the other stream */
+  test_webrtc_signal_state (t, STATE_NEW);
+  p = gst_promise_new_with_change_func (_on_pad_stats, t, NULL);
+  g_signal_emit_by_name (t->webrtc1, "get-stats", pad, p);
+  test_webrtc_wait_for_state_mask (t, 1 << STATE_CUSTOM);
+
+  gst_object_unref (pad);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
+struct pacer_stats_check
+{
+  struct test_webrtc *t;
+  guint target_bitrate;
+  guint n_pacers;
+};
+
+static gboolean
+_check_pacer_stats (GQuark field_id, const GValue * value, gpointer user_data)
+{
+  struct pacer_stats_check *check = user_data;
+  const GstStructure *s = gst_value_get_structure (value);
+  GstWebRTCStatsType type;
+  GstStructure *pacer;
+  guint target_bitrate, bitrate, queued_packets;
+  guint64 queued_bytes, sent, dropped, queue_delay, average_delay, max_delay;
+
+  gst_structure_get (s, "type", GST_TYPE_WEBRTC_STATS_TYPE, &type, NULL);
+  if (type != GST_WEBRTC_STATS_TRANSPORT
+      || !gst_structure_get (s, "pacer-stats", GST_TYPE_STRUCTURE, &pacer,
+          NULL))
+    return TRUE;
+
+  fail_unless (gst_structure_get (pacer,
+          "target-bitrate", G_TYPE_UINT, &target_bitrate,
+          "bitrate", G_TYPE_UINT, &bitrate,
+          "queued-packets", G_TYPE_UINT, &queued_packets,
+          "queued-bytes", G_TYPE_UINT64, &queued_bytes,
+          "packets-sent", G_TYPE_UINT64, &sent,
+          "packets-dropped", G_TYPE_UINT64, &dropped,
+          "queue-delay", G_TYPE_UINT64, &queue_delay,
+          "average-queue-delay", G_TYPE_UINT64, &average_delay,
+          "max-queue-delay", G_TYPE_UINT64, &max_delay, NULL));
+
+  /* the pacing rate starts at the target and only goes down on loss */
+  fail_unless_equals_int (target_bitrate, check->target_bitrate);
+  fail_unless (bitrate > 0 && bitrate <= target_bitrate);
+  fail_unless_equals_uint64 (dropped, 0);
+  fail_unless (queued_packets > 0 || queued_bytes == 0);
+  fail_unless (average_delay <= max_delay);
+
+  gst_structure_free (pacer);
+  check->n_pacers++;
+
+  return TRUE;
+}
+
+static void
+_on_pacer_stats (GstPromise * promise, gpointer user_data)
+{
+  struct pacer_stats_check *check = user_data;
+  const GstStructure *reply = gst_promise_get_reply (promise);
+
+  validate_stats (reply);
+  gst_structure_foreach (reply, _check_pacer_stats, check);
+  fail_unless (check->n_pacers > 0);
+
+  test_webrtc_signal_state (check->t, STATE_CUSTOM);
+  gst_promise_unref (promise);
+}
+
+static void
+_check_pacer (struct test_webrtc *t, GstElement * webrtc,
+    guint target_bitrate)
+{
+  struct pacer_stats_check check = { t, target_bitrate, 0 };
+  GstPromise *p;
+
+  test_webrtc_signal_state (t, STATE_NEW);
+  p = gst_promise_new_with_change_func (_on_pacer_stats, &check, NULL);
+  g_signal_emit_by_name (webrtc, "get-stats", NULL, p);
+  test_webrtc_wait_for_state_mask (t, 1 << STATE_CUSTOM);
+}
+
+GST_START_TEST (test_session_stats_pacing)
+{
+  struct test_webrtc *t = create_audio_test ();
+  guint bitrate;
+
+  /* test that pacing can be configured and shows up in the transport stats */
+  g_object_set (t->webrtc1, "pacing-bitrate", 500000, NULL);
+  g_object_get (t->webrtc1, "pacing-bitrate", &bitrate, NULL);
+  fail_unless_equals_int (bitrate, 500000);
+
+  test_validate_sdp (t, NULL, NULL);
+
+  _check_pacer (t, t->webrtc1, 500000);
+
+  /* applies to the existing transports, a burst size below the packet size
+   * still lets packets through */
+  g_object_set (t->webrtc2, "pacing-bitrate", 250000, "pacing-burst-size",
+      0, NULL);
+  _check_pacer (t, t->webrtc2, 250000);
+
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
+static void
+_wait_for_ice_connected (struct test_webrtc *t, GstElement * webrtc)
+{
+  GstWebRTCICEGatheringState gathering_state;
+  GstWebRTCICEConnectionState connection_state;
+
+  g_mutex_lock (&t->lock);
+  g_object_get (webrtc, "ice-gathering-state", &gathering_state,
+      "ice-connection-state", &connection_state, NULL);
+  while (gathering_state != GST_WEBRTC_ICE_GATHERING_STATE_COMPLETE
+      || (connection_state != GST_WEBRTC_ICE_CONNECTION_STATE_CONNECTED
+          && connection_state != GST_WEBRTC_ICE_CONNECTION_STATE_COMPLETED)) {
+    g_cond_wait (&t->cond, &t->lock);
+    g_object_get (webrtc, "ice-gathering-state", &gathering_state,
+        "ice-connection-state", &connection_state, NULL);
+  }
+  g_mutex_unlock (&t->lock);
+}
+
+static gboolean
+_check_ice_timing_stats (GQuark field_id, const GValue * value,
+    gpointer user_data)
+{
+  guint *n_pairs = user_data;
+  const GstStructure *s = gst_value_get_structure (value);
+  GstWebRTCStatsType type;
+  guint64 gathering_time, connection_time;
+
+  gst_structure_get (s, "type", GST_TYPE_WEBRTC_STATS_TYPE, &type, NULL);
+  if (type != GST_WEBRTC_STATS_TRANSPORT
+      || !g_str_has_prefix (g_quark_to_string (field_id),
+          "ice-candidate-pair_"))
+    return TRUE;
+
+  fail_unless (gst_structure_get (s, "gathering-time", G_TYPE_UINT64,
+          &gathering_time, "connection-time", G_TYPE_UINT64, &connection_time,
+          NULL));
+  /* both agents run on this host, this is quick */
+  fail_unless (gathering_time < 30 * GST_SECOND);
+  fail_unless (connection_time < 30 * GST_SECOND);
+  (*n_pairs)++;
+
+  return TRUE;
+}
+
+static void
+_on_ice_timing_stats (GstPromise * promise, gpointer user_data)
+{
+  struct test_webrtc *t = user_data;
+  const GstStructure *reply = gst_promise_get_reply (promise);
+  guint n_pairs = 0;
+
+  validate_stats (reply);
+  gst_structure_foreach (reply, _check_ice_timing_stats, &n_pairs);
+  fail_unless (n_pairs > 0);
+
+  test_webrtc_signal_state (t, STATE_CUSTOM);
+  gst_promise_unref (promise);
+}
+
+GST_START_TEST (test_ice_agent_configuration)
+{
+  struct test_webrtc *t = create_audio_test ();
+  GObject *ice1, *ice2, *agent, *new_agent;
+  guint pacing, cache_time;
+  gboolean aggressive;
+  GstPromise *p;
+
+  g_object_get (t->webrtc1, "ice-agent", &ice1, NULL);
+  g_object_get (t->webrtc2, "ice-agent", &ice2, NULL);
+
+  g_object_set (ice1, "check-pacing", 5, "local-address-cache-time", 10,
+      NULL);
+  g_object_get (ice1, "check-pacing", &pacing, "local-address-cache-time",
+      &cache_time, NULL);
+  fail_unless_equals_int (pacing, 5);
+  fail_unless_equals_int (cache_time, 10);
+
+  /* aggressive nomination is the default, switching to regular nomination
+   * replaces the agent as long as no stream was added yet.  Older libnice
+   * versions can't change the mode and keep the agent */
+  g_object_get (ice1, "agent", &agent, NULL);
+  g_object_set (ice1, "aggressive-nomination", FALSE, NULL);
+  g_object_get (ice1, "aggressive-nomination", &aggressive, "agent",
+      &new_agent, NULL);
+  if (!aggressive)
+    fail_unless (new_agent != agent);
+  else
+    fail_unless (new_agent == agent);
+  /* the settings carry over to the new agent */
+  g_object_get (ice1, "check-pacing", &pacing, NULL);
+  fail_unless_equals_int (pacing, 5);
+  g_object_unref (agent);
+  g_object_unref (new_agent);
+
+  /* both agents gather from the same cached interface list */
+  g_object_set (ice2, "local-address-cache-time", 10, NULL);
+
+  test_validate_sdp (t, NULL, NULL);
+
+  /* once connected, the timing of both phases shows up in the stats */
+  _wait_for_ice_connected (t, t->webrtc1);
+  test_webrtc_signal_state (t, STATE_NEW);
+  p = gst_promise_new_with_change_func (_on_ice_timing_stats, t, NULL);
+  g_signal_emit_by_name (t->webrtc1, "get-stats", NULL, p);
+  test_webrtc_wait_for_state_mask (t, 1 << STATE_CUSTOM);
+
+  g_object_unref (ice1);
+  g_object_unref (ice2);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_add_transceiver)
 {
   struct test_webrtc *t = test_webrtc_new ();
@@ -1777,6 +2252,72 @@ GST_START_TEST (test_data_channel_transfer_data)
 
 GST_END_TEST;
 
+/* larger than the 16 KiB parts sctpenc passes to usrsctp but within the
+ * default max-message-size of 64 KiB */
+#define CHUNKED_MESSAGE_SIZE (64 * 1024)
+
+static void
+have_data_channel_transfer_chunked_data (struct test_webrtc *t,
+    GstElement * element, GObject * our, gpointer user_data)
+{
+  GObject *other = user_data;
+  guint8 *message = g_new (guint8, CHUNKED_MESSAGE_SIZE);
+  GBytes *data;
+  gsize i;
+
+  /* differs between the parts so that reordering them is noticed */
+  for (i = 0; i < CHUNKED_MESSAGE_SIZE; i++)
+    message[i] = (guint8) ((i >> 8) ^ i);
+
+  data = g_bytes_new_take (message, CHUNKED_MESSAGE_SIZE);
+
+  g_object_set_data_full (our, "expected", g_bytes_ref (data),
+      (GDestroyNotify) g_bytes_unref);
+  g_signal_connect (our, "on-message-data", G_CALLBACK (on_message_data), t);
+
+  g_signal_connect (other, "on-error",
+      G_CALLBACK (on_channel_error_not_reached), NULL);
+  g_signal_emit_by_name (other, "send-data", data);
+  g_bytes_unref (data);
+}
+
+GST_START_TEST (test_data_channel_transfer_chunked_data)
+{
+  struct test_webrtc *t = test_webrtc_new ();
+  GObject *channel = NULL;
+  VAL_SDP_INIT (offer, on_sdp_has_datachannel, NULL, NULL);
+  VAL_SDP_INIT (answer, on_sdp_has_datachannel, NULL, NULL);
+
+  t->on_negotiation_needed = NULL;
+  t->on_ice_candidate = NULL;
+  t->on_data_channel = have_data_channel_transfer_chunked_data;
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+
+  g_signal_emit_by_name (t->webrtc1, "create-data-channel", "label", NULL,
+      &channel);
+  g_assert_nonnull (channel);
+  t->data_channel_data = channel;
+  g_signal_connect (channel, "on-error",
+      G_CALLBACK (on_channel_error_not_reached), NULL);
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  /* the message is only signalled once, as a whole */
+  test_validate_sdp_full (t, &offer, &answer, 1 << STATE_CUSTOM, FALSE);
+
+  g_object_unref (channel);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 static void
 have_data_channel_create_data_channel (struct test_webrtc *t,
     GstElement * element, GObject * our, gpointer user_data)
@@ -1794,6 +2335,109 @@ have_data_channel_create_data_channel (struct test_webrtc *t,
       G_CALLBACK (on_channel_error_not_reached), NULL);
 }
 
+#define N_LIST_MESSAGES 16
+
+static void
+on_message_data_list (GObject * channel, GPtrArray * data,
+    struct test_webrtc *t)
+{
+  guint received =
+      GPOINTER_TO_UINT (g_object_get_data (channel, "received"));
+  GBytes *expected = g_object_get_data (channel, "expected");
+  guint i;
+
+  for (i = 0; i < data->len; i++) {
+    GBytes *bytes = g_ptr_array_index (data, i);
+
+    /* every other message is empty */
+    if (received % 2)
+      fail_unless (bytes == NULL);
+    else
+      g_assert_cmpbytes (bytes, expected);
+    received++;
+  }
+
+  fail_unless (received <= N_LIST_MESSAGES);
+  g_object_set_data (channel, "received", GUINT_TO_POINTER (received));
+
+  if (received == N_LIST_MESSAGES)
+    test_webrtc_signal_state (t, STATE_CUSTOM);
+}
+
+static void
+on_message_data_not_reached (GObject * channel, GBytes * data,
+    struct test_webrtc *t)
+{
+  g_assert_not_reached ();
+}
+
+static void
+have_data_channel_transfer_data_list (struct test_webrtc *t,
+    GstElement * element, GObject * our, gpointer user_data)
+{
+  GObject *other = user_data;
+  GBytes *data = g_bytes_new_static (test_string, strlen (test_string));
+  GPtrArray *list;
+  guint i;
+
+  g_object_set_data_full (our, "expected", g_bytes_ref (data),
+      (GDestroyNotify) g_bytes_unref);
+  g_signal_connect (our, "on-message-data-list",
+      G_CALLBACK (on_message_data_list), t);
+  g_signal_connect (our, "on-message-data",
+      G_CALLBACK (on_message_data_not_reached), t);
+
+  g_signal_connect (other, "on-error",
+      G_CALLBACK (on_channel_error_not_reached), NULL);
+
+  list = g_ptr_array_new ();
+  for (i = 0; i < N_LIST_MESSAGES; i++)
+    g_ptr_array_add (list, i % 2 ? NULL : data);
+
+  g_signal_emit_by_name (other, "send-data-list", list);
+
+  g_ptr_array_unref (list);
+  g_bytes_unref (data);
+}
+
+GST_START_TEST (test_data_channel_transfer_data_list)
+{
+  struct test_webrtc *t = test_webrtc_new ();
+  GObject *channel = NULL;
+  VAL_SDP_INIT (offer, on_sdp_has_datachannel, NULL, NULL);
+  VAL_SDP_INIT (answer, on_sdp_has_datachannel, NULL, NULL);
+
+  t->on_negotiation_needed = NULL;
+  t->on_ice_candidate = NULL;
+  t->on_data_channel = have_data_channel_transfer_data_list;
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+
+  g_signal_emit_by_name (t->webrtc1, "create-data-channel", "label", NULL,
+      &channel);
+  g_assert_nonnull (channel);
+  t->data_channel_data = channel;
+  g_signal_connect (channel, "on-error",
+      G_CALLBACK (on_channel_error_not_reached), NULL);
+  /* hold back outgoing messages for up to 10ms */
+  g_object_set (channel, "coalesce-latency", 10 * GST_MSECOND, NULL);
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  test_validate_sdp_full (t, &offer, &answer, 1 << STATE_CUSTOM, FALSE);
+
+  g_object_unref (channel);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_data_channel_create_after_negotiate)
 {
   struct test_webrtc *t = test_webrtc_new ();
@@ -2742,6 +3386,148 @@ GST_START_TEST (test_renego_transceiver_set_direction)
 
 GST_END_TEST;
 
+#define N_MANY_TRANSCEIVERS 128
+
+/* Checks that @webrtc still has the transceivers in @before, in the same
+ * m-lines and with the same @mids, and @n_pads pads */
+static void
+check_transceivers_unchanged (GstElement * webrtc, GArray * before,
+    gchar ** mids, gint n_pads)
+{
+  GArray *transceivers;
+  guint i;
+
+  g_signal_emit_by_name (webrtc, "get-transceivers", &transceivers);
+  fail_unless_equals_int (transceivers->len, before->len);
+  for (i = 0; i < transceivers->len; i++) {
+    GstWebRTCRTPTransceiver *trans =
+        g_array_index (transceivers, GstWebRTCRTPTransceiver *, i);
+    GstWebRTCRTPTransceiver *old =
+        g_array_index (before, GstWebRTCRTPTransceiver *, i);
+
+    fail_unless (trans == old);
+    fail_unless_equals_int (trans->mline, i);
+    fail_unless_equals_string (trans->mid, mids[i]);
+  }
+  g_array_unref (transceivers);
+
+  fail_unless_equals_int (GST_ELEMENT (webrtc)->numpads, n_pads);
+}
+
+GST_START_TEST (test_renego_many_transceivers)
+{
+  struct test_webrtc *t = test_webrtc_new ();
+  const gchar *expected_offer[N_MANY_TRANSCEIVERS];
+  const gchar *expected_answer[N_MANY_TRANSCEIVERS];
+  VAL_SDP_INIT (count, _count_num_sdp_media,
+      GUINT_TO_POINTER (N_MANY_TRANSCEIVERS), NULL);
+  VAL_SDP_INIT (offer, on_sdp_media_direction, expected_offer, &count);
+  VAL_SDP_INIT (answer, on_sdp_media_direction, expected_answer, &count);
+  VAL_SDP_INIT (renego_mid, sdp_media_equal_mid, NULL, NULL);
+  VAL_SDP_INIT (renego_ice_params, sdp_media_equal_ice_params, NULL,
+      &renego_mid);
+  GArray *transceivers, *transceivers1, *transceivers2;
+  gchar *mids[N_MANY_TRANSCEIVERS];
+  gint n_pads1, n_pads2;
+  GstCaps *caps;
+  gint64 start;
+  guint i;
+
+  /* negotiate a single bundled session with many transceivers, as used by
+   * conferencing setups, then renegotiate it without changes and with a
+   * single direction change */
+  t->on_negotiation_needed = NULL;
+  t->on_ice_candidate = NULL;
+  t->on_pad_added = _pad_added_fakesink;
+
+  gst_util_set_object_arg (G_OBJECT (t->webrtc1), "bundle-policy",
+      "max-bundle");
+  gst_util_set_object_arg (G_OBJECT (t->webrtc2), "bundle-policy",
+      "max-bundle");
+
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (96));
+  for (i = 0; i < N_MANY_TRANSCEIVERS; i++) {
+    GstWebRTCRTPTransceiver *trans;
+
+    g_signal_emit_by_name (t->webrtc1, "add-transceiver",
+        GST_WEBRTC_RTP_TRANSCEIVER_DIRECTION_SENDRECV, caps, &trans);
+    fail_unless (trans != NULL);
+    gst_object_unref (trans);
+
+    expected_offer[i] = "sendrecv";
+    expected_answer[i] = "recvonly";
+  }
+  gst_caps_unref (caps);
+
+  start = g_get_monotonic_time ();
+  test_validate_sdp (t, &offer, &answer);
+  GST_INFO ("initial negotiation of %u transceivers took %" G_GINT64_FORMAT
+      " us", N_MANY_TRANSCEIVERS, g_get_monotonic_time () - start);
+
+  g_signal_emit_by_name (t->webrtc2, "get-transceivers", &transceivers);
+  fail_unless (transceivers != NULL);
+  fail_unless_equals_int (transceivers->len, N_MANY_TRANSCEIVERS);
+  for (i = 0; i < transceivers->len; i++) {
+    GstWebRTCRTPTransceiver *trans =
+        g_array_index (transceivers, GstWebRTCRTPTransceiver *, i);
+
+    fail_unless_equals_int (trans->mline, i);
+    fail_unless (trans->mid != NULL);
+  }
+  g_array_unref (transceivers);
+
+  /* renegotiation keeps the existing transceivers and pads.  The arrays
+   * hold a reference, a replacement can't reuse the same address */
+  g_signal_emit_by_name (t->webrtc1, "get-transceivers", &transceivers1);
+  g_signal_emit_by_name (t->webrtc2, "get-transceivers", &transceivers2);
+  for (i = 0; i < N_MANY_TRANSCEIVERS; i++)
+    mids[i] = g_strdup (g_array_index (transceivers1,
+            GstWebRTCRTPTransceiver *, i)->mid);
+  n_pads1 = GST_ELEMENT (t->webrtc1)->numpads;
+  n_pads2 = GST_ELEMENT (t->webrtc2)->numpads;
+
+  /* nothing changed */
+  count.next = &renego_ice_params;
+  test_webrtc_reset_negotiation (t);
+  start = g_get_monotonic_time ();
+  test_validate_sdp (t, &offer, &answer);
+  GST_INFO ("unchanged renegotiation of %u transceivers took %"
+      G_GINT64_FORMAT " us", N_MANY_TRANSCEIVERS,
+      g_get_monotonic_time () - start);
+
+  check_transceivers_unchanged (t->webrtc1, transceivers1, mids, n_pads1);
+  check_transceivers_unchanged (t->webrtc2, transceivers2, mids, n_pads2);
+
+  /* only the last m-line changes */
+  g_signal_emit_by_name (t->webrtc1, "get-transceivers", &transceivers);
+  fail_unless_equals_int (transceivers->len, N_MANY_TRANSCEIVERS);
+  g_object_set (g_array_index (transceivers, GstWebRTCRTPTransceiver *,
+          N_MANY_TRANSCEIVERS - 1), "direction",
+      GST_WEBRTC_RTP_TRANSCEIVER_DIRECTION_INACTIVE, NULL);
+  g_array_unref (transceivers);
+  expected_offer[N_MANY_TRANSCEIVERS - 1] = "inactive";
+  expected_answer[N_MANY_TRANSCEIVERS - 1] = "inactive";
+
+  test_webrtc_reset_negotiation (t);
+  start = g_get_monotonic_time ();
+  test_validate_sdp (t, &offer, &answer);
+  GST_INFO ("renegotiation of one out of %u transceivers took %"
+      G_GINT64_FORMAT " us", N_MANY_TRANSCEIVERS,
+      g_get_monotonic_time () - start);
+
+  check_transceivers_unchanged (t->webrtc1, transceivers1, mids, n_pads1);
+  check_transceivers_unchanged (t->webrtc2, transceivers2, mids, n_pads2);
+
+  for (i = 0; i < N_MANY_TRANSCEIVERS; i++)
+    g_free (mids[i]);
+
+  g_array_unref (transceivers1);
+  g_array_unref (transceivers2);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 static Suite *
 webrtcbin_suite (void)
 {
@@ -2764,7 +3550,11 @@ webrtcbin_suite (void)
   if (nicesrc && nicesink && dtlssrtpenc && dtlssrtpdec) {
     tcase_add_test (tc, test_sdp_no_media);
     tcase_add_test (tc, test_session_stats);
+    tcase_add_test (tc, test_session_stats_by_type);
+    tcase_add_test (tc, test_session_stats_pacing);
+    tcase_add_test (tc, test_ice_agent_configuration);
     tcase_add_test (tc, test_audio);
+    tcase_add_test (tc, test_audio_receive_stream_threads);
     tcase_add_test (tc, test_audio_video);
     tcase_add_test (tc, test_media_direction);
     tcase_add_test (tc, test_media_setup);
@@ -2782,11 +3572,14 @@ webrtcbin_suite (void)
     tcase_add_test (tc, test_bundle_renego_add_stream);
     tcase_add_test (tc, test_bundle_max_compat_max_bundle_renego_add_stream);
     tcase_add_test (tc, test_renego_transceiver_set_direction);
+    tcase_add_test (tc, test_renego_many_transceivers);
     if (sctpenc && sctpdec) {
       tcase_add_test (tc, test_data_channel_create);
       tcase_add_test (tc, test_data_channel_remote_notify);
       tcase_add_test (tc, test_data_channel_transfer_string);
       tcase_add_test (tc, test_data_channel_transfer_data);
+      tcase_add_test (tc, test_data_channel_transfer_chunked_data);
+      tcase_add_test (tc, test_data_channel_transfer_data_list);
       tcase_add_test (tc, test_data_channel_create_after_negotiate);
       tcase_add_test (tc, test_data_channel_low_threshold);
       tcase_add_test (tc, test_data_channel_max_message_size);
@@ -0,0 +1,102 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Helpers shared by the benchmarks in this directory */
+
+#include "benchmark.h"
+
+/* Parses the command line with @options and the GStreamer options, and
+ * initializes GStreamer */
+gboolean
+benchmark_init (int *argc, char ***argv, const gchar * summary,
+    const GOptionEntry * options)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  gboolean ret;
+
+  ctx = g_option_context_new (summary);
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  ret = g_option_context_parse (ctx, argc, argv, &error);
+  if (!ret) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+  }
+  g_option_context_free (ctx);
+
+  return ret;
+}
+
+GstElement *
+benchmark_parse_launch (const gchar * description)
+{
+  GstElement *pipeline;
+  GError *error = NULL;
+
+  pipeline = gst_parse_launch (description, &error);
+  if (!pipeline) {
+    g_printerr ("Failed to create pipeline: %s\n", error->message);
+    g_clear_error (&error);
+  }
+
+  return pipeline;
+}
+
+/* Waits until @pipeline is done, returns FALSE if it posted an error */
+gboolean
+benchmark_wait_eos (GstElement * pipeline)
+{
+  GstBus *bus;
+  GstMessage *msg;
+  GError *error = NULL;
+  gboolean ret = TRUE;
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &error, NULL);
+    g_printerr ("Error: %s\n", error->message);
+    g_clear_error (&error);
+    ret = FALSE;
+  }
+
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  return ret;
+}
+
+/* Plays @pipeline until it is done and stops it again. @elapsed is set to
+ * the time this took in microseconds, at least 1 */
+gboolean
+benchmark_run (GstElement * pipeline, gint64 * elapsed)
+{
+  gint64 start;
+  gboolean ret;
+
+  start = g_get_monotonic_time ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  ret = benchmark_wait_eos (pipeline);
+  *elapsed = MAX (g_get_monotonic_time () - start, 1);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  return ret;
+}
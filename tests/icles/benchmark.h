@@ -0,0 +1,38 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+gboolean     benchmark_init         (int * argc, char *** argv,
+                                     const gchar * summary,
+                                     const GOptionEntry * options);
+
+GstElement * benchmark_parse_launch (const gchar * description);
+
+gboolean     benchmark_wait_eos     (GstElement * pipeline);
+
+gboolean     benchmark_run          (GstElement * pipeline, gint64 * elapsed);
+
+G_END_DECLS
+
+#endif /* __BENCHMARK_H__ */
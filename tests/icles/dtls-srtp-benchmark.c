@@ -0,0 +1,153 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of buffer lists sent over a local DTLS-SRTP
+ * loopback between a dtlssrtpenc/dtlssrtpdec client and server pair:
+ *
+ *   dtls-srtp-benchmark [--lists 1000] [--list-size 32] [--buffer-size 1000]
+ */
+
+#include <gst/app/gstappsrc.h>
+
+#include "benchmark.h"
+
+static GMutex lock;
+static GCond cond;
+static guint keys_set;
+static guint64 received;
+static guint64 expected;
+
+static void
+on_key_set (GstElement * element, gpointer user_data)
+{
+  g_mutex_lock (&lock);
+  keys_set++;
+  g_cond_broadcast (&cond);
+  g_mutex_unlock (&lock);
+}
+
+static void
+on_handoff (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  g_mutex_lock (&lock);
+  received++;
+  if (received == expected)
+    g_cond_broadcast (&cond);
+  g_mutex_unlock (&lock);
+}
+
+int
+main (int argc, char **argv)
+{
+  gint lists = 1000;
+  gint list_size = 32;
+  gint buffer_size = 1000;
+  GstElement *pipeline, *src, *sink, *enc;
+  guint8 *payload;
+  gint64 start, end;
+  gint i, j;
+  GOptionEntry options[] = {
+    {"lists", 'l', 0, G_OPTION_ARG_INT, &lists,
+        "Number of buffer lists to send (default: 1000)", NULL},
+    {"list-size", 'n', 0, G_OPTION_ARG_INT, &list_size,
+        "Buffers per list (default: 32)", NULL},
+    {"buffer-size", 'b', 0, G_OPTION_ARG_INT, &buffer_size,
+        "Bytes per buffer (default: 1000)", NULL},
+    {NULL}
+  };
+
+  if (!benchmark_init (&argc, &argv, "- DTLS-SRTP buffer list benchmark",
+          options))
+    return 1;
+
+  if (lists <= 0 || list_size <= 0 || buffer_size <= 0) {
+    g_printerr ("Invalid arguments\n");
+    return 1;
+  }
+
+  /* The decoders create the connections the encoders look up, so they have
+   * to come first. Data sent by the client comes out of the server decoder */
+  pipeline = benchmark_parse_launch ("dtlssrtpdec name=sdec "
+      "connection-id=server dtlssrtpdec name=cdec connection-id=client "
+      "appsrc name=src caps=application/data format=bytes ! "
+      "cenc.data_sink dtlssrtpenc name=cenc connection-id=client "
+      "is-client=true ! sdec. "
+      "dtlssrtpenc name=senc connection-id=server is-client=false ! cdec. "
+      "sdec.data_src ! fakesink name=sink sync=false async=false "
+      "signal-handoffs=true");
+  if (!pipeline)
+    return 1;
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_signal_connect (sink, "handoff", G_CALLBACK (on_handoff), NULL);
+  enc = gst_bin_get_by_name (GST_BIN (pipeline), "cenc");
+  g_signal_connect (enc, "on-key-set", G_CALLBACK (on_key_set), NULL);
+  gst_object_unref (enc);
+  enc = gst_bin_get_by_name (GST_BIN (pipeline), "senc");
+  g_signal_connect (enc, "on-key-set", G_CALLBACK (on_key_set), NULL);
+  gst_object_unref (enc);
+
+  expected = (guint64) lists * list_size;
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  g_mutex_lock (&lock);
+  while (keys_set < 2)
+    g_cond_wait (&cond, &lock);
+  g_mutex_unlock (&lock);
+
+  payload = g_malloc (buffer_size);
+  for (i = 0; i < buffer_size; i++)
+    payload[i] = i & 0xff;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < lists; i++) {
+    GstBufferList *list = gst_buffer_list_new_sized (list_size);
+
+    for (j = 0; j < list_size; j++)
+      gst_buffer_list_add (list, gst_buffer_new_wrapped (g_memdup (payload,
+                  buffer_size), buffer_size));
+
+    if (gst_app_src_push_buffer_list (GST_APP_SRC (src), list) != GST_FLOW_OK) {
+      g_printerr ("Failed to push buffer list\n");
+      break;
+    }
+  }
+
+  if (i == lists) {
+    g_mutex_lock (&lock);
+    while (received < expected)
+      g_cond_wait (&cond, &lock);
+    g_mutex_unlock (&lock);
+    end = g_get_monotonic_time ();
+
+    g_print ("transferred %" G_GUINT64_FORMAT " B in %" G_GINT64_FORMAT
+        " us (%.2f MB/s)\n", expected * buffer_size, end - start,
+        (gdouble) expected * buffer_size / MAX (end - start, 1));
+  }
+
+  g_free (payload);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (src);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return i == lists ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of fieldanalysis on telecined content at several
+ * resolutions:
+ *
+ *   fieldanalysis-benchmark [--frames N] [--threads N] [--fast]
+ *                           [--frame-metric 5-tap|windowed-comb]
+ */
+
+#include "benchmark.h"
+
+static const struct
+{
+  const gchar *name;
+  gint width;
+  gint height;
+} resolutions[] = {
+  {"480i", 720, 480},
+  {"576i", 720, 576},
+  {"1080i", 1920, 1080},
+  {"2160i", 3840, 2160},
+};
+
+static gboolean
+run_benchmark (gint width, gint height, gint frames, guint threads,
+    gboolean fast, const gchar * frame_metric, gdouble * fps)
+{
+  GstElement *pipeline;
+  gchar *desc;
+  gint64 elapsed;
+  gboolean ret;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d pattern=ball ! "
+      "video/x-raw,format=I420,width=%d,height=%d,framerate=24000/1001 ! "
+      "interlace field-pattern=2:3 ! "
+      "fieldanalysis n-threads=%u fast=%d frame-metric=%s ! fakesink",
+      frames, width, height, threads, fast, frame_metric);
+  pipeline = benchmark_parse_launch (desc);
+  g_free (desc);
+
+  if (!pipeline)
+    return FALSE;
+
+  ret = benchmark_run (pipeline, &elapsed);
+  gst_object_unref (pipeline);
+
+  if (ret)
+    *fps = frames * (gdouble) G_USEC_PER_SEC / elapsed;
+
+  return ret;
+}
+
+int
+main (int argc, char **argv)
+{
+  gint frames = 300;
+  guint threads = 1;
+  gboolean fast = FALSE;
+  gchar *frame_metric = NULL;
+  guint i;
+  GOptionEntry options[] = {
+    {"frames", 'n', 0, G_OPTION_ARG_INT, &frames,
+        "Number of source frames per resolution (default: 300)", NULL},
+    {"threads", 't', 0, G_OPTION_ARG_INT, &threads,
+        "Number of threads, 0 for the number of processors (default: 1)",
+        NULL},
+    {"fast", 'f', 0, G_OPTION_ARG_NONE, &fast,
+        "Only analyse a subset of the lines", NULL},
+    {"frame-metric", 'm', 0, G_OPTION_ARG_STRING, &frame_metric,
+        "Frame metric (default: 5-tap)", NULL},
+    {NULL}
+  };
+
+  if (!benchmark_init (&argc, &argv, "- fieldanalysis benchmark", options))
+    return 1;
+
+  g_print ("%-8s %10s %10s\n", "size", "fps", "Mpixel/s");
+
+  for (i = 0; i < G_N_ELEMENTS (resolutions); i++) {
+    gdouble fps;
+
+    if (!run_benchmark (resolutions[i].width, resolutions[i].height, frames,
+            threads, fast, frame_metric ? frame_metric : "5-tap", &fps))
+      return 1;
+
+    g_print ("%-8s %10.1f %10.1f\n", resolutions[i].name, fps,
+        fps * resolutions[i].width * resolutions[i].height / 1e6);
+  }
+
+  g_free (frame_metric);
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures how many times faster than realtime freeverb runs:
+ *
+ *   freeverb-benchmark [--seconds N] [--threads N] [--rate 48000]
+ *                      [--buffer-samples 1024]
+ */
+
+#include "benchmark.h"
+
+static const struct
+{
+  const gchar *format;
+  gint channels;
+} configurations[] = {
+  {"F32LE", 1},
+  {"F32LE", 2},
+  {"S16LE", 1},
+  {"S16LE", 2},
+};
+
+static gboolean
+run_benchmark (const gchar * format, gint channels, gint rate,
+    gint buffer_samples, gint seconds, guint threads, gdouble * factor)
+{
+  GstElement *pipeline;
+  gchar *desc;
+  gint64 elapsed;
+  gint num_buffers;
+  gboolean ret;
+
+  num_buffers = (gint64) seconds * rate / buffer_samples;
+
+  desc = g_strdup_printf ("audiotestsrc num-buffers=%d samplesperbuffer=%d "
+      "wave=pink-noise ! audio/x-raw,format=%s,rate=%d,channels=%d ! "
+      "freeverb n-threads=%u ! fakesink", num_buffers, buffer_samples, format,
+      rate, channels, threads);
+  pipeline = benchmark_parse_launch (desc);
+  g_free (desc);
+
+  if (!pipeline)
+    return FALSE;
+
+  ret = benchmark_run (pipeline, &elapsed);
+  gst_object_unref (pipeline);
+
+  if (ret)
+    *factor = (gdouble) num_buffers * buffer_samples / rate *
+        G_USEC_PER_SEC / elapsed;
+
+  return ret;
+}
+
+int
+main (int argc, char **argv)
+{
+  gint seconds = 60;
+  guint threads = 1;
+  gint rate = 48000;
+  gint buffer_samples = 1024;
+  guint i;
+  GOptionEntry options[] = {
+    {"seconds", 's', 0, G_OPTION_ARG_INT, &seconds,
+        "Seconds of audio per configuration (default: 60)", NULL},
+    {"threads", 't', 0, G_OPTION_ARG_INT, &threads,
+        "Number of threads, 0 for automatic (default: 1)", NULL},
+    {"rate", 'r', 0, G_OPTION_ARG_INT, &rate,
+        "Sample rate (default: 48000)", NULL},
+    {"buffer-samples", 'b', 0, G_OPTION_ARG_INT, &buffer_samples,
+        "Samples per buffer (default: 1024)", NULL},
+    {NULL}
+  };
+
+  if (!benchmark_init (&argc, &argv, "- freeverb benchmark", options))
+    return 1;
+
+  if (seconds <= 0 || rate <= 0 || buffer_samples <= 0) {
+    g_printerr ("Invalid arguments\n");
+    return 1;
+  }
+
+  g_print ("%-8s %8s %16s\n", "format", "channels", "realtime factor");
+
+  for (i = 0; i < G_N_ELEMENTS (configurations); i++) {
+    gdouble factor;
+
+    if (!run_benchmark (configurations[i].format, configurations[i].channels,
+            rate, buffer_samples, seconds, threads, &factor))
+      return 1;
+
+    g_print ("%-8s %8d %15.1fx\n", configurations[i].format,
+        configurations[i].channels, factor);
+  }
+
+  return 0;
+}
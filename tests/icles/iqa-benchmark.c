@@ -0,0 +1,128 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of the native iqa metrics at several resolutions:
+ *
+ *   iqa-benchmark [--frames N] [--threads N] [--format I420]
+ *                 [--metrics psnr,ssim,ms-ssim]
+ */
+
+#include "benchmark.h"
+
+static const struct
+{
+  const gchar *name;
+  gint width;
+  gint height;
+} resolutions[] = {
+  {"480p", 854, 480},
+  {"720p", 1280, 720},
+  {"1080p", 1920, 1080},
+  {"2160p", 3840, 2160},
+};
+
+static gboolean
+run_benchmark (const gchar * format, gint width, gint height, gint frames,
+    guint threads, gboolean psnr, gboolean ssim, gboolean ms_ssim,
+    gdouble * fps)
+{
+  GstElement *pipeline;
+  gchar *desc;
+  gint64 elapsed;
+  gboolean ret;
+
+  desc = g_strdup_printf ("iqa name=iqa do-psnr=%d do-ssim=%d do-ms-ssim=%d "
+      "n-threads=%u ! fakesink "
+      "videotestsrc num-buffers=%d pattern=ball ! "
+      "video/x-raw,format=%s,width=%d,height=%d ! iqa. "
+      "videotestsrc num-buffers=%d pattern=ball animation-mode=frames "
+      "flip=true ! video/x-raw,format=%s,width=%d,height=%d ! iqa.",
+      psnr, ssim, ms_ssim, threads, frames, format, width, height, frames,
+      format, width, height);
+  pipeline = benchmark_parse_launch (desc);
+  g_free (desc);
+
+  if (!pipeline)
+    return FALSE;
+
+  ret = benchmark_run (pipeline, &elapsed);
+  gst_object_unref (pipeline);
+
+  if (ret)
+    *fps = frames * (gdouble) G_USEC_PER_SEC / elapsed;
+
+  return ret;
+}
+
+int
+main (int argc, char **argv)
+{
+  gint frames = 100;
+  guint threads = 1;
+  gchar *format = NULL;
+  gchar *metrics = NULL;
+  gchar **names;
+  gboolean psnr = FALSE, ssim = FALSE, ms_ssim = FALSE;
+  guint i;
+  GOptionEntry options[] = {
+    {"frames", 'n', 0, G_OPTION_ARG_INT, &frames,
+        "Number of frames per resolution (default: 100)", NULL},
+    {"threads", 't', 0, G_OPTION_ARG_INT, &threads,
+        "Number of threads, 0 for the number of processors (default: 1)",
+        NULL},
+    {"format", 'f', 0, G_OPTION_ARG_STRING, &format,
+        "Video format (default: I420)", NULL},
+    {"metrics", 'm', 0, G_OPTION_ARG_STRING, &metrics,
+        "Comma separated metrics (default: psnr,ssim,ms-ssim)", NULL},
+    {NULL}
+  };
+
+  if (!benchmark_init (&argc, &argv, "- iqa metrics benchmark", options))
+    return 1;
+
+  names = g_strsplit (metrics ? metrics : "psnr,ssim,ms-ssim", ",", -1);
+  for (i = 0; names[i]; i++) {
+    if (g_str_equal (names[i], "psnr"))
+      psnr = TRUE;
+    else if (g_str_equal (names[i], "ssim"))
+      ssim = TRUE;
+    else if (g_str_equal (names[i], "ms-ssim"))
+      ms_ssim = TRUE;
+    else
+      g_printerr ("Unknown metric %s\n", names[i]);
+  }
+  g_strfreev (names);
+
+  g_print ("%-8s %10s %10s\n", "size", "fps", "Mpixel/s");
+
+  for (i = 0; i < G_N_ELEMENTS (resolutions); i++) {
+    gdouble fps;
+
+    if (!run_benchmark (format ? format : "I420", resolutions[i].width,
+            resolutions[i].height, frames, threads, psnr, ssim, ms_ssim, &fps))
+      return 1;
+
+    g_print ("%-8s %10.1f %10.1f\n", resolutions[i].name, fps,
+        fps * resolutions[i].width * resolutions[i].height / 1e6);
+  }
+
+  g_free (format);
+  g_free (metrics);
+
+  return 0;
+}
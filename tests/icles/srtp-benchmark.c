@@ -0,0 +1,136 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures how many RTP packets per second srtpenc protects when they are
+ * pushed in buffer lists, with and without room for in place protection:
+ *
+ *   srtp-benchmark [--packets 200000] [--list-size 32]
+ */
+
+#include <gst/app/gstappsrc.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+#include "benchmark.h"
+
+#define PAYLOAD_SIZE 1200
+#define SSRC 1356955624
+/* More than the room srtpenc needs for the authentication tag and MKI */
+#define TRAILER_ROOM 256
+
+static GstBuffer *
+create_rtp_buffer (guint16 seqnum, gsize spare)
+{
+  GstRTPBuffer rtpbuf = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf;
+  gsize size = 12 + PAYLOAD_SIZE;
+
+  buf = gst_buffer_new_allocate (NULL, size + spare, NULL);
+  gst_buffer_memset (buf, 0, 0, size + spare);
+  gst_buffer_memset (buf, 0, 0x80, 1);
+  gst_buffer_set_size (buf, size);
+
+  gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtpbuf);
+  gst_rtp_buffer_set_payload_type (&rtpbuf, 96);
+  gst_rtp_buffer_set_ssrc (&rtpbuf, SSRC);
+  gst_rtp_buffer_set_seq (&rtpbuf, seqnum);
+  gst_rtp_buffer_set_timestamp (&rtpbuf, seqnum * 3000);
+  gst_rtp_buffer_unmap (&rtpbuf);
+
+  return buf;
+}
+
+static gboolean
+run_benchmark (gint packets, gint list_size, gsize spare, gdouble * rate)
+{
+  GstElement *pipeline, *src;
+  gint64 start, end;
+  gboolean ret;
+  gint i, j;
+
+  pipeline = benchmark_parse_launch ("appsrc name=src format=time "
+      "caps=\"application/x-rtp,media=video,clock-rate=90000,"
+      "encoding-name=VP8,payload=96\" ! srtpenc "
+      "key=012345678901234567890123456789012345678901234567890123456789 ! "
+      "fakesink sync=false");
+  if (!pipeline)
+    return FALSE;
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < packets; i += list_size) {
+    GstBufferList *list = gst_buffer_list_new_sized (list_size);
+
+    for (j = 0; j < list_size; j++)
+      gst_buffer_list_add (list, create_rtp_buffer (i + j, spare));
+
+    if (gst_app_src_push_buffer_list (GST_APP_SRC (src), list) != GST_FLOW_OK)
+      break;
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (src));
+
+  ret = benchmark_wait_eos (pipeline);
+  end = g_get_monotonic_time ();
+
+  if (ret)
+    *rate = (gdouble) i * G_USEC_PER_SEC / MAX (end - start, 1);
+
+  gst_object_unref (src);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+int
+main (int argc, char **argv)
+{
+  gint packets = 200000;
+  gint list_size = 32;
+  gdouble rate;
+  GOptionEntry options[] = {
+    {"packets", 'p', 0, G_OPTION_ARG_INT, &packets,
+        "Number of packets per configuration (default: 200000)", NULL},
+    {"list-size", 'n', 0, G_OPTION_ARG_INT, &list_size,
+        "Packets per buffer list (default: 32)", NULL},
+    {NULL}
+  };
+
+  if (!benchmark_init (&argc, &argv, "- srtpenc buffer list benchmark",
+          options))
+    return 1;
+
+  if (packets <= 0 || list_size <= 0) {
+    g_printerr ("Invalid arguments\n");
+    return 1;
+  }
+
+  g_print ("%-10s %16s\n", "protection", "packets/s");
+
+  if (!run_benchmark (packets, list_size, 0, &rate))
+    return 1;
+  g_print ("%-10s %16.0f\n", "copy", rate);
+
+  if (!run_benchmark (packets, list_size, TRAILER_ROOM, &rate))
+    return 1;
+  g_print ("%-10s %16.0f\n", "in-place", rate);
+
+  return 0;
+}